@@ -16,10 +16,16 @@
 #include "TMemFile.h"
 #include "RConfig.h" /// R__DEPRECATED
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <set>
+#include <thread>
+#include <utility>
 
 namespace ROOT {
 
@@ -36,6 +42,14 @@ class TBufferMergerFile;
  * socket, TBufferMerger uses threads that each write to a
  * TBufferMergerFile, which in turn push data into a queue
  * managed by the TBufferMerger.
+ *
+ * By default, the buffers in the queue are merged into the output
+ * file by whichever thread pushes data when no other thread is
+ * merging. With SetAsyncWriting(), a dedicated writer thread does
+ * all the merging and writing instead, while the threads that
+ * write to TBufferMergerFiles only compress their data and push it
+ * to the queue. In this mode, TBufferMergerFile::SetWriteRange
+ * controls the order in which the data is written to the output.
  */
 
 class TBufferMerger {
@@ -93,6 +107,51 @@ public:
     */
    void SetAutoSave(size_t size);
 
+   /** Lets a dedicated writer thread merge the queued buffers and write
+    *  them to the output file, instead of the threads that push them.
+    *  The threads that call TBufferMergerFile::Write then only compress
+    *  their data, which helps when compression is expensive and writing
+    *  to the output would otherwise serialize the workers. The queued
+    *  buffers are merged in the order of their write range (see
+    *  TBufferMergerFile::SetWriteRange). The auto save setting is
+    *  ignored in this mode. Must be called before the first GetFile().
+    *  @param async Whether to use a dedicated writer thread
+    */
+   void SetAsyncWriting(Bool_t async = true);
+
+   /** Returns whether a dedicated writer thread merges and writes the data. */
+   Bool_t GetAsyncWriting() const
+   {
+      return fAsyncWriting;
+   }
+
+   /** Limits the number of bytes buffered in the queue when writing
+    *  asynchronously: TBufferMergerFile::Write waits for the writer
+    *  thread while more than size bytes are queued. Data that is next
+    *  in write order, or that has no write range, is never held back,
+    *  and neither is any data while no file produces the data that is
+    *  next in write order, so the limit can be exceeded.
+    *  @param size Maximum number of queued bytes (0 = no limit, default = 256 MB)
+    */
+   void SetMaxBuffered(size_t size)
+   {
+      fMaxBuffered = size;
+   }
+
+   /** Returns the maximum number of bytes buffered in the queue when writing asynchronously. */
+   size_t GetMaxBuffered() const
+   {
+      return fMaxBuffered;
+   }
+
+   /** Sets the first entry of the write ranges when writing asynchronously
+    *  (see TBufferMergerFile::SetWriteRange): the data with the write range
+    *  that starts at first is written first. Must be called before data is
+    *  written with a write range.
+    *  @param first First entry of the write ranges (default = 0)
+    */
+   void SetFirstWriteEntry(ULong64_t first);
+
    /** Sets the merge options. SetMergeOptions("fast") will disable
     * recompression of input data into the output if they have different
     * compression settings.
@@ -158,6 +217,14 @@ private:
    void Push(TBufferFile *buffer);
    bool TryMerge(TBufferMergerFile *memfile);
 
+   void PushOrdered(TBufferFile *buffer, ULong64_t begin, bool hasRange);
+   void OpenWriteRange(ULong64_t begin);
+   void CloseWriteRange(ULong64_t begin, ULong64_t end);
+   bool CanWriteNext() const;
+   bool MustWait(const TBufferFile *buffer, ULong64_t begin, bool hasRange) const;
+   void WriteLoop();
+   void StopWriter();
+
    bool fCompressTemporaryKeys{false};                           //< Enable compression of the TKeys in the TMemFile (save memory at the expense of time, end result is unchanged)
    size_t fAutoSave{0};                                          //< AutoSave only every fAutoSave bytes
    std::atomic<size_t> fBuffered{0};                             //< Number of bytes currently buffered
@@ -166,6 +233,16 @@ private:
    mutable std::mutex fQueueMutex;                               //< Mutex used to lock fQueue
    std::queue<TBufferFile *> fQueue;                             //< Queue to which data is pushed and merged
    std::vector<std::weak_ptr<TBufferMergerFile>> fAttachedFiles; //< Attached files
+   bool fAsyncWriting{false};                                    //< Merge and write on the fWriter thread
+   size_t fMaxBuffered{256 * 1024 * 1024};                       //< Maximum number of queued bytes with async writing
+   bool fStopWriter{false};                                      //< Signals fWriter to write all data and return
+   std::thread fWriter;                                          //< Thread that merges and writes with async writing
+   std::condition_variable fPushed;                              //< Signalled when data is queued or can be written
+   std::condition_variable fWritten;                             //< Signalled when queued data was written
+   ULong64_t fNextWriteEntry{0};                                 //< First entry of the write range to write next
+   std::multimap<ULong64_t, TBufferFile *> fOrderedQueue;        //< Queued buffers by first entry of their write range
+   std::multiset<ULong64_t> fOpenRanges;                         //< First entries of the ranges still being produced
+   std::map<ULong64_t, ULong64_t> fClosedRanges;                 //< Ranges that were produced but not written yet
 };
 
 /**
@@ -180,6 +257,8 @@ private:
 class TBufferMergerFile : public TMemFile {
 private:
    TBufferMerger &fMerger; //< TBufferMerger this file is attached to
+   std::pair<ULong64_t, ULong64_t> fWriteRange{0, 0}; //< Range of entries of the data currently written to this file
+   bool fHasWriteRange{false};                       //< Whether fWriteRange was set and not reset
 
    /** Constructor. Can only be called by TBufferMerger.
     * @param m Merger this file is attached to. */
@@ -211,6 +290,24 @@ public:
     */
    virtual Int_t Write(const char *name = nullptr, Int_t opt = 0, Int_t bufsize = 0) override;
 
+   /** Sets the range of entries [begin, end) of the data written from
+    *  now on, when the TBufferMerger writes asynchronously (see
+    *  TBufferMerger::SetAsyncWriting). The write ranges of all the files
+    *  must tile the entries starting at TBufferMerger::SetFirstWriteEntry,
+    *  each range being set once: the data of a range is written only
+    *  after the data of all the ranges that precede it, so the output is
+    *  in entry order whatever the order in which the files are filled.
+    *  The data of a range that is never set is written at the end, and
+    *  data written without a range is written as soon as possible.
+    *  @param begin First entry of the range
+    *  @param end One past the last entry of the range
+    */
+   void SetWriteRange(ULong64_t begin, ULong64_t end);
+
+   /** Signals that no more data will be written with the current write
+    *  range, so that the data of the following ranges can be written. */
+   void ResetWriteRange();
+
    ClassDefOverride(TBufferMergerFile, 0);
 };
 
@@ -17,6 +17,7 @@
 #include "TVirtualMutex.h"
 
 #include <utility>
+#include <vector>
 
 namespace ROOT {
 
@@ -46,6 +47,8 @@ TBufferMerger::~TBufferMerger()
    for (const auto &f : fAttachedFiles)
       if (!f.expired()) Fatal("TBufferMerger", " TBufferMergerFiles must be destroyed before the server");
 
+   StopWriter();
+
    if (!fQueue.empty())
       Merge();
 
@@ -68,7 +71,7 @@ std::shared_ptr<TBufferMergerFile> TBufferMerger::GetFile()
 size_t TBufferMerger::GetQueueSize() const
 {
    std::lock_guard<std::mutex> lock(fQueueMutex);
-   return fQueue.size();
+   return fQueue.size() + fOrderedQueue.size();
 }
 
 void TBufferMerger::Push(TBufferFile *buffer)
@@ -94,6 +97,23 @@ const char *TBufferMerger::GetMergeOptions()
 }
 
 
+void TBufferMerger::SetAsyncWriting(Bool_t async)
+{
+   if (async == fAsyncWriting)
+      return;
+   if (!fAttachedFiles.empty()) {
+      Error("SetAsyncWriting", "cannot change the writing mode after files were requested with GetFile()");
+      return;
+   }
+   if (async) {
+      fStopWriter = false;
+      fWriter = std::thread([this] { WriteLoop(); });
+   } else {
+      StopWriter();
+   }
+   fAsyncWriting = async;
+}
+
 void TBufferMerger::SetAutoSave(size_t size)
 {
    fAutoSave = size;
@@ -144,4 +164,138 @@ bool TBufferMerger::TryMerge(ROOT::TBufferMergerFile *memfile)
       return false;
 }
 
+void TBufferMerger::SetFirstWriteEntry(ULong64_t first)
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   fNextWriteEntry = first;
+}
+
+/// Whether a buffer must wait for the writer thread before it is queued. Must be called with fQueueMutex locked.
+bool TBufferMerger::MustWait(const TBufferFile *buffer, ULong64_t begin, bool hasRange) const
+{
+   if (fMaxBuffered == 0 || fBuffered + buffer->BufferSize() <= fMaxBuffered)
+      return false;
+   // The data that is next in write order is never held back, or the writer and this thread would wait for each other.
+   // Other data only waits if the next range is being produced or was produced, which guarantees that the writer
+   // makes progress: otherwise the file that will produce it might wait for a worker that waits here.
+   if (!hasRange || begin == fNextWriteEntry)
+      return false;
+   return fOpenRanges.count(fNextWriteEntry) > 0 || fClosedRanges.count(fNextWriteEntry) > 0;
+}
+
+void TBufferMerger::PushOrdered(TBufferFile *buffer, ULong64_t begin, bool hasRange)
+{
+   {
+      std::unique_lock<std::mutex> lock(fQueueMutex);
+      fWritten.wait(lock, [&] { return !MustWait(buffer, begin, hasRange); });
+      fBuffered += buffer->BufferSize();
+      // buffers of the same range are written in the order in which they are pushed
+      if (hasRange)
+         fOrderedQueue.emplace(begin, buffer);
+      else
+         fQueue.push(buffer);
+   }
+   fPushed.notify_one();
+}
+
+void TBufferMerger::OpenWriteRange(ULong64_t begin)
+{
+   std::lock_guard<std::mutex> lock(fQueueMutex);
+   fOpenRanges.insert(begin);
+}
+
+void TBufferMerger::CloseWriteRange(ULong64_t begin, ULong64_t end)
+{
+   {
+      std::lock_guard<std::mutex> lock(fQueueMutex);
+      auto it = fOpenRanges.find(begin);
+      if (it != fOpenRanges.end())
+         fOpenRanges.erase(it);
+      // an empty range would hide a non-empty range that starts at the same entry
+      if (end > begin)
+         fClosedRanges[begin] = end;
+   }
+   // the writer might have been waiting for this range
+   fPushed.notify_one();
+   fWritten.notify_all();
+}
+
+/// Whether the writer thread has data to write. Must be called with fQueueMutex locked.
+bool TBufferMerger::CanWriteNext() const
+{
+   if (!fQueue.empty())
+      return true;
+   if (!fOrderedQueue.empty() && fOrderedQueue.begin()->first == fNextWriteEntry)
+      return true;
+   return fClosedRanges.count(fNextWriteEntry) > 0;
+}
+
+void TBufferMerger::WriteLoop()
+{
+   std::unique_lock<std::mutex> lock(fQueueMutex);
+   while (true) {
+      fPushed.wait(lock, [this] { return fStopWriter || CanWriteNext(); });
+      if (fStopWriter && fQueue.empty() && fOrderedQueue.empty())
+         return;
+
+      // Take the buffers without a range, then the ones of the next range, moving on to the following range as long as
+      // the next one was closed. When stopping, the ranges that were never closed are written in order at the end.
+      std::vector<std::unique_ptr<TBufferFile>> buffers;
+      size_t nBytes = 0;
+      auto take = [&](TBufferFile *buffer) {
+         nBytes += buffer->BufferSize();
+         buffers.emplace_back(buffer);
+      };
+      for (; !fQueue.empty(); fQueue.pop())
+         take(fQueue.front());
+      bool advanced = false;
+      while (true) {
+         auto range = fOrderedQueue.equal_range(fNextWriteEntry);
+         for (auto it = range.first; it != range.second; ++it)
+            take(it->second);
+         fOrderedQueue.erase(range.first, range.second);
+         auto closed = fClosedRanges.find(fNextWriteEntry);
+         if (closed != fClosedRanges.end()) {
+            fNextWriteEntry = closed->second;
+            fClosedRanges.erase(closed);
+            advanced = true;
+         } else if (fStopWriter && !fOrderedQueue.empty()) {
+            fNextWriteEntry = fOrderedQueue.begin()->first;
+         } else {
+            break;
+         }
+      }
+      if (advanced)
+         fWritten.notify_all(); // the data of the new next range is not held back anymore
+
+      if (buffers.empty())
+         continue;
+      lock.unlock();
+      {
+         std::lock_guard<std::mutex> mergeLock(fMergeMutex);
+         for (auto &buffer : buffers)
+            fMerger.AddAdoptFile(new TMemFile(fMerger.GetOutputFileName(), std::move(buffer)));
+         fMerger.PartialMerge(TFileMerger::kAll | TFileMerger::kIncremental | TFileMerger::kDelayWrite |
+                              TFileMerger::kKeepCompression);
+         fMerger.Reset();
+      }
+      lock.lock();
+      fBuffered -= nBytes;
+      fWritten.notify_all();
+   }
+}
+
+/// Write all the queued data and join the writer thread, if it is running.
+void TBufferMerger::StopWriter()
+{
+   if (!fWriter.joinable())
+      return;
+   {
+      std::lock_guard<std::mutex> lock(fQueueMutex);
+      fStopWriter = true;
+   }
+   fPushed.notify_one();
+   fWriter.join();
+}
+
 } // namespace ROOT
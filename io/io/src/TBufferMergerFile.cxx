@@ -13,6 +13,8 @@
 
 #include "TBufferFile.h"
 
+#include <utility>
+
 namespace ROOT {
 
 TBufferMergerFile::TBufferMergerFile(TBufferMerger &m)
@@ -24,6 +26,26 @@ TBufferMergerFile::TBufferMergerFile(TBufferMerger &m)
 
 TBufferMergerFile::~TBufferMergerFile()
 {
+   ResetWriteRange();
+}
+
+void TBufferMergerFile::SetWriteRange(ULong64_t begin, ULong64_t end)
+{
+   // e.g. when the same range is announced again after the input switches to a new tree
+   if (fHasWriteRange && fWriteRange == std::make_pair(begin, end))
+      return;
+   ResetWriteRange();
+   fMerger.OpenWriteRange(begin);
+   fWriteRange = {begin, end};
+   fHasWriteRange = true;
+}
+
+void TBufferMergerFile::ResetWriteRange()
+{
+   if (!fHasWriteRange)
+      return;
+   fHasWriteRange = false;
+   fMerger.CloseWriteRange(fWriteRange.first, fWriteRange.second);
 }
 
 Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
@@ -35,8 +57,8 @@ Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
 
    // Instead of Writing the TTree, doing a memcpy, Pushing to the queue
    // then Reading and then deleting, let's see if we can just merge using
-   // the live TTree.
-   if (fMerger.TryMerge(this)) {
+   // the live TTree. With asynchronous writing, only the writer thread merges.
+   if (!fMerger.GetAsyncWriting() && fMerger.TryMerge(this)) {
       ResetAfterMerge(0);
       return 0;
    }
@@ -51,7 +73,10 @@ Int_t TBufferMergerFile::Write(const char *name, Int_t opt, Int_t bufsize)
       TBufferFile *buffer = new TBufferFile(TBuffer::kWrite, GetSize());
       CopyTo(*buffer);
       buffer->SetReadMode();
-      fMerger.Push(buffer);
+      if (fMerger.GetAsyncWriting())
+         fMerger.PushOrdered(buffer, fWriteRange.first, fHasWriteRange);
+      else
+         fMerger.Push(buffer);
       ResetAfterMerge(0);
    }
    return nbytes;
@@ -85,6 +85,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include <sys/stat.h>
 #ifndef WIN32
 #   include <unistd.h>
+#   include <sys/mman.h>
 #else
 #   define ssize_t int
 #   include <io.h>
@@ -130,6 +131,7 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TObjString.h"
 #include "TStopwatch.h"
 #include "compiledata.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <set>
@@ -139,6 +141,11 @@ The structure of a directory is shown in TDirectoryFile::TDirectoryFile
 #include "TGlobal.h"
 #include "ROOT/RConcurrentHashColl.hxx"
 #include <memory>
+#include <vector>
+
+#ifdef R__HAS_URING
+#include "ROOT/RIoUring.hxx"
+#endif
 
 using std::sqrt;
 
@@ -162,6 +169,53 @@ const Int_t kBEGIN = 100;
 
 ClassImp(TFile);
 
+#ifdef R__HAS_URING
+namespace {
+/// The maximum number of reads that are in flight at the same time in TFile::ReadBuffers.
+constexpr Int_t kMaxIoUringDepth = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the nbuf blocks described in arrays pos and len from the file descriptor fd, one after the other into buf,
+/// submitting all reads at once to an io_uring queue.
+/// Returns false if io_uring is not available or if some read did not succeed completely: the caller then falls back
+/// to blocking reads, which also report the errors.
+
+bool ReadBuffersIoUring(int fd, char *buf, const Long64_t *pos, const Int_t *len, Int_t nbuf, Long64_t archiveOffset)
+{
+   // the availability of io_uring is checked once per thread, to warn only once if it is not supported by the kernel
+   thread_local bool uringFailed = false;
+   if (uringFailed)
+      return false;
+
+   std::unique_ptr<ROOT::Internal::RIoUring> ring;
+   try {
+      ring = std::make_unique<ROOT::Internal::RIoUring>(std::min(nbuf, kMaxIoUringDepth));
+   } catch (const std::runtime_error &e) {
+      Warning("TFile::ReadBuffers", "io_uring is not available, falling back to blocking reads:\n%s", e.what());
+      uringFailed = true;
+      return false;
+   }
+
+   std::vector<ROOT::Internal::RIoUring::RReadEvent> reads(nbuf);
+   Long64_t k = 0;
+   for (Int_t i = 0; i < nbuf; ++i) {
+      reads[i].fBuffer = &buf[k];
+      reads[i].fOffset = pos[i] + archiveOffset;
+      reads[i].fSize = len[i];
+      reads[i].fFileDes = fd;
+      k += len[i];
+   }
+   try {
+      ring->SubmitReadsAndWait(reads.data(), nbuf);
+   } catch (const std::runtime_error &) {
+      return false;
+   }
+   return std::all_of(reads.begin(), reads.end(),
+                      [](const ROOT::Internal::RIoUring::RReadEvent &read) { return read.fOutBytes == read.fSize; });
+}
+} // anonymous namespace
+#endif
+
 //*-*x17 macros/layout_file
 // Needed to add the "fake" global gFile to the list of globals.
 namespace {
@@ -207,10 +261,19 @@ TFile::TFile() : TDirectoryFile(), fCompress(ROOT::RCompressionSetting::EAlgorit
 /// RECREATE      | Create a new file, if the file already exists it will be overwritten.
 /// UPDATE        | Open an existing file for writing. If no file exists, it is created.
 /// READ          | Open an existing file for reading (default).
+/// READ_MMAP     | Open an existing local file for reading through a memory mapping of the whole file, see below.
 /// NET           | Used by derived remote file access classes, not a user callable option.
 /// WEB           | Used by derived remote http access class, not a user callable option.
 ///
 /// If option = "" (default), READ is assumed.
+///
+/// With option READ_MMAP, the file is mapped in memory, and the data is read directly from the mapping rather than
+/// with one read call per record. TBasket::ReadBasketBuffers uses the mapped bytes of uncompressed baskets in place,
+/// without copying them, and decompresses the other baskets straight from the mapping. This mostly benefits
+/// applications that read the same local files repeatedly, e.g. from the page cache of a local SSD. The bytes read
+/// from the mapping are not counted by GetBytesRead() and GetReadCalls(). If the file cannot be mapped, e.g. on
+/// Windows, it is read as with option READ. GetOption() returns "READ" in both cases: use IsMapped() to check whether
+/// the file is mapped.
 /// The file can be specified as a URL of the form:
 ///
 ///     file:///user/rdm/bla.root or file:/user/rdm/bla.root
@@ -387,6 +450,11 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
    Bool_t recreate = (fOption == "RECREATE") ? kTRUE : kFALSE;
    Bool_t update   = (fOption == "UPDATE") ? kTRUE : kFALSE;
    Bool_t read     = (fOption == "READ") ? kTRUE : kFALSE;
+   const Bool_t readMmap = (fOption == "READ_MMAP") ? kTRUE : kFALSE;
+   if (readMmap) {
+      read    = kTRUE;
+      fOption = "READ";
+   }
    if (!create && !recreate && !update && !read) {
       read    = kTRUE;
       fOption = "READ";
@@ -493,6 +561,8 @@ TFile::TFile(const char *fname1, Option_t *option, const char *ftitle, Int_t com
          goto zombie;
       }
       fWritable = kFALSE;
+      if (readMmap)
+         MapFile();
    }
 
    // calling virtual methods from constructor not a good idea, but it is how code was developed
@@ -897,6 +967,7 @@ void TFile::Close(Option_t *option)
 
    if (fIsArchive || !fIsRootFile) {
       FlushWriteCache();
+      UnmapFile();
       SysClose(fD);
       fD = -1;
 
@@ -952,6 +1023,7 @@ void TFile::Close(Option_t *option)
    }
 
    if (IsOpen()) {
+      UnmapFile();
       SysClose(fD);
       fD = -1;
    }
@@ -1660,6 +1732,12 @@ Bool_t TFile::ReadBuffer(char *buf, Long64_t pos, Int_t len)
          return kFALSE;
       }
 
+      if (const char *mapped = GetMappedBuffer(pos, len)) {
+         memcpy(buf, mapped, len);
+         SetOffset(pos + len);
+         return kFALSE;
+      }
+
       Seek(pos);
       ssize_t siz;
 
@@ -1757,6 +1835,45 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
       return kFALSE;
    }
 
+   // memory-mapped files: copy the blocks from the mapping
+   if (fMmapBuffer) {
+      Int_t k = 0;
+      Int_t j = 0;
+      for (; j < nbuf; j++) {
+         const char *mapped = GetMappedBuffer(pos[j], len[j]);
+         if (!mapped)
+            break;
+         memcpy(&buf[k], mapped, len[j]);
+         k += len[j];
+      }
+      if (j == nbuf)
+         return kFALSE;
+   }
+
+#ifdef R__HAS_URING
+   // For local files, all blocks are read at once with io_uring, rather than with one blocking read per block (or per
+   // group of blocks that fit in the read-ahead buffer): the reads are then served in parallel by the storage device.
+   // Derived classes that are not local files implement their own SysRead.
+   if (nbuf > 1 && fD >= 0 && IsA() == TFile::Class() && gEnv->GetValue("TFile.IoUring", 1) == 1) {
+      Double_t start = 0;
+      if (gPerfStats) start = TTimeStamp();
+      if (ReadBuffersIoUring(fD, buf, pos, len, nbuf, fArchiveOffset)) {
+         Long64_t nbytes = 0;
+         for (Int_t j = 0; j < nbuf; j++)
+            nbytes += len[j];
+         fBytesRead  += nbytes;
+         fgBytesRead += nbytes;
+         fReadCalls++;
+         fgReadCalls++;
+         if (gMonitoringWriter)
+            gMonitoringWriter->SendFileReadProgress(this);
+         if (gPerfStats)
+            gPerfStats->FileReadEvent(this, static_cast<Int_t>(nbytes), start);
+         return kFALSE;
+      }
+   }
+#endif
+
    Int_t k = 0;
    Bool_t result = kTRUE;
    TFileCacheRead *old = fCacheRead;
@@ -1807,6 +1924,62 @@ Bool_t TFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, Int_t nbuf)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Map the whole file in memory, see option READ_MMAP of the constructor.
+/// If the file cannot be mapped, a warning is issued and the file is read with read calls.
+
+void TFile::MapFile()
+{
+#ifndef WIN32
+   Long_t id, flags, modtime;
+   Long64_t size = 0;
+   if (SysStat(fD, &id, &size, &flags, &modtime) != 0 || size <= 0) {
+      Warning("MapFile", "cannot determine the size of file %s, it is not memory mapped", GetName());
+      return;
+   }
+   // The mapping is private and writable, so that code that modifies the content of a basket buffer in place (as it
+   // can do with buffers it owns) gets a copy of the affected pages, rather than a crash. The file is never modified.
+   void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_NORESERVE, fD, 0);
+   if (addr == MAP_FAILED) {
+      SysError("MapFile", "cannot memory map file %s, it is read with read calls", GetName());
+      return;
+   }
+   fMmapBuffer = static_cast<char *>(addr);
+   fMmapSize = size;
+#else
+   Warning("MapFile", "memory mapped files are not supported on this platform, file %s is read with read calls",
+           GetName());
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Release the memory mapping of the file, if any.
+
+void TFile::UnmapFile()
+{
+#ifndef WIN32
+   if (fMmapBuffer)
+      munmap(fMmapBuffer, fMmapSize);
+#endif
+   fMmapBuffer = nullptr;
+   fMmapSize = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the address of the bytes [pos, pos + len) of the file in its memory mapping, see option READ_MMAP of the
+/// constructor, or nullptr if the file is not mapped or the bytes are out of the mapping.
+///
+/// The returned buffer is valid until the file is closed. It is used e.g. by TBasket::ReadBasketBuffers to read
+/// baskets without copying them.
+
+char *TFile::GetMappedBuffer(Long64_t pos, Int_t len) const
+{
+   const Long64_t begin = pos + fArchiveOffset;
+   if (!fMmapBuffer || begin < 0 || len < 0 || begin + len > fMmapSize)
+      return nullptr;
+   return fMmapBuffer + begin;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read buffer via cache.
 ///
@@ -2147,6 +2320,7 @@ Int_t TFile::ReOpen(Option_t *mode)
 
       // close readonly file
       if (IsOpen()) {
+         UnmapFile();
          SysClose(fD);
          fD = -1;
       }
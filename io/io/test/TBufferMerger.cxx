@@ -8,6 +8,7 @@
 #include "TTree.h"
 
 #include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <future>
 #include <memory>
@@ -160,6 +161,74 @@ TEST(TBufferMerger, AutoSave)
    RemoveFile("tbuffermerger_autosave.root");
 }
 
+TEST(TBufferMerger, AsyncWritingInOrder)
+{
+   const int nthreads = 4;
+   const int nchunks = 8;
+   const int chunksize = 1000;
+   const ULong64_t firstEntry = 42;
+
+   ROOT::EnableThreadSafety();
+
+   {
+      TBufferMerger merger("tbuffermerger_async.root");
+      merger.SetAsyncWriting();
+      merger.SetMaxBuffered(64 * 1024);
+      merger.SetFirstWriteEntry(firstEntry);
+      EXPECT_TRUE(merger.GetAsyncWriting());
+
+      std::vector<std::shared_ptr<TBufferMergerFile>> files;
+      for (int i = 0; i < nthreads; ++i) {
+         files.emplace_back(merger.GetFile());
+         // the threads fill their trees concurrently: the ranges make the output independent of the scheduling
+         const ULong64_t begin = firstEntry + i * nchunks * chunksize;
+         files.back()->SetWriteRange(begin, begin + nchunks * chunksize);
+      }
+
+      std::vector<std::thread> threads;
+      for (int i = 0; i < nthreads; ++i) {
+         threads.emplace_back([&, i]() {
+            auto &myfile = files[i];
+            myfile->cd();
+            auto mytree = new TTree("mytree", "mytree");
+            int n = 0;
+            mytree->Branch("n", &n, "n/I");
+            // the last thread starts first
+            std::this_thread::sleep_for(std::chrono::milliseconds(10 * (nthreads - i)));
+            for (int c = 0; c < nchunks; ++c) {
+               for (int e = 0; e < chunksize; ++e) {
+                  n = (i * nchunks + c) * chunksize + e;
+                  mytree->Fill();
+               }
+               myfile->Write();
+            }
+            mytree->ResetBranchAddresses();
+            myfile->ResetWriteRange();
+         });
+      }
+
+      for (auto &&t : threads)
+         t.join();
+      files.clear();
+   }
+
+   {
+      TFile f("tbuffermerger_async.root");
+      auto t = f.Get<TTree>("mytree");
+      ASSERT_TRUE(t != nullptr);
+      ASSERT_EQ(t->GetEntries(), nthreads * nchunks * chunksize);
+
+      int n = 0;
+      t->SetBranchAddress("n", &n);
+      for (int i = 0; i < t->GetEntries(); ++i) {
+         t->GetEntry(i);
+         ASSERT_EQ(n, i);
+      }
+   }
+
+   RemoveFile("tbuffermerger_async.root");
+}
+
 TEST(TBufferMerger, CheckTreeFillResults)
 {
    int sum_s, sum_p;
@@ -1,7 +1,12 @@
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "gtest/gtest.h"
 
+#include "TEnv.h"
 #include "TFile.h"
 #include "TKey.h"
 #include "TNamed.h"
@@ -85,3 +90,80 @@ TEST(TFile, ReadFromSameFile)
 
    EXPECT_TRUE(o1 != o2) << "Same objects read from two different files have the same pointer!";
 }
+
+// ReadBuffers reads the same bytes, whether all blocks are read at once (e.g. with io_uring) or one after the other
+TEST(TFile, ReadBuffers)
+{
+   auto filename{"tfile_readbuffers.root"};
+   {
+      TFile f{filename, "recreate"};
+      for (int i = 0; i < 100; ++i) {
+         std::vector<int> vec(i * 100, i);
+         f.WriteObject(&vec, ("vec" + std::to_string(i)).c_str());
+      }
+   }
+
+   TFile f{filename};
+   // the blocks are passed in increasing order of their positions, as TFileCacheRead does
+   std::vector<std::pair<Long64_t, Int_t>> blocks;
+   for (auto key : TRangeDynCast<TKey>(*f.GetListOfKeys()))
+      blocks.emplace_back(key->GetSeekKey(), key->GetNbytes());
+   std::sort(blocks.begin(), blocks.end());
+   std::vector<Long64_t> pos;
+   std::vector<Int_t> len;
+   for (const auto &block : blocks) {
+      pos.push_back(block.first);
+      len.push_back(block.second);
+   }
+   const auto nbytes = std::accumulate(len.begin(), len.end(), 0);
+
+   // one read per block
+   std::vector<char> expected(nbytes);
+   int k = 0;
+   for (std::size_t i = 0; i < pos.size(); ++i) {
+      f.Seek(pos[i]);
+      ASSERT_FALSE(f.ReadBuffer(&expected[k], len[i]));
+      k += len[i];
+   }
+
+   for (auto useIoUring : {1, 0}) {
+      gEnv->SetValue("TFile.IoUring", useIoUring);
+      std::vector<char> buf(nbytes);
+      EXPECT_FALSE(f.ReadBuffers(buf.data(), pos.data(), len.data(), pos.size()));
+      EXPECT_EQ(buf, expected);
+   }
+   gEnv->SetValue("TFile.IoUring", 1);
+
+   f.Close();
+   gSystem->Unlink(filename);
+}
+
+TEST(TFile, ReadMmap)
+{
+   auto filename{"tfile_readmmap.root"};
+   {
+      TFile f{filename, "RECREATE"};
+      for (int i = 0; i < 10; ++i) {
+         std::vector<int> vec(i * 1000, i);
+         f.WriteObject(&vec, ("vec" + std::to_string(i)).c_str());
+      }
+   }
+
+   TFile f{filename, "READ_MMAP"};
+   ASSERT_FALSE(f.IsZombie());
+#ifndef _WIN32
+   EXPECT_TRUE(f.IsMapped());
+#endif
+   EXPECT_FALSE(f.IsWritable());
+   EXPECT_EQ(f.GetMappedBuffer(f.GetSize(), 1), nullptr);
+   for (int i = 0; i < 10; ++i) {
+      auto vec = f.Get<std::vector<int>>(("vec" + std::to_string(i)).c_str());
+      ASSERT_NE(vec, nullptr);
+      EXPECT_EQ(*vec, std::vector<int>(i * 1000, i));
+      delete vec;
+   }
+
+   f.Close();
+   EXPECT_FALSE(f.IsMapped());
+   gSystem->Unlink(filename);
+}
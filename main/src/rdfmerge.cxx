@@ -0,0 +1,83 @@
+/**
+  \file rdfmerge.cxx
+  \brief This program merges the partial results of RDataFrame computations stored in a list of ROOT files, and writes
+  them to a target ROOT file.
+
+  Syntax:
+  ```{.cpp}
+       rdfmerge targetfile source1 source2 ...
+  ```
+  or
+  ```{.cpp}
+       rdfmerge -f targetfile source1 source2 ...
+  ```
+  (the second form overwrites targetfile if it exists: without `-f`, rdfmerge refuses to overwrite an existing file)
+
+  \param -f   Force overwriting of output file.
+  \return rdfmerge returns a status code: 0 if OK, 1 otherwise
+
+  The source files contain ROOT::Detail::RDF::RMergeableValue objects, e.g. written by batch jobs that processed
+  different chunks of the same dataset:
+  ```{.cpp}
+  auto h = df.Histo1D("x");
+  TFile f("partial_0.root", "RECREATE");
+  ROOT::Detail::RDF::WriteMergeableValue(*ROOT::Detail::RDF::GetMergeableValue(h), f, "h");
+  ```
+  Mergeables stored with the same name in the top-level directories of the source files are merged together, in the
+  order of the source files, and the result is written with that name to the target file. Other objects are ignored.
+  Partial results of any RDataFrame action that supports ROOT::Detail::RDF::GetMergeableValue can be merged, including
+  the ones that `hadd` cannot combine, such as means, standard deviations, minima, maxima or cut-flow reports.
+  The merged results are read back with ROOT::Detail::RDF::ReadMergeableValue.
+*/
+#include "ROOT/RDF/RMergeableValue.hxx"
+#include "TSystem.h"
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char **argv)
+{
+   const char *usage = "Usage: rdfmerge [-f] targetfile source1 [source2 source3 ...]\n"
+                       "Merge the RDataFrame partial results (RMergeableValue objects) stored in the source files.\n"
+                       "The target file must not exist, unless -f is given.\n"
+                       "  -f  Force overwriting of the target file.\n";
+   if (argc < 3 || std::strcmp(argv[1], "-h") == 0 || std::strcmp(argv[1], "--help") == 0) {
+      std::cerr << usage;
+      return 1;
+   }
+
+   bool force = false;
+   int a = 1;
+   if (std::strcmp(argv[a], "-f") == 0) {
+      force = true;
+      ++a;
+   }
+   if (argc - a < 2) {
+      std::cerr << usage;
+      return 1;
+   }
+
+   const std::string targetName = argv[a++];
+   std::vector<std::string> sourceNames(argv + a, argv + argc);
+   for (const auto &sourceName : sourceNames) {
+      if (sourceName == targetName) {
+         std::cerr << "rdfmerge: the target file " << targetName << " cannot be one of the source files.\n";
+         return 1;
+      }
+   }
+   if (!force && !gSystem->AccessPathName(targetName.c_str())) {
+      std::cerr << "rdfmerge: the target file " << targetName << " already exists, use -f to overwrite it.\n";
+      return 1;
+   }
+
+   try {
+      ROOT::Detail::RDF::MergeMergeableFiles(targetName, sourceNames);
+   } catch (const std::exception &e) {
+      std::cerr << "rdfmerge: " << e.what() << '\n';
+      return 1;
+   }
+   return 0;
+}
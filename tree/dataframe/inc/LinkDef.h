@@ -57,8 +57,66 @@
 #pragma link C++ class ROOT::Detail::RDF::RMergeableValue<TStatistic>+;
 #pragma link C++ class ROOT::Detail::RDF::RMergeableValue<TProfile>+;
 #pragma link C++ class ROOT::Detail::RDF::RMergeableValue<TProfile2D>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<double>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableCount+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMean+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableStdDev+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableCountDistinct+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableQuantiles+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableAdaptiveHisto+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableFill<TH1D>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableFill<TH2D>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableFill<TH3D>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableFill<TGraph>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableFill<TStatistic>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableFill<TProfile>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableFill<TProfile2D>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMin<int>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMin<unsigned int>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMin<float>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMin<double>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMin<Long64_t>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMin<ULong64_t>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMax<int>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMax<unsigned int>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMax<float>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMax<double>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMax<Long64_t>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableMax<ULong64_t>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableSum<int>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableSum<unsigned int>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableSum<float>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableSum<double>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableSum<Long64_t>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableSum<ULong64_t>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<bool>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<unsigned int>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<unsigned long>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<ULong64_t>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<int>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<long>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<Long64_t>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<std::vector<float>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<bool>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<unsigned int>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<unsigned long>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<ULong64_t>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<int>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<long>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<Long64_t>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<float>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableTake<std::vector<double>>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableValue<ROOT::RDF::RCutFlowReport>+;
+#pragma link C++ class ROOT::Detail::RDF::RMergeableReport+;
+#pragma link C++ class ROOT::Detail::RDF::RHyperLogLog+;
+#pragma link C++ class ROOT::Detail::RDF::RTDigest+;
+#pragma link C++ enum ROOT::RDF::EAdaptiveBinning;
 #pragma link C++ class TNotifyLink<ROOT::Internal::RDF::RNewSampleFlag>;
-#pragma link C++ class ROOT::RDF::RCutFlowReport;
+#pragma link C++ class ROOT::RDF::RCutFlowReport+;
+#pragma link C++ class ROOT::RDF::TCutInfo+;
+#pragma link C++ class ROOT::RDF::RProfileReport;
+#pragma link C++ class ROOT::RDF::RNodeProfileInfo;
+#pragma link C++ class ROOT::RDF::RNodeSlotStats;
 
 #endif
 
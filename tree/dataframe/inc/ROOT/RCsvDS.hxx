@@ -33,6 +33,16 @@ namespace RDF {
 
 class RCsvDS final : public ROOT::RDF::RDataSource {
 
+public:
+   /// Options that control how the CSV file is read, see RCsvDS(std::string_view, const ROptions &).
+   struct ROptions {
+      bool fHeaders = true;                 ///< The first row of the file contains the column names
+      char fDelimiter = ',';                ///< Delimiter character
+      Long64_t fLinesChunkSize = -1LL;      ///< Number of lines read into memory at once, -1 for all (not memory-mapped)
+      bool fMemoryMap = false;              ///< Memory-map the file and parse the entries lazily during the event loop
+      Long64_t fNTypeInferenceLines = 1000; ///< Number of lines used to infer the column types when memory-mapped
+   };
+
 private:
    // Possible values are d, b, l, s. This is possible only because we treat double, bool, Long64_t and string
    using ColType_t = char;
@@ -44,9 +54,17 @@ private:
    std::uint64_t fDataPos = 0;
    bool fReadHeaders = false;
    unsigned int fNSlots = 0U;
+   const std::string fFileName;
    std::unique_ptr<ROOT::Internal::RRawFile> fCsvFile;
    const char fDelimiter;
    const Long64_t fLinesChunkSize;
+   const Long64_t fNTypeInferenceLines;
+   bool fMemoryMapped = false;
+   void *fMapping = nullptr; // the whole file, if memory-mapped
+   std::uint64_t fMappingSize = 0;
+   bool fLinesIndexed = false;
+   std::vector<std::uint64_t> fLineOffsets; // fLineOffsets[entry], offset of the non-empty lines in the mapped file
+   std::vector<std::string> fSlotValues;    // one per slot, the value being parsed in memory-mapped mode
    ULong64_t fEntryRangesRequested = 0ULL;
    ULong64_t fProcessedLines = 0ULL; // marks the progress of the consumption of the csv lines
    std::vector<std::string> fHeaders;
@@ -65,10 +83,13 @@ private:
    void FillRecord(const std::string &, Record_t &);
    void GenerateHeaders(size_t);
    std::vector<void *> GetColumnReadersImpl(std::string_view, const std::type_info &);
-   void InferColTypes(std::vector<std::string> &);
-   void InferType(const std::string &, unsigned int);
+   void IndexLines();
+   void InferColTypes(const std::vector<std::vector<std::string>> &);
+   ColType_t InferType(const std::string &) const;
+   void MapFile(std::string_view);
    std::vector<std::string> ParseColumns(const std::string &);
    size_t ParseValue(const std::string &, std::vector<std::string> &, size_t);
+   const char *ParseValue(const char *, const char *, std::string &) const;
    ColType_t GetType(std::string_view colName) const;
 
 protected:
@@ -76,6 +97,8 @@ protected:
 
 public:
    RCsvDS(std::string_view fileName, bool readHeaders = true, char delimiter = ',', Long64_t linesChunkSize = -1LL);
+   RCsvDS(std::string_view fileName, const ROptions &options);
+   void Initialise();
    void Finalise();
    void FreeRecords();
    ~RCsvDS();
@@ -86,6 +109,7 @@ public:
    bool SetEntry(unsigned int slot, ULong64_t entry);
    void SetNSlots(unsigned int nSlots);
    std::string GetLabel();
+   std::string GetDatasetIdentifier();
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +121,12 @@ public:
 RDataFrame MakeCsvDataFrame(std::string_view fileName, bool readHeaders = true, char delimiter = ',',
                             Long64_t linesChunkSize = -1LL);
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a CSV RDataFrame.
+/// \param[in] fileName Path of the CSV file.
+/// \param[in] options Options that control how the file is read, e.g. whether it is memory-mapped.
+RDataFrame MakeCsvDataFrame(std::string_view fileName, const RCsvDS::ROptions &options);
+
 } // ns RDF
 
 } // ns ROOT
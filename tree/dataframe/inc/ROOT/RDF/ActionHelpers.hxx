@@ -25,6 +25,7 @@
 #include "ROOT/TBufferMerger.hxx" // for SnapshotHelper
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
+#include "ROOT/RDF/RSketches.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RSnapshotOptions.hxx"
 #include "ROOT/TypeTraits.hxx"
@@ -43,11 +44,18 @@
 #include "TTree.h"
 #include "TTreeReader.h" // for SnapshotHelper
 #include "ROOT/RDF/RMergeableValue.hxx"
+#include "RConfigure.h" // R__HAS_ROOT7
+
+#ifdef R__HAS_ROOT7
+#include "ROOT/RNTuple.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#endif
 
 #include <algorithm>
 #include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -87,6 +95,15 @@ public:
       throw std::logic_error("This action does not support callbacks!");
    }
 
+   // call Helper::IsDone if present: helpers without it produce their final result only at the end of the event loop
+   template <typename H = Helper>
+   auto CallIsDone(int) -> decltype(std::declval<H>().IsDone())
+   {
+      return static_cast<Helper *>(this)->IsDone();
+   }
+
+   bool CallIsDone(...) { return false; }
+
    // Helper functions for RMergeableValue
    virtual std::unique_ptr<RMergeableValueBase> GetMergeableValue() const
    {
@@ -98,6 +115,24 @@ public:
       return {};
    }
    virtual ROOT::RDF::SampleCallback_t GetSampleCallback() { return {}; }
+
+   /// Whether the action can run in bulk mode. In that case Exec receives references to values that live in a
+   /// different memory location for each entry: helpers that keep the addresses of their inputs (e.g. as TTree
+   /// branch addresses) must return false.
+   virtual bool SupportsBulk() const { return true; }
+
+   /// Whether the action writes outputs that must be combined after a multi-process event loop, see
+   /// ROOT::RDF::EnableMultiProcessing. Such helpers write the outputs of worker processes to partial outputs (see
+   /// ROOT::Internal::RDF::GetWorkerIndex) and combine them in MergePartialOutputs.
+   virtual bool HasPartialOutputs() const { return false; }
+   virtual void MergePartialOutputs(unsigned int /*nWorkers*/) {}
+
+   /// Whether the tasks of a multi-thread event loop must process contiguous ranges of entries, e.g. to write outputs
+   /// in entry order. In that case, the entry ranges of the tasks reported to the sample callback tile the entries
+   /// starting at the one passed to SetFirstEntry, which is called before the event loop. Data sources do not provide
+   /// such ranges: SetFirstEntry is not called then.
+   virtual bool NeedsContiguousTasks() const { return false; }
+   virtual void SetFirstEntry(ULong64_t /*firstEntry*/) {}
 };
 
 } // namespace RDF
@@ -232,6 +267,12 @@ public:
          fProxiedWPtr.lock()->Report(*fReport);
    }
 
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableReport>(*fReport);
+   }
+
    std::string GetActionName() { return "Report"; }
 };
 
@@ -679,6 +720,12 @@ public:
 
    COLL &PartialUpdate(unsigned int slot) { return *fColls[slot].get(); }
 
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableTake<COLL>>(*fColls[0]);
+   }
+
    std::string GetActionName() { return "Take"; }
 };
 
@@ -724,6 +771,12 @@ public:
 
    std::vector<T> &PartialUpdate(unsigned int slot) { return *fColls[slot]; }
 
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableTake<std::vector<T>>>(*fColls[0]);
+   }
+
    std::string GetActionName() { return "Take"; }
 };
 
@@ -761,6 +814,12 @@ public:
       }
    }
 
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableTake<COLL>>(*fColls[0]);
+   }
+
    std::string GetActionName() { return "Take"; }
 };
 
@@ -806,6 +865,12 @@ public:
       }
    }
 
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableTake<std::vector<std::vector<RealT_t>>>>(*fColls[0]);
+   }
+
    std::string GetActionName() { return "Take"; }
 };
 
@@ -1085,6 +1150,118 @@ extern template void StdDevHelper::Exec(unsigned int, const std::vector<char> &)
 extern template void StdDevHelper::Exec(unsigned int, const std::vector<int> &);
 extern template void StdDevHelper::Exec(unsigned int, const std::vector<unsigned int> &);
 
+class CountDistinctHelper : public RActionImpl<CountDistinctHelper> {
+   const std::shared_ptr<ULong64_t> fResultCount;
+   std::vector<RHyperLogLog> fSketches;
+
+public:
+   CountDistinctHelper(const std::shared_ptr<ULong64_t> &countPtr, unsigned int precision, const unsigned int nSlots);
+   CountDistinctHelper(CountDistinctHelper &&) = default;
+   CountDistinctHelper(const CountDistinctHelper &) = delete;
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   /// Values of multiple columns are counted as one tuple.
+   template <typename... ColTypes>
+   void Exec(unsigned int slot, const ColTypes &... values)
+   {
+      fSketches[slot].Add(HashValues(values...));
+   }
+
+   void Initialize() { /* noop */}
+
+   /// Merge the per-slot sketches into the first one and estimate the number of distinct values.
+   void Finalize();
+
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableCountDistinct>(*fResultCount, fSketches[0]);
+   }
+
+   std::string GetActionName() { return "CountDistinct"; }
+};
+
+class QuantilesHelper : public RActionImpl<QuantilesHelper> {
+   const std::shared_ptr<std::vector<double>> fResultQuantiles;
+   const std::vector<double> fProbabilities;
+   std::vector<RTDigest> fDigests;
+
+public:
+   QuantilesHelper(const std::shared_ptr<std::vector<double>> &quantilesPtr, const std::vector<double> &probabilities,
+                   double compression, const unsigned int nSlots);
+   QuantilesHelper(QuantilesHelper &&) = default;
+   QuantilesHelper(const QuantilesHelper &) = delete;
+   void InitTask(TTreeReader *, unsigned int) {}
+   void Exec(unsigned int slot, double v);
+
+   template <typename T, std::enable_if_t<IsDataContainer<T>::value, int> = 0>
+   void Exec(unsigned int slot, const T &vs)
+   {
+      for (auto &&v : vs)
+         fDigests[slot].Add(v);
+   }
+
+   void Initialize() { /* noop */}
+
+   /// Merge the per-slot digests into the first one and estimate the quantiles.
+   void Finalize();
+
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableQuantiles>(*fResultQuantiles, fDigests[0], fProbabilities);
+   }
+
+   std::string GetActionName() { return "Quantiles"; }
+};
+
+extern template void QuantilesHelper::Exec(unsigned int, const std::vector<float> &);
+extern template void QuantilesHelper::Exec(unsigned int, const std::vector<double> &);
+extern template void QuantilesHelper::Exec(unsigned int, const std::vector<char> &);
+extern template void QuantilesHelper::Exec(unsigned int, const std::vector<int> &);
+extern template void QuantilesHelper::Exec(unsigned int, const std::vector<unsigned int> &);
+
+class AdaptiveHistoHelper : public RActionImpl<AdaptiveHistoHelper> {
+   const std::shared_ptr<::TH1D> fResultHist;
+   const ROOT::RDF::EAdaptiveBinning fBinning;
+   const int fNBins;
+   std::vector<RTDigest> fDigests;
+
+public:
+   AdaptiveHistoHelper(const std::shared_ptr<::TH1D> &h, ROOT::RDF::EAdaptiveBinning binning, int nBins,
+                       double compression, const unsigned int nSlots);
+   AdaptiveHistoHelper(AdaptiveHistoHelper &&) = default;
+   AdaptiveHistoHelper(const AdaptiveHistoHelper &) = delete;
+   void InitTask(TTreeReader *, unsigned int) {}
+   void Exec(unsigned int slot, double v);
+
+   template <typename T, std::enable_if_t<IsDataContainer<T>::value, int> = 0>
+   void Exec(unsigned int slot, const T &vs)
+   {
+      for (auto &&v : vs)
+         fDigests[slot].Add(v);
+   }
+
+   void Initialize() { /* noop */}
+
+   /// Merge the per-slot digests into the first one, then choose the bins of the histogram and fill them.
+   void Finalize();
+
+   // Helper functions for RMergeableValue
+   std::unique_ptr<RMergeableValueBase> GetMergeableValue() const final
+   {
+      return std::make_unique<RMergeableAdaptiveHisto>(*fResultHist, fDigests[0], fBinning, fNBins);
+   }
+
+   std::string GetActionName() { return "AdaptiveHisto1D"; }
+};
+
+extern template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<float> &);
+extern template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<double> &);
+extern template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<char> &);
+extern template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<int> &);
+extern template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<unsigned int> &);
+
 template <typename PrevNodeType>
 class DisplayHelper : public RActionImpl<DisplayHelper<PrevNodeType>> {
 private:
@@ -1114,6 +1291,8 @@ public:
 
    void Finalize() {}
 
+   bool IsDone() const { return !fDisplayerHelper->HasNext(); }
+
    std::string GetActionName() { return "Display"; }
 };
 
@@ -1254,6 +1433,18 @@ void SetBranchesHelper(TTree *inputTree, TTree &outputTree, const std::string &i
 
 void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &treeName, const std::string &fileName);
 
+#ifdef R__HAS_ROOT7
+/// Open the output file of a Snapshot to RNTuple and create the writer of the output RNTuple, following the options.
+std::unique_ptr<ROOT::Experimental::RNTupleWriter>
+MakeSnapshotRNTupleWriter(std::unique_ptr<ROOT::Experimental::RNTupleModel> model, const std::string &fileName,
+                          const std::string &ntupleName, const RSnapshotOptions &opts,
+                          std::unique_ptr<TFile> &outputFile);
+#endif
+
+/// Combine the partial output files written by the worker processes of a multi-process Snapshot into its output file.
+void MergeSnapshotOutputs(const std::string &fileName, const std::string &dirName, const std::string &treeName,
+                          const RSnapshotOptions &opts, unsigned int nWorkers);
+
 /// Helper object for a single-thread Snapshot action
 template <typename... ColTypes>
 class SnapshotHelper : public RActionImpl<SnapshotHelper<ColTypes...>> {
@@ -1335,15 +1526,20 @@ public:
 
    void Initialize()
    {
+      // the worker processes of a multi-process event loop write their entries to partial output files, see
+      // MergePartialOutputs
+      const auto workerIndex = GetWorkerIndex();
+      const auto fileName = workerIndex < 0 ? fFileName : GetPartialOutputName(fFileName, workerIndex);
+      const auto mode = workerIndex < 0 ? fOptions.fMode : std::string("RECREATE");
       fOutputFile.reset(
-         TFile::Open(fFileName.c_str(), fOptions.fMode.c_str(), /*ftitle=*/"",
+         TFile::Open(fileName.c_str(), mode.c_str(), /*ftitle=*/"",
                      ROOT::CompressionSettings(fOptions.fCompressionAlgorithm, fOptions.fCompressionLevel)));
       if(!fOutputFile)
-         throw std::runtime_error("Snapshot: could not create output file " + fFileName);
+         throw std::runtime_error("Snapshot: could not create output file " + fileName);
 
       TDirectory *outputDir = fOutputFile.get();
       if (!fDirName.empty()) {
-         TString checkupdate = fOptions.fMode;
+         TString checkupdate = mode;
          checkupdate.ToLower();
          if (checkupdate == "update")
             outputDir = fOutputFile->mkdir(fDirName.c_str(), "", true);  // do not overwrite existing directory
@@ -1376,6 +1572,16 @@ public:
    {
       return [this](unsigned int, const RSampleInfo &) mutable { fBranchAddressesNeedReset = true; };
    }
+
+   // output branches point to the input values, whose addresses change from entry to entry in bulk mode
+   bool SupportsBulk() const final { return false; }
+
+   bool HasPartialOutputs() const final { return true; }
+
+   void MergePartialOutputs(unsigned int nWorkers) final
+   {
+      MergeSnapshotOutputs(fFileName, fDirName, fTreeName, fOptions, nWorkers);
+   }
 };
 
 /// Helper object for a multi-thread Snapshot action
@@ -1398,6 +1604,17 @@ class SnapshotHelperMT : public RActionImpl<SnapshotHelperMT<ColTypes...>> {
    // Addresses associated to output branches per slot, non-null only for the ones holding C arrays
    std::vector<std::vector<void *>> fBranchAddresses;
    std::vector<RBranchSet> fOutputBranches;
+   // Whether the output is written in entry order, i.e. with asynchronous writing and contiguous task ranges
+   bool fOrderedOutput = false;
+
+   /// Write the entries processed from now on in this slot in the order of the entry range of the current task.
+   void SetWriteRange(unsigned int slot, const RSampleInfo &info)
+   {
+      // the entries of the previous data block of this task, if any, are written with the previous range
+      if (fOutputTrees[slot] && fOutputTrees[slot]->GetEntries() > 0)
+         fOutputFiles[slot]->Write();
+      fOutputFiles[slot]->SetWriteRange(info.EntryRange().first, info.EntryRange().second);
+   }
 
 public:
    using ColumnTypes_t = TypeList<ColTypes...>;
@@ -1431,7 +1648,8 @@ public:
       // TODO we could instead create the output tree and its branches, change addresses of input variables in each task
       fOutputTrees[slot] =
          std::make_unique<TTree>(fTreeName.c_str(), fTreeName.c_str(), fOptions.fSplitLevel, /*dir=*/treeDirectory);
-      fOutputTrees[slot]->SetBit(TTree::kEntriesReshuffled);
+      if (!fOrderedOutput)
+         fOutputTrees[slot]->SetBit(TTree::kEntriesReshuffled);
       // TODO can be removed when RDF supports interleaved TBB task execution properly, see ROOT-10269
       fOutputTrees[slot]->SetImplicitMT(false);
       if (fOptions.fAutoFlush)
@@ -1447,6 +1665,8 @@ public:
    {
       if (fOutputTrees[slot]->GetEntries() > 0)
          fOutputFiles[slot]->Write();
+      // the data of other tasks does not need to wait for this one anymore
+      fOutputFiles[slot]->ResetWriteRange();
       // clear now to avoid concurrent destruction of output trees and input tree (which has them listed as fClones)
       fOutputTrees[slot].reset(nullptr);
       fOutputBranches[slot].Clear();
@@ -1505,6 +1725,10 @@ public:
       if(!out_file)
          throw std::runtime_error("Snapshot: could not create output file " + fFileName);
       fMerger = std::make_unique<ROOT::TBufferMerger>(std::unique_ptr<TFile>(out_file));
+      // the workers only fill and compress the baskets, a dedicated thread merges and writes them
+      if (fOptions.fAsyncWriting)
+         fMerger->SetAsyncWriting();
+      fOrderedOutput = false;
    }
 
    void Finalize()
@@ -1534,9 +1758,151 @@ public:
 
    ROOT::RDF::SampleCallback_t GetSampleCallback() final
    {
-      return [this](unsigned int slot, const RSampleInfo &) mutable { fBranchAddressesNeedReset[slot] = 1; };
+      return [this](unsigned int slot, const RSampleInfo &info) mutable {
+         fBranchAddressesNeedReset[slot] = 1;
+         if (fOrderedOutput)
+            SetWriteRange(slot, info);
+      };
+   }
+
+   // with asynchronous writing, the tasks write their entries in the order of their entry ranges
+   bool NeedsContiguousTasks() const final { return fOptions.fAsyncWriting; }
+
+   void SetFirstEntry(ULong64_t firstEntry) final
+   {
+      fMerger->SetFirstWriteEntry(firstEntry);
+      fOrderedOutput = true;
    }
+
+   // output branches point to the input values, whose addresses change from entry to entry in bulk mode
+   bool SupportsBulk() const final { return false; }
+};
+
+#ifdef R__HAS_ROOT7
+/// Helper object for a Snapshot action that writes an RNTuple, in single- and multi-thread event loops.
+/// Each processing slot copies its entries to its own buffer, and the buffer is written to the output as a separate
+/// cluster when it is full. RNTupleWriter can only be filled by one thread at a time, so the serialization of the
+/// entries of a cluster and the commit of the cluster are done under a lock: the slots run the upstream computation
+/// graph and buffer entries concurrently, but they write their clusters one after the other. When implicit
+/// multi-threading is enabled, the pages of each cluster are compressed in parallel during the commit.
+template <typename... ColTypes>
+class SnapshotRNTupleHelper : public RActionImpl<SnapshotRNTupleHelper<ColTypes...>> {
+   using Entry_t = std::tuple<ColTypes...>;
+
+   const std::string fFileName;
+   const std::string fNTupleName;
+   const RSnapshotOptions fOptions;
+   const ColumnNames_t fOutputFieldNames;
+   /// Number of entries per cluster
+   const std::size_t fClusterSize;
+   /// Called once the output is written, e.g. to open the dataset returned by Snapshot
+   std::function<void()> fOnWritten;
+   std::unique_ptr<TFile> fOutputFile;
+   std::unique_ptr<ROOT::Experimental::RNTupleWriter> fWriter;
+   /// The values of the default entry of the writer, which the buffered entries are moved into when they are written
+   std::tuple<std::shared_ptr<ColTypes>...> fWriterValues;
+   std::unique_ptr<std::mutex> fWriterMutex{new std::mutex}; // a ptr so that the helper is movable
+   std::vector<std::vector<Entry_t>> fBuffers;              // per slot
+
+   template <std::size_t... S>
+   std::unique_ptr<ROOT::Experimental::RNTupleModel> MakeModel(std::index_sequence<S...>)
+   {
+      auto model = ROOT::Experimental::RNTupleModel::Create();
+      // braced initialization creates the fields in the order of the columns
+      fWriterValues =
+         std::tuple<std::shared_ptr<ColTypes>...>{model->template MakeField<ColTypes>(fOutputFieldNames[S])...};
+      return model;
+   }
+
+   template <std::size_t... S>
+   void MoveToWriter(Entry_t &entry, std::index_sequence<S...>)
+   {
+      int expander[] = {(*std::get<S>(fWriterValues) = std::move(std::get<S>(entry)), 0)..., 0};
+      (void)expander; // avoid unused variable warnings for older compilers such as gcc 4.9
+   }
+
+   /// Write the entries buffered by this slot as one cluster. Only one slot at a time can write a cluster.
+   void WriteCluster(unsigned int slot)
+   {
+      auto &buffer = fBuffers[slot];
+      if (buffer.empty())
+         return;
+      {
+         // the whole cluster is filled and committed under the lock, so that it only contains entries of this slot
+         std::lock_guard<std::mutex> lock(*fWriterMutex);
+         for (auto &entry : buffer) {
+            MoveToWriter(entry, std::index_sequence_for<ColTypes...>{});
+            fWriter->Fill();
+         }
+         fWriter->CommitCluster();
+      }
+      buffer.clear();
+   }
+
+public:
+   using ColumnTypes_t = TypeList<ColTypes...>;
+   SnapshotRNTupleHelper(unsigned int nSlots, std::string_view filename, std::string_view dirname,
+                         std::string_view ntuplename, const ColumnNames_t &bnames, const RSnapshotOptions &options,
+                         std::function<void()> onWritten)
+      : fFileName(filename), fNTupleName(ntuplename), fOptions(options),
+        fOutputFieldNames(ReplaceDotWithUnderscore(bnames)),
+        fClusterSize(options.fAutoFlush > 0 ? options.fAutoFlush : 100000), fOnWritten(std::move(onWritten)),
+        fBuffers(nSlots)
+   {
+      if (!dirname.empty())
+         throw std::runtime_error("Snapshot: RNTuple output cannot be written to a directory of the output file.");
+      ValidateSnapshotOutput(fOptions, fNTupleName, fFileName);
+   }
+   SnapshotRNTupleHelper(const SnapshotRNTupleHelper &) = delete;
+   SnapshotRNTupleHelper(SnapshotRNTupleHelper &&) = default;
+
+   void InitTask(TTreeReader *, unsigned int) {}
+
+   void Exec(unsigned int slot, ColTypes &... values)
+   {
+      auto &buffer = fBuffers[slot];
+      if (buffer.capacity() == 0u)
+         buffer.reserve(fClusterSize);
+      buffer.emplace_back(values...);
+      if (buffer.size() >= fClusterSize)
+         WriteCluster(slot);
+   }
+
+   void Initialize()
+   {
+      if (GetWorkerIndex() >= 0)
+         throw std::runtime_error("Snapshot: RNTuple output is not supported in multi-process event loops.");
+      fWriter = MakeSnapshotRNTupleWriter(MakeModel(std::index_sequence_for<ColTypes...>{}), fFileName, fNTupleName,
+                                          fOptions, fOutputFile);
+   }
+
+   void Finalize()
+   {
+      // the entries left in the buffers of the slots are also written in clusters of fClusterSize entries (rather than
+      // in one small cluster per slot): only the last cluster can be smaller
+      std::size_t nFilled = 0u;
+      for (auto &buffer : fBuffers) {
+         for (auto &entry : buffer) {
+            MoveToWriter(entry, std::index_sequence_for<ColTypes...>{});
+            fWriter->Fill();
+            if (++nFilled == fClusterSize) {
+               fWriter->CommitCluster();
+               nFilled = 0u;
+            }
+         }
+         buffer.clear();
+      }
+      // the RNTuple is complete on disk once the writer is destroyed
+      fWriter.reset();
+      fOutputFile->Close();
+      fOutputFile.reset();
+      if (fOnWritten)
+         fOnWritten();
+   }
+
+   std::string GetActionName() { return "Snapshot"; }
 };
+#endif // R__HAS_ROOT7
 
 template <typename Acc, typename Merge, typename R, typename T, typename U,
           bool MustCopyAssign = std::is_same<R, U>::value>
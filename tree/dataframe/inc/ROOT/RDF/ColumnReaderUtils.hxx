@@ -11,23 +11,29 @@
 #ifndef ROOT_RDF_COLUMNREADERUTILS
 #define ROOT_RDF_COLUMNREADERUTILS
 
+#include "RBulkColumnReader.hxx"
 #include "RColumnReaderBase.hxx"
 #include "RBookedDefines.hxx"
 #include "RDefineBase.hxx"
 #include "RDefineReader.hxx"
 #include "RDSColumnReader.hxx"
+#include "RLoopManager.hxx"
 #include "RTreeColumnReader.hxx"
 
 #include <ROOT/RDataSource.hxx>
 #include <ROOT/TypeTraits.hxx>
+#include <TDataType.h>
 #include <TTreeReader.h>
 
+#include <algorithm> // std::all_of
 #include <array>
 #include <cassert>
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <typeinfo> // for typeid
+#include <utility> // std::index_sequence
 #include <vector>
 
 namespace ROOT {
@@ -37,35 +43,82 @@ namespace RDF {
 using namespace ROOT::TypeTraits;
 namespace RDFDetail = ROOT::Detail::RDF;
 
+/// Columns of these types can be buffered by RBulkColumnReader, see RLoopManager::GetBulkSize.
+template <typename T>
+using IsBulkReadable = std::integral_constant<bool, std::is_arithmetic<T>::value>;
+
+/// Return a RTreeBlockReader for the given TTree branch, which RBulkColumnReader uses to read its values a basket at a
+/// time, or nullptr if the column is not a TTree branch.
+template <typename T>
+std::unique_ptr<RTreeBlockReader> MakeTreeBlockReader(TTreeReader *r, const std::string &colName, std::true_type)
+{
+   if (r == nullptr)
+      return nullptr;
+   return std::make_unique<RTreeBlockReader>(*r, colName, TDataType::GetType(typeid(T)), sizeof(T));
+}
+
+template <typename T>
+std::unique_ptr<RTreeBlockReader> MakeTreeBlockReader(TTreeReader *, const std::string &, std::false_type)
+{
+   return nullptr;
+}
+
+/// Wrap a column reader in a RBulkColumnReader and register the latter with the RLoopManager, which fills it.
+template <typename T>
+std::unique_ptr<RDFDetail::RColumnReaderBase>
+MakeBulkColumnReader(unsigned int slot, RLoopManager &lm, std::unique_ptr<RDFDetail::RColumnReaderBase> reader,
+                     std::unique_ptr<RTreeBlockReader> blockReader, std::true_type /*isBulkReadable*/)
+{
+   auto bulkReader =
+      std::make_unique<RBulkColumnReader<T>>(std::move(reader), lm.GetBulkSize(), std::move(blockReader));
+   lm.RegisterBulkReader(slot, bulkReader.get());
+   return bulkReader;
+}
+
+template <typename T>
+std::unique_ptr<RDFDetail::RColumnReaderBase>
+MakeBulkColumnReader(unsigned int, RLoopManager &, std::unique_ptr<RDFDetail::RColumnReaderBase> reader,
+                     std::unique_ptr<RTreeBlockReader>, std::false_type /*isBulkReadable*/)
+{
+   // never actually used: RLoopManager does not run in bulk mode if some column cannot be read in bulk
+   return reader;
+}
+
 template <typename T>
 std::unique_ptr<RDFDetail::RColumnReaderBase>
-MakeColumnReader(unsigned int slot, RDefineBase *define,
-                 const std::map<std::string, std::vector<void *>> &DSValuePtrsMap, TTreeReader *r,
-                 ROOT::RDF::RDataSource *ds, const std::string &colName)
+MakeColumnReader(unsigned int slot, RDefineBase *define, RLoopManager &lm, TTreeReader *r, const std::string &colName)
 {
    using Ret_t = std::unique_ptr<RDFDetail::RColumnReaderBase>;
 
    // this check must come first!
    // so that Redefine'd columns have precedence over the original columns
-   if (define != nullptr)
+   if (define != nullptr) {
       return Ret_t{new RDefineReader(slot, *define, typeid(T))};
+   }
 
+   Ret_t reader;
+   std::unique_ptr<RTreeBlockReader> blockReader;
+   const auto &DSValuePtrsMap = lm.GetDSValuePtrs();
    const auto DSValuePtrsIt = DSValuePtrsMap.find(colName);
    if (DSValuePtrsIt != DSValuePtrsMap.end()) {
       // reading from a RDataSource with the old column reader interface
       const std::vector<void *> &DSValuePtrs = DSValuePtrsIt->second;
-      return Ret_t(new RDSColumnReader<T>(DSValuePtrs[slot]));
-   }
-
-   if (ds != nullptr) {
+      reader.reset(new RDSColumnReader<T>(DSValuePtrs[slot]));
+   } else if (auto *ds = lm.GetDataSource()) {
       // reading from a RDataSource with the new column reader interface
-      return ds->GetColumnReaders(slot, colName, typeid(T));
+      reader = ds->GetColumnReaders(slot, colName, typeid(T));
+   } else {
+      assert(r != nullptr && "We could not find a reader for this column, this should never happen at this point.");
+      // reading from a TTree
+      reader.reset(new RTreeColumnReader<T>(*r, colName));
+      if (lm.GetBulkSize() > 1u)
+         blockReader = MakeTreeBlockReader<T>(r, colName, IsBlockReadable<T>{});
    }
 
-   assert(r != nullptr && "We could not find a reader for this column, this should never happen at this point.");
+   if (lm.GetBulkSize() > 1u)
+      return MakeBulkColumnReader<T>(slot, lm, std::move(reader), std::move(blockReader), IsBulkReadable<T>{});
 
-   // reading from a TTree
-   return Ret_t{new RTreeColumnReader<T>(*r, colName)};
+   return reader;
 }
 
 /// This type aggregates some of the arguments passed to MakeColumnReaders.
@@ -76,8 +129,7 @@ struct RColumnReadersInfo {
    const std::vector<std::string> &fColNames;
    const RBookedDefines &fCustomCols;
    const bool *fIsDefine;
-   const std::map<std::string, std::vector<void *>> &fDSValuePtrsMap;
-   ROOT::RDF::RDataSource *fDataSource;
+   RLoopManager &fLoopManager;
 };
 
 /// Create a group of column readers, one per type in the parameter pack.
@@ -93,21 +145,53 @@ MakeColumnReaders(unsigned int slot, TTreeReader *r, TypeList<ColTypes...>, cons
    const auto &colNames = colInfo.fColNames;
    const auto &defines = colInfo.fCustomCols.GetColumns();
    const bool *isDefine = colInfo.fIsDefine;
-   const auto &DSValuePtrsMap = colInfo.fDSValuePtrsMap;
-   auto *ds = colInfo.fDataSource;
+   auto &lm = colInfo.fLoopManager;
 
    int i = -1;
    std::array<std::unique_ptr<RDFDetail::RColumnReaderBase>, sizeof...(ColTypes)> ret{
-      {{(++i, MakeColumnReader<ColTypes>(slot, isDefine[i] ? defines.at(colNames[i]).get() : nullptr, DSValuePtrsMap, r,
-                                         ds, colNames[i]))}...}};
+      {{(++i, MakeColumnReader<ColTypes>(slot, isDefine[i] ? defines.at(colNames[i]).get() : nullptr, lm, r,
+                                         colNames[i]))}...}};
    return ret;
 
    // avoid bogus "unused variable" warnings
-   (void)ds;
+   (void)lm;
    (void)slot;
    (void)r;
 }
 
+/// Return true if all columns can be read in bulk, i.e. if the event loop can run in bulk mode as far as the reading
+/// of these columns is concerned. Defined columns are queried recursively, other columns can be read in bulk if they
+/// are of a fundamental type.
+template <typename... ColTypes>
+bool CanReadInBulk(TypeList<ColTypes...>, const std::vector<std::string> &colNames, const bool *isDefine,
+                   const RBookedDefines &customCols)
+{
+   const auto &defines = customCols.GetColumns();
+   int i = -1;
+   std::array<bool, sizeof...(ColTypes)> canRead{
+      {(++i, isDefine[i] ? defines.at(colNames[i])->SupportsBulk() : IsBulkReadable<ColTypes>::value)...}};
+   return std::all_of(canRead.begin(), canRead.end(), [](bool b) { return b; });
+
+   // avoid bogus "unused variable" warnings
+   (void)isDefine;
+   (void)colNames;
+}
+
+/// Read the values of all columns for the given entry, discarding them. Column readers cache the values of the current
+/// entry (and Define readers the result of the Define), so reading them again is cheap: this is used in profiling mode
+/// to measure the time spent reading the columns separately from the time spent in user code.
+template <typename... ColTypes, std::size_t... S>
+void ReadColumnValues(std::array<std::unique_ptr<RDFDetail::RColumnReaderBase>, sizeof...(ColTypes)> &readers,
+                      Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>)
+{
+   // hack to expand a parameter pack without c++17 fold expressions.
+   using expander = int[];
+   (void)expander{((void)readers[S]->template Get<ColTypes>(entry), 0)..., 0};
+   // avoid bogus "unused variable" warnings
+   (void)readers;
+   (void)entry;
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
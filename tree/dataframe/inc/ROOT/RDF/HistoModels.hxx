@@ -153,6 +153,12 @@ struct TProfile2DModel {
    std::shared_ptr<::TProfile2D> GetProfile() const;
 };
 
+/// Strategies to choose the bin edges of the histograms returned by RInterface::AdaptiveHisto1D.
+enum class EAdaptiveBinning {
+   kEqualPopulation, ///< The bins contain (approximately) the same number of entries
+   kFreedmanDiaconis ///< Bins of equal width 2 * IQR / cbrt(entries), between the minimum and maximum value
+};
+
 } // ns RDF
 
 } // ns ROOT
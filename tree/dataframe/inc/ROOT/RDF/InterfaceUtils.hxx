@@ -100,6 +100,9 @@ struct Sum{};
 struct Mean{};
 struct Fill{};
 struct StdDev{};
+struct CountDistinct{};
+struct Quantiles{};
+struct AdaptiveHisto1D{};
 struct Display{};
 struct Snapshot{};
 struct Book{};
@@ -217,6 +220,61 @@ std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::sha
    return std::make_unique<Action_t>(Helper_t(stdDeviationV, nSlots), bl, prevNode, defines);
 }
 
+struct CountDistinctHelperArgs {
+   std::shared_ptr<ULong64_t> fResult;
+   unsigned int fPrecision;
+};
+
+// CountDistinct action
+template <typename... ColTypes, typename PrevNodeType>
+std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::shared_ptr<CountDistinctHelperArgs> &args,
+                                         const unsigned int nSlots, std::shared_ptr<PrevNodeType> prevNode,
+                                         ActionTags::CountDistinct, const RBookedDefines &defines)
+{
+   using Helper_t = CountDistinctHelper;
+   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColTypes...>>;
+   return std::make_unique<Action_t>(Helper_t(args->fResult, args->fPrecision, nSlots), bl, std::move(prevNode),
+                                     defines);
+}
+
+struct QuantilesHelperArgs {
+   std::shared_ptr<std::vector<double>> fResult;
+   std::vector<double> fProbabilities;
+   double fCompression;
+};
+
+// Quantiles action
+template <typename ColType, typename PrevNodeType>
+std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::shared_ptr<QuantilesHelperArgs> &args,
+                                         const unsigned int nSlots, std::shared_ptr<PrevNodeType> prevNode,
+                                         ActionTags::Quantiles, const RBookedDefines &defines)
+{
+   using Helper_t = QuantilesHelper;
+   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColType>>;
+   return std::make_unique<Action_t>(Helper_t(args->fResult, args->fProbabilities, args->fCompression, nSlots), bl,
+                                     std::move(prevNode), defines);
+}
+
+struct AdaptiveHistoHelperArgs {
+   std::shared_ptr<::TH1D> fResult;
+   ROOT::RDF::EAdaptiveBinning fBinning;
+   int fNBins;
+   double fCompression;
+};
+
+// AdaptiveHisto1D action
+template <typename ColType, typename PrevNodeType>
+std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::shared_ptr<AdaptiveHistoHelperArgs> &args,
+                                         const unsigned int nSlots, std::shared_ptr<PrevNodeType> prevNode,
+                                         ActionTags::AdaptiveHisto1D, const RBookedDefines &defines)
+{
+   using Helper_t = AdaptiveHistoHelper;
+   using Action_t = RAction<Helper_t, PrevNodeType, TTraits::TypeList<ColType>>;
+   return std::make_unique<Action_t>(
+      Helper_t(args->fResult, args->fBinning, args->fNBins, args->fCompression, nSlots), bl, std::move(prevNode),
+      defines);
+}
+
 // Display action
 template <typename... ColTypes, typename PrevNodeType>
 std::unique_ptr<RActionBase> BuildAction(const ColumnNames_t &bl, const std::shared_ptr<RDisplay> &d,
@@ -234,6 +292,7 @@ struct SnapshotHelperArgs {
    std::string fTreeName;
    std::vector<std::string> fOutputColNames;
    ROOT::RDF::RSnapshotOptions fOptions;
+   std::function<void()> fOnWritten; ///< Called once the output is written (RNTuple output only)
 };
 
 // Snapshot action
@@ -250,7 +309,18 @@ BuildAction(const ColumnNames_t &colNames, const std::shared_ptr<SnapshotHelperA
    const auto &options = snapHelperArgs->fOptions;
 
    std::unique_ptr<RActionBase> actionPtr;
-   if (!ROOT::IsImplicitMTEnabled()) {
+   if (options.fOutputFormat == ROOT::RDF::ESnapshotOutputFormat::kRNTuple) {
+#ifdef R__HAS_ROOT7
+      // single- and multi-thread snapshot to RNTuple
+      using Helper_t = SnapshotRNTupleHelper<ColTypes...>;
+      using Action_t = RAction<Helper_t, PrevNodeType>;
+      actionPtr.reset(new Action_t(
+         Helper_t(nSlots, filename, dirname, treename, outputColNames, options, snapHelperArgs->fOnWritten), colNames,
+         prevNode, defines));
+#else
+      throw std::runtime_error("Snapshot: RNTuple output requires ROOT built with root7.");
+#endif
+   } else if (!ROOT::IsImplicitMTEnabled()) {
       // single-thread snapshot
       using Helper_t = SnapshotHelper<ColTypes...>;
       using Action_t = RAction<Helper_t, PrevNodeType>;
@@ -302,10 +372,10 @@ void CheckForDefinition(const std::string &where, std::string_view definedColVie
 
 std::string PrettyPrintAddr(const void *const addr);
 
-void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter, std::shared_ptr<RNodeBase> *prevNodeOnHeap,
-                   std::string_view name, std::string_view expression,
-                   const std::map<std::string, std::string> &aliasMap, const ColumnNames_t &branches,
-                   const RBookedDefines &customCols, TTree *tree, RDataSource *ds);
+std::shared_ptr<RJittedFilter>
+BookFilterJit(std::shared_ptr<RNodeBase> *prevNodeOnHeap, std::string_view name, std::string_view expression,
+              const std::map<std::string, std::string> &aliasMap, const ColumnNames_t &branches,
+              const RBookedDefines &customCols, TTree *tree, RDataSource *ds);
 
 std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_view expression, RLoopManager &lm,
                                                    RDataSource *ds, const RBookedDefines &customCols,
@@ -432,20 +502,17 @@ struct RDefinePerSampleTag {};
 
 template <typename F>
 auto MakeDefineNode(DefineTypes::RDefineTag, std::string_view name, std::string_view dummyType, F &&f,
-                    const ColumnNames_t &cols, unsigned int nSlots, RBookedDefines &defines,
-                    const std::map<std::string, std::vector<void *>> &dsValuePtrs, RDataSource *ds)
+                    const ColumnNames_t &cols, RBookedDefines &defines, RLoopManager &lm)
 {
    return std::unique_ptr<RDefineBase>(new RDefine<std::decay_t<F>, CustomColExtraArgs::None>(
-      name, dummyType, std::forward<F>(f), cols, nSlots, defines, dsValuePtrs, ds));
+      name, dummyType, std::forward<F>(f), cols, defines, lm));
 }
 
 template <typename F>
 auto MakeDefineNode(DefineTypes::RDefinePerSampleTag, std::string_view name, std::string_view dummyType, F &&f,
-                    const ColumnNames_t &, unsigned int nSlots, RBookedDefines &,
-                    const std::map<std::string, std::vector<void *>> &, RDataSource *)
+                    const ColumnNames_t &, RBookedDefines &, RLoopManager &lm)
 {
-   return std::unique_ptr<RDefineBase>(
-      new RDefinePerSample<std::decay_t<F>>(name, dummyType, std::forward<F>(f), nSlots));
+   return std::unique_ptr<RDefineBase>(new RDefinePerSample<std::decay_t<F>>(name, dummyType, std::forward<F>(f), lm));
 }
 
 // Build a RDefine or a RDefinePerSample object and attach it to an existing RJittedDefine
@@ -483,8 +550,8 @@ void JitDefineHelper(F &&f, const char **colsPtr, std::size_t colsSize, std::str
    // to help devs debugging
    const auto dummyType = "jittedCol_t";
    // use unique_ptr<RDefineBase> instead of make_unique<NewCol_t> to reduce jit/compile-times
-   std::unique_ptr<RDefineBase> newCol{MakeDefineNode(RDefineTypeTag{}, name, dummyType, std::forward<F>(f), cols,
-                                                      lm->GetNSlots(), *defines, lm->GetDSValuePtrs(), ds)};
+   std::unique_ptr<RDefineBase> newCol{
+      MakeDefineNode(RDefineTypeTag{}, name, dummyType, std::forward<F>(f), cols, *defines, *lm)};
    jittedDefine->SetDefine(std::move(newCol));
 
    // defines points to the columns structure in the heap, created before the jitted call so that the jitter can
@@ -683,6 +750,14 @@ void CheckForDuplicateSnapshotColumns(const ColumnNames_t &cols);
 
 void TriggerRun(ROOT::RDF::RNode &node);
 
+ROOT::Detail::RDF::RLoopManager &GetLoopManager(ROOT::RDF::RNode &node);
+
+std::shared_ptr<ROOT::Detail::RDF::RLoopManager>
+GetOrMakePersistentCache(ROOT::Detail::RDF::RNodeBase *node, const RBookedDefines &defines,
+                         ROOT::Detail::RDF::RLoopManager &lm, const ColumnNames_t &columns,
+                         const std::vector<std::string> &columnTypes, std::string_view cacheDir, std::string_view key,
+                         const std::function<void(const std::string &, const std::string &)> &writeCache);
+
 } // namespace RDF
 } // namespace Internal
 
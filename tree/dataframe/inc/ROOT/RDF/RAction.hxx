@@ -15,6 +15,7 @@
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t, IsInternalColumn
 #include "ROOT/RDF/RLoopManager.hxx"
 
@@ -22,6 +23,7 @@
 #include <cstddef> // std::size_t
 #include <memory>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace ROOT {
@@ -84,17 +86,34 @@ public:
    */
    std::unique_ptr<RDFDetail::RMergeableValueBase> GetMergeableValue() const final
    {
+      // after a multi-process event loop the result is the merge of the partial results of the worker processes
+      if (auto merged = CloneMergedValue())
+         return merged;
       return fHelper.GetMergeableValue();
    }
 
-   void Initialize() final { fHelper.Initialize(); }
+   bool HasPartialOutputs() const final { return fHelper.HasPartialOutputs(); }
+
+   void MergePartialOutputs(unsigned int nWorkers) final { fHelper.MergePartialOutputs(nWorkers); }
+
+   bool NeedsContiguousTasks() const final { return fHelper.NeedsContiguousTasks(); }
+
+   void SetFirstEntry(ULong64_t firstEntry) final { fHelper.SetFirstEntry(firstEntry); }
+
+   void Initialize() final
+   {
+      fProfile = fLoopManager->GetNodeProfile(this, "Action", fHelper.GetActionName());
+      for (auto &column : GetDefines().GetColumns())
+         column.second->InitNode();
+      fHelper.Initialize();
+   }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : GetDefines().GetColumns())
          bookedBranch.second->InitSlot(r, slot);
       RDFInternal::RColumnReadersInfo info{RActionBase::GetColumnNames(), RActionBase::GetDefines(), fIsDefine.data(),
-                                           fLoopManager->GetDSValuePtrs(), fLoopManager->GetDataSource()};
+                                           *fLoopManager};
       fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
       fHelper.InitTask(r, slot);
    }
@@ -108,9 +127,58 @@ public:
 
    void Run(unsigned int slot, Long64_t entry) final
    {
+      // once its result is final, the action does not need to process further entries
+      if (fHelper.CallIsDone(0)) {
+         SetDone();
+         return;
+      }
       // check if entry passes all filters
-      if (fPrevData.CheckFilters(slot, entry))
+      if (!fPrevData.CheckFilters(slot, entry))
+         return;
+      if (fProfile == nullptr) {
          CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      } else {
+         RNodeProfile::RScope scope(*fProfile, slot);
+         RDFInternal::ReadColumnValues(fValues[slot], entry, ColumnTypes_t{}, TypeInd_t{});
+         scope.ReadDone();
+         CallExec(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+      }
+      if (fHelper.CallIsDone(0))
+         SetDone();
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void CallExecBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask,
+                     TypeList<ColTypes...>, std::index_sequence<S...>)
+   {
+      std::tuple<ColTypes *...> values{fValues[slot][S]->template GetBulk<ColTypes>(entries, mask)...};
+      const auto bulkSize = entries.size();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i])
+            fHelper.Exec(slot, std::get<S>(values)[i]...);
+         if (fHelper.CallIsDone(0))
+            break;
+      }
+      (void)values; // avoid "unused variable" warnings
+   }
+
+   void RunBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries) final
+   {
+      if (fHelper.CallIsDone(0)) {
+         SetDone();
+         return;
+      }
+      // the mask flags the entries that pass all filters
+      const auto &mask = fPrevData.CheckFiltersBulk(slot, entries);
+      CallExecBulk(slot, entries, mask, ColumnTypes_t{}, TypeInd_t{});
+      if (fHelper.CallIsDone(0))
+         SetDone();
+   }
+
+   bool SupportsBulk() const final
+   {
+      return fHelper.SupportsBulk() &&
+             RDFInternal::CanReadInBulk(ColumnTypes_t{}, GetColumnNames(), fIsDefine.data(), GetDefines());
    }
 
    void TriggerChildrenCount() final { fPrevData.IncrChildrenCount(); }
@@ -139,7 +207,10 @@ public:
       auto prevColumns = prevNode->GetDefinedColumns();
 
       // Action nodes do not need to go through CreateFilterNode: they are never common nodes between multiple branches
-      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(fHelper.GetActionName());
+      auto name = fHelper.GetActionName();
+      if (fProfile != nullptr && !fProfile->GetSummary().empty())
+         name += "\n" + fProfile->GetSummary();
+      auto thisNode = std::make_shared<RDFGraphDrawing::GraphNode>(name);
 
       auto upmostNode = AddDefinesToGraph(thisNode, GetDefines(), prevColumns);
 
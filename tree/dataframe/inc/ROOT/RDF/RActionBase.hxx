@@ -14,10 +14,14 @@
 #include "ROOT/RDF/RBookedDefines.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
 #include "ROOT/RDF/Utils.hxx" // ColumnNames_t
+#include "ROOT/RVec.hxx"
 #include "RtypesCore.h"
 
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ROOT {
 
@@ -34,33 +38,61 @@ namespace RDF {
 namespace GraphDrawing {
 class GraphNode;
 }
+class RNodeProfile;
 
 using namespace ROOT::Detail::RDF;
 
 class RActionBase {
+public:
+   using MergeableValues_t = std::vector<std::unique_ptr<RMergeableValueBase>>;
+   /// Merges the partial results of an action into the first one, and sets the result of the action to the merged value.
+   using ResultMerger_t = std::function<void(MergeableValues_t &)>;
+
 protected:
    /// A raw pointer to the RLoopManager at the root of this functional graph.
    /// Never null: children nodes have shared ownership of parent nodes in the graph.
    RLoopManager *fLoopManager;
+   /// Runtime statistics of this action. Null unless profiling is enabled, see RLoopManager::GetNodeProfile.
+   RNodeProfile *fProfile = nullptr;
 
 private:
    const unsigned int fNSlots; ///< Number of thread slots used by this node.
    bool fHasRun = false;
+   /// Whether the result of this action is final, i.e. it does not need to process further entries.
+   std::atomic_bool fIsDone{false};
    const ColumnNames_t fColumnNames;
 
    RBookedDefines fDefines;
 
+   /// Sets the result of this action from partial results, e.g. computed by the worker processes of a multi-process
+   /// event loop. Empty if the result type of the action cannot be set this way.
+   ResultMerger_t fResultMerger;
+   /// The merged partial results of the last event loop, if set with SetMergedResult. See GetMergeableValue.
+   std::unique_ptr<RMergeableValueBase> fMergedValue;
+
+protected:
+   /// Return a copy of the merged partial results of the last event loop, or nullptr if the result of this action was
+   /// not set with SetMergedResult.
+   std::unique_ptr<RMergeableValueBase> CloneMergedValue() const;
+
 public:
    RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, const RBookedDefines &defines);
    RActionBase(const RActionBase &) = delete;
    RActionBase &operator=(const RActionBase &) = delete;
    virtual ~RActionBase();
 
-   const ColumnNames_t &GetColumnNames() const { return fColumnNames; }
+   /// Return the names of the columns read by this action.
+   virtual const ColumnNames_t &GetColumnNames() const { return fColumnNames; }
    RBookedDefines &GetDefines() { return fDefines; }
+   /// Return the Defines that are available to this action.
+   virtual const RBookedDefines &GetDefines() const { return fDefines; }
    RLoopManager *GetLoopManager() { return fLoopManager; }
    unsigned int GetNSlots() const { return fNSlots; }
    virtual void Run(unsigned int slot, Long64_t entry) = 0;
+   /// Bulk version of Run: process all entries of the current bulk that pass the upstream filters.
+   virtual void RunBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries) = 0;
+   /// Whether this action (including its input columns) can be run over a bulk of entries.
+   virtual bool SupportsBulk() const = 0;
    virtual void Initialize() = 0;
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
    virtual void TriggerChildrenCount() = 0;
@@ -73,6 +105,11 @@ public:
    // overridden by RJittedAction
    virtual bool HasRun() const { return fHasRun; }
    virtual void SetHasRun() { fHasRun = true; }
+   /// Whether the result of this action is final, see SetDone.
+   bool IsDone() const { return fIsDone; }
+   void SetDone();
+   /// Return the runtime statistics of this action, or nullptr if profiling is not enabled.
+   virtual const RNodeProfile *GetProfile() const { return fProfile; }
 
    virtual std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph() = 0;
 
@@ -83,6 +120,24 @@ public:
    virtual std::unique_ptr<RMergeableValueBase> GetMergeableValue() const = 0;
 
    virtual ROOT::RDF::SampleCallback_t GetSampleCallback() = 0;
+
+   /// Whether this action writes outputs that are combined after a multi-process event loop (e.g. Snapshot) rather
+   /// than producing a mergeable result.
+   virtual bool HasPartialOutputs() const = 0;
+   /// Combine the outputs written by the worker processes of a multi-process event loop into the final output.
+   virtual void MergePartialOutputs(unsigned int nWorkers) = 0;
+   /// Whether the tasks of a multi-thread event loop must process contiguous ranges of entries, see SetFirstEntry.
+   virtual bool NeedsContiguousTasks() const = 0;
+   /// Called before a multi-thread event loop in which the entry ranges of the tasks, as reported by
+   /// RSampleInfo::EntryRange, tile the entries starting at firstEntry.
+   virtual void SetFirstEntry(ULong64_t firstEntry) = 0;
+
+   void SetResultMerger(ResultMerger_t &&merger) { fResultMerger = std::move(merger); }
+   bool HasStreamableResult() const;
+   /// Whether the partial results of this action computed by the worker processes of a multi-process event loop can be
+   /// combined, see ROOT::RDF::EnableMultiProcessing.
+   bool SupportsMultiProcess() const { return HasPartialOutputs() || HasStreamableResult(); }
+   void SetMergedResult(MergeableValues_t &&partials);
 };
 } // namespace RDF
 } // namespace Internal
@@ -0,0 +1,161 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RBULKCOLUMNREADER
+#define ROOT_RDF_RBULKCOLUMNREADER
+
+#include "RColumnReaderBase.hxx"
+#include <ROOT/RVec.hxx>
+#include <Bytes.h>     // frombuf
+#include <Rtypes.h>    // Long64_t, R__CLING_PTRCHECK
+#include <TDataType.h> // EDataType
+
+#include <algorithm> // std::lower_bound
+#include <cstddef>   // std::size_t
+#include <memory>
+#include <string>
+#include <type_traits>
+
+class TBranch;
+class TBufferFile;
+class TTree;
+class TTreeReader;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+/// Type-erased interface of RBulkColumnReader, used by RLoopManager to fill the readers entry by entry.
+class R__CLING_PTRCHECK(off) RBulkColumnReaderBase : public ROOT::Detail::RDF::RColumnReaderBase {
+public:
+   /// Copy the value of the current entry in position `idx` of the bulk.
+   virtual void Load(std::size_t idx, Long64_t entry) = 0;
+   /// Complete the loading of a bulk, after Load has been called for all its entries. `entries` must stay valid until
+   /// the bulk has been processed.
+   virtual void LoadBulk(const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask) = 0;
+};
+
+/// Columns of these types can be read one basket at a time by RTreeBlockReader (these are the types for which
+/// frombuf is defined).
+template <typename T>
+using IsBlockReadable =
+   std::integral_constant<bool, std::is_same<T, bool>::value || std::is_same<T, char>::value ||
+                                   std::is_same<T, unsigned char>::value || std::is_same<T, short>::value ||
+                                   std::is_same<T, unsigned short>::value || std::is_same<T, int>::value ||
+                                   std::is_same<T, unsigned int>::value || std::is_same<T, Long64_t>::value ||
+                                   std::is_same<T, ULong64_t>::value || std::is_same<T, float>::value ||
+                                   std::is_same<T, double>::value>;
+
+/// Read the values of a TTree branch one basket at a time, in their serialized form, bypassing TTreeReader.
+///
+/// Only top-level branches with a single leaf of fundamental type (no arrays, no objects) that belong to the tree
+/// being read, not to one of its friends, can be read this way: see TBulkBranchRead.
+class RTreeBlockReader {
+   TTreeReader *fTreeReader;
+   std::string fBranchName;
+   EDataType fType;
+   std::size_t fValueSize;
+   /// The tree the branch was looked up in: for a TChain, the current tree of the chain.
+   TTree *fTree = nullptr;
+   /// The number of fTree in its TChain (0 for a TTree).
+   Int_t fTreeNumber = -1;
+   /// The branch that is read, or null if it cannot be read block-wise in the current tree.
+   TBranch *fBranch = nullptr;
+   /// Holds the serialized values of the entries in the last basket read.
+   std::unique_ptr<TBufferFile> fBuffer;
+   /// Entry number (in fTree) of the first entry in fBuffer.
+   Long64_t fBufferFirst = 0;
+   /// Number of entries in fBuffer.
+   Long64_t fBufferSize = 0;
+
+   TBranch *FindBranch() const;
+
+public:
+   RTreeBlockReader(TTreeReader &r, const std::string &branchName, EDataType type, std::size_t valueSize);
+   ~RTreeBlockReader();
+
+   /// Return the number of the current entry of the TTreeReader in the tree that contains the branch (the entry
+   /// number local to the current tree for a TChain), or -1 if the branch cannot be read block-wise in that tree.
+   Long64_t GetCurrentEntry();
+   /// Return the address of the serialized value of the given entry, as returned by GetCurrentEntry. The basket that
+   /// contains it is read if needed. The value stays valid until the next call, also if the tree is deleted.
+   char *GetValue(Long64_t entry);
+};
+
+/// Column reader that buffers the values of a column for a whole bulk of entries.
+///
+/// When the event loop runs in bulk mode, RLoopManager reads entries one by one (as TTreeReader and RDataSource
+/// require) and calls Load for every booked column, then calls LoadBulk once the bulk is complete. The computation
+/// graph then processes the whole bulk in one go, accessing the buffered values via GetBulk.
+///
+/// Values of TTree branches of fundamental type are read a basket at a time by a RTreeBlockReader and decoded in the
+/// bulk buffer; values of other columns are copied from the reader they come from. Either way, values are loaded in
+/// Load, while the tree they come from is still alive: a TChain deletes the previous tree when it moves to the next
+/// file, which can happen before a bulk is complete.
+template <typename T>
+class R__CLING_PTRCHECK(off) RBulkColumnReader final : public RBulkColumnReaderBase {
+   /// The reader that values are copied from.
+   std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase> fReader;
+   /// Reads the values basket by basket if the column is a TTree branch that supports it, otherwise null.
+   std::unique_ptr<RTreeBlockReader> fBlockReader;
+   /// The values of the entries of the current bulk.
+   ROOT::RVec<T> fValues;
+   /// The entries of the current bulk, as passed to LoadBulk. They are sorted, but not necessarily contiguous.
+   const ROOT::RVec<Long64_t> *fEntries = nullptr;
+
+   /// Return the position in the bulk of the given entry.
+   std::size_t GetIndex(Long64_t entry) const
+   {
+      const auto &entries = *fEntries;
+      // entries are usually contiguous, but not e.g. with a TEntryList or with entries rejected by a RDataSource
+      const auto guess = static_cast<std::size_t>(entry - entries[0]);
+      if (guess < entries.size() && entries[guess] == entry)
+         return guess;
+      return std::lower_bound(entries.begin(), entries.end(), entry) - entries.begin();
+   }
+
+   void *GetImpl(Long64_t entry) final { return &fValues[GetIndex(entry)]; }
+
+   void *GetBulkImpl(const ROOT::RVec<Long64_t> &, const ROOT::RVecB &) final { return fValues.data(); }
+
+   /// Decode the value of the current entry from the basket read by fBlockReader. Return false if the branch cannot be
+   /// read block-wise in the current tree.
+   bool LoadFromBlock(std::size_t idx, std::true_type /*isBlockReadable*/)
+   {
+      const auto blockEntry = fBlockReader->GetCurrentEntry();
+      if (blockEntry < 0)
+         return false;
+      char *buf = fBlockReader->GetValue(blockEntry);
+      frombuf(buf, &fValues[idx]);
+      return true;
+   }
+
+   bool LoadFromBlock(std::size_t, std::false_type /*isBlockReadable*/) { return false; }
+
+public:
+   RBulkColumnReader(std::unique_ptr<ROOT::Detail::RDF::RColumnReaderBase> reader, std::size_t bulkSize,
+                     std::unique_ptr<RTreeBlockReader> blockReader = nullptr)
+      : fReader(std::move(reader)), fBlockReader(std::move(blockReader)), fValues(bulkSize)
+   {
+   }
+
+   void Load(std::size_t idx, Long64_t entry) final
+   {
+      if (fBlockReader && LoadFromBlock(idx, IsBlockReadable<T>{}))
+         return;
+      fValues[idx] = fReader->template Get<T>(entry);
+   }
+
+   void LoadBulk(const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &) final { fEntries = &entries; }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
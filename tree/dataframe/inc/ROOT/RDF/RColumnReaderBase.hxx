@@ -11,8 +11,11 @@
 #ifndef ROOT_INTERNAL_RDF_RCOLUMNREADERBASE
 #define ROOT_INTERNAL_RDF_RCOLUMNREADERBASE
 
+#include <ROOT/RVec.hxx>
 #include <Rtypes.h>
 
+#include <stdexcept>
+
 namespace ROOT {
 namespace Detail {
 namespace RDF {
@@ -38,8 +41,24 @@ public:
       return *static_cast<T *>(GetImpl(entry));
    }
 
+   /// Return a pointer to the column values for a bulk of entries, stored contiguously.
+   /// Only used when the event loop runs in bulk mode (see RLoopManager::GetBulkSize).
+   /// \tparam T The column type
+   /// \param entries The entry numbers of the bulk
+   /// \param mask The entries of the bulk for which a valid value is required
+   template <typename T>
+   T *GetBulk(const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask)
+   {
+      return static_cast<T *>(GetBulkImpl(entries, mask));
+   }
+
 private:
    virtual void *GetImpl(Long64_t entry) = 0;
+
+   virtual void *GetBulkImpl(const ROOT::RVec<Long64_t> &, const ROOT::RVecB &)
+   {
+      throw std::logic_error("This column reader does not support bulk reading.");
+   }
 };
 
 } // namespace RDF
@@ -22,6 +22,7 @@ namespace ROOT {
 namespace Detail {
 namespace RDF {
 class RFilterBase;
+class RMergeableReport;
 } // End NS RDF
 } // End NS Detail
 
@@ -32,12 +33,14 @@ class TCutInfo {
    friend class ROOT::Detail::RDF::RFilterBase;
 
 private:
-   const std::string fName;
-   const ULong64_t fPass;
-   const ULong64_t fAll;
+   std::string fName;
+   ULong64_t fPass = 0;
+   ULong64_t fAll = 0;
    TCutInfo(const std::string &name, ULong64_t pass, ULong64_t all) : fName(name), fPass(pass), fAll(all) {}
 
 public:
+   /// Default constructor. Needed to allow serialization of cut-flow reports, see RMergeableReport.
+   TCutInfo() = default;
    const std::string &GetName() const { return fName; }
    ULong64_t GetAll() const { return fAll; }
    ULong64_t GetPass() const { return fPass; }
@@ -46,10 +49,12 @@ public:
 
 class RCutFlowReport {
    friend class ROOT::Detail::RDF::RFilterBase;
+   friend class ROOT::Detail::RDF::RMergeableReport;
 
 private:
    std::vector<TCutInfo> fCutInfos;
    void AddCut(TCutInfo &&ci) { fCutInfos.emplace_back(std::move(ci)); };
+   void Merge(const RCutFlowReport &other);
 
 public:
    using const_iterator = typename std::vector<TCutInfo>::const_iterator;
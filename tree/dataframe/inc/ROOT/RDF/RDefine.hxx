@@ -14,6 +14,7 @@
 #include "ROOT/RDF/ColumnReaderUtils.hxx"
 #include "ROOT/RDF/RColumnReaderBase.hxx"
 #include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/TypeTraits.hxx"
@@ -21,6 +22,7 @@
 
 #include <array>
 #include <deque>
+#include <tuple>
 #include <type_traits>
 #include <utility> // std::index_sequence
 #include <vector>
@@ -58,6 +60,8 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
    // Avoid instantiating vector<bool> as `operator[]` returns temporaries in that case. Use std::deque instead.
    using ValuesPerSlot_t =
       std::conditional_t<std::is_same<ret_type, bool>::value, std::deque<ret_type>, std::vector<ret_type>>;
+   // Only Defines that return fundamental types are evaluated in bulk
+   using SupportsBulk_t = RDFInternal::IsBulkReadable<ret_type>;
 
    F fExpression;
    ValuesPerSlot_t fLastResults;
@@ -65,6 +69,13 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
    /// Column readers per slot and per input column
    std::vector<std::array<std::unique_ptr<RColumnReaderBase>, ColumnTypes_t::list_size>> fValues;
 
+   /// Per-slot values for the entries of the current bulk. Only used in bulk mode.
+   std::vector<ROOT::RVec<ret_type>> fBulkValues;
+   /// Per-slot flags that signal which values of the current bulk have already been evaluated.
+   std::vector<ROOT::RVecB> fBulkIsEvaluated;
+   /// Per-slot entry number of the first entry of the current bulk.
+   std::vector<Long64_t> fBulkFirstEntry;
+
    template <typename... ColTypes, std::size_t... S>
    void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>, NoneTag)
    {
@@ -96,12 +107,63 @@ class R__CLING_PTRCHECK(off) RDefine final : public RDefineBase {
       (void)entry;
    }
 
+   template <typename... Args>
+   ret_type EvalBulkEntry(unsigned int, Long64_t, NoneTag, Args &... args)
+   {
+      return fExpression(args...);
+   }
+
+   template <typename... Args>
+   ret_type EvalBulkEntry(unsigned int slot, Long64_t, SlotTag, Args &... args)
+   {
+      return fExpression(slot, args...);
+   }
+
+   template <typename... Args>
+   ret_type EvalBulkEntry(unsigned int slot, Long64_t entry, SlotAndEntryTag, Args &... args)
+   {
+      return fExpression(slot, entry, args...);
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void UpdateBulkHelper(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask,
+                         TypeList<ColTypes...>, std::index_sequence<S...>, std::true_type /*supportsBulk*/)
+   {
+      auto &values = fBulkValues[slot];
+      auto &isEvaluated = fBulkIsEvaluated[slot];
+      const auto bulkSize = entries.size();
+      if (entries[0] != fBulkFirstEntry[slot] || values.size() != bulkSize) {
+         values.resize(bulkSize);
+         isEvaluated.assign(bulkSize, false);
+         fBulkFirstEntry[slot] = entries[0];
+      }
+
+      // the input columns are evaluated (if they are Defines themselves) for the entries selected by the mask
+      std::tuple<ColTypes *...> inputs{fValues[slot][S]->template GetBulk<ColTypes>(entries, mask)...};
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i] && !isEvaluated[i]) {
+            values[i] = EvalBulkEntry(slot, entries[i], ExtraArgsTag{}, std::get<S>(inputs)[i]...);
+            isEvaluated[i] = true;
+         }
+      }
+      // silence "unused variable" warnings in gcc
+      (void)inputs;
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void UpdateBulkHelper(unsigned int, const ROOT::RVec<Long64_t> &, const ROOT::RVecB &, TypeList<ColTypes...>,
+                         std::index_sequence<S...>, std::false_type /*supportsBulk*/)
+   {
+      // never called: SupportsBulk() returns false
+      RDefineBase::UpdateBulk(0u, {}, {});
+   }
+
 public:
    RDefine(std::string_view name, std::string_view type, F expression, const ROOT::RDF::ColumnNames_t &columns,
-           unsigned int nSlots, const RDFInternal::RBookedDefines &defines,
-           const std::map<std::string, std::vector<void *>> &DSValuePtrs, ROOT::RDF::RDataSource *ds)
-      : RDefineBase(name, type, nSlots, defines, DSValuePtrs, ds, columns), fExpression(std::move(expression)),
-        fLastResults(nSlots * RDFInternal::CacheLineStep<ret_type>()), fValues(nSlots)
+           const RDFInternal::RBookedDefines &defines, RLoopManager &lm)
+      : RDefineBase(name, type, defines, lm, columns), fExpression(std::move(expression)),
+        fLastResults(lm.GetNSlots() * RDFInternal::CacheLineStep<ret_type>()), fValues(lm.GetNSlots()),
+        fBulkValues(lm.GetNSlots()), fBulkIsEvaluated(lm.GetNSlots()), fBulkFirstEntry(lm.GetNSlots(), -1)
    {
    }
 
@@ -114,9 +176,10 @@ public:
          for (auto &define : fDefines.GetColumns())
             define.second->InitSlot(r, slot);
          fIsInitialized[slot] = true;
-         RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), fDSValuePtrs, fDataSource};
+         RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), *fLoopManager};
          fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
+         fBulkFirstEntry[slot] = -1;
       }
    }
 
@@ -131,13 +194,34 @@ public:
    {
       if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
          // evaluate this define expression, cache the result
-         UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         if (fProfile == nullptr) {
+            UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         } else {
+            RDFInternal::RNodeProfile::RScope scope(*fProfile, slot);
+            RDFInternal::ReadColumnValues(fValues[slot], entry, ColumnTypes_t{}, TypeInd_t{});
+            scope.ReadDone();
+            UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{}, ExtraArgsTag{});
+         }
          fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entry;
       }
    }
 
    void Update(unsigned int /*slot*/, const ROOT::RDF::RSampleInfo &/*id*/) final {}
 
+   bool SupportsBulk() const final
+   {
+      return SupportsBulk_t::value &&
+             RDFInternal::CanReadInBulk(ColumnTypes_t{}, fColumnNames, fIsDefine.data(), fDefines);
+   }
+
+   /// Evaluate the values of the entries of the current bulk that are selected by the mask and not evaluated yet.
+   void UpdateBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask) final
+   {
+      UpdateBulkHelper(slot, entries, mask, ColumnTypes_t{}, TypeInd_t{}, SupportsBulk_t{});
+   }
+
+   void *GetBulkValuePtr(unsigned int slot) final { return static_cast<void *>(fBulkValues[slot].data()); }
+
    const std::type_info &GetTypeId() const { return typeid(ret_type); }
 
    /// Clean-up operations to be performed at the end of a task.
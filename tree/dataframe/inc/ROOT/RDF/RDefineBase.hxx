@@ -18,7 +18,6 @@
 #include "ROOT/RVec.hxx"
 
 #include <deque>
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -26,14 +25,19 @@
 class TTreeReader;
 
 namespace ROOT {
+namespace Internal {
 namespace RDF {
-class RDataSource;
+class RNodeProfile;
 }
+} // namespace Internal
+
 namespace Detail {
 namespace RDF {
 
 namespace RDFInternal = ROOT::Internal::RDF;
 
+class RLoopManager;
+
 class RDefineBase {
 protected:
    const std::string fName; ///< The name of the custom column
@@ -41,17 +45,18 @@ protected:
    std::vector<Long64_t> fLastCheckedEntry;
    RDFInternal::RBookedDefines fDefines;
    std::deque<bool> fIsInitialized; // because vector<bool> is not thread-safe
-   const std::map<std::string, std::vector<void *>> &fDSValuePtrs; // reference to RLoopManager's data member
-   ROOT::RDF::RDataSource *fDataSource; ///< non-owning ptr to the RDataSource, if any. Used to retrieve column readers.
+   RLoopManager *fLoopManager; ///< non-owning ptr to the RLoopManager. Used to retrieve column readers.
    const ROOT::RDF::ColumnNames_t fColumnNames;
    /// The nth flag signals whether the nth input column is a custom column or not.
    ROOT::RVecB fIsDefine;
+   /// Runtime statistics of this Define. Null unless profiling is enabled, see RLoopManager::GetNodeProfile.
+   RDFInternal::RNodeProfile *fProfile = nullptr;
+   /// The expression of a jitted Define. Empty if the Define evaluates a C++ callable.
+   std::string fExpression;
 
 public:
-   RDefineBase(std::string_view name, std::string_view type, unsigned int nSlots,
-               const RDFInternal::RBookedDefines &defines,
-               const std::map<std::string, std::vector<void *>> &DSValuePtrs, ROOT::RDF::RDataSource *ds,
-               const ColumnNames_t &columnNames);
+   RDefineBase(std::string_view name, std::string_view type, const RDFInternal::RBookedDefines &defines,
+               RLoopManager &lm, const ColumnNames_t &columnNames);
 
    RDefineBase &operator=(const RDefineBase &) = delete;
    RDefineBase &operator=(RDefineBase &&) = delete;
@@ -62,12 +67,29 @@ public:
    virtual const std::type_info &GetTypeId() const = 0;
    std::string GetName() const;
    std::string GetTypeName() const;
+   /// Return the names of the columns this Define is computed from.
+   virtual const ColumnNames_t &GetColumnNames() const { return fColumnNames; }
+   /// Return the Defines that are available to this Define.
+   virtual const RDFInternal::RBookedDefines &GetDefines() const { return fDefines; }
    /// Update the value at the address returned by GetValuePtr with the content corresponding to the given entry
    virtual void Update(unsigned int slot, Long64_t entry) = 0;
    /// Update function to be called once per sample, used if the derived type is a RDefinePerSample
    virtual void Update(unsigned int /*slot*/, const ROOT::RDF::RSampleInfo &/*id*/) {}
    /// Clean-up operations to be performed at the end of a task.
    virtual void FinaliseSlot(unsigned int slot) = 0;
+   /// Whether this Define can be evaluated over a bulk of entries, see RLoopManager::GetBulkSize.
+   virtual bool SupportsBulk() const { return false; }
+   /// Evaluate the Define'd values for the entries of the current bulk that are selected by the mask.
+   virtual void UpdateBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask);
+   /// Return the (type-erased) address of the Define'd values of the current bulk for the given processing slot.
+   virtual void *GetBulkValuePtr(unsigned int slot);
+   /// Operations to be performed once before each event loop, called by the nodes that use this Define.
+   virtual void InitNode();
+   /// Return the runtime statistics of this Define, or nullptr if profiling is not enabled.
+   virtual const RDFInternal::RNodeProfile *GetProfile() const { return fProfile; }
+   void SetExpression(std::string_view expression) { fExpression = std::string(expression); }
+   /// Return the expression of a jitted Define, or an empty string if the Define evaluates a C++ callable.
+   const std::string &GetExpression() const { return fExpression; }
 };
 
 } // ns RDF
@@ -0,0 +1,225 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RDEFINEBATCH
+#define ROOT_RDF_RDEFINEBATCH
+
+#include "ROOT/RDF/ColumnReaderUtils.hxx"
+#include "ROOT/RDF/RColumnReaderBase.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
+#include "ROOT/RDF/Utils.hxx"
+#include "ROOT/RStringView.hxx"
+#include "ROOT/RVec.hxx"
+#include "ROOT/TypeTraits.hxx"
+#include "RtypesCore.h"
+
+#include <algorithm> // std::copy
+#include <array>
+#include <cstddef> // std::size_t
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility> // std::index_sequence
+#include <vector>
+
+class TTreeReader;
+
+namespace ROOT {
+namespace Detail {
+namespace RDF {
+
+using namespace ROOT::TypeTraits;
+
+/// A Define whose expression is evaluated over batches of entries, see RInterface::DefineBatch.
+///
+/// The expression receives one RVec per input column and returns an RVec with one value per entry of the batch.
+/// In bulk mode (see RLoopManager::GetBulkSize) a batch contains the entries of the current bulk that are selected by
+/// the upstream filters, otherwise the expression is invoked with batches of one entry.
+template <typename F>
+class R__CLING_PTRCHECK(off) RDefineBatch final : public RDefineBase {
+   using ColumnTypes_t = RDFInternal::RVecValueTypes_t<typename CallableTraits<F>::arg_types>;
+   using TypeInd_t = std::make_index_sequence<ColumnTypes_t::list_size>;
+   using ret_type = RDFInternal::RVecValueType_t<typename CallableTraits<F>::ret_type>;
+   // Avoid instantiating vector<bool> as `operator[]` returns temporaries in that case. Use std::deque instead.
+   using ValuesPerSlot_t =
+      std::conditional_t<std::is_same<ret_type, bool>::value, std::deque<ret_type>, std::vector<ret_type>>;
+   using SupportsBulk_t = RDFInternal::IsBulkReadable<ret_type>;
+
+   F fExpression;
+   ValuesPerSlot_t fLastResults;
+
+   /// Column readers per slot and per input column
+   std::vector<std::array<std::unique_ptr<RColumnReaderBase>, ColumnTypes_t::list_size>> fValues;
+
+   /// Per-slot values for the entries of the current bulk. Only used in bulk mode.
+   std::vector<ROOT::RVec<ret_type>> fBulkValues;
+   /// Per-slot flags that signal which values of the current bulk have already been evaluated.
+   std::vector<ROOT::RVecB> fBulkIsEvaluated;
+   /// Per-slot entry number of the first entry of the current bulk.
+   std::vector<Long64_t> fBulkFirstEntry;
+   /// Per-slot positions in the current bulk of the entries passed to the expression.
+   std::vector<ROOT::RVec<std::size_t>> fBulkToEvaluate;
+
+   void CheckBatchSize(std::size_t nValues, std::size_t nEntries) const
+   {
+      if (nValues != nEntries) {
+         throw std::runtime_error("DefineBatch: the expression of column \"" + fName + "\" returned " +
+                                  std::to_string(nValues) + " values for a batch of " + std::to_string(nEntries) +
+                                  " entries.");
+      }
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void UpdateHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>)
+   {
+      // a batch of one element that views the value of the current entry
+      const auto result = fExpression(ROOT::RVec<ColTypes>(&fValues[slot][S]->template Get<ColTypes>(entry), 1u)...);
+      CheckBatchSize(result.size(), 1u);
+      fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()] = result[0];
+      // silence "unused parameter" warnings in gcc
+      (void)entry;
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void UpdateBulkHelper(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask,
+                         TypeList<ColTypes...>, std::index_sequence<S...>, std::true_type /*supportsBulk*/)
+   {
+      auto &values = fBulkValues[slot];
+      auto &isEvaluated = fBulkIsEvaluated[slot];
+      const auto bulkSize = entries.size();
+      if (entries[0] != fBulkFirstEntry[slot] || values.size() != bulkSize) {
+         values.resize(bulkSize);
+         isEvaluated.assign(bulkSize, false);
+         fBulkFirstEntry[slot] = entries[0];
+      }
+
+      // only the entries selected by the mask that have not been evaluated yet (e.g. for a different branch of the
+      // computation graph) are passed to the expression
+      auto &toEvaluate = fBulkToEvaluate[slot];
+      toEvaluate.clear();
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         if (mask[i] && !isEvaluated[i])
+            toEvaluate.push_back(i);
+      }
+      if (toEvaluate.empty())
+         return;
+
+      // the input columns are evaluated (if they are Defines themselves) for the entries selected by the mask
+      std::tuple<ColTypes *...> inputs{fValues[slot][S]->template GetBulk<ColTypes>(entries, mask)...};
+      if (toEvaluate.size() == bulkSize) {
+         // the expression can read the buffers of the input columns directly
+         const auto result = fExpression(ROOT::RVec<ColTypes>(std::get<S>(inputs), bulkSize)...);
+         CheckBatchSize(result.size(), bulkSize);
+         std::copy(result.begin(), result.end(), values.begin());
+      } else {
+         const auto result =
+            fExpression(ROOT::VecOps::Take(ROOT::RVec<ColTypes>(std::get<S>(inputs), bulkSize), toEvaluate)...);
+         CheckBatchSize(result.size(), toEvaluate.size());
+         for (std::size_t i = 0u; i < toEvaluate.size(); ++i)
+            values[toEvaluate[i]] = result[i];
+      }
+      for (auto i : toEvaluate)
+         isEvaluated[i] = true;
+      // silence "unused variable" warnings in gcc
+      (void)inputs;
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void UpdateBulkHelper(unsigned int, const ROOT::RVec<Long64_t> &, const ROOT::RVecB &, TypeList<ColTypes...>,
+                         std::index_sequence<S...>, std::false_type /*supportsBulk*/)
+   {
+      // never called: SupportsBulk() returns false
+      RDefineBase::UpdateBulk(0u, {}, {});
+   }
+
+public:
+   RDefineBatch(std::string_view name, std::string_view type, F expression, const ROOT::RDF::ColumnNames_t &columns,
+                const RDFInternal::RBookedDefines &defines, RLoopManager &lm)
+      : RDefineBase(name, type, defines, lm, columns), fExpression(std::move(expression)),
+        fLastResults(lm.GetNSlots() * RDFInternal::CacheLineStep<ret_type>()), fValues(lm.GetNSlots()),
+        fBulkValues(lm.GetNSlots()), fBulkIsEvaluated(lm.GetNSlots()), fBulkFirstEntry(lm.GetNSlots(), -1),
+        fBulkToEvaluate(lm.GetNSlots())
+   {
+   }
+
+   RDefineBatch(const RDefineBatch &) = delete;
+   RDefineBatch &operator=(const RDefineBatch &) = delete;
+
+   void InitSlot(TTreeReader *r, unsigned int slot) final
+   {
+      if (!fIsInitialized[slot]) {
+         for (auto &define : fDefines.GetColumns())
+            define.second->InitSlot(r, slot);
+         fIsInitialized[slot] = true;
+         RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), *fLoopManager};
+         fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
+         fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
+         fBulkFirstEntry[slot] = -1;
+      }
+   }
+
+   /// Return the (type-erased) address of the Define'd value for the given processing slot.
+   void *GetValuePtr(unsigned int slot) final
+   {
+      return static_cast<void *>(&fLastResults[slot * RDFInternal::CacheLineStep<ret_type>()]);
+   }
+
+   /// Update the value at the address returned by GetValuePtr, evaluating the expression over a batch of one entry.
+   void Update(unsigned int slot, Long64_t entry) final
+   {
+      if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
+         if (fProfile == nullptr) {
+            UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+         } else {
+            RDFInternal::RNodeProfile::RScope scope(*fProfile, slot);
+            RDFInternal::ReadColumnValues(fValues[slot], entry, ColumnTypes_t{}, TypeInd_t{});
+            scope.ReadDone();
+            UpdateHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+         }
+         fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entry;
+      }
+   }
+
+   void Update(unsigned int /*slot*/, const ROOT::RDF::RSampleInfo & /*id*/) final {}
+
+   bool SupportsBulk() const final
+   {
+      return SupportsBulk_t::value &&
+             RDFInternal::CanReadInBulk(ColumnTypes_t{}, fColumnNames, fIsDefine.data(), fDefines);
+   }
+
+   /// Evaluate the expression once for all the entries of the current bulk that are selected by the mask and not
+   /// evaluated yet.
+   void UpdateBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask) final
+   {
+      UpdateBulkHelper(slot, entries, mask, ColumnTypes_t{}, TypeInd_t{}, SupportsBulk_t{});
+   }
+
+   void *GetBulkValuePtr(unsigned int slot) final { return static_cast<void *>(fBulkValues[slot].data()); }
+
+   const std::type_info &GetTypeId() const { return typeid(ret_type); }
+
+   /// Clean-up operations to be performed at the end of a task.
+   void FinaliseSlot(unsigned int slot) final
+   {
+      if (fIsInitialized[slot]) {
+         for (auto &v : fValues[slot])
+            v.reset();
+         fIsInitialized[slot] = false;
+      }
+   }
+};
+
+} // namespace RDF
+} // namespace Detail
+} // namespace ROOT
+
+#endif // ROOT_RDF_RDEFINEBATCH
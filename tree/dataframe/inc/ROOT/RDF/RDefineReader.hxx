@@ -42,6 +42,12 @@ class R__CLING_PTRCHECK(off) RDefineReader final : public ROOT::Detail::RDF::RCo
       return fCustomValuePtr;
    }
 
+   void *GetBulkImpl(const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask) final
+   {
+      fDefine.UpdateBulk(fSlot, entries, mask);
+      return fDefine.GetBulkValuePtr(fSlot);
+   }
+
 public:
    RDefineReader(unsigned int slot, RDFDetail::RDefineBase &define, const std::type_info &tid)
       : fDefine(define), fCustomValuePtr(define.GetValuePtr(slot)), fSlot(slot)
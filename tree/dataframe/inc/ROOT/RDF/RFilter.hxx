@@ -16,7 +16,9 @@
 #include "ROOT/RDF/RCutFlowReport.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RFilterChain.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/TypeTraits.hxx"
 #include "RtypesCore.h"
 
@@ -24,6 +26,7 @@
 #include <cassert>
 #include <memory>
 #include <string>
+#include <tuple>
 #include <utility> // std::index_sequence
 #include <vector>
 
@@ -79,12 +82,15 @@ public:
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
       if (entry != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
-         if (!fPrevData.CheckFilters(slot, entry)) {
+         if (fChain != nullptr) {
+            // this filter and the upstream ones in the chain are evaluated in an optimized order
+            fLastResult[slot * RDFInternal::CacheLineStep<int>()] = fChain->CheckFilters(slot, entry);
+         } else if (!fPrevData.CheckFilters(slot, entry)) {
             // a filter upstream returned false, cache the result
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = false;
          } else {
             // evaluate this filter, cache the result
-            auto passed = CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+            auto passed = EvalFilter(slot, entry);
             passed ? ++fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()]
                    : ++fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()];
             fLastResult[slot * RDFInternal::CacheLineStep<int>()] = passed;
@@ -94,6 +100,19 @@ public:
       return fLastResult[slot * RDFInternal::CacheLineStep<int>()];
    }
 
+   bool EvalFilter(unsigned int slot, Long64_t entry) final
+   {
+      if (fProfile == nullptr)
+         return CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+
+      RDFInternal::RNodeProfile::RScope scope(*fProfile, slot);
+      RDFInternal::ReadColumnValues(fValues[slot], entry, ColumnTypes_t{}, TypeInd_t{});
+      scope.ReadDone();
+      return CheckFilterHelper(slot, entry, ColumnTypes_t{}, TypeInd_t{});
+   }
+
+   RNodeBase *GetPrevNode() const final { return fPrevDataPtr.get(); }
+
    template <typename... ColTypes, std::size_t... S>
    bool CheckFilterHelper(unsigned int slot, Long64_t entry, TypeList<ColTypes...>, std::index_sequence<S...>)
    {
@@ -103,12 +122,47 @@ public:
       return fFilter(fValues[slot][S]->template Get<ColTypes>(entry)...);
    }
 
+   const ROOT::RVecB &CheckFiltersBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries) final
+   {
+      auto &mask = fLastBulkResult[slot];
+      if (entries[0] != fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()]) {
+         // only entries that pass the upstream filters are evaluated
+         const auto &prevMask = fPrevData.CheckFiltersBulk(slot, entries);
+         mask.resize(entries.size());
+         CheckFilterBulkHelper(slot, entries, prevMask, mask, ColumnTypes_t{}, TypeInd_t{});
+         fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = entries[0];
+      }
+      return mask;
+   }
+
+   template <typename... ColTypes, std::size_t... S>
+   void CheckFilterBulkHelper(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &prevMask,
+                              ROOT::RVecB &mask, TypeList<ColTypes...>, std::index_sequence<S...>)
+   {
+      std::tuple<ColTypes *...> values{fValues[slot][S]->template GetBulk<ColTypes>(entries, prevMask)...};
+      const auto bulkSize = entries.size();
+      ULong64_t nPrevAccepted = 0ull;
+      ULong64_t nAccepted = 0ull;
+      for (std::size_t i = 0u; i < bulkSize; ++i) {
+         nPrevAccepted += prevMask[i];
+         mask[i] = prevMask[i] && fFilter(std::get<S>(values)[i]...);
+         nAccepted += mask[i];
+      }
+      fAccepted[slot * RDFInternal::CacheLineStep<ULong64_t>()] += nAccepted;
+      fRejected[slot * RDFInternal::CacheLineStep<ULong64_t>()] += nPrevAccepted - nAccepted;
+      (void)values; // avoid "unused variable" warnings
+   }
+
+   bool SupportsBulk() const final
+   {
+      return RDFInternal::CanReadInBulk(ColumnTypes_t{}, fColumnNames, fIsDefine.data(), fDefines);
+   }
+
    void InitSlot(TTreeReader *r, unsigned int slot) final
    {
       for (auto &bookedBranch : fDefines.GetColumns())
          bookedBranch.second->InitSlot(r, slot);
-      RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), fLoopManager->GetDSValuePtrs(),
-                                           fLoopManager->GetDataSource()};
+      RDFInternal::RColumnReadersInfo info{fColumnNames, fDefines, fIsDefine.data(), *fLoopManager};
       fValues[slot] = RDFInternal::MakeColumnReaders(slot, r, ColumnTypes_t{}, info);
       fLastCheckedEntry[slot * RDFInternal::CacheLineStep<Long64_t>()] = -1;
    }
@@ -29,6 +29,13 @@ namespace RDF {
 class RCutFlowReport;
 } // ns RDF
 
+namespace Internal {
+namespace RDF {
+class RFilterChain;
+class RNodeProfile;
+} // ns RDF
+} // ns Internal
+
 namespace Detail {
 namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
@@ -41,11 +48,19 @@ protected:
    std::vector<int> fLastResult = {true}; // std::vector<bool> cannot be used in a MT context safely
    std::vector<ULong64_t> fAccepted = {0};
    std::vector<ULong64_t> fRejected = {0};
+   std::vector<ROOT::RVecB> fLastBulkResult; ///< Per-slot selection masks of the last bulk processed, in bulk mode
    const std::string fName;
    const ROOT::RDF::ColumnNames_t fColumnNames;
    RDFInternal::RBookedDefines fDefines;
    /// The nth flag signals whether the nth input column is a custom column or not.
    ROOT::RVecB fIsDefine;
+   /// If not null, the chain of filters ending with this filter that CheckFilters evaluates instead of the upstream
+   /// nodes, see RLoopManager::SetupFilterChains. Non-owning.
+   RDFInternal::RFilterChain *fChain = nullptr;
+   /// Runtime statistics of this filter. Null unless profiling is enabled, see RLoopManager::GetNodeProfile.
+   RDFInternal::RNodeProfile *fProfile = nullptr;
+   /// The expression of a jitted filter. Empty if the filter evaluates a C++ callable.
+   std::string fExpression;
 
 public:
    RFilterBase(RLoopManager *df, std::string_view name, const unsigned int nSlots,
@@ -55,6 +70,12 @@ public:
    virtual ~RFilterBase();
 
    virtual void InitSlot(TTreeReader *r, unsigned int slot) = 0;
+   /// Return the names of the columns read by this filter.
+   virtual const ColumnNames_t &GetColumnNames() const { return fColumnNames; }
+   /// Return the Defines that are available to this filter.
+   virtual const RDFInternal::RBookedDefines &GetDefines() const { return fDefines; }
+   /// Whether this filter (including its input columns) can be evaluated over a bulk of entries.
+   virtual bool SupportsBulk() const = 0;
    bool HasName() const;
    std::string GetName() const;
    virtual void FillReport(ROOT::RDF::RCutFlowReport &) const;
@@ -70,6 +91,19 @@ public:
    virtual void FinaliseSlot(unsigned int slot) = 0;
    virtual void InitNode();
    virtual void AddFilterName(std::vector<std::string> &filters) = 0;
+   /// Return the node this filter is attached to.
+   virtual RNodeBase *GetPrevNode() const = 0;
+   /// Return the number of active nodes hanging from this filter in the current event loop.
+   virtual unsigned int GetNChildren() const { return fNChildren; }
+   /// Evaluate the filter expression for the given entry, regardless of the result of upstream filters.
+   virtual bool EvalFilter(unsigned int slot, Long64_t entry) = 0;
+   /// Make CheckFilters evaluate the given chain of filters, which ends with this filter. nullptr resets the default.
+   virtual void SetFilterChain(RDFInternal::RFilterChain *chain) { fChain = chain; }
+   /// Return the runtime statistics of this filter, or nullptr if profiling is not enabled.
+   virtual const RDFInternal::RNodeProfile *GetProfile() const { return fProfile; }
+   void SetExpression(std::string_view expression) { fExpression = std::string(expression); }
+   /// Return the expression of a jitted filter, or an empty string if the filter evaluates a C++ callable.
+   const std::string &GetExpression() const { return fExpression; }
 };
 
 } // ns RDF
@@ -0,0 +1,72 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RFILTERCHAIN
+#define ROOT_RDF_RFILTERCHAIN
+
+#include "RtypesCore.h"
+
+#include <cstddef> // std::size_t
+#include <vector>
+
+namespace ROOT {
+namespace Detail {
+namespace RDF {
+class RFilterBase;
+class RNodeBase;
+} // namespace RDF
+} // namespace Detail
+
+namespace Internal {
+namespace RDF {
+
+/// A chain of unnamed Filters, each of which is the only active child of the previous one, whose expressions are
+/// evaluated in an order that is optimized at runtime.
+///
+/// During the first entries processed by each slot (the warm-up) the filter expressions of the chain are evaluated in
+/// booking order until one rejects the entry, measuring the cost of each evaluation and the fraction of entries each
+/// filter accepts. Afterwards, that slot evaluates the expressions in order of increasing cost per rejected entry and
+/// stops at the first that rejects the entry, so that cheap and selective filters run first. The selected entries are
+/// the same as when evaluating the filters in booking order, provided that the filter expressions do not depend on
+/// each other. The filters of a chain are unnamed, so they do not appear in cut-flow reports, and the counters of
+/// the named filters upstream and downstream of the chain do not depend on the evaluation order.
+class RFilterChain {
+   using RFilterBase = ROOT::Detail::RDF::RFilterBase;
+   using RNodeBase = ROOT::Detail::RDF::RNodeBase;
+
+   struct RSlotStats {
+      std::vector<std::size_t> fOrder;    ///< Order in which the filters are evaluated
+      std::vector<double> fTime;          ///< Time spent evaluating each filter during the warm-up, in nanoseconds
+      std::vector<ULong64_t> fNEvaluated; ///< Number of entries on which each filter was evaluated during the warm-up
+      std::vector<ULong64_t> fNPassed;    ///< Number of entries accepted by each filter during the warm-up
+      ULong64_t fNWarmUp = 0ull;          ///< Number of entries evaluated during the warm-up
+   };
+
+   RNodeBase *fUpstream;               ///< The node the first filter of the chain is attached to
+   std::vector<RFilterBase *> fFilters; ///< The filters of the chain, in booking order
+   std::vector<RSlotStats> fSlotStats;
+   const ULong64_t fNWarmUpEntries;
+
+   bool WarmUp(unsigned int slot, Long64_t entry);
+   void Optimize(unsigned int slot);
+
+public:
+   RFilterChain(RNodeBase *upstream, const std::vector<RFilterBase *> &filters, unsigned int nSlots,
+                ULong64_t nWarmUpEntries);
+
+   /// Return whether the entry passes the upstream filters and all filters of the chain.
+   bool CheckFilters(unsigned int slot, Long64_t entry);
+   /// The last filter of the chain, whose CheckFilters is replaced by the one of this object.
+   RFilterBase *GetLast() const { return fFilters.back(); }
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -18,6 +18,7 @@
 #include "ROOT/RDF/InterfaceUtils.hxx"
 #include "ROOT/RDF/RBookedDefines.hxx"
 #include "ROOT/RDF/RDefine.hxx"
+#include "ROOT/RDF/RDefineBatch.hxx"
 #include "ROOT/RDF/RDefinePerSample.hxx"
 #include "ROOT/RDF/RFilter.hxx"
 #include "ROOT/RDF/RLazyDSImpl.hxx"
@@ -71,6 +72,14 @@ namespace cling {
 std::string printValue(ROOT::RDataFrame *tdf);
 }
 
+#ifdef R__HAS_ROOT7
+namespace ROOT {
+namespace Experimental {
+RDataFrame MakeNTupleDataFrame(std::string_view ntupleName, std::string_view fileName);
+}
+} // namespace ROOT
+#endif
+
 namespace ROOT {
 namespace RDF {
 namespace RDFDetail = ROOT::Detail::RDF;
@@ -107,6 +116,7 @@ class RInterface {
    friend class RInterface;
 
    friend void RDFInternal::TriggerRun(RNode &node);
+   friend RLoopManager &RDFInternal::GetLoopManager(RNode &node);
 
    std::shared_ptr<Proxied> fProxiedPtr; ///< Smart pointer to the graph node encapsulated by this RInterface.
    ///< The RLoopManager at the root of this computation graph. Never null.
@@ -261,12 +271,11 @@ public:
       auto upcastNodeOnHeap = RDFInternal::MakeSharedOnHeap(RDFInternal::UpcastNode(fProxiedPtr));
       using BaseNodeType_t = typename std::remove_pointer_t<decltype(upcastNodeOnHeap)>::element_type;
       RInterface<BaseNodeType_t> upcastInterface(*upcastNodeOnHeap, *fLoopManager, fDefines, fDataSource);
-      const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(fLoopManager, name);
 
-      RDFInternal::BookFilterJit(jittedFilter, upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
-                                 fLoopManager->GetBranchNames(), fDefines, fLoopManager->GetTree(), fDataSource);
+      auto jittedFilter =
+         RDFInternal::BookFilterJit(upcastNodeOnHeap, name, expression, fLoopManager->GetAliasMap(),
+                                    fLoopManager->GetBranchNames(), fDefines, fLoopManager->GetTree(), fDataSource);
 
-      fLoopManager->Book(jittedFilter.get());
       return RInterface<RDFDetail::RJittedFilter, DS_t>(std::move(jittedFilter), *fLoopManager, fDefines, fDataSource);
    }
 
@@ -366,6 +375,67 @@ public:
    }
    // clang-format on
 
+   // clang-format off
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Define a new column, evaluating the expression over batches of entries.
+   /// \param[in] name The name of the defined column.
+   /// \param[in] expression Function, lambda expression, functor class or any other callable object producing the defined values for a batch of entries.
+   /// \param[in] columns Names of the columns/branches in input to the expression.
+   /// \return the first node of the computation graph for which the new quantity is defined.
+   ///
+   /// The expression must be a callable of signature RVec<R>(const RVec<T1> &, const RVec<T2> &, ...) where `T1, T2...`
+   /// are the types of the input columns and `R` is the type of the defined column. Each invocation receives the
+   /// values of the input columns for a batch of entries and must return one value per entry, in the same order.
+   /// This allows to compute the defined values with vectorized code, e.g. with the functions in ROOT::VecOps.
+   ///
+   /// Batches contain the entries of a bulk that pass all the preceding filters, see ROOT::RDF::EnableBulkProcessing.
+   /// When all entries of the bulk are selected, the input RVecs are views of the buffers of the input columns and no
+   /// copy takes place. If the event loop does not run in bulk mode, the expression is invoked with batches of one entry.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// ROOT::RDF::EnableBulkProcessing(df, 256);
+   /// auto pt = [](const RVec<float> &px, const RVec<float> &py) { return sqrt(px * px + py * py); };
+   /// df.DefineBatch("pt", pt, {"px", "py"});
+   /// ~~~
+   ///
+   /// See Define for more information.
+   template <typename F>
+   RInterface<Proxied, DS_t> DefineBatch(std::string_view name, F expression, const ColumnNames_t &columns = {})
+   {
+      constexpr auto where = "DefineBatch";
+      RDFInternal::CheckValidCppVarName(name, where);
+      RDFInternal::CheckForRedefinition(where, name, fDefines.GetNames(), fLoopManager->GetAliasMap(),
+                                        fLoopManager->GetBranchNames(),
+                                        fDataSource ? fDataSource->GetColumnNames() : ColumnNames_t{});
+
+      using ColTypes_t = RDFInternal::RVecValueTypes_t<typename TTraits::CallableTraits<F>::arg_types>;
+      using RetType_t = RDFInternal::RVecValueType_t<typename TTraits::CallableTraits<F>::ret_type>;
+      constexpr auto nColumns = ColTypes_t::list_size;
+
+      const auto validColumnNames = GetValidatedColumnNames(nColumns, columns);
+      CheckAndFillDSColumns(validColumnNames, ColTypes_t());
+
+      auto retTypeName = RDFInternal::TypeID2TypeName(typeid(RetType_t));
+      if (retTypeName.empty()) {
+         // The type is not known to the interpreter.
+         // We must not error out here, but if/when this column is used in jitted code
+         const auto demangledType = RDFInternal::DemangleTypeIdName(typeid(RetType_t));
+         retTypeName = "CLING_UNKNOWN_TYPE_" + demangledType;
+      }
+
+      auto newColumn = std::make_shared<RDFDetail::RDefineBatch<F>>(name, retTypeName, std::move(expression),
+                                                                    validColumnNames, fDefines, *fLoopManager);
+
+      RDFInternal::RBookedDefines newCols(fDefines);
+      newCols.AddColumn(newColumn, name);
+
+      RInterface<Proxied> newInterface(fProxiedPtr, *fLoopManager, std::move(newCols), fDataSource);
+
+      return newInterface;
+   }
+   // clang-format on
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Define a new column.
    /// \param[in] name The name of the defined column.
@@ -530,8 +600,8 @@ public:
          retTypeName = "CLING_UNKNOWN_TYPE_" + demangledType;
       }
 
-      auto newColumn = std::make_shared<RDFDetail::RDefinePerSample<F>>(name, retTypeName, std::move(expression),
-                                                                        fLoopManager->GetNSlots());
+      auto newColumn =
+         std::make_shared<RDFDetail::RDefinePerSample<F>>(name, retTypeName, std::move(expression), *fLoopManager);
 
       auto updateDefinePerSample = [newColumn](unsigned int slot, const ROOT::RDF::RSampleInfo &id) {
          newColumn->Update(slot, id);
@@ -697,6 +767,20 @@ public:
    /// opts.fLazy = true;
    /// df.Snapshot("outputTree", "outputFile.root", {"x"}, opts);
    /// ~~~
+   ///
+   /// ### Writing an RNTuple
+   ///
+   /// If ROOT is built with root7, Snapshot can write an RNTuple instead of a TTree, with one field per column, of the
+   /// type of the column (including RVecs and nested collections):
+   /// ~~~{.cpp}
+   /// RSnapshotOptions opts;
+   /// opts.fOutputFormat = ROOT::RDF::ESnapshotOutputFormat::kRNTuple;
+   /// df.Snapshot("outputNTuple", "outputFile.root", {"x", "jets_pt"}, opts);
+   /// ~~~
+   /// Each processing slot writes its entries as separate clusters of `fAutoFlush` entries (100000 by default), so
+   /// in multi-thread runs the clusters are written in an undefined order. Writing to a sub-directory and
+   /// multi-process event loops are not supported. The returned RDataFrame reads the output RNTuple: with lazy
+   /// Snapshots, it can be used only after the event loop ran.
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>>
    Snapshot(std::string_view treename, std::string_view filename, const ColumnNames_t &columnList,
@@ -734,7 +818,7 @@ public:
          std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
 
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      auto newRDF = MakeSnapshotOutputRDF(fullTreeName, filename, validCols, *snapHelperArgs);
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, RDFDetail::RInferredType>(
          validCols, newRDF, snapHelperArgs, validCols.size());
@@ -928,6 +1012,62 @@ public:
       return Cache(selectedColumns);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Save selected columns to a file on disk, or read them back if a previous run already saved them.
+   /// \param[in] columnList columns to be cached.
+   /// \param[in] cacheDir directory where cache files are stored. It is created if it does not exist.
+   /// \param[in] key a user-defined string that is part of the identity of the cached dataset (see below).
+   /// \return a `RDataFrame` that reads the cached dataset from disk.
+   ///
+   /// Like Cache(), this method returns a new `RDataFrame` object, completely detached from the originating
+   /// `RDataFrame`, that only contains the cached columns. Instead of being kept in memory, the cached columns are
+   /// written to a ROOT file in `cacheDir` that survives the end of the process. The name of the file is derived from
+   /// a hash of:
+   /// - the computation graph upstream of this node: names and expressions of the Filters, names, types and
+   ///   expressions of the Defines, parameters of the Ranges, aliases
+   /// - the names and types of the cached columns
+   /// - the input dataset: names, sizes and modification times of the input files (for TTrees), the number of entries
+   ///   (for RDataFrames with no data source), or, for data sources, the columns and the identifier returned by
+   ///   RDataSource::GetDatasetIdentifier (e.g. names, sizes and modification times of the CSV or SQlite input files,
+   ///   and the SQL query)
+   /// - the user-provided `key`
+   ///
+   /// If a cache file with that name already exists, no event loop is run: the returned `RDataFrame` directly reads
+   /// the cached columns. Otherwise the columns are written out with Snapshot first (which runs the event loop).
+   /// Modifying an input file therefore invalidates the cache automatically.
+   ///
+   /// \note The code of C++ callables passed to Filter and Define cannot be part of the hash, nor can the code of the
+   /// functions called by jitted expressions. If the computation graph contains Filters or Defines that evaluate C++
+   /// callables, an exception is thrown unless `key` is not empty: change `key` whenever their code changes (or clean
+   /// up `cacheDir`) to avoid reading stale results. The same applies to data sources that cannot identify their
+   /// dataset (e.g. in-memory datasets such as the ones of RArrowDS): an exception is thrown unless `key` is not
+   /// empty, and `key` must change whenever the dataset changes. Cache files are never removed automatically.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// // the first run of this program writes the selected entries to disk, later runs read them back
+   /// auto cached = df.Filter("pt > 20", "ptCut").Define("pt2", "pt * pt").PersistentCache({"pt", "pt2"}, "rdfcache");
+   /// ~~~
+   RInterface<RLoopManager>
+   PersistentCache(const ColumnNames_t &columnList, std::string_view cacheDir, std::string_view key = "")
+   {
+      if (columnList.empty())
+         throw std::runtime_error("PersistentCache: the list of columns to be cached is empty.");
+
+      const auto columnListWithoutSizeColumns = RDFInternal::FilterArraySizeColNames(columnList, "PersistentCache");
+      const auto validColumnNames =
+         GetValidatedColumnNames(columnListWithoutSizeColumns.size(), columnListWithoutSizeColumns);
+      const auto colTypes = GetValidatedArgTypes(validColumnNames, fDefines, fLoopManager->GetTree(), fDataSource,
+                                                 "PersistentCache", /*vector2rvec=*/false);
+
+      auto writeCache = [&](const std::string &treeName, const std::string &fileName) {
+         Snapshot(treeName, fileName, columnListWithoutSizeColumns);
+      };
+      auto lm = RDFInternal::GetOrMakePersistentCache(fProxiedPtr.get(), fDefines, *fLoopManager,
+                                                      columnListWithoutSizeColumns, colTypes, cacheDir, key, writeCache);
+      return RInterface<RLoopManager>(std::move(lm));
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Creates a node that filters entries based on range: [begin, end).
@@ -937,7 +1077,9 @@ public:
    /// \return the first node of the computation graph for which the event loop is limited to a certain range of entries.
    ///
    /// Note that in case of previous Ranges and Filters the selected range refers to the transformed dataset.
-   /// Ranges are only available if EnableImplicitMT has _not_ been called. Multi-thread ranges are not supported.
+   /// In multi-thread event loops, Ranges applied directly to the RDataFrame select entries based on their global entry
+   /// number and are evaluated in parallel. If a Range has Filters or other Ranges upstream, the entries it selects
+   /// depend on the order in which entries are processed: in that case the event loop runs on a single thread.
    ///
    /// ### Example usage:
    /// ~~~{.cpp}
@@ -951,7 +1093,6 @@ public:
       // check invariants
       if (stride == 0 || (end != 0 && end < begin))
          throw std::runtime_error("Range: stride must be strictly greater than 0 and end must be greater than begin.");
-      CheckIMTDisabled("Range");
 
       using Range_t = RDFDetail::RRange<Proxied>;
       auto rangePtr = std::make_shared<Range_t>(begin, end, stride, fProxiedPtr);
@@ -1289,6 +1430,81 @@ public:
       return Histo1D<V, W>({h_name.c_str(), h_title.c_str(), 128u, 0., 0.}, vName, wName);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Fill and return a one-dimensional histogram whose bins are chosen from the values of a column (*lazy action*).
+   /// \tparam V The type of the column used to fill the histogram.
+   /// \param[in] model The name, title and number of bins of the returned histogram. Axis limits are ignored.
+   /// \param[in] vName The name of the column that will fill the histogram.
+   /// \param[in] binning The strategy used to choose the bin edges.
+   /// \param[in] compression The compression parameter of the t-digest, see Quantiles().
+   /// \return the monodimensional histogram wrapped in a RResultPtr.
+   ///
+   /// Histo1D() without axis limits buffers the values to choose the axis range, and the buffers of the different
+   /// processing slots need to be merged at the end of the event loop. This action instead summarises the
+   /// distribution of the values with a t-digest of bounded size (see ROOT::Detail::RDF::RTDigest), chooses the bin
+   /// edges from it at the end of the event loop and fills the bins with the estimated number of entries in each
+   /// of them, in a single pass over the data and with bounded memory:
+   /// - with EAdaptiveBinning::kEqualPopulation, the histogram has `model.fNbinsX` bins with (approximately) the
+   ///   same number of entries, which is well suited to distributions with long tails;
+   /// - with EAdaptiveBinning::kFreedmanDiaconis, the histogram has bins of equal width 2 * IQR / cbrt(entries)
+   ///   between the minimum and the maximum value, at most `model.fNbinsX` of them.
+   ///
+   /// As bin contents are estimated from the digest, they are not integers in general. Columns can be of a container
+   /// type, in which case the histogram is filled with each one of the elements of the container. Merging the results
+   /// with ROOT::Detail::RDF::MergeValues chooses the bins again from the merged digests.
+   ///
+   /// This action is *lazy*: upon invocation of this method the calculation is
+   /// booked but not executed. Also see RResultPtr.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// // Deduce column type (this invocation needs jitting internally), 20 bins with the same number of entries
+   /// auto myHist1 = myDf.AdaptiveHisto1D({"histName", "histTitle", 20, 0., 0.}, "myColumn");
+   /// // Explicit column type, Freedman-Diaconis bins
+   /// auto myHist2 = myDf.AdaptiveHisto1D<float>({"histName", "histTitle", 1000, 0., 0.}, "myColumn",
+   ///                                            ROOT::RDF::EAdaptiveBinning::kFreedmanDiaconis);
+   /// ~~~
+   template <typename V = RDFDetail::RInferredType>
+   RResultPtr<::TH1D> AdaptiveHisto1D(const TH1DModel &model, std::string_view vName,
+                                      EAdaptiveBinning binning = EAdaptiveBinning::kEqualPopulation,
+                                      double compression = 100.)
+   {
+      if (model.fNbinsX <= 0)
+         throw std::runtime_error("AdaptiveHisto1D: the number of bins must be strictly positive.");
+      if (!(compression > 0.))
+         throw std::runtime_error("AdaptiveHisto1D: the compression must be strictly positive.");
+      const auto userColumns = ColumnNames_t({std::string(vName)});
+
+      std::shared_ptr<::TH1D> h(nullptr);
+      {
+         ROOT::Internal::RDF::RIgnoreErrorLevelRAII iel(kError);
+         h = model.GetHistogram();
+         h->SetDirectory(nullptr);
+      }
+      auto args = std::make_shared<RDFInternal::AdaptiveHistoHelperArgs>(
+         RDFInternal::AdaptiveHistoHelperArgs{h, binning, model.fNbinsX, compression});
+      return CreateAction<RDFInternal::ActionTags::AdaptiveHisto1D, V>(userColumns, h, args);
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Fill and return a one-dimensional histogram whose bins are chosen from the values of a column (*lazy action*).
+   /// \tparam V The type of the column used to fill the histogram.
+   /// \param[in] vName The name of the column that will fill the histogram.
+   /// \param[in] binning The strategy used to choose the bin edges.
+   /// \return the monodimensional histogram wrapped in a RResultPtr.
+   ///
+   /// This overload uses a default model histogram with 128 bins.
+   /// The "name" and "title" strings are built starting from the input column name.
+   /// See the description of the first AdaptiveHisto1D() overload for more details.
+   template <typename V = RDFDetail::RInferredType>
+   RResultPtr<::TH1D>
+   AdaptiveHisto1D(std::string_view vName, EAdaptiveBinning binning = EAdaptiveBinning::kEqualPopulation)
+   {
+      const auto h_name = std::string(vName);
+      const auto h_title = h_name + ";" + h_name + ";count";
+      return AdaptiveHisto1D<V>({h_name.c_str(), h_title.c_str(), 128u, 0., 0.}, vName, binning);
+   }
+
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Fill and return a one-dimensional histogram with the weighted values of a column (*lazy action*).
    /// \tparam V The type of the column used to fill the histogram.
@@ -1986,6 +2202,91 @@ public:
       return CreateAction<RDFInternal::ActionTags::StdDev, T>(userColumns, stdDeviationV, stdDeviationV);
    }
 
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the approximate number of distinct values of one or more columns (*lazy action*).
+   /// \tparam FirstColumn The type of the first column.
+   /// \tparam OtherColumns The types of the other columns.
+   /// \param[in] columns The names of the columns. Values of multiple columns are counted as one tuple.
+   /// \param[in] precision The number of registers of the sketch is 2^precision, between 2^4 and 2^18.
+   /// \return the estimated number of distinct values wrapped in a RResultPtr.
+   ///
+   /// The count is estimated with the HyperLogLog algorithm (see ROOT::Detail::RDF::RHyperLogLog): the memory used
+   /// by the action does not depend on the number of distinct values, but the result is only approximate, with a
+   /// relative standard error of about 1.04 / sqrt(2^precision), i.e. 1.6% for the default precision.
+   /// Column values must be arithmetic types, strings, collections thereof or types for which `std::hash` is
+   /// specialized.
+   ///
+   /// If the column types are not specified, RDataFrame will infer them from the data and just-in-time compile the
+   /// correct template specialization of this method.
+   ///
+   /// This action is *lazy*: upon invocation of this method the calculation is
+   /// booked but not executed. Also see RResultPtr.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// // Deduce column types (this invocation needs jitting internally)
+   /// auto nRuns = myDf.CountDistinct({"run"});
+   /// // Explicit column types, distinct (run, lumi) pairs
+   /// auto nLumis = myDf.CountDistinct<unsigned int, unsigned int>({"run", "lumi"});
+   /// ~~~
+   ///
+   template <typename FirstColumn = RDFDetail::RInferredType, typename... OtherColumns>
+   RResultPtr<ULong64_t> CountDistinct(const ColumnNames_t &columns, unsigned int precision = 12)
+   {
+      if (precision < 4u || precision > 18u)
+         throw std::runtime_error("CountDistinct: the precision must be between 4 and 18.");
+      auto countV = std::make_shared<ULong64_t>(0ull);
+      auto args = std::make_shared<RDFInternal::CountDistinctHelperArgs>(
+         RDFInternal::CountDistinctHelperArgs{countV, precision});
+      return CreateAction<RDFInternal::ActionTags::CountDistinct, FirstColumn, OtherColumns...>(columns, countV, args,
+                                                                                               columns.size());
+   }
+
+   ////////////////////////////////////////////////////////////////////////////
+   /// \brief Return the approximate quantiles of processed column values (*lazy action*).
+   /// \tparam T The type of the branch/column.
+   /// \param[in] columnName The name of the branch/column to be treated.
+   /// \param[in] probabilities The orders of the quantiles, between 0 and 1.
+   /// \param[in] compression The compression parameter of the t-digest, see below.
+   /// \return the quantiles, in the same order as the probabilities, wrapped in a RResultPtr.
+   ///
+   /// The quantiles are estimated with the t-digest algorithm (see ROOT::Detail::RDF::RTDigest), which summarises
+   /// the distribution with about `compression` centroids: the memory used by the action does not depend on the
+   /// number of processed values. Larger values of `compression` give more accurate results. Quantiles close to 0
+   /// and 1 are estimated more accurately than the median. NaN values are ignored. If no value is processed, all
+   /// quantiles are NaN.
+   ///
+   /// If T is not specified, RDataFrame will infer it from the data and just-in-time compile the correct
+   /// template specialization of this method.
+   ///
+   /// This action is *lazy*: upon invocation of this method the calculation is
+   /// booked but not executed. Also see RResultPtr.
+   ///
+   /// ### Example usage:
+   /// ~~~{.cpp}
+   /// // Deduce column type (this invocation needs jitting internally)
+   /// auto quartiles = myDf.Quantiles("values", {0.25, 0.5, 0.75});
+   /// // Explicit column type
+   /// auto tails = myDf.Quantiles<float>("values", {0.01, 0.99});
+   /// ~~~
+   ///
+   template <typename T = RDFDetail::RInferredType>
+   RResultPtr<std::vector<double>>
+   Quantiles(std::string_view columnName, const std::vector<double> &probabilities, double compression = 100.)
+   {
+      for (auto p : probabilities) {
+         if (!(p >= 0. && p <= 1.))
+            throw std::runtime_error("Quantiles: the probabilities must be between 0 and 1.");
+      }
+      if (!(compression > 0.))
+         throw std::runtime_error("Quantiles: the compression must be strictly positive.");
+      const auto userColumns = ColumnNames_t({std::string(columnName)});
+      auto quantilesV = std::make_shared<std::vector<double>>();
+      auto args = std::make_shared<RDFInternal::QuantilesHelperArgs>(
+         RDFInternal::QuantilesHelperArgs{quantilesV, probabilities, compression});
+      return CreateAction<RDFInternal::ActionTags::Quantiles, T>(userColumns, quantilesV, args);
+   }
+
    // clang-format off
    ////////////////////////////////////////////////////////////////////////////
    /// \brief Return the sum of processed column values (*lazy action*).
@@ -2540,6 +2841,10 @@ public:
    /// * Result_t &PartialUpdate(unsigned int slot): this method is optional, i.e. can be omitted. If present, it should
    ///   return the value of the partial result of this action for the given 'slot'. Different threads might call this
    ///   method concurrently, but will always pass different 'slot' numbers.
+   /// * bool IsDone(): this method is optional. If present, it should return true once the result of the action is
+   ///   final, e.g. after a given number of entries has been collected: the action then stops processing entries, and
+   ///   the event loop stops early when the results of all booked actions are final. Different threads might call
+   ///   this method concurrently.
    /// * std::shared_ptr<Result_t> GetResultPtr() const: return a shared_ptr to the result of this action (of type
    ///   Result_t). The RResultPtr returned by Book will point to this object. Note that this method can be called
    ///   before Initialize(), because the RResultPtr is constructed before the event loop is started.
@@ -2674,8 +2979,7 @@ private:
       using NewColEntry_t = RDFDetail::RDefine<decltype(entryColGen), RDFDetail::CustomColExtraArgs::SlotAndEntry>;
 
       auto entryColumn = std::make_shared<NewColEntry_t>(entryColName, entryColType, std::move(entryColGen),
-                                                         ColumnNames_t{}, fLoopManager->GetNSlots(), newCols,
-                                                         fLoopManager->GetDSValuePtrs(), fDataSource);
+                                                         ColumnNames_t{}, newCols, *fLoopManager);
       newCols.AddColumn(entryColumn, entryColName);
 
       // Slot number column
@@ -2685,8 +2989,7 @@ private:
       using NewColSlot_t = RDFDetail::RDefine<decltype(slotColGen), RDFDetail::CustomColExtraArgs::Slot>;
 
       auto slotColumn = std::make_shared<NewColSlot_t>(slotColName, slotColType, std::move(slotColGen), ColumnNames_t{},
-                                                       fLoopManager->GetNSlots(), newCols,
-                                                       fLoopManager->GetDSValuePtrs(), fDataSource);
+                                                       newCols, *fLoopManager);
       newCols.AddColumn(slotColumn, slotColName);
 
       fDefines = std::move(newCols);
@@ -2811,9 +3114,8 @@ private:
       }
 
       using NewCol_t = RDFDetail::RDefine<F, DefineType>;
-      auto newColumn =
-         std::make_shared<NewCol_t>(name, retTypeName, std::forward<F>(expression), validColumnNames,
-                                    fLoopManager->GetNSlots(), fDefines, fLoopManager->GetDSValuePtrs(), fDataSource);
+      auto newColumn = std::make_shared<NewCol_t>(name, retTypeName, std::forward<F>(expression), validColumnNames,
+                                                  fDefines, *fLoopManager);
 
       RDFInternal::RBookedDefines newCols(fDefines);
       newCols.AddColumn(newColumn, name);
@@ -2837,6 +3139,25 @@ private:
       return *this; // never reached
    }
 
+   /// Create the RDataFrame returned by Snapshot, which reads the output dataset.
+   std::shared_ptr<ROOT::RDataFrame> MakeSnapshotOutputRDF(std::string_view fullTreeName, std::string_view filename,
+                                                           const ColumnNames_t &validCols,
+                                                           RDFInternal::SnapshotHelperArgs &snapHelperArgs)
+   {
+      if (snapHelperArgs.fOptions.fOutputFormat != ROOT::RDF::ESnapshotOutputFormat::kRNTuple)
+         return std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+#ifdef R__HAS_ROOT7
+      // an RNTuple can only be opened once it is written: the placeholder is replaced at the end of the event loop
+      auto newRDF = std::make_shared<ROOT::RDataFrame>(0);
+      snapHelperArgs.fOnWritten = [newRDF, ntupleName = std::string(fullTreeName), fileName = std::string(filename)] {
+         *newRDF = ROOT::Experimental::MakeNTupleDataFrame(ntupleName, fileName);
+      };
+      return newRDF;
+#else
+      throw std::runtime_error("Snapshot: RNTuple output requires ROOT built with root7.");
+#endif
+   }
+
    template <typename... ColumnTypes>
    RResultPtr<RInterface<RLoopManager>> SnapshotImpl(std::string_view fullTreeName, std::string_view filename,
                                                      const ColumnNames_t &columnList, const RSnapshotOptions &options)
@@ -2856,7 +3177,7 @@ private:
          std::string(filename), std::string(dirname), std::string(treename), columnListWithoutSizeColumns, options});
 
       ::TDirectory::TContext ctxt;
-      auto newRDF = std::make_shared<ROOT::RDataFrame>(fullTreeName, filename, validCols);
+      auto newRDF = MakeSnapshotOutputRDF(fullTreeName, filename, validCols, *snapHelperArgs);
 
       auto resPtr = CreateAction<RDFInternal::ActionTags::Snapshot, ColumnTypes...>(validCols, newRDF, snapHelperArgs);
 
@@ -46,7 +46,12 @@ public:
 
    void SetAction(std::unique_ptr<RActionBase> a) { fConcreteAction = std::move(a); }
 
+   const ColumnNames_t &GetColumnNames() const final;
+   const RBookedDefines &GetDefines() const final;
+
    void Run(unsigned int slot, Long64_t entry) final;
+   void RunBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries) final;
+   bool SupportsBulk() const final;
    void Initialize() final;
    void InitSlot(TTreeReader *r, unsigned int slot) final;
    void TriggerChildrenCount() final;
@@ -55,11 +60,16 @@ public:
    void *PartialUpdate(unsigned int slot) final;
    bool HasRun() const final;
    void SetHasRun() final;
+   const RNodeProfile *GetProfile() const final;
 
    std::shared_ptr<GraphDrawing::GraphNode> GetGraph();
 
    // Helper for RMergeableValue
    std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> GetMergeableValue() const final;
+   bool HasPartialOutputs() const final;
+   void MergePartialOutputs(unsigned int nWorkers) final;
+   bool NeedsContiguousTasks() const final;
+   void SetFirstEntry(ULong64_t firstEntry) final;
 
    ROOT::RDF::SampleCallback_t GetSampleCallback() final;
 };
@@ -29,24 +29,32 @@ namespace RDF {
 /// RJittedDefine is a placeholder that is put in the collection of custom columns in place of a RDefine
 /// that will be just-in-time compiled. Jitted code will assign the concrete RDefine to this RJittedDefine
 /// before the event-loop starts.
+/// The concrete define might also be shared with another RJittedDefine that evaluates the same expression on the same
+/// input columns, see ROOT::RDF::EnableGraphOptimization.
 class RJittedDefine : public RDefineBase {
-   std::unique_ptr<RDefineBase> fConcreteDefine = nullptr;
+   std::shared_ptr<RDefineBase> fConcreteDefine = nullptr;
 
 public:
-   RJittedDefine(std::string_view name, std::string_view type, unsigned int nSlots,
-                       const std::map<std::string, std::vector<void *>> &DSValuePtrs)
-      : RDefineBase(name, type, nSlots, RDFInternal::RBookedDefines(), DSValuePtrs, nullptr, /* columnNames */ {})
+   RJittedDefine(std::string_view name, std::string_view type, RLoopManager &lm)
+      : RDefineBase(name, type, RDFInternal::RBookedDefines(), lm, /* columnNames */ {})
    {
    }
 
-   void SetDefine(std::unique_ptr<RDefineBase> c) { fConcreteDefine = std::move(c); }
+   void SetDefine(std::shared_ptr<RDefineBase> c) { fConcreteDefine = std::move(c); }
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
+   const ColumnNames_t &GetColumnNames() const final;
+   const RDFInternal::RBookedDefines &GetDefines() const final;
    void *GetValuePtr(unsigned int slot) final;
    const std::type_info &GetTypeId() const final;
    void Update(unsigned int slot, Long64_t entry) final;
    void Update(unsigned int slot, const ROOT::RDF::RSampleInfo &id) final;
    void FinaliseSlot(unsigned int slot) final;
+   bool SupportsBulk() const final;
+   void UpdateBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask) final;
+   void *GetBulkValuePtr(unsigned int slot) final;
+   void InitNode() final;
+   const ROOT::Internal::RDF::RNodeProfile *GetProfile() const final;
 };
 
 } // ns RDF
@@ -46,7 +46,11 @@ public:
    void SetFilter(std::unique_ptr<RFilterBase> f);
 
    void InitSlot(TTreeReader *r, unsigned int slot) final;
+   const ColumnNames_t &GetColumnNames() const final;
+   const RDFInternal::RBookedDefines &GetDefines() const final;
    bool CheckFilters(unsigned int slot, Long64_t entry) final;
+   const ROOT::RVecB &CheckFiltersBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries) final;
+   bool SupportsBulk() const final;
    void Report(ROOT::RDF::RCutFlowReport &) const final;
    void PartialReport(ROOT::RDF::RCutFlowReport &) const final;
    void FillReport(ROOT::RDF::RCutFlowReport &) const final;
@@ -58,6 +62,11 @@ public:
    void InitNode() final;
    void AddFilterName(std::vector<std::string> &filters) final;
    void FinaliseSlot(unsigned int slot) final;
+   RNodeBase *GetPrevNode() const final;
+   unsigned int GetNChildren() const final;
+   bool EvalFilter(unsigned int slot, Long64_t entry) final;
+   void SetFilterChain(ROOT::Internal::RDF::RFilterChain *chain) final;
+   const ROOT::Internal::RDF::RNodeProfile *GetProfile() const final;
    std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph();
 };
 
@@ -11,14 +11,23 @@
 #ifndef ROOT_RLOOPMANAGER
 #define ROOT_RLOOPMANAGER
 
+#include "ROOT/RDF/RFilterChain.hxx"
 #include "ROOT/RDF/RNodeBase.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 #include "ROOT/RDF/RNewSampleNotifier.hxx"
 #include "ROOT/RDF/RSampleInfo.hxx"
+#include "ROOT/RVec.hxx"
 
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility> // std::pair
 #include <vector>
 
 // forward declarations
@@ -37,6 +46,7 @@ namespace RDF {
 std::vector<std::string> GetBranchNames(TTree &t, bool allowDuplicates = true);
 
 class RActionBase;
+class RBulkColumnReaderBase;
 class GraphNode;
 
 namespace GraphDrawing {
@@ -46,9 +56,15 @@ class GraphCreatorHelper;
 using Callback_t = std::function<void(unsigned int)>;
 
 class RCallback {
+   using Clock_t = std::chrono::steady_clock;
+
    const Callback_t fFun;
    const ULong64_t fEveryN;
+   /// If non-zero, the callback is called when this much time passed since the previous call (or since the slot
+   /// processed its first entry) rather than every fEveryN entries.
+   const Clock_t::duration fPeriod{Clock_t::duration::zero()};
    std::vector<ULong64_t> fCounters;
+   std::vector<Clock_t::time_point> fLastCalls;
 
 public:
    RCallback(ULong64_t everyN, Callback_t &&f, unsigned int nSlots)
@@ -56,8 +72,24 @@ public:
    {
    }
 
+   RCallback(Clock_t::duration period, Callback_t &&f, unsigned int nSlots)
+      : fFun(std::move(f)), fEveryN(0ull), fPeriod(period), fCounters(nSlots, 0ull), fLastCalls(nSlots)
+   {
+   }
+
    void operator()(unsigned int slot)
    {
+      if (fPeriod != Clock_t::duration::zero()) {
+         const auto now = Clock_t::now();
+         auto &lastCall = fLastCalls[slot];
+         if (lastCall == Clock_t::time_point()) {
+            lastCall = now;
+         } else if (now - lastCall >= fPeriod) {
+            lastCall = now;
+            fFun(slot);
+         }
+         return;
+      }
       auto &c = fCounters[slot];
       ++c;
       if (c == fEveryN) {
@@ -91,6 +123,9 @@ namespace RDF {
 namespace RDFInternal = ROOT::Internal::RDF;
 
 class RFilterBase;
+class RJittedDefine;
+class RJittedFilter;
+class RMergeableValueBase;
 class RRangeBase;
 using ROOT::RDF::RDataSource;
 
@@ -133,6 +168,60 @@ class RLoopManager : public RNodeBase {
    /// Cache of the tree/chain branch names. Never access directy, always use GetBranchNames().
    ColumnNames_t fValidBranchNames;
 
+   /// Names of the columns of the dataset that the booked nodes of the computation graph read, directly or via
+   /// Defines. Rebuilt before each event loop, see UpdateDataSetColumns. The corresponding branches are registered with
+   /// the TTreeCache before any entry is read, instead of being discovered by its learning phase.
+   std::set<std::string> fDataSetColumns;
+   /// The names of the branches registered with the TTreeCache by the current event loop, see SetupTreeCache.
+   ColumnNames_t fCacheBranchNames;
+   /// Per-slot names of the branches that were read outside of the TTreeCache during the current event loop.
+   std::vector<std::set<std::string>> fUncachedBranches;
+
+   /// Number of entries processed at a time in bulk mode, as requested by the user. 1 means no bulk processing.
+   unsigned int fBulkSize{1u};
+   /// Whether the current event loop runs in bulk mode. Decided at the beginning of each event loop.
+   bool fUseBulk{false};
+   /// Per-slot column readers that buffer the values of the entries of the current bulk.
+   std::vector<std::vector<RDFInternal::RBulkColumnReaderBase *>> fBulkReaders;
+   /// Per-slot entry numbers of the current bulk.
+   std::vector<ROOT::RVec<Long64_t>> fBulkEntries;
+   /// Per-slot masks of the current bulk: false for entries that must be skipped (e.g. rejected by a RDataSource).
+   std::vector<ROOT::RVecB> fBulkMasks;
+
+   /// Number of booked actions whose result is final, see RActionBase::SetDone. The event loop stops as soon as the
+   /// results of all booked actions are final.
+   std::atomic<unsigned int> fNActionsDone{0u};
+
+   /// Global entries [first, second) that can be selected by the Range nodes in a multi-thread event loop in which all
+   /// active branches of the computation graph start with a Range. Other entries do not need to be processed.
+   std::pair<ULong64_t, ULong64_t> fGlobalEntryBounds{0ull, std::numeric_limits<ULong64_t>::max()};
+
+   /// Whether graph optimizations are enabled, see ROOT::RDF::EnableGraphOptimization.
+   bool fOptimizeGraph{false};
+   /// Number of entries per slot used to measure the cost and selectivity of chained Filters before reordering them.
+   /// 0 means that Filters are never reordered.
+   ULong64_t fNWarmUpEntries{0ull};
+   /// Jitted Filters and Defines booked while graph optimizations are enabled, keyed by expression and inputs.
+   std::unordered_map<std::string, std::weak_ptr<RJittedFilter>> fJittedFilters;
+   std::unordered_map<std::string, std::weak_ptr<RJittedDefine>> fJittedDefines;
+   /// Chains of Filters that are evaluated in optimized order in the current event loop.
+   std::vector<std::unique_ptr<RDFInternal::RFilterChain>> fFilterChains;
+
+   /// Number of worker processes of multi-process event loops, see ROOT::RDF::EnableMultiProcessing. 1 means that
+   /// event loops run in this process, 0 that the number of worker processes is the number of cores.
+   unsigned int fNWorkers{1u};
+   /// Entries [first, second) processed by the current event loop. Restricted to a share of the entries in the worker
+   /// processes of a multi-process event loop.
+   std::pair<ULong64_t, ULong64_t> fEntryRange{0ull, std::numeric_limits<ULong64_t>::max()};
+   /// File that stores the results of the previous event loops and the entries they processed, see
+   /// ROOT::RDF::EnableIncrementalProcessing. Empty if incremental processing is disabled.
+   std::string fIncrementalStateFileName;
+
+   bool fProfilingEnabled = false;
+   /// Collects runtime statistics of the nodes of the graph. Null until profiling is enabled for the first time, then
+   /// kept alive because nodes hold pointers to their profiles.
+   std::unique_ptr<RDFInternal::RProfiler> fProfiler;
+
    void CheckIndexedFriends();
    void RunEmptySourceMT();
    void RunEmptySource();
@@ -140,7 +229,20 @@ class RLoopManager : public RNodeBase {
    void RunTreeReader();
    void RunDataSourceMT();
    void RunDataSource();
+   void RunEventLoop();
+   bool CanRunMultiProcess() const;
+   void RunMultiProcess();
+   int RunWorker(unsigned int index, const std::pair<ULong64_t, ULong64_t> &range, const std::string &fileName);
+   std::vector<std::unique_ptr<RMergeableValueBase>> LoadIncrementalState();
+   void SaveIncrementalState(const std::vector<RDFInternal::RActionBase *> &actions,
+                             std::vector<std::unique_ptr<RMergeableValueBase>> &&storedResults, bool hasNewEntries);
    void RunAndCheckFilters(unsigned int slot, Long64_t entry);
+   void RunAndCheckFiltersBulk(unsigned int slot);
+   void PushBulkEntry(unsigned int slot, Long64_t entry, bool isValid = true);
+   void FlushBulk(unsigned int slot);
+   bool CanRunInBulk() const;
+   bool SetupRangesMT();
+   void SetupFilterChains();
    void InitNodeSlots(TTreeReader *r, unsigned int slot);
    void InitNodes();
    void CleanUpNodes();
@@ -149,6 +251,10 @@ class RLoopManager : public RNodeBase {
    void SetupSampleCallbacks(TTreeReader *r, unsigned int slot);
    void UpdateSampleInfo(unsigned int slot, const std::pair<ULong64_t, ULong64_t> &range);
    void UpdateSampleInfo(unsigned int slot, TTreeReader &r);
+   void SetupTreeCache(TTreeReader &r);
+   void CollectUncachedBranches(TTreeReader &r, unsigned int slot);
+   void UpdateDataSetColumns();
+   void WarnUncachedBranches();
 
 public:
    RLoopManager(TTree *tree, const ColumnNames_t &defaultBranches);
@@ -173,6 +279,7 @@ public:
    void Book(RRangeBase *rangePtr);
    void Deregister(RRangeBase *rangePtr);
    bool CheckFilters(unsigned int, Long64_t) final;
+   const ROOT::RVecB &CheckFiltersBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries) final;
    unsigned int GetNSlots() const { return fNSlots; }
    void Report(ROOT::RDF::RCutFlowReport &rep) const final;
    /// End of recursive chain of calls, does nothing
@@ -180,10 +287,17 @@ public:
    void SetTree(const std::shared_ptr<TTree> &tree) { fTree = tree; }
    void IncrChildrenCount() final { ++fNChildren; }
    void StopProcessing() final { ++fNStopsReceived; }
+   /// Signal that the result of one more booked action is final. Thread-safe.
+   void ActionDone() { ++fNActionsDone; }
+   /// Whether the results of all booked actions are final, in which case no more entries need to be processed.
+   bool AllActionsDone() const { return !fBookedActions.empty() && fNActionsDone == fBookedActions.size(); }
    void ToJitExec(const std::string &) const;
+   /// Schedule a call that builds a jitted node from code found in the jit cache, to be executed by Jit().
+   void ToCachedJitExec(std::function<void()> &&call) const;
    void AddColumnAlias(const std::string &alias, const std::string &colName) { fAliasColumnNameMap[alias] = colName; }
    const std::map<std::string, std::string> &GetAliasMap() const { return fAliasColumnNameMap; }
    void RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f);
+   void RegisterCallback(std::chrono::steady_clock::duration period, std::function<void(unsigned int)> &&f);
    unsigned int GetNRuns() const { return fNRuns; }
    bool HasDSValuePtrs(const std::string &col) const;
    const std::map<std::string, std::vector<void *>> &GetDSValuePtrs() const { return fDSValuePtrMap; }
@@ -204,8 +318,31 @@ public:
    std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> GetGraph();
 
    const ColumnNames_t &GetBranchNames();
+   /// Return the names of the columns of the dataset read by the last event loop (or the one that is running).
+   const std::set<std::string> &GetDataSetColumns() const { return fDataSetColumns; }
 
    void AddSampleCallback(ROOT::RDF::SampleCallback_t &&callback);
+
+   void SetBulkSize(unsigned int bulkSize);
+   /// Return the number of entries processed at a time by the current event loop, 1 if not running in bulk mode.
+   unsigned int GetBulkSize() const { return fUseBulk ? fBulkSize : 1u; }
+   void RegisterBulkReader(unsigned int slot, RDFInternal::RBulkColumnReaderBase *reader);
+
+   void SetGraphOptimization(ULong64_t nWarmUpEntries);
+   bool IsGraphOptimizationEnabled() const { return fOptimizeGraph; }
+   std::shared_ptr<RJittedFilter> GetEquivalentJittedFilter(const std::string &key);
+   void RegisterJittedFilter(const std::string &key, const std::shared_ptr<RJittedFilter> &filter);
+   std::shared_ptr<RJittedDefine> GetEquivalentJittedDefine(const std::string &key);
+   void RegisterJittedDefine(const std::string &key, const std::shared_ptr<RJittedDefine> &define);
+
+   void SetNWorkers(unsigned int nWorkers);
+   unsigned int GetNWorkers() const { return fNWorkers; }
+
+   void SetIncrementalStateFileName(const std::string &fileName);
+
+   void SetProfiling(bool enable);
+   RDFInternal::RNodeProfile *GetNodeProfile(const void *node, std::string_view kind, std::string_view name);
+   ROOT::RDF::RProfileReport GetProfileReport() const;
 };
 
 } // ns RDF
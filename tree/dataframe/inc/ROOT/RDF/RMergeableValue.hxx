@@ -20,18 +20,31 @@
 #include <memory>
 #include <stdexcept>
 #include <algorithm> // std::min, std::max
+#include <cmath>     // std::llround
+#include <string>
+#include <vector>
 
+#include "ROOT/RDF/HistoModels.hxx" // EAdaptiveBinning
+#include "ROOT/RDF/RCutFlowReport.hxx"
+#include "ROOT/RDF/RSketches.hxx"    // RMergeableAdaptiveHisto, RMergeableCountDistinct, RMergeableQuantiles
 #include "RtypesCore.h"
+#include "TH1.h"                     // RMergeableAdaptiveHisto
 #include "TList.h" // RMergeableFill::Merge
 
+class TDirectory;
+
 namespace ROOT {
 namespace Detail {
 namespace RDF {
 
 // Fwd declarations for RMergeableValue
+class RMergeableValueBase;
+
 template <typename T>
 class RMergeableValue;
 
+void MergeValues(RMergeableValueBase &OutputMergeable, const RMergeableValueBase &InputMergeable);
+
 template <typename T, typename... Ts>
 std::unique_ptr<RMergeableValue<T>> MergeValues(std::unique_ptr<RMergeableValue<T>> OutputMergeable,
                                                 std::unique_ptr<RMergeableValue<Ts>>... InputMergeables);
@@ -49,6 +62,15 @@ object along the call chain. This class is never used in the public API and has
 no meaning for the final user.
 */
 class RMergeableValueBase {
+   friend void MergeValues(RMergeableValueBase &OutputMergeable, const RMergeableValueBase &InputMergeable);
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Aggregate the information contained in another mergeable into
+   ///        this, checking at runtime that both hold the same type of result.
+   ///
+   /// Implemented by RMergeableValue, which calls its own `Merge` method.
+   virtual void MergeAny(const RMergeableValueBase &) = 0;
+
 public:
    virtual ~RMergeableValueBase() = default;
    /**
@@ -113,7 +135,9 @@ be needed according to the peculiarities of the result types. The following
 subclasses, their names hinting at the action operation of the result, are
 currently available:
 
+- RMergeableAdaptiveHisto
 - RMergeableCount
+- RMergeableCountDistinct
 - RMergeableFill, responsible for the following actions:
    - Graph
    - Histo{1,2,3}D
@@ -122,8 +146,26 @@ currently available:
 - RMergeableMax
 - RMergeableMean
 - RMergeableMin
+- RMergeableQuantiles
+- RMergeableReport
 - RMergeableStdDev
 - RMergeableSum
+- RMergeableTake
+
+Mergeables can be written to a ROOT file with WriteMergeableValue, or to a
+memory buffer with SerializeMergeableValue, e.g. to be sent over a socket. The
+`rdfmerge` command-line utility merges the mergeables stored in several ROOT
+files, e.g. the outputs of batch jobs that processed different chunks of the
+same dataset:
+~~~{.cpp}
+// in each job
+auto h = df.Histo1D("Branch_A");
+TFile f("partial_0.root", "RECREATE");
+ROOT::Detail::RDF::WriteMergeableValue(*GetMergeableValue(h), f, "h");
+~~~
+~~~
+$ rdfmerge merged.root partial_*.root
+~~~
 */
 template <typename T>
 class RMergeableValue : public RMergeableValueBase {
@@ -145,6 +187,14 @@ class RMergeableValue : public RMergeableValueBase {
    /// (namespaceROOT_1_1Detail_1_1RDF.html#af16fefbe2d120983123ddf8a1e137277).
    virtual void Merge(const RMergeableValue<T> &) = 0;
 
+   void MergeAny(const RMergeableValueBase &other) final
+   {
+      const auto *othercast = dynamic_cast<const RMergeableValue<T> *>(&other);
+      if (othercast == nullptr)
+         throw std::invalid_argument("Results from different actions cannot be merged together.");
+      Merge(*othercast);
+   }
+
 protected:
    T fValue;
 
@@ -166,6 +216,71 @@ public:
    const T &GetValue() const { return fValue; }
 };
 
+/**
+\class ROOT::Detail::RDF::RMergeableAdaptiveHisto
+\ingroup dataframe
+\brief Specialization of RMergeableValue for the ROOT::RDF::RInterface::AdaptiveHisto1D
+action.
+
+Histograms with adaptive binning cannot be merged bin by bin, as their bin
+edges depend on the values they were filled with. This subclass stores the
+t-digest the histogram was computed from, so that merging the digests gives
+the histogram of the union of the inputs, with bins chosen again.
+*/
+class RMergeableAdaptiveHisto final : public RMergeableValue<TH1D> {
+   RTDigest fSketch;                     ///< The digest used to compute the result.
+   ROOT::RDF::EAdaptiveBinning fBinning =
+      ROOT::RDF::EAdaptiveBinning::kEqualPopulation; ///< The strategy used to choose the bin edges.
+   int fNBins = 0;                                   ///< The number of bins, or the maximum number of bins.
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Aggregate the information contained in another RMergeableValue
+   ///        into this.
+   /// \param[in] other Another RMergeableValue object.
+   /// \throws std::invalid_argument If the cast of the other object to the same
+   ///         type as this one fails.
+   ///
+   /// The other RMergeableValue object is cast to the same type as this object.
+   /// This is needed to make sure that only results of the same type of action
+   /// are merged together. Then the two digests are merged and the histogram
+   /// held by the current object is binned and filled again from the merged
+   /// digest.
+   ///
+   /// \note All the `Merge` methods in the RMergeableValue family are private.
+   /// To merge multiple RMergeableValue objects please use [MergeValues]
+   /// (namespaceROOT_1_1Detail_1_1RDF.html#af16fefbe2d120983123ddf8a1e137277).
+   void Merge(const RMergeableValue<TH1D> &other) final
+   {
+      try {
+         const auto &othercast = dynamic_cast<const RMergeableAdaptiveHisto &>(other);
+         fSketch.Merge(othercast.fSketch);
+         ROOT::Internal::RDF::FillAdaptiveHisto(this->fValue, fSketch, fBinning, fNBins);
+      } catch (const std::bad_cast &) {
+         throw std::invalid_argument("Results from different actions cannot be merged together.");
+      }
+   }
+
+public:
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Constructor that initializes data members.
+   /// \param[in] value The action result.
+   /// \param[in] sketch The digest used to compute that result.
+   /// \param[in] binning The strategy used to choose the bin edges.
+   /// \param[in] nBins The number of bins, or the maximum number of bins.
+   RMergeableAdaptiveHisto(const TH1D &value, const RTDigest &sketch, ROOT::RDF::EAdaptiveBinning binning, int nBins)
+      : RMergeableValue<TH1D>(value), fSketch{sketch}, fBinning{binning}, fNBins{nBins}
+   {
+   }
+   /**
+      Default constructor. Needed to allow serialization of ROOT objects. See
+      [TBufferFile::WriteObjectClass]
+      (classTBufferFile.html#a209078a4cb58373b627390790bf0c9c1)
+   */
+   RMergeableAdaptiveHisto() = default;
+   RMergeableAdaptiveHisto(RMergeableAdaptiveHisto &&) = default;
+   RMergeableAdaptiveHisto(const RMergeableAdaptiveHisto &) = delete;
+};
+
 /**
 \class ROOT::Detail::RDF::RMergeableCount
 \ingroup dataframe
@@ -214,6 +329,66 @@ public:
    RMergeableCount(const RMergeableCount &) = delete;
 };
 
+/**
+\class ROOT::Detail::RDF::RMergeableCountDistinct
+\ingroup dataframe
+\brief Specialization of RMergeableValue for the ROOT::RDF::RInterface::CountDistinct
+action.
+
+Distinct counts cannot be added together, as the same value might appear in
+both partial results. This subclass stores the HyperLogLog sketch the estimate
+was computed from, so that merging the sketches gives the estimated number of
+distinct values in the union of the inputs.
+*/
+class RMergeableCountDistinct final : public RMergeableValue<ULong64_t> {
+   RHyperLogLog fSketch; ///< The sketch used to compute the result.
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Aggregate the information contained in another RMergeableValue
+   ///        into this.
+   /// \param[in] other Another RMergeableValue object.
+   /// \throws std::invalid_argument If the cast of the other object to the same
+   ///         type as this one fails, or if the two sketches have a different
+   ///         precision.
+   ///
+   /// The other RMergeableValue object is cast to the same type as this object.
+   /// This is needed to make sure that only results of the same type of action
+   /// are merged together. Then the two sketches are merged and the value held
+   /// by the current object is estimated again from the merged sketch.
+   ///
+   /// \note All the `Merge` methods in the RMergeableValue family are private.
+   /// To merge multiple RMergeableValue objects please use [MergeValues]
+   /// (namespaceROOT_1_1Detail_1_1RDF.html#af16fefbe2d120983123ddf8a1e137277).
+   void Merge(const RMergeableValue<ULong64_t> &other) final
+   {
+      try {
+         const auto &othercast = dynamic_cast<const RMergeableCountDistinct &>(other);
+         fSketch.Merge(othercast.fSketch);
+         this->fValue = std::llround(fSketch.Estimate());
+      } catch (const std::bad_cast &) {
+         throw std::invalid_argument("Results from different actions cannot be merged together.");
+      }
+   }
+
+public:
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Constructor that initializes data members.
+   /// \param[in] value The action result.
+   /// \param[in] sketch The sketch used to compute that result.
+   RMergeableCountDistinct(ULong64_t value, const RHyperLogLog &sketch)
+      : RMergeableValue<ULong64_t>(value), fSketch{sketch}
+   {
+   }
+   /**
+      Default constructor. Needed to allow serialization of ROOT objects. See
+      [TBufferFile::WriteObjectClass]
+      (classTBufferFile.html#a209078a4cb58373b627390790bf0c9c1)
+   */
+   RMergeableCountDistinct() = default;
+   RMergeableCountDistinct(RMergeableCountDistinct &&) = default;
+   RMergeableCountDistinct(const RMergeableCountDistinct &) = delete;
+};
+
 /**
 \class ROOT::Detail::RDF::RMergeableFill
 \ingroup dataframe
@@ -412,6 +587,121 @@ public:
    RMergeableMin(const RMergeableMin &) = delete;
 };
 
+/**
+\class ROOT::Detail::RDF::RMergeableQuantiles
+\ingroup dataframe
+\brief Specialization of RMergeableValue for the ROOT::RDF::RInterface::Quantiles
+action.
+
+This class also stores the t-digest the quantiles were computed from and the
+probabilities they correspond to, so that merging the digests gives the
+estimated quantiles of the union of the inputs.
+*/
+class RMergeableQuantiles final : public RMergeableValue<std::vector<double>> {
+   RTDigest fSketch;                   ///< The digest used to compute the result.
+   std::vector<double> fProbabilities; ///< The probabilities of the quantiles in the result.
+
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Aggregate the information contained in another RMergeableValue
+   ///        into this.
+   /// \param[in] other Another RMergeableValue object.
+   /// \throws std::invalid_argument If the cast of the other object to the same
+   ///         type as this one fails, or if the two results refer to different
+   ///         probabilities.
+   ///
+   /// The other RMergeableValue object is cast to the same type as this object.
+   /// This is needed to make sure that only results of the same type of action
+   /// are merged together. Then the two digests are merged and the quantiles
+   /// held by the current object are estimated again from the merged digest.
+   ///
+   /// \note All the `Merge` methods in the RMergeableValue family are private.
+   /// To merge multiple RMergeableValue objects please use [MergeValues]
+   /// (namespaceROOT_1_1Detail_1_1RDF.html#af16fefbe2d120983123ddf8a1e137277).
+   void Merge(const RMergeableValue<std::vector<double>> &other) final
+   {
+      try {
+         const auto &othercast = dynamic_cast<const RMergeableQuantiles &>(other);
+         if (othercast.fProbabilities != fProbabilities)
+            throw std::invalid_argument("Quantiles computed for different probabilities cannot be merged together.");
+         fSketch.Merge(othercast.fSketch);
+         for (std::size_t i = 0u; i < fProbabilities.size(); ++i)
+            this->fValue[i] = fSketch.Quantile(fProbabilities[i]);
+      } catch (const std::bad_cast &) {
+         throw std::invalid_argument("Results from different actions cannot be merged together.");
+      }
+   }
+
+public:
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Constructor that initializes data members.
+   /// \param[in] value The action result.
+   /// \param[in] sketch The digest used to compute that result.
+   /// \param[in] probabilities The probabilities of the quantiles in the result.
+   RMergeableQuantiles(const std::vector<double> &value, const RTDigest &sketch,
+                       const std::vector<double> &probabilities)
+      : RMergeableValue<std::vector<double>>(value), fSketch{sketch}, fProbabilities{probabilities}
+   {
+   }
+   /**
+      Default constructor. Needed to allow serialization of ROOT objects. See
+      [TBufferFile::WriteObjectClass]
+      (classTBufferFile.html#a209078a4cb58373b627390790bf0c9c1)
+   */
+   RMergeableQuantiles() = default;
+   RMergeableQuantiles(RMergeableQuantiles &&) = default;
+   RMergeableQuantiles(const RMergeableQuantiles &) = delete;
+};
+
+/**
+\class ROOT::Detail::RDF::RMergeableReport
+\ingroup dataframe
+\brief Specialization of RMergeableValue for the
+[Report](classROOT_1_1RDF_1_1RInterface.html#a94f322531dcb25beb8f53a602e5d6332)
+action.
+
+The numbers of entries that were processed and that passed each named filter
+are added together. Only reports of the same cut flow can be merged.
+*/
+class RMergeableReport final : public RMergeableValue<ROOT::RDF::RCutFlowReport> {
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Aggregate the information contained in another RMergeableValue
+   ///        into this.
+   /// \param[in] other Another RMergeableValue object.
+   /// \throws std::invalid_argument If the cast of the other object to the same
+   ///         type as this one fails, or if the two reports list different cuts.
+   ///
+   /// The other RMergeableValue object is cast to the same type as this object.
+   /// This is needed to make sure that only results of the same type of action
+   /// are merged together. Then the statistics of each cut are added together.
+   ///
+   /// \note All the `Merge` methods in the RMergeableValue family are private.
+   /// To merge multiple RMergeableValue objects please use [MergeValues]
+   /// (namespaceROOT_1_1Detail_1_1RDF.html#af16fefbe2d120983123ddf8a1e137277).
+   void Merge(const RMergeableValue<ROOT::RDF::RCutFlowReport> &other) final
+   {
+      try {
+         const auto &othercast = dynamic_cast<const RMergeableReport &>(other);
+         this->fValue.Merge(othercast.fValue);
+      } catch (const std::bad_cast &) {
+         throw std::invalid_argument("Results from different actions cannot be merged together.");
+      }
+   }
+
+public:
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Constructor that initializes data members.
+   /// \param[in] value The action result.
+   RMergeableReport(const ROOT::RDF::RCutFlowReport &value) : RMergeableValue<ROOT::RDF::RCutFlowReport>(value) {}
+   /**
+      Default constructor. Needed to allow serialization of ROOT objects. See
+      [TBufferFile::WriteObjectClass]
+      (classTBufferFile.html#a209078a4cb58373b627390790bf0c9c1)
+   */
+   RMergeableReport() = default;
+   RMergeableReport(RMergeableReport &&) = default;
+   RMergeableReport(const RMergeableReport &) = delete;
+};
+
 /**
 \class ROOT::Detail::RDF::RMergeableStdDev
 \ingroup dataframe
@@ -523,6 +813,59 @@ public:
    RMergeableSum(const RMergeableSum &) = delete;
 };
 
+/**
+\class ROOT::Detail::RDF::RMergeableTake
+\ingroup dataframe
+\brief Specialization of RMergeableValue for the
+[Take](classROOT_1_1RDF_1_1RInterface.html#a4fd694773a2931b6b07afa0e1c2c7e44)
+action.
+\tparam COLL Type of the collection returned by Take.
+
+The collections are concatenated, in the order in which the mergeables are
+merged.
+*/
+template <typename COLL>
+class RMergeableTake final : public RMergeableValue<COLL> {
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Aggregate the information contained in another RMergeableValue
+   ///        into this.
+   /// \param[in] other Another RMergeableValue object.
+   /// \throws std::invalid_argument If the cast of the other object to the same
+   ///         type as this one fails.
+   ///
+   /// The other RMergeableValue object is cast to the same type as this object.
+   /// This is needed to make sure that only results of the same type of action
+   /// are merged together. Then the elements of the other collection are
+   /// appended to the collection held by the current object.
+   ///
+   /// \note All the `Merge` methods in the RMergeableValue family are private.
+   /// To merge multiple RMergeableValue objects please use [MergeValues]
+   /// (namespaceROOT_1_1Detail_1_1RDF.html#af16fefbe2d120983123ddf8a1e137277).
+   void Merge(const RMergeableValue<COLL> &other) final
+   {
+      try {
+         const auto &othercast = dynamic_cast<const RMergeableTake<COLL> &>(other);
+         this->fValue.insert(this->fValue.end(), othercast.fValue.begin(), othercast.fValue.end());
+      } catch (const std::bad_cast &) {
+         throw std::invalid_argument("Results from different actions cannot be merged together.");
+      }
+   }
+
+public:
+   /////////////////////////////////////////////////////////////////////////////
+   /// \brief Constructor that initializes data members.
+   /// \param[in] value The action result.
+   RMergeableTake(const COLL &value) : RMergeableValue<COLL>(value) {}
+   /**
+      Default constructor. Needed to allow serialization of ROOT objects. See
+      [TBufferFile::WriteObjectClass]
+      (classTBufferFile.html#a209078a4cb58373b627390790bf0c9c1)
+   */
+   RMergeableTake() = default;
+   RMergeableTake(RMergeableTake &&) = default;
+   RMergeableTake(const RMergeableTake &) = delete;
+};
+
 /// \cond HIDDEN_SYMBOLS
 // What follows mimics C++17 std::conjunction without using recursive template instantiations.
 // Used in `MergeValues` to check that all the mergeables hold values of the same type.
@@ -600,6 +943,90 @@ void MergeValues(RMergeableValue<T> &OutputMergeable, const RMergeableValue<Ts>
    // Cast to void to suppress unused-value warning in Clang
    (void)expander{0, (OutputMergeable.Merge(InputMergeables), 0)...};
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Merge a RMergeableValue object into another, when their types are
+///        only known at runtime.
+/// \param[in,out] OutputMergeable The mergeable object where the information
+///                will be aggregated.
+/// \param[in] InputMergeable Another mergeable containing a partial result.
+/// \throws std::invalid_argument If the two mergeables hold results of
+///         different actions.
+///
+/// This overload is meant for mergeables that were read back with
+/// ReadMergeableValue or DeserializeMergeableValue.
+inline void MergeValues(RMergeableValueBase &OutputMergeable, const RMergeableValueBase &InputMergeable)
+{
+   OutputMergeable.MergeAny(InputMergeable);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Serialize a RMergeableValue object into a memory buffer.
+/// \param[in] value The mergeable object.
+/// \returns The buffer, which can be read back with DeserializeMergeableValue.
+/// \throws std::runtime_error If no dictionary is available for the type of
+///         the mergeable.
+///
+/// The buffer starts with a header that records the version of the buffer
+/// format and the name and checksum of the class of the mergeable, followed by
+/// the object streamed with TBufferFile. It can be read by processes that use
+/// the same layout of the mergeable classes, e.g. other processes of the same
+/// ROOT installation. Use WriteMergeableValue to store mergeables for the longer
+/// term: ROOT files also record the layout of the classes they contain.
+std::vector<char> SerializeMergeableValue(const RMergeableValueBase &value);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Read a RMergeableValue object from a buffer filled by
+///        SerializeMergeableValue.
+/// \param[in] buffer The start of the buffer.
+/// \param[in] size The size of the buffer in bytes.
+/// \throws std::runtime_error If the buffer was not produced by
+///         SerializeMergeableValue, or if the class of the mergeable is unknown
+///         or has a different layout in this process.
+///
+/// The result can be merged with MergeValues, or cast to the type of the
+/// mergeable to retrieve its value:
+/// ~~~{.cpp}
+/// auto m = ROOT::Detail::RDF::DeserializeMergeableValue(buffer.data(), buffer.size());
+/// const auto &h = dynamic_cast<ROOT::Detail::RDF::RMergeableValue<TH1D> &>(*m).GetValue();
+/// ~~~
+std::unique_ptr<RMergeableValueBase> DeserializeMergeableValue(const char *buffer, std::size_t size);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Write a RMergeableValue object to a ROOT file or directory.
+/// \param[in] value The mergeable object.
+/// \param[in] dir The directory the mergeable is written to.
+/// \param[in] name The name of the key of the mergeable in the directory.
+/// \throws std::runtime_error If the mergeable could not be written.
+///
+/// The mergeable is written with its actual type, so that it can be read back
+/// with ReadMergeableValue and merged with the `rdfmerge` utility.
+void WriteMergeableValue(const RMergeableValueBase &value, TDirectory &dir, const std::string &name);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Read a RMergeableValue object written with WriteMergeableValue.
+/// \param[in] dir The directory the mergeable was written to.
+/// \param[in] name The name of the key of the mergeable in the directory.
+/// \throws std::runtime_error If no mergeable with that name could be read.
+std::unique_ptr<RMergeableValueBase> ReadMergeableValue(TDirectory &dir, const std::string &name);
+
+////////////////////////////////////////////////////////////////////////////////
+/// \brief Merge the RMergeableValue objects stored in several ROOT files.
+/// \param[in] outputFileName The file the merged mergeables are written to. It
+///            is overwritten if it exists.
+/// \param[in] inputFileNames The files that contain the partial results.
+/// \throws std::runtime_error If an input file cannot be read, or if an output
+///         cannot be written.
+/// \throws std::invalid_argument If mergeables with the same name hold results
+///         of different actions.
+///
+/// Mergeables stored with the same name in the top-level directories of the
+/// input files are merged together, in the order of the input files, and the
+/// result is written with that name to the output file. Other objects in the
+/// input files are ignored. This is the function behind the `rdfmerge`
+/// utility.
+void MergeMergeableFiles(const std::string &outputFileName, const std::vector<std::string> &inputFileNames);
+
 } // namespace RDF
 } // namespace Detail
 } // namespace ROOT
@@ -12,6 +12,7 @@
 #define ROOT_RDFNODEBASE
 
 #include "RtypesCore.h"
+#include "ROOT/RVec.hxx"
 
 #include <memory>
 #include <string>
@@ -48,6 +49,8 @@ public:
    RNodeBase(RLoopManager *lm = nullptr) : fLoopManager(lm) {}
    virtual ~RNodeBase() {}
    virtual bool CheckFilters(unsigned int, Long64_t) = 0;
+   /// Bulk version of CheckFilters: return the selection mask for the bulk of entries that is being processed.
+   virtual const ROOT::RVecB &CheckFiltersBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries) = 0;
    virtual void Report(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void PartialReport(ROOT::RDF::RCutFlowReport &) const = 0;
    virtual void IncrChildrenCount() = 0;
@@ -0,0 +1,89 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RPROFILEREPORT
+#define ROOT_RPROFILEREPORT
+
+#include "RtypesCore.h"
+
+#include <string>
+#include <vector>
+
+namespace ROOT {
+
+namespace Internal {
+namespace RDF {
+class RNodeProfile;
+class RProfiler;
+} // namespace RDF
+} // namespace Internal
+
+namespace RDF {
+
+/// Runtime statistics of a node of the computation graph for one processing slot.
+struct RNodeSlotStats {
+   ULong64_t fNCalls = 0ull;  ///< Number of times the node was evaluated
+   double fTime = 0.;         ///< Wall-clock time spent evaluating the node, in seconds
+   double fReadTime = 0.;     ///< Part of fTime spent reading the input columns, in seconds
+   Long64_t fBytesRead = 0ll; ///< Bytes read from the input files while reading the input columns
+};
+
+/// Runtime statistics of a Filter, Define or action of the computation graph, see RProfileReport.
+class RNodeProfileInfo {
+   friend class ROOT::Internal::RDF::RNodeProfile;
+
+   std::string fKind;
+   std::string fName;
+   std::vector<RNodeSlotStats> fSlotStats;
+
+public:
+   /// The kind of node: "Filter", "Define" or "Action".
+   const std::string &GetKind() const { return fKind; }
+   /// The name of the filter, the name of the defined column or the name of the action. Empty for unnamed filters.
+   const std::string &GetName() const { return fName; }
+   /// The statistics of each processing slot.
+   const std::vector<RNodeSlotStats> &GetSlotStats() const { return fSlotStats; }
+   /// The statistics summed over all processing slots.
+   RNodeSlotStats GetTotal() const;
+};
+
+// clang-format off
+/**
+\class ROOT::RDF::RProfileReport
+\ingroup dataframe
+\brief Per-node runtime statistics of the last event loop of a RDataFrame, see ROOT::RDF::EnableProfiling.
+
+For each Filter, Define and action that was evaluated, the report contains the number of evaluations, the wall-clock
+time they took and the part of that time spent reading the input columns rather than in user code, together with the
+number of bytes read from the input files, for each processing slot. Reading a column that is itself a Define triggers
+the evaluation of that Define: its cost is therefore included in the read time of the node and also reported
+separately for the Define.
+*/
+// clang-format on
+class RProfileReport {
+   friend class ROOT::Internal::RDF::RProfiler;
+
+   std::vector<RNodeProfileInfo> fNodes;
+   double fEventLoopTime = 0.;
+
+public:
+   using const_iterator = std::vector<RNodeProfileInfo>::const_iterator;
+   const_iterator begin() const { return fNodes.begin(); }
+   const_iterator end() const { return fNodes.end(); }
+   std::size_t size() const { return fNodes.size(); }
+   /// Wall-clock time of the whole event loop, in seconds.
+   double GetEventLoopTime() const { return fEventLoopTime; }
+   void Print() const;
+   std::string AsJSON() const;
+   void SaveJSON(const std::string &fileName) const;
+};
+
+} // namespace RDF
+} // namespace ROOT
+
+#endif
@@ -0,0 +1,95 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RPROFILER
+#define ROOT_RDF_RPROFILER
+
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "ROOT/RDF/Utils.hxx" // CacheLineStep
+#include "ROOT/RStringView.hxx"
+#include "RtypesCore.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TTreeReader;
+
+namespace ROOT {
+namespace Internal {
+namespace RDF {
+
+class RProfiler;
+
+/// Runtime statistics of one node of the computation graph, collected per processing slot in profiling mode.
+class RNodeProfile {
+   friend class RProfiler;
+   using Clock_t = std::chrono::steady_clock;
+
+   RProfiler &fProfiler;
+   ROOT::RDF::RNodeProfileInfo fInfo;
+
+   ROOT::RDF::RNodeSlotStats &GetSlotStats(unsigned int slot)
+   {
+      return fInfo.fSlotStats[slot * CacheLineStep<ROOT::RDF::RNodeSlotStats>()];
+   }
+
+public:
+   /// Measure one evaluation of the node: time and bytes read are recorded when the object goes out of scope.
+   /// Call ReadDone once the input columns have been read, to separate the reading time from the time spent in user code.
+   class RScope {
+      RNodeProfile &fProfile;
+      const unsigned int fSlot;
+      const Clock_t::time_point fStart;
+      Clock_t::time_point fReadEnd;
+      const Long64_t fStartBytes;
+      Long64_t fReadEndBytes;
+
+   public:
+      RScope(RNodeProfile &profile, unsigned int slot);
+      RScope(const RScope &) = delete;
+      RScope &operator=(const RScope &) = delete;
+      ~RScope();
+      void ReadDone();
+   };
+
+   RNodeProfile(RProfiler &profiler, std::string_view kind, std::string_view name, unsigned int nSlots);
+   void Reset();
+   /// Return a short human-readable summary of the statistics, e.g. for graph drawing. Empty if the node never ran.
+   std::string GetSummary() const;
+   ROOT::RDF::RNodeProfileInfo GetInfo() const;
+};
+
+/// Collect the runtime statistics of the nodes of a computation graph, see ROOT::RDF::EnableProfiling.
+/// Statistics are reset at the beginning of each event loop.
+class RProfiler {
+   const unsigned int fNSlots;
+   /// Per-slot readers of the input TTree, used to count the bytes read. Null for other kinds of data sources.
+   std::vector<TTreeReader *> fTreeReaders;
+   /// Profiles of the nodes of the graph, in the order in which they have been registered.
+   std::vector<std::unique_ptr<RNodeProfile>> fProfiles;
+   std::unordered_map<const void *, RNodeProfile *> fProfilesByNode;
+   double fEventLoopTime = 0.;
+
+public:
+   RProfiler(unsigned int nSlots) : fNSlots(nSlots), fTreeReaders(nSlots, nullptr) {}
+   RNodeProfile *GetNodeProfile(const void *node, std::string_view kind, std::string_view name);
+   void SetTreeReader(unsigned int slot, TTreeReader *r) { fTreeReaders[slot] = r; }
+   Long64_t GetBytesRead(unsigned int slot) const;
+   void Reset();
+   void SetEventLoopTime(double seconds) { fEventLoopTime = seconds; }
+   ROOT::RDF::RProfileReport GetReport() const;
+};
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -40,7 +40,10 @@ class RRange final : public RRangeBase {
 public:
    RRange(unsigned int start, unsigned int stop, unsigned int stride, std::shared_ptr<PrevData> pd)
       : RRangeBase(pd->GetLoopManagerUnchecked(), start, stop, stride, pd->GetLoopManagerUnchecked()->GetNSlots()),
-        fPrevDataPtr(std::move(pd)), fPrevData(*fPrevDataPtr) {}
+        fPrevDataPtr(std::move(pd)), fPrevData(*fPrevDataPtr)
+   {
+      fIsGlobal = static_cast<RNodeBase *>(fPrevDataPtr.get()) == static_cast<RNodeBase *>(fLoopManager);
+   }
 
    RRange(const RRange &) = delete;
    RRange &operator=(const RRange &) = delete;
@@ -48,9 +51,16 @@ public:
    // otherwise if fPrevDataFrame is fLoopManager we get a use after delete
    ~RRange() { fLoopManager->Deregister(this); }
 
-   /// Ranges act as filters when it comes to selecting entries that downstream nodes should process
+   RNodeBase *GetPrevNode() const final { return fPrevDataPtr.get(); }
+
+   /// Ranges act as filters when it comes to selecting entries that downstream nodes should process.
+   /// In multi-thread event loops entries are processed out of order, so they are selected based on their global entry
+   /// number: this is only possible for ranges that are applied directly to the RDataFrame (see RLoopManager::Run).
    bool CheckFilters(unsigned int slot, Long64_t entry) final
    {
+      if (fUseGlobalEntries)
+         return fPrevData.CheckFilters(slot, entry) && IsInGlobalRange(entry);
+
       if (entry != fLastCheckedEntry) {
          if (fHasStopped)
             return false;
@@ -75,6 +85,46 @@ public:
       return fLastResult;
    }
 
+   /// Bulk version of CheckFilters. Entries are counted in the order in which they appear in the bulk.
+   /// In multi-thread event loops, entries are instead selected based on their global entry number.
+   const ROOT::RVecB &CheckFiltersBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries) final
+   {
+      auto &mask = fLastBulkResults[slot];
+      if (fUseGlobalEntries) {
+         const auto &prevMask = fPrevData.CheckFiltersBulk(slot, entries);
+         mask.resize(entries.size());
+         for (std::size_t i = 0u; i < entries.size(); ++i)
+            mask[i] = prevMask[i] && IsInGlobalRange(entries[i]);
+         return mask;
+      }
+
+      if (entries[0] != fLastCheckedEntry) {
+         const auto bulkSize = entries.size();
+         if (fHasStopped) {
+            mask.assign(bulkSize, false);
+         } else {
+            const auto &prevMask = fPrevData.CheckFiltersBulk(slot, entries);
+            mask.resize(bulkSize);
+            for (std::size_t i = 0u; i < bulkSize; ++i) {
+               if (!prevMask[i] || fHasStopped) {
+                  mask[i] = false;
+                  continue;
+               }
+               // apply range filter logic
+               ++fNProcessedEntries;
+               mask[i] = !(fNProcessedEntries <= fStart || (fStop > 0 && fNProcessedEntries > fStop) ||
+                           (fStride != 1 && fNProcessedEntries % fStride != 0));
+               if (fNProcessedEntries == fStop) {
+                  fHasStopped = true;
+                  fPrevData.StopProcessing();
+               }
+            }
+         }
+         fLastCheckedEntry = entries[0];
+      }
+      return mask;
+   }
+
    // recursive chain of `Report`s
    // RRange simply forwards these calls to the previous node
    void Report(ROOT::RDF::RCutFlowReport &rep) const final { fPrevData.PartialReport(rep); }
@@ -14,6 +14,8 @@
 #include "ROOT/RDF/RNodeBase.hxx"
 #include "RtypesCore.h"
 
+#include <vector>
+
 namespace ROOT {
 
 // fwd decl
@@ -36,12 +38,24 @@ protected:
    unsigned int fStride;
    Long64_t fLastCheckedEntry{-1};
    bool fLastResult{true};
+   std::vector<ROOT::RVecB> fLastBulkResults; ///< Per-slot selection masks of the last bulk processed, in bulk mode
    ULong64_t fNProcessedEntries{0};
    bool fHasStopped{false};    ///< True if the end of the range has been reached
    const unsigned int fNSlots; ///< Number of thread slots used by this node, inherited from parent node.
+   bool fIsGlobal{false};      ///< True if the range is applied directly to the RDataFrame, with no upstream filters
+   /// True if entries are selected based on their global entry number rather than counted as they are processed.
+   /// This is the case in multi-thread event loops, where entries are not processed in order.
+   bool fUseGlobalEntries{false};
 
    void ResetCounters();
 
+   /// Whether the entry is selected by the range, when entries are identified by their global entry number.
+   bool IsInGlobalRange(Long64_t entry) const
+   {
+      const auto n = static_cast<ULong64_t>(entry) + 1ull;
+      return n > fStart && (fStop == 0 || n <= fStop) && (fStride == 1 || n % fStride == 0);
+   }
+
 public:
    RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
               const unsigned int nSlots);
@@ -50,6 +64,14 @@ public:
    virtual ~RRangeBase();
 
    void InitNode() { ResetCounters(); }
+   bool HasChildren() const { return fNChildren > 0; }
+   bool IsGlobal() const { return fIsGlobal; }
+   unsigned int GetStart() const { return fStart; }
+   unsigned int GetStop() const { return fStop; }
+   unsigned int GetStride() const { return fStride; }
+   void SetUseGlobalEntries(bool useGlobalEntries) { fUseGlobalEntries = useGlobalEntries; }
+   /// Return the node this range is attached to.
+   virtual RNodeBase *GetPrevNode() const = 0;
    virtual std::shared_ptr<RDFGraphDrawing::GraphNode> GetGraph() = 0;
 };
 
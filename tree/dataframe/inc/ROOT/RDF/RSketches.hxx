@@ -0,0 +1,208 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RDF_RSKETCHES
+#define ROOT_RDF_RSKETCHES
+
+#include "ROOT/RDF/HistoModels.hxx" // EAdaptiveBinning
+#include "ROOT/RDF/Utils.hxx"       // IsDataContainer
+#include "RtypesCore.h"
+
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <functional> // std::hash
+#include <string>
+#include <type_traits>
+#include <utility> // std::pair
+#include <vector>
+
+class TH1D;
+
+namespace ROOT {
+namespace Detail {
+namespace RDF {
+
+/**
+\class ROOT::Detail::RDF::RHyperLogLog
+\ingroup dataframe
+\brief Approximate count of distinct values with the HyperLogLog algorithm.
+
+The sketch holds 2^precision one-byte registers, i.e. its memory footprint does not depend on the number of values
+added to it. The relative standard error of the estimate is about 1.04 / sqrt(2^precision), e.g. 1.6% for the
+default precision of 12 (4 KiB of registers). Values are added as 64-bit hashes, see ROOT::Internal::RDF::HashValue.
+Two sketches with the same precision can be merged: the result is the sketch of the union of the two sets of values.
+*/
+class RHyperLogLog {
+   unsigned int fPrecision = 12;
+   std::vector<UChar_t> fRegisters;
+
+public:
+   /// \throws std::invalid_argument if precision is not between 4 and 18.
+   explicit RHyperLogLog(unsigned int precision = 12);
+
+   /// Add the 64-bit hash of a value to the sketch.
+   void Add(std::uint64_t hash)
+   {
+      // the first fPrecision bits select the register, the register keeps the maximum position of the leftmost 1-bit
+      // in the remaining bits. The guard bit bounds the rank to 64 - fPrecision + 1.
+      const auto index = hash >> (64u - fPrecision);
+      auto w = (hash << fPrecision) | (std::uint64_t(1) << (fPrecision - 1u));
+      UChar_t rank = 1u;
+      while ((w & (std::uint64_t(1) << 63u)) == 0u) {
+         ++rank;
+         w <<= 1u;
+      }
+      if (rank > fRegisters[index])
+         fRegisters[index] = rank;
+   }
+
+   /// \throws std::invalid_argument if the two sketches have a different precision.
+   void Merge(const RHyperLogLog &other);
+
+   double Estimate() const;
+
+   unsigned int GetPrecision() const { return fPrecision; }
+};
+
+/**
+\class ROOT::Detail::RDF::RTDigest
+\ingroup dataframe
+\brief Approximate quantiles of a distribution with the (merging) t-digest algorithm.
+
+Values are summarised by a sorted list of centroids (mean and weight). The compression parameter bounds the number of
+centroids to about `compression` (and the memory to O(compression)), independently of the number of values. Centroids
+are smaller at the tails of the distribution, so the relative accuracy of extreme quantiles is better than the one of
+the median. Two digests can be merged: the result is the digest of the union of the two samples.
+*/
+class RTDigest {
+   double fCompression = 100.;
+   /// Means of the centroids, sorted
+   std::vector<double> fMeans;
+   /// Weights of the centroids
+   std::vector<double> fWeights;
+   /// Values added since the last compression of the centroids
+   std::vector<double> fBuffer;
+   double fTotalWeight = 0.;
+   double fMin = 0.;
+   double fMax = 0.;
+
+   std::size_t GetBufferCapacity() const;
+   void MergeCentroids(std::vector<std::pair<double, double>> &centroids);
+
+public:
+   /// \throws std::invalid_argument if compression is not strictly positive.
+   explicit RTDigest(double compression = 100.);
+
+   /// Add a value to the digest. NaNs are ignored.
+   void Add(double x)
+   {
+      if (x != x)
+         return;
+      if (fTotalWeight == 0. || x < fMin)
+         fMin = x;
+      if (fTotalWeight == 0. || x > fMax)
+         fMax = x;
+      fTotalWeight += 1.;
+      fBuffer.push_back(x);
+      if (fBuffer.size() >= GetBufferCapacity())
+         Compress();
+   }
+
+   /// Merge the values added since the last call into the centroids.
+   void Compress();
+
+   void Merge(const RTDigest &other);
+
+   /// Return the estimate of the quantile of order q (0 <= q <= 1), NaN if the digest is empty.
+   /// Values added since the last call to Compress() are compressed first.
+   double Quantile(double q);
+
+   /// Return the estimate of the fraction of the values that are smaller than x, NaN if the digest is empty.
+   /// Values added since the last call to Compress() are compressed first.
+   double Cdf(double x);
+
+   double GetTotalWeight() const { return fTotalWeight; }
+   double GetCompression() const { return fCompression; }
+   double GetMin() const { return fMin; }
+   double GetMax() const { return fMax; }
+   /// Return the number of centroids, after compression.
+   std::size_t GetNCentroids() const { return fMeans.size(); }
+};
+
+} // namespace RDF
+} // namespace Detail
+
+namespace Internal {
+namespace RDF {
+
+/// Finalizer of MurmurHash3: spread the bits of h so that all bits of the result depend on all bits of the input.
+inline std::uint64_t MixHash(std::uint64_t h)
+{
+   h ^= h >> 33u;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33u;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33u;
+   return h;
+}
+
+/// Combine the hash of a value with the hash of the values that precede it (e.g. in a collection or in a tuple).
+inline std::uint64_t CombineHashes(std::uint64_t seed, std::uint64_t h)
+{
+   return MixHash(seed ^ (h + 0x9e3779b97f4a7c15ULL + (seed << 6u) + (seed >> 2u)));
+}
+
+/// Return a well-distributed 64-bit hash of a value, as required by RHyperLogLog.
+/// Arithmetic values are hashed by their bit pattern, collections element by element, other types with std::hash.
+template <typename T, std::enable_if_t<std::is_arithmetic<T>::value, int> = 0>
+std::uint64_t HashValue(const T &v)
+{
+   static_assert(sizeof(T) <= sizeof(std::uint64_t), "Arithmetic types larger than 64 bits are not supported");
+   std::uint64_t bits = 0u;
+   std::memcpy(&bits, &v, sizeof(T));
+   return MixHash(bits);
+}
+
+template <typename T, std::enable_if_t<!std::is_arithmetic<T>::value && !IsDataContainer<T>::value, int> = 0>
+std::uint64_t HashValue(const T &v)
+{
+   return MixHash(std::hash<T>{}(v));
+}
+
+template <typename T, std::enable_if_t<IsDataContainer<T>::value, int> = 0>
+std::uint64_t HashValue(const T &vs)
+{
+   std::uint64_t h = MixHash(vs.size());
+   for (auto &&v : vs)
+      h = CombineHashes(h, HashValue<typename T::value_type>(v));
+   return h;
+}
+
+/// Set the bins of h according to the distribution summarised by the digest, and its content to the estimated number
+/// of values in each bin. nBins is the number of bins for EAdaptiveBinning::kEqualPopulation, and the maximum number
+/// of bins for EAdaptiveBinning::kFreedmanDiaconis.
+void FillAdaptiveHisto(TH1D &h, ROOT::Detail::RDF::RTDigest &digest, ROOT::RDF::EAdaptiveBinning binning, int nBins);
+
+/// Return the hash of the tuple of values of one or more columns.
+template <typename T>
+std::uint64_t HashValues(const T &v)
+{
+   return HashValue(v);
+}
+
+template <typename T, typename... Ts>
+std::uint64_t HashValues(const T &v, const Ts &... vs)
+{
+   return CombineHashes(HashValue(v), HashValues(vs...));
+}
+
+} // namespace RDF
+} // namespace Internal
+} // namespace ROOT
+
+#endif // ROOT_RDF_RSKETCHES
@@ -162,6 +162,32 @@ struct RemoveFirstTwoParametersIf<true, TypeList> {
 template <bool MustRemove, typename TypeList>
 using RemoveFirstTwoParametersIf_t = typename RemoveFirstTwoParametersIf<MustRemove, TypeList>::type;
 
+/// `type` is T if RVecT is a ROOT::RVec<T>. Used to extract the column types from the signature of DefineBatch callables.
+template <typename RVecT>
+struct RVecValueType {
+   static_assert(sizeof(RVecT) == 0u, "The arguments and the return type of a DefineBatch expression must be RVecs");
+};
+
+template <typename T>
+struct RVecValueType<ROOT::VecOps::RVec<T>> {
+   using type = T;
+};
+
+template <typename RVecT>
+using RVecValueType_t = typename RVecValueType<RVecT>::type;
+
+/// `type` is TypeList<T1, T2, ...> if TypeList is a TypeList<RVec<T1>, RVec<T2>, ...>
+template <typename TypeList>
+struct RVecValueTypes;
+
+template <typename... RVecTs>
+struct RVecValueTypes<TypeList<RVecTs...>> {
+   using type = TypeList<RVecValueType_t<RVecTs>...>;
+};
+
+template <typename TypeList>
+using RVecValueTypes_t = typename RVecValueTypes<TypeList>::type;
+
 // Check the value_type type of a type with a SFINAE to allow compilation in presence
 // fundamental types
 template <typename T,
@@ -197,6 +223,54 @@ void InterpreterDeclare(const std::string &code);
 /// The pointer returned by the call to TInterpreter::Calc is returned in case of success.
 Long64_t InterpreterCalc(const std::string &code, const std::string &context = "");
 
+/// Set the directory where compiled jitted expressions are cached across processes. An empty string disables caching.
+void SetJitCacheDir(std::string_view dir);
+
+/// Return the directory where compiled jitted expressions are cached, empty if caching is disabled.
+const std::string &GetJitCacheDir();
+
+/// The kind of node that is built for a jitted expression stored in the jit cache.
+enum class EJitCacheKind { kFilter, kDefine, kDefinePerSample };
+
+/// Signature of the functions of the jit cache that build the node of a jitted expression. They take the arguments of
+/// JitFilterHelper and JitDefineHelper as type-erased pointers: input column names, their number, node name, loop
+/// manager, weak pointer to the jitted node, booked defines and previous node.
+using JitCacheBookFunc_t = void (*)(const char **, std::size_t, const char *, void *, void *, void *, void *);
+
+/// Return the key that identifies in the jit cache the lambda expression `lambdaExpr` used by a node of type `kind`.
+/// `types` are the types the lambda signature depends on: the key also depends on the contents of their headers and
+/// on the ROOT version.
+std::string GetJitCacheKey(EJitCacheKind kind, const std::string &lambdaExpr, const std::vector<std::string> &types);
+
+/// Look for the jitted expression identified by `key` in the jit cache. If found, load the library that contains it,
+/// fill `retType` with the return type of the expression and return the function that builds its node, which can be
+/// called without invoking the interpreter. Return nullptr otherwise.
+JitCacheBookFunc_t FindInJitCache(const std::string &key, std::string &retType);
+
+/// Schedule the compilation of function `retType f(params) body` for the jitted expression identified by `key`,
+/// together with the function that builds its node of type `kind`. `types` are the types the function signature
+/// depends on. Scheduled functions are compiled by WriteJitCache.
+void AddToJitCache(EJitCacheKind kind, const std::string &key, const std::string &retType, const std::string &params,
+                   const std::string &body, const std::vector<std::string> &types);
+
+/// Compile the functions scheduled by AddToJitCache in shared libraries in the jit cache directory.
+void WriteJitCache();
+
+/// Set the index of the worker process of a multi-process event loop that runs in this process, see
+/// ROOT::RDF::EnableMultiProcessing. -1 (the default) means that this is not a worker process.
+void SetWorkerIndex(int index);
+
+/// Return the index of the worker process of a multi-process event loop that runs in this process, -1 if none.
+int GetWorkerIndex();
+
+/// Return the name of the file where worker `index` of a multi-process event loop writes its part of the output
+/// file `fileName` (e.g. of a Snapshot).
+std::string GetPartialOutputName(const std::string &fileName, unsigned int index);
+
+/// Return a string that identifies the content of a file: its name, followed by its size and modification time if
+/// they are available (they might not be, e.g. for some remote files).
+std::string GetFileIdentifier(const std::string &fileName);
+
 /// Whether custom column with name colName is an "internal" column such as rdfentry_ or rdfslot_
 bool IsInternalColumn(std::string_view colName);
 
@@ -16,6 +16,7 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RResultHandle.hxx>
 #include <ROOT/RDF/GraphUtils.hxx>
+#include <ROOT/RDF/RProfileReport.hxx>
 #include <ROOT/TypeTraits.hxx>
 
 #include <algorithm> // std::transform
@@ -181,6 +182,174 @@ RNode AsRNode(NodeType node)
 // clang-format on
 void RunGraphs(std::vector<RResultHandle> handles);
 
+// clang-format off
+/// Process the entries of a dataset in bulks rather than one by one in the event loops of a RDataFrame.
+/// \param[in] node Any node of the RDataFrame computation graph: the setting applies to the whole graph.
+/// \param[in] bulkSize The number of entries processed at a time. A value of 1 disables bulk processing.
+///
+/// In bulk mode the values of the columns read from the dataset are first loaded in contiguous buffers for a bulk
+/// of entries (TTree branches of fundamental type are read a basket at a time), then Filters evaluate a selection
+/// mask for the whole bulk, and Defines and actions run over all selected entries in a tight loop. This reduces the per-entry overhead of the event loop, which is significant
+/// for simple analyses of flat datasets.
+///
+/// Bulk processing is only applied to event loops in which all columns read are of fundamental types (or are Defines
+/// that return fundamental types) and all actions support it (Snapshot does not): otherwise a warning is emitted and
+/// entries are processed one by one as usual. Results are the same in both modes, except that callbacks registered
+/// via RResultPtr::OnPartialResult are invoked after each bulk rather than after each entry.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::EnableBulkProcessing(df, 512);
+/// auto h = df.Filter("x > 0").Define("y", "x * x").Histo1D("y");
+/// ~~~
+// clang-format on
+void EnableBulkProcessing(RNode node, unsigned int bulkSize = 256);
+
+// clang-format off
+/// Optimize the computation graph of a RDataFrame before running its event loops.
+/// \param[in] node Any node of the RDataFrame computation graph: the setting applies to the whole graph.
+/// \param[in] nWarmUpEntries The number of entries per processing slot used to measure the cost and selectivity of
+/// chained Filters before reordering them. The default value of 0 disables the reordering of Filters, which must be
+/// requested explicitly.
+///
+/// With graph optimizations enabled, RDataFrame performs the following transformations, which do not change the
+/// results of the computation graph:
+/// - unnamed jitted Filters with the same expression and the same input columns that are attached to the same node
+///   (e.g. in different branches of the computation graph) are merged into one node, which is evaluated only once
+///   per entry;
+/// - jitted Defines with the same expression and the same input columns share the computed values, even if they
+///   define columns with different names;
+/// - only if `nWarmUpEntries` is greater than 0, chains of unnamed Filters in which no intermediate result is used by
+///   other nodes are evaluated in an order that is optimized at runtime: during the first `nWarmUpEntries` entries
+///   processed by each slot the expressions are evaluated in booking order, as usual, to measure their cost and
+///   selectivity, then cheap and selective filters are evaluated first.
+///
+/// Only Filters and Defines booked after this call are merged, so it should be invoked right after constructing the
+/// RDataFrame. Reordering Filters assumes that their expressions can be evaluated in any order: it must not be
+/// requested if a Filter guards against invalid values read by a later Filter in the same chain, e.g.
+/// `Filter("v.size() > 0").Filter("v[0] > 1")`. The cut-flow reports do not depend on the order, as only unnamed
+/// Filters are reordered. Filters are not reordered when running in bulk mode (see EnableBulkProcessing).
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::EnableGraphOptimization(df, 1000); // also reorder Filters after 1000 entries per slot
+/// auto f = df.Filter("TMath::Erf(x) > 0.5").Filter("y > 0");
+/// auto h1 = f.Define("z", "x * y").Histo1D("z");
+/// auto h2 = df.Filter("y > 0").Define("w", "x * y").Histo1D("w"); // "x * y" is evaluated once per entry
+/// ~~~
+// clang-format on
+void EnableGraphOptimization(RNode node, unsigned int nWarmUpEntries = 0);
+
+// clang-format off
+/// Collect runtime statistics of each node of a RDataFrame computation graph during its event loops.
+/// \param[in] node Any node of the RDataFrame computation graph: the setting applies to the whole graph.
+/// \param[in] enable Whether statistics should be collected in the next event loops.
+///
+/// For each Filter, Define and action, and for each processing slot, RDataFrame records how many times the node was
+/// evaluated, the wall-clock time spent in it, the part of that time spent reading its input columns rather than in
+/// user code, and the number of bytes read from the input files while doing so. The statistics of the last event loop
+/// are retrieved with GetProfileReport and are also shown in the output of SaveGraph.
+/// Profiling adds some overhead to each node evaluation. Nodes processed in bulk mode (see EnableBulkProcessing) are
+/// not profiled.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::EnableProfiling(df);
+/// auto h = df.Filter("x > 0").Define("y", "x * x").Histo1D("y");
+/// h->Draw();
+/// auto report = ROOT::RDF::GetProfileReport(df);
+/// report.Print();
+/// report.SaveJSON("profile.json");
+/// ROOT::RDF::SaveGraph(df, "graph.dot");
+/// ~~~
+// clang-format on
+void EnableProfiling(RNode node, bool enable = true);
+
+// clang-format off
+/// Run the event loops of a RDataFrame in several worker processes forked from the current one.
+/// \param[in] node Any node of the RDataFrame computation graph: the setting applies to the whole graph.
+/// \param[in] nWorkers The number of worker processes. A value of 0 uses as many workers as cores, a value of 1
+/// disables multi-process execution.
+///
+/// Each worker processes a contiguous share of the entries and writes the partial results of the booked actions,
+/// converted to ROOT::Detail::RDF::RMergeableValue, to a temporary file; the results are then merged in the calling
+/// process. The parts written by Snapshot in each worker are combined in entry order in the requested output file.
+/// Unlike implicit multi-threading, this also scales for analyses whose performance is limited by locks or by code
+/// that is not thread-safe.
+///
+/// Only event loops over TTrees or over an empty source can be split across processes, and only if no Range is
+/// booked and all actions produce mergeable results that can be streamed (Foreach and Display do not, nor Take of
+/// types without dictionary): otherwise a warning is emitted and the event loop runs in the calling process.
+/// Callbacks registered via RResultPtr::OnPartialResult and profiling are evaluated in the workers and are not
+/// available in the calling process; the statistics of named Filters are only available through Report. Throws if
+/// implicit multi-threading is enabled for this RDataFrame. Not available on Windows.
+///
+/// ~~~{.cpp}
+/// ROOT::RDataFrame df("tree", "file.root");
+/// ROOT::RDF::EnableMultiProcessing(df, 8);
+/// auto h = df.Filter("x > 0").Define("y", "x * x").Histo1D("y");
+/// h->Draw(); // runs the event loop in 8 processes
+/// ~~~
+// clang-format on
+void EnableMultiProcessing(RNode node, unsigned int nWorkers = 0);
+
+// clang-format off
+/// Process only the entries that were not processed by previous runs, and merge the results with the stored ones.
+/// \param[in] node Any node of the RDataFrame computation graph: the setting applies to the whole graph.
+/// \param[in] stateFileName The ROOT file where the results and the list of processed entries are stored. An empty
+/// string disables incremental processing.
+///
+/// This is meant for datasets that grow over time, e.g. a TChain to which new files are added, or whose last file is
+/// still being written. After each event loop, the results of the booked actions, converted to
+/// ROOT::Detail::RDF::RMergeableValue, are stored in `stateFileName` together with the names of the files of the
+/// dataset and their number of entries. If the state file exists when the next event loop starts, possibly in another
+/// process, only the entries that were added to the dataset since then are processed, and the results of the actions
+/// are the merged results of all runs.
+///
+/// The files processed by previous runs must still be the first files of the dataset, with the same number of entries
+/// except for the last of them, which can have grown. The same actions must be booked in the same order in all runs.
+/// Otherwise the event loop throws: remove the state file to process the whole dataset again. Incremental processing
+/// requires that the results of all actions can be merged and stored (Foreach, Display and Snapshot cannot), and cannot
+/// be combined with Range or with entry lists. Throws if the RDataFrame does not read a TTree or TChain.
+///
+/// ~~~{.cpp}
+/// TChain chain("events");
+/// chain.Add("/data/run_*.root"); // new files appear over time
+/// ROOT::RDataFrame df(chain);
+/// ROOT::RDF::EnableIncrementalProcessing(df, "monitoring_state.root");
+/// auto h = df.Filter("x > 0").Histo1D("x");
+/// h->Draw(); // the histogram of all the entries processed so far
+/// ~~~
+// clang-format on
+void EnableIncrementalProcessing(RNode node, std::string_view stateFileName);
+
+/// Return the runtime statistics of the nodes evaluated in the last event loop of a RDataFrame computation graph.
+/// Throws if profiling was not enabled with EnableProfiling.
+RProfileReport GetProfileReport(RNode node);
+
+// clang-format off
+/// Cache the compiled code of jitted expressions across processes.
+/// \param[in] dir The directory where compiled expressions are stored. An empty string disables the cache.
+///
+/// Expressions passed as strings to Filter, Define and similar methods are just-in-time compiled by the interpreter,
+/// which can take a significant time when there are many of them. With the cache enabled, the first process that
+/// jits an expression also compiles it (with ACLiC), together with the Filter or Define node that evaluates it, in a
+/// shared library in `dir`. The compilation happens at the end of the event loop, so it does not delay it. Later
+/// processes that use the same expression, with the same column types, the same contents of the headers that declare
+/// them and the same ROOT version, load the compiled node instead of invoking the interpreter. The jit cache directory
+/// can also be set via the `RDataFrame.JitCacheDir` entry of `.rootrc`.
+///
+/// Expressions that cannot be compiled outside of the interpreter, e.g. because they use functions or types that
+/// were declared interactively, are jitted as usual and do not prevent the other expressions from being cached.
+///
+/// ~~~{.cpp}
+/// ROOT::RDF::SetJitCacheDir("/scratch/rdf_jit_cache");
+/// ROOT::RDataFrame df("tree", "file.root");
+/// auto h = df.Filter("x > 0").Define("y", "sqrt(x)").Histo1D("y");
+/// ~~~
+// clang-format on
+void SetJitCacheDir(std::string_view dir);
+
 } // namespace RDF
 } // namespace ROOT
 #endif
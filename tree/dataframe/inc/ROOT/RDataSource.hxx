@@ -172,6 +172,8 @@ public:
    /// This function will be invoked repeatedly by RDataFrame as it needs additional entries to process.
    /// The same entry range should not be returned more than once.
    /// Returning an empty collection of ranges signals to RDataFrame that the processing can stop.
+   /// Data sources whose number of entries is not known in advance (e.g. streams, see RStreamDS) can block until new
+   /// entries are available, and return the ranges of the entries that arrived since the previous call.
    // clang-format on
    virtual std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges() = 0;
 
@@ -222,6 +224,12 @@ public:
    /// Concrete datasources can override the default implementation.
    virtual std::string GetLabel() { return "Custom Datasource"; }
 
+   /// \brief Return a string that identifies the dataset read by this data source, or an empty string if it cannot.
+   /// The string must change whenever the content of the dataset changes, e.g. it contains the names, sizes and
+   /// modification times of the input files. RInterface::PersistentCache uses it to name its cache files.
+   /// Concrete datasources can override the default implementation.
+   virtual std::string GetDatasetIdentifier() { return ""; }
+
 protected:
    /// type-erased vector of pointers to pointers to column values - one per slot
    virtual Record_t GetColumnReadersImpl(std::string_view name, const std::type_info &) = 0;
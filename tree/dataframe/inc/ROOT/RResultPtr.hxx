@@ -17,6 +17,7 @@
 #include "ROOT/TypeTraits.hxx"
 #include "TError.h" // Warning
 
+#include <chrono>
 #include <memory>
 #include <functional>
 #include <type_traits> // std::is_constructible
@@ -65,6 +66,9 @@ class RMergeableValue;
 
 template <typename T>
 std::unique_ptr<RMergeableValue<T>> GetMergeableValue(RResultPtr<T> &rptr);
+
+template <typename T, typename... Ts>
+void MergeValues(RMergeableValue<T> &OutputMergeable, const RMergeableValue<Ts> &... InputMergeables);
 } // namespace RDF
 } // namespace Detail
 namespace RDF {
@@ -304,6 +308,37 @@ public:
       return *this;
    }
 
+   // clang-format off
+   /// Register a callback that RDataFrame will execute periodically on a partial result.
+   ///
+   /// \param[in] period Minimum time between two calls of the callback, e.g. `std::chrono::seconds(5)`
+   /// \param[in] callback a callable with signature `void(Value_t&)` where Value_t is the type of the value contained in this RResultPtr
+   /// \return this RResultPtr, to allow chaining of OnPartialResult with other calls
+   ///
+   /// Same as the overload that takes a number of events, except that the callback is invoked once the given time has
+   /// passed since the previous invocation (the first time, since the event loop started processing entries), at the
+   /// next processed entry. This is useful e.g. to refresh monitoring plots at a regular pace while processing a
+   /// stream of entries whose rate is not known in advance (see ROOT::RDF::RStreamDS):
+   /// \code{.cpp}
+   /// h.OnPartialResult(std::chrono::seconds(2), [&c](TH1D &h_) { c.cd(); h_.Draw(); c.Update(); });
+   /// \endcode
+   /// No call happens while no entries are processed, as the partial result does not change in the meantime.
+   // clang-format on
+   RResultPtr<T> &OnPartialResult(std::chrono::steady_clock::duration period, std::function<void(T &)> callback)
+   {
+      ThrowIfNull();
+      const auto nSlots = fLoopManager->GetNSlots();
+      auto actionPtr = fActionPtr;
+      auto c = [nSlots, actionPtr, callback](unsigned int slot) {
+         if (slot != nSlots - 1)
+            return;
+         auto partialResult = static_cast<Value_t *>(actionPtr->PartialUpdate(slot));
+         callback(*partialResult);
+      };
+      fLoopManager->RegisterCallback(period, std::move(c));
+      return *this;
+   }
+
    // clang-format off
    /// Register a callback that RDataFrame will execute in each worker thread concurrently on that thread's partial result.
    ///
@@ -347,6 +382,22 @@ public:
       return *this;
    }
 
+   /// Register a callback that RDataFrame will execute periodically in each worker thread on that thread's partial
+   /// result. See the OnPartialResult overload that takes a period, and OnPartialResultSlot: each thread measures the
+   /// time since its previous call independently.
+   RResultPtr<T> &
+   OnPartialResultSlot(std::chrono::steady_clock::duration period, std::function<void(unsigned int, T &)> callback)
+   {
+      ThrowIfNull();
+      auto actionPtr = fActionPtr;
+      auto c = [actionPtr, callback](unsigned int slot) {
+         auto partialResult = static_cast<Value_t *>(actionPtr->PartialUpdate(slot));
+         callback(slot, *partialResult);
+      };
+      fLoopManager->RegisterCallback(period, std::move(c));
+      return *this;
+   }
+
    // clang-format off
    /// Check whether the result has already been computed
    ///
@@ -409,6 +460,31 @@ bool operator!=(std::nullptr_t lhs, const RResultPtr<T1> &rhs)
 
 } // namespace RDF
 
+namespace Internal {
+namespace RDF {
+/// Let the action set its result `r` from the partial results computed by the worker processes of a multi-process
+/// event loop, see ROOT::RDF::EnableMultiProcessing. The partial results are the mergeables returned by the
+/// GetMergeableValue method of the action, i.e. RMergeableValue<T> objects.
+template <typename T>
+void SetResultMerger(const std::shared_ptr<T> &r, RActionBase &action, std::true_type /*isCopyAssignable*/)
+{
+   action.SetResultMerger([r](RActionBase::MergeableValues_t &partials) {
+      using Mergeable_t = ROOT::Detail::RDF::RMergeableValue<T>;
+      auto &merged = static_cast<Mergeable_t &>(*partials[0]);
+      for (std::size_t i = 1u; i < partials.size(); ++i)
+         ROOT::Detail::RDF::MergeValues(merged, static_cast<const Mergeable_t &>(*partials[i]));
+      *r = merged.GetValue();
+   });
+}
+
+// no-op overload: the result cannot be set from a merged value
+template <typename T>
+void SetResultMerger(const std::shared_ptr<T> &, RActionBase &, std::false_type /*isCopyAssignable*/)
+{
+}
+} // namespace RDF
+} // namespace Internal
+
 namespace Detail {
 namespace RDF {
 /// Create a RResultPtr and set its pointer to the corresponding RAction
@@ -417,6 +493,7 @@ template <typename T>
 RResultPtr<T>
 MakeResultPtr(const std::shared_ptr<T> &r, RLoopManager &lm, std::shared_ptr<RDFInternal::RActionBase> actionPtr)
 {
+   RDFInternal::SetResultMerger(r, *actionPtr, std::is_copy_assignable<T>{});
    return RResultPtr<T>(r, &lm, std::move(actionPtr));
 }
 
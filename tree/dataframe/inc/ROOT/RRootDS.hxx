@@ -55,6 +55,7 @@ public:
    void SetNSlots(unsigned int nSlots);
    void Initialise();
    std::string GetLabel();
+   std::string GetDatasetIdentifier();
 };
 
 RDataFrame MakeRootDataFrame(std::string_view treeName, std::string_view fileNameGlob);
@@ -18,6 +18,14 @@
 namespace ROOT {
 
 namespace RDF {
+
+/// The format of the dataset written by Snapshot
+enum class ESnapshotOutputFormat {
+   kDefault, ///< Currently the same as kTTree
+   kTTree,
+   kRNTuple  ///< Requires ROOT built with root7
+};
+
 /// A collection of options to steer the creation of the dataset on file
 struct RSnapshotOptions {
    using ECAlgo = ROOT::ECompressionAlgorithm;
@@ -37,6 +45,13 @@ struct RSnapshotOptions {
    int fSplitLevel = 99;                       ///< Split level of output tree
    bool fLazy = false;                         ///< Do not start the event loop when Snapshot is called
    bool fOverwriteIfExists = false; ///< If fMode is "UPDATE", overwrite object in output file if it already exists
+   /// In multi-thread runs, write the output on a dedicated thread while the worker threads fill and compress the
+   /// baskets. The output entries are written in the order of the input entries, except with data sources.
+   bool fAsyncWriting = false;
+   /// Format of the output dataset. With RNTuple output, the compression settings and the mode of creation of the
+   /// output file apply, fAutoFlush is the number of entries per cluster, and the other TTree-specific options are
+   /// ignored.
+   ESnapshotOutputFormat fOutputFormat = ESnapshotOutputFormat::kDefault;
 };
 } // ns RDF
 } // ns ROOT
@@ -48,6 +48,21 @@ is used:
   - For expressions ("SELECT 1+1 FROM table"), the type of the first row of the result set determines the column type.
     That can result in a column to be of thought of type NULL where subsequent rows actually have meaningful values.
     The provided SELECT query can be used to avoid such ambiguities.
+
+By default, the rows of the result set are read one after the other by a single query. To read them in parallel when
+implicit multi-threading is enabled, the name of an integer column of the result set can be given as a partitioning
+key, for instance the rowid of the table or an indexed id column:
+
+    auto rdf = ROOT::RDF::MakeSqliteDataFrame("/path/to/file.sqlite", "select rowid as id, name from table", "id");
+
+The range of values of the key is split into partitions of equal width, one per processing slot unless a number of
+partitions is given. Each partition is read by its own query on its own database connection, restricted to the rows
+whose key lies in the partition. SQlite resolves such queries with a range search if the key is the rowid or an
+indexed column. In this mode:
+
+  - rows whose key is NULL are not processed;
+  - the order in which rows are processed is not the order of the result set;
+  - entry numbers (`rdfentry_`) are unique, but not consecutive.
 */
 class RSqliteDS final : public ROOT::RDF::RDataSource {
 private:
@@ -78,13 +93,17 @@ private:
 
    void SqliteError(int errcode);
 
+   void SetupPartitions();
+
    std::unique_ptr<Internal::RSqliteDSDataSet> fDataSet;
    unsigned int fNSlots;
    ULong64_t fNRow;
    std::vector<std::string> fColumnNames;
    std::vector<ETypes> fColumnTypes;
-   /// The data source is inherently single-threaded and returns only one row at a time. This vector holds the results.
-   std::vector<Value_t> fValues;
+   /// The column values of the current row of each slot, indexed by slot and column.
+   std::vector<std::vector<Value_t>> fValues;
+   /// The number of partitions of the key range if a partitioning key was given, zero to use one per slot.
+   unsigned int fNPartitions;
 
    // clang-format off
    /// Corresponds to the types defined in ETypes.
@@ -99,6 +118,8 @@ private:
 
 public:
    RSqliteDS(const std::string &fileName, const std::string &query);
+   RSqliteDS(const std::string &fileName, const std::string &query, const std::string &keyColumn,
+             unsigned int nPartitions = 0);
    ~RSqliteDS();
    void SetNSlots(unsigned int nSlots) final;
    const std::vector<std::string> &GetColumnNames() const final;
@@ -108,12 +129,15 @@ public:
    bool SetEntry(unsigned int slot, ULong64_t entry) final;
    void Initialise() final;
    std::string GetLabel() final;
+   std::string GetDatasetIdentifier() final;
 
 protected:
    Record_t GetColumnReadersImpl(std::string_view name, const std::type_info &) final;
 };
 
 RDataFrame MakeSqliteDataFrame(std::string_view fileName, std::string_view query);
+RDataFrame MakeSqliteDataFrame(std::string_view fileName, std::string_view query, std::string_view keyColumn,
+                               unsigned int nPartitions = 0);
 
 } // namespace RDF
 
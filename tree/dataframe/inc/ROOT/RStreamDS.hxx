@@ -0,0 +1,284 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_RSTREAMDS
+#define ROOT_RSTREAMDS
+
+#include "ROOT/RDataSource.hxx"
+#include "ROOT/RDF/Utils.hxx" // TypeID2TypeName
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <utility> // std::index_sequence
+#include <vector>
+
+namespace ROOT {
+
+namespace RDF {
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A RDataSource that reads an unbounded stream of entries pushed by one or more producer threads.
+///
+/// The number of entries of a stream is not known in advance: the event loop processes the entries as they are pushed,
+/// and ends when the stream is closed and all the entries pushed before that have been processed. This makes it
+/// possible to process data coming e.g. from a pipe, a socket or a message queue, and to inspect up-to-date results
+/// while the event loop runs with RResultPtr::OnPartialResult:
+/// ~~~{.cpp}
+/// auto source = std::make_unique<ROOT::RDF::RStreamDS<int, double>>(std::vector<std::string>{"run", "energy"});
+/// auto &stream = *source;
+/// ROOT::RDataFrame df(std::move(source));
+/// auto h = df.Histo1D<double>({"h", "energy", 100, 0., 100.}, "energy");
+/// h.OnPartialResult(std::chrono::seconds(5), [](TH1D &h_) { h_.SaveAs("monitoring.root"); });
+///
+/// std::thread producer([&stream] {
+///    zmq::context_t ctx;
+///    zmq::socket_t socket(ctx, zmq::socket_type::pull);
+///    socket.bind("ipc:///tmp/events");
+///    zmq::message_t msg;
+///    while (socket.recv(msg)) {
+///       const auto event = msg.data<Event>();
+///       if (!stream.Push(event->run, event->energy))
+///          break; // the event loop ended
+///    }
+///    stream.Close();
+/// });
+/// h->Draw(); // runs the event loop until the stream is closed
+/// producer.join();
+/// ~~~
+///
+/// Entries are buffered between the producers and the event loop. The buffer holds at most `capacity` entries: Push
+/// blocks while it is full (back-pressure), and TryPush returns false instead, e.g. to drop entries when the event loop
+/// cannot keep up with the input rate. The event loop takes the buffered entries in batches of at most `batchSize`
+/// entries per processing slot. A batch is processed as soon as it is full, or when `maxLatency` elapsed since entries
+/// became available, so that entries are processed promptly also when the input rate is low.
+///
+/// A stream is processed by a single event loop. When the event loop ends, also before the stream was closed (e.g.
+/// because the results of all actions are final), the stream is closed and the entries left in the buffer are
+/// discarded: Push returns false, so that producers can stop. The producers must not use the stream after the
+/// RDataFrame that owns it is destroyed.
+template <typename... ColumnTypes>
+class RStreamDS final : public ROOT::RDF::RDataSource {
+   const std::vector<std::string> fColNames;
+   const std::vector<std::string> fColTypeNames{ROOT::Internal::RDF::TypeID2TypeName(typeid(ColumnTypes))...};
+   const std::size_t fCapacity;
+   const std::size_t fBatchSize;
+   const std::chrono::milliseconds fMaxLatency;
+   unsigned int fNSlots{0};
+
+   mutable std::mutex fMutex;
+   /// Signalled when there is room in the buffer, or the stream is closed.
+   std::condition_variable fCanPush;
+   /// Signalled when entries are pushed to the buffer, or the stream is closed.
+   std::condition_variable fCanPop;
+   std::deque<std::tuple<ColumnTypes...>> fBuffer;
+   bool fIsClosed{false};
+
+   // The entries handed to the event loop by the last call to GetEntryRanges. These members are only accessed by the
+   // event loop, and are not modified while the entries are processed.
+   std::vector<std::tuple<ColumnTypes...>> fBatch;
+   ULong64_t fBatchFirstEntry{0};
+   ULong64_t fNEntries{0}; ///< Number of entries handed to the event loop so far
+   /// The addresses of the values of each column for each slot, pointed to by the column readers.
+   std::tuple<std::vector<ColumnTypes *>...> fValuePtrs;
+
+   template <typename T>
+   static Record_t MakeRecord(std::vector<T *> &ptrs)
+   {
+      Record_t record;
+      for (auto &ptr : ptrs)
+         record.emplace_back(&ptr);
+      return record;
+   }
+
+   template <std::size_t... S>
+   Record_t GetColumnRecord(std::size_t index, std::index_sequence<S...>)
+   {
+      std::vector<Record_t> records{MakeRecord(std::get<S>(fValuePtrs))...};
+      return records[index];
+   }
+
+   template <std::size_t... S>
+   void ResizeValuePtrs(std::index_sequence<S...>)
+   {
+      std::initializer_list<int> expander{(std::get<S>(fValuePtrs).resize(fNSlots, nullptr), 0)...};
+      (void)expander; // avoid unused variable warnings
+   }
+
+   template <std::size_t... S>
+   void SetEntryHelper(unsigned int slot, std::tuple<ColumnTypes...> &entry, std::index_sequence<S...>)
+   {
+      std::initializer_list<int> expander{(std::get<S>(fValuePtrs)[slot] = &std::get<S>(entry), 0)...};
+      (void)expander; // avoid unused variable warnings
+   }
+
+   bool PushImpl(std::tuple<ColumnTypes...> &&entry, bool wait)
+   {
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         if (wait)
+            fCanPush.wait(lock, [this] { return fBuffer.size() < fCapacity || fIsClosed; });
+         if (fIsClosed || fBuffer.size() >= fCapacity)
+            return false;
+         fBuffer.emplace_back(std::move(entry));
+      }
+      fCanPop.notify_one();
+      return true;
+   }
+
+protected:
+   std::string AsString() { return "stream data source"; };
+
+   Record_t GetColumnReadersImpl(std::string_view colName, const std::type_info &id)
+   {
+      const auto it = std::find(fColNames.begin(), fColNames.end(), colName);
+      if (it == fColNames.end())
+         throw std::runtime_error("The specified column name, \"" + std::string(colName) +
+                                  "\" is not known to the data source.");
+      const auto index = std::distance(fColNames.begin(), it);
+      const auto idName = ROOT::Internal::RDF::TypeID2TypeName(id);
+      if (fColTypeNames[index] != idName)
+         throw std::runtime_error("Column " + *it + " has type " + fColTypeNames[index] +
+                                  " while the id specified is associated to type " + idName);
+      return GetColumnRecord(index, std::index_sequence_for<ColumnTypes...>());
+   }
+
+public:
+   /// \param[in] columnNames The names of the columns, one per column type.
+   /// \param[in] capacity The maximum number of entries buffered between the producers and the event loop.
+   /// \param[in] batchSize The maximum number of entries per processing slot handed to the event loop at once.
+   /// \param[in] maxLatency How long the event loop waits for a full batch once entries are available.
+   RStreamDS(const std::vector<std::string> &columnNames, std::size_t capacity = 10000, std::size_t batchSize = 100,
+             std::chrono::milliseconds maxLatency = std::chrono::milliseconds(100))
+      : fColNames(columnNames), fCapacity(capacity), fBatchSize(batchSize), fMaxLatency(maxLatency)
+   {
+      if (fColNames.size() != sizeof...(ColumnTypes))
+         throw std::runtime_error("RStreamDS: " + std::to_string(fColNames.size()) + " column names were passed for " +
+                                  std::to_string(sizeof...(ColumnTypes)) + " column types.");
+      if (fCapacity == 0u || fBatchSize == 0u)
+         throw std::runtime_error("RStreamDS: the capacity of the buffer and the size of the batches must be positive.");
+   }
+
+   /// Add an entry to the stream, waiting while the buffer is full.
+   /// Return false, discarding the entry, if the stream is closed.
+   bool Push(ColumnTypes... values) { return PushImpl(std::tuple<ColumnTypes...>(std::move(values)...), true); }
+
+   /// Add an entry to the stream if the buffer is not full.
+   /// Return false, discarding the entry, if the buffer is full or the stream is closed.
+   bool TryPush(ColumnTypes... values) { return PushImpl(std::tuple<ColumnTypes...>(std::move(values)...), false); }
+
+   /// Signal that no more entries will be pushed: the event loop ends once the buffered entries are processed.
+   void Close()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fIsClosed = true;
+      }
+      fCanPush.notify_all();
+      fCanPop.notify_all();
+   }
+
+   bool IsClosed() const
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      return fIsClosed;
+   }
+
+   /// Return the number of entries in the buffer, i.e. pushed but not yet handed to the event loop.
+   std::size_t GetNBuffered() const
+   {
+      std::lock_guard<std::mutex> lock(fMutex);
+      return fBuffer.size();
+   }
+
+   const std::vector<std::string> &GetColumnNames() const { return fColNames; }
+
+   bool HasColumn(std::string_view colName) const
+   {
+      return std::find(fColNames.begin(), fColNames.end(), colName) != fColNames.end();
+   }
+
+   std::string GetTypeName(std::string_view colName) const
+   {
+      const auto it = std::find(fColNames.begin(), fColNames.end(), colName);
+      if (it == fColNames.end())
+         throw std::runtime_error("The specified column name, \"" + std::string(colName) +
+                                  "\" is not known to the data source.");
+      return fColTypeNames[std::distance(fColNames.begin(), it)];
+   }
+
+   void SetNSlots(unsigned int nSlots)
+   {
+      fNSlots = nSlots;
+      ResizeValuePtrs(std::index_sequence_for<ColumnTypes...>());
+   }
+
+   /// Wait for the next batch of entries, and return one range of entries per processing slot.
+   /// Return no ranges once the stream is closed and all its entries were handed to the event loop.
+   std::vector<std::pair<ULong64_t, ULong64_t>> GetEntryRanges()
+   {
+      const auto fullBatch = std::min(fCapacity, fBatchSize * fNSlots);
+      fBatch.clear();
+      {
+         std::unique_lock<std::mutex> lock(fMutex);
+         fCanPop.wait(lock, [this] { return !fBuffer.empty() || fIsClosed; });
+         fCanPop.wait_for(lock, fMaxLatency, [this, fullBatch] { return fBuffer.size() >= fullBatch || fIsClosed; });
+         const auto nEntries = std::min(fullBatch, fBuffer.size());
+         std::move(fBuffer.begin(), fBuffer.begin() + nEntries, std::back_inserter(fBatch));
+         fBuffer.erase(fBuffer.begin(), fBuffer.begin() + nEntries);
+      }
+      fCanPush.notify_all();
+
+      std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+      const ULong64_t nEntries = fBatch.size();
+      const ULong64_t nRanges = std::min<ULong64_t>(fNSlots, nEntries);
+      fBatchFirstEntry = fNEntries;
+      for (ULong64_t r = 0ull; r < nRanges; ++r) {
+         // distribute the remainder among the first ranges
+         const auto begin = fNEntries + r * (nEntries / nRanges) + std::min(r, nEntries % nRanges);
+         const auto end = begin + nEntries / nRanges + (r < nEntries % nRanges ? 1ull : 0ull);
+         ranges.emplace_back(begin, end);
+      }
+      fNEntries += nEntries;
+      return ranges;
+   }
+
+   bool SetEntry(unsigned int slot, ULong64_t entry)
+   {
+      SetEntryHelper(slot, fBatch[entry - fBatchFirstEntry], std::index_sequence_for<ColumnTypes...>());
+      return true;
+   }
+
+   /// Close the stream and discard the entries left in the buffer: a stream is processed by a single event loop.
+   void Finalise()
+   {
+      {
+         std::lock_guard<std::mutex> lock(fMutex);
+         fIsClosed = true;
+         fBuffer.clear();
+      }
+      fBatch.clear();
+      fCanPush.notify_all();
+      fCanPop.notify_all();
+   }
+
+   std::string GetLabel() { return "StreamDS"; }
+};
+
+} // ns RDF
+
+} // ns ROOT
+
+#endif
@@ -10,11 +10,63 @@
 
 #include "ROOT/RDF/RActionBase.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RMergeableValue.hxx"
+#include "TClass.h"
+
+#include <stdexcept>
+#include <typeinfo>
 
 using namespace ROOT::Internal::RDF;
 
 RActionBase::RActionBase(RLoopManager *lm, const ColumnNames_t &colNames, const RBookedDefines &defines)
-   : fLoopManager(lm), fNSlots(lm->GetNSlots()), fColumnNames(colNames), fDefines(defines) { }
+   : fLoopManager(lm), fNSlots(lm->GetNSlots()), fColumnNames(colNames), fDefines(defines)
+{
+}
 
 // outlined to pin virtual table
 RActionBase::~RActionBase() {}
+
+/// Flag the result of this action as final. The first time it is called, it notifies the RLoopManager, which stops the
+/// event loop as soon as the results of all booked actions are final. Thread-safe.
+void RActionBase::SetDone()
+{
+   if (!fIsDone.load(std::memory_order_relaxed) && !fIsDone.exchange(true))
+      fLoopManager->ActionDone();
+}
+
+/// Whether the result of this action can be converted to a mergeable that can be streamed, and set from merged
+/// mergeables with SetMergedResult. This is needed to combine the partial results computed by the worker processes of a
+/// multi-process event loop (see ROOT::RDF::EnableMultiProcessing), or to merge the result with the results of
+/// previous event loops (see ROOT::RDF::EnableIncrementalProcessing).
+bool RActionBase::HasStreamableResult() const
+{
+   if (!fResultMerger)
+      return false;
+   try {
+      const auto mergeable = GetMergeableValue();
+      const auto &m = *mergeable;
+      return TClass::GetClass(typeid(m)) != nullptr;
+   } catch (const std::logic_error &) {
+      // GetMergeableValue is not implemented for this type of action
+      return false;
+   }
+}
+
+/// Merge partial results of this action, e.g. computed by the worker processes of a multi-process event loop, and set
+/// the result of the action to the merged value.
+void RActionBase::SetMergedResult(MergeableValues_t &&partials)
+{
+   if (partials.empty())
+      throw std::logic_error("RDataFrame: no partial results to merge.");
+   fResultMerger(partials);
+   fMergedValue = std::move(partials[0]);
+}
+
+std::unique_ptr<RMergeableValueBase> RActionBase::CloneMergedValue() const
+{
+   if (fMergedValue == nullptr)
+      return nullptr;
+   // mergeables are not copyable: stream the merged value in a buffer and read it back
+   const auto buffer = ROOT::Detail::RDF::SerializeMergeableValue(*fMergedValue);
+   return ROOT::Detail::RDF::DeserializeMergeableValue(buffer.data(), buffer.size());
+}
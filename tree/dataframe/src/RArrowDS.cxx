@@ -23,11 +23,16 @@ ROOT::RDF::MakeArrowDataFrame, which accepts one parameter:
 The types of the columns are derived from the types in the associated
 arrow::Schema.
 
+Values are not copied: columns of primitive types are read directly from the
+Arrow buffers, and list columns are exposed as RVecs that adopt the memory of
+the Arrow buffers. Booleans and strings are unpacked for each entry. The
+entry ranges processed by each task do not cross the boundaries between the
+chunks (record batches) of the table.
+
 */
 // clang-format on
 
 #include <ROOT/RDF/Utils.hxx>
-#include <ROOT/TSeq.hxx>
 #include <ROOT/RArrowDS.hxx>
 #include <snprintf.h>
 
@@ -78,13 +83,17 @@ ROOT_ARROW_STL_CONVERSION(float, FloatType)
 ROOT_ARROW_STL_CONVERSION(double, DoubleType)
 ROOT_ARROW_STL_CONVERSION(std::string, StringType)
 
-// Per slot visitor of an Array.
+// Per slot accessor of the values of a column. The visitor is bound to one chunk of the column at a time: visiting the
+// chunk caches the addresses of its buffers, which are then used to point to the values of each entry without copies.
 class ArrayPtrVisitor : public ::arrow::ArrayVisitor {
 private:
+   enum class EKind { kNone, kPrimitive, kBool, kString, kList };
+
    /// The pointer to update.
    void **fResult;
    bool fCachedBool{false}; // Booleans need to be unpacked, so we use a cached entry.
    // FIXME: I should really use a variant here
+   // RVecs adopt the memory of the values of the current list, they never own it.
    RVec<float> fCachedRVecFloat;
    RVec<double> fCachedRVecDouble;
    RVec<ULong64_t> fCachedRVecULong64;
@@ -92,109 +101,128 @@ private:
    RVec<Long64_t> fCachedRVecLong64;
    RVec<Int_t> fCachedRVecInt;
    std::string fCachedString;
-   /// The entry in the array which should be looked up.
-   ULong64_t fCurrentEntry;
+
+   EKind fKind{EKind::kNone};
+   /// Primitive arrays: the values of the chunk and the size of one value.
+   const uint8_t *fRawValues{nullptr};
+   std::size_t fValueSize{0};
+   /// Boolean and string arrays: the chunk itself, values need to be unpacked.
+   const arrow::BooleanArray *fBoolArray{nullptr};
+   const arrow::StringArray *fStringArray{nullptr};
+   /// List arrays: the offsets of the lists in the chunk, the values of all lists and their type.
+   const int32_t *fListOffsets{nullptr};
+   const uint8_t *fListValues{nullptr};
+   arrow::Type::type fListValueType{arrow::Type::NA};
 
    template <typename T>
-   void *getTypeErasedPtrFrom(arrow::ListArray const &array, int32_t entry, RVec<T> &cache)
+   void *PointToList(int64_t entry, RVec<T> &cache)
    {
-      using ArrowType = typename RootConversionTraits<T>::ArrowType;
-      using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
-      auto values = reinterpret_cast<ArrayType *>(array.values().get());
-      auto offset = array.value_offset(entry);
+      const auto offset = fListOffsets[entry];
+      const auto length = fListOffsets[entry + 1] - offset;
       // Here the cast to void* is a worksround while we figure out the
       // issues we have with long long types, signed and unsigned.
-      RVec<T> tmp(reinterpret_cast<T *>((void *)values->raw_values()) + offset, array.value_length(entry));
-      std::swap(cache, tmp);
+      // Move-assigning a RVec that adopts the memory of the Arrow buffer does not copy the values.
+      cache = RVec<T>(reinterpret_cast<T *>((void *)fListValues) + offset, length);
       return (void *)(&cache);
    }
 
-public:
-   ArrayPtrVisitor(void **result) : fResult{result}, fCurrentEntry{0} {}
-
-   void SetEntry(ULong64_t entry) { fCurrentEntry = entry; }
-
-   /// Check if we are asking the same entry as before.
-   virtual arrow::Status Visit(arrow::Int32Array const &array) final
+   template <typename ArrayType>
+   arrow::Status BindPrimitive(ArrayType const &array)
    {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
+      fKind = EKind::kPrimitive;
+      fRawValues = reinterpret_cast<const uint8_t *>(array.raw_values());
+      fValueSize = sizeof(*array.raw_values());
       return arrow::Status::OK();
    }
 
-   virtual arrow::Status Visit(arrow::Int64Array const &array) final
+   template <typename ArrayType>
+   void BindListValues(arrow::ListArray const &array)
    {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
+      fListValues = reinterpret_cast<const uint8_t *>(static_cast<ArrayType *>(array.values().get())->raw_values());
    }
 
-   /// Check if we are asking the same entry as before.
-   virtual arrow::Status Visit(arrow::UInt32Array const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
+public:
+   ArrayPtrVisitor(void **result) : fResult{result} {}
 
-   virtual arrow::Status Visit(arrow::UInt64Array const &array) final
+   /// Prepare to read the entries of the given chunk.
+   void SetChunk(arrow::Array const &chunk)
    {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
+      fKind = EKind::kNone;
+      auto status = chunk.Accept(this);
+      if (!status.ok())
+         throw std::runtime_error("RArrowDS: cannot read a chunk of type " + chunk.type()->ToString() + ": " +
+                                  status.ToString());
    }
 
-   virtual arrow::Status Visit(arrow::FloatArray const &array) final
+   /// Point the result to the value of the given entry of the current chunk.
+   void SetEntry(int64_t entry)
    {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
+      switch (fKind) {
+      case EKind::kPrimitive: *fResult = (void *)(fRawValues + entry * fValueSize); break;
+      case EKind::kBool:
+         fCachedBool = fBoolArray->Value(entry);
+         *fResult = reinterpret_cast<void *>(&fCachedBool);
+         break;
+      case EKind::kString:
+         fCachedString = fStringArray->GetString(entry);
+         *fResult = reinterpret_cast<void *>(&fCachedString);
+         break;
+      case EKind::kList:
+         switch (fListValueType) {
+         case arrow::Type::FLOAT: *fResult = PointToList(entry, fCachedRVecFloat); break;
+         case arrow::Type::DOUBLE: *fResult = PointToList(entry, fCachedRVecDouble); break;
+         case arrow::Type::UINT32: *fResult = PointToList(entry, fCachedRVecUInt); break;
+         case arrow::Type::UINT64: *fResult = PointToList(entry, fCachedRVecULong64); break;
+         case arrow::Type::INT32: *fResult = PointToList(entry, fCachedRVecInt); break;
+         case arrow::Type::INT64: *fResult = PointToList(entry, fCachedRVecLong64); break;
+         default: break; // not reachable, checked in Visit
+         }
+         break;
+      case EKind::kNone: throw std::runtime_error("RArrowDS: no chunk was selected for reading");
+      }
    }
 
-   virtual arrow::Status Visit(arrow::DoubleArray const &array) final
-   {
-      *fResult = (void *)(array.raw_values() + fCurrentEntry);
-      return arrow::Status::OK();
-   }
+   virtual arrow::Status Visit(arrow::Int32Array const &array) final { return BindPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::Int64Array const &array) final { return BindPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::UInt32Array const &array) final { return BindPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::UInt64Array const &array) final { return BindPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::FloatArray const &array) final { return BindPrimitive(array); }
+
+   virtual arrow::Status Visit(arrow::DoubleArray const &array) final { return BindPrimitive(array); }
 
    virtual arrow::Status Visit(arrow::BooleanArray const &array) final
    {
-      fCachedBool = array.Value(fCurrentEntry);
-      *fResult = reinterpret_cast<void *>(&fCachedBool);
+      fKind = EKind::kBool;
+      fBoolArray = &array;
       return arrow::Status::OK();
    }
 
    virtual arrow::Status Visit(arrow::StringArray const &array) final
    {
-      fCachedString = array.GetString(fCurrentEntry);
-      *fResult = reinterpret_cast<void *>(&fCachedString);
+      fKind = EKind::kString;
+      fStringArray = &array;
       return arrow::Status::OK();
    }
 
    virtual arrow::Status Visit(arrow::ListArray const &array) final
    {
-      switch (array.value_type()->id()) {
-      case arrow::Type::FLOAT: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecFloat);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::DOUBLE: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecDouble);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::UINT32: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecUInt);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::UINT64: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecULong64);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::INT32: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecInt);
-         return arrow::Status::OK();
-      }
-      case arrow::Type::INT64: {
-         *fResult = getTypeErasedPtrFrom(array, fCurrentEntry, fCachedRVecLong64);
-         return arrow::Status::OK();
-      }
+      fListValueType = array.value_type()->id();
+      switch (fListValueType) {
+      case arrow::Type::FLOAT: BindListValues<arrow::FloatArray>(array); break;
+      case arrow::Type::DOUBLE: BindListValues<arrow::DoubleArray>(array); break;
+      case arrow::Type::UINT32: BindListValues<arrow::UInt32Array>(array); break;
+      case arrow::Type::UINT64: BindListValues<arrow::UInt64Array>(array); break;
+      case arrow::Type::INT32: BindListValues<arrow::Int32Array>(array); break;
+      case arrow::Type::INT64: BindListValues<arrow::Int64Array>(array); break;
       default: return arrow::Status::TypeError("Type not supported");
       }
+      fKind = EKind::kList;
+      fListOffsets = array.raw_value_offsets();
+      return arrow::Status::OK();
    }
 
    using ::arrow::ArrayVisitor::Visit;
@@ -204,19 +232,21 @@ public:
 class TValueGetter {
 private:
    std::vector<void *> fValuesPtrPerSlot;
-   std::vector<ULong64_t> fLastEntryPerSlot;
-   std::vector<ULong64_t> fLastChunkPerSlot;
+   /// The chunk each slot is currently reading, and the range of entries [first, end) it contains.
+   std::vector<std::size_t> fCurrentChunkPerSlot;
+   std::vector<std::pair<ULong64_t, ULong64_t>> fCurrentChunkRangePerSlot;
    std::vector<ULong64_t> fFirstEntryPerChunk;
    std::vector<ArrayPtrVisitor> fArrayVisitorPerSlot;
    /// Since data can be chunked in different arrays we need to construct an
-   /// index which contains the first element of each chunk, so that we can
+   /// index which contains the end (one past the last entry) of each chunk, so that we can
    /// quickly move to the correct chunk.
    std::vector<ULong64_t> fChunkIndex;
    arrow::ArrayVector fChunks;
 
 public:
    TValueGetter(size_t slots, arrow::ArrayVector chunks)
-      : fValuesPtrPerSlot(slots, nullptr), fLastEntryPerSlot(slots, 0), fLastChunkPerSlot(slots, 0), fChunks{chunks}
+      : fValuesPtrPerSlot(slots, nullptr), fCurrentChunkPerSlot(slots, 0), fCurrentChunkRangePerSlot(slots, {0, 0}),
+        fChunks{chunks}
    {
       fChunkIndex.reserve(fChunks.size());
       size_t next = 0;
@@ -240,46 +270,37 @@ public:
       return result;
    }
 
+   /// The end (one past the last entry) of each chunk of the column.
+   const std::vector<ULong64_t> &GetChunkEnds() const { return fChunkIndex; }
+
    // Convenience method to avoid code duplication between
    // SetEntry and InitSlot
    void UncachedSlotLookup(unsigned int slot, ULong64_t entry)
    {
-      // If entry is greater than the previous one,
-      // we can skip all the chunks before the last one we
-      // queried.
-      size_t ci = 0;
-      assert(slot < fLastChunkPerSlot.size());
-      if (fLastEntryPerSlot[slot] < entry) {
-         ci = fLastChunkPerSlot.at(slot);
-      }
-
-      for (size_t ce = fChunkIndex.size(); ci != ce; ++ci) {
-         if (entry < fChunkIndex[ci]) {
-            assert(slot < fLastChunkPerSlot.size());
-            fLastChunkPerSlot[slot] = ci;
-            break;
-         }
-      }
-
-      // Update the pointer to the requested entry.
-      // Notice that we need to find the entry
-      auto chunk = fChunks.at(fLastChunkPerSlot[slot]);
-      assert(slot < fArrayVisitorPerSlot.size());
-      fArrayVisitorPerSlot[slot].SetEntry(entry - fFirstEntryPerChunk[fLastChunkPerSlot[slot]]);
-      fLastEntryPerSlot[slot] = entry;
-      auto status = chunk->Accept(fArrayVisitorPerSlot.data() + slot);
-      if (!status.ok()) {
+      assert(slot < fCurrentChunkPerSlot.size());
+      // the first chunk that ends after the entry (empty chunks are skipped)
+      const auto ci = std::distance(fChunkIndex.begin(), std::upper_bound(fChunkIndex.begin(), fChunkIndex.end(), entry));
+      if (static_cast<std::size_t>(ci) == fChunks.size()) {
          std::string msg = "Could not get pointer for slot ";
          msg += std::to_string(slot) + " looking at entry " + std::to_string(entry);
          throw std::runtime_error(msg);
       }
+
+      // Bind the visitor to the chunk: the buffers of the chunk are looked up once, not for every entry
+      fCurrentChunkPerSlot[slot] = ci;
+      fCurrentChunkRangePerSlot[slot] = {fFirstEntryPerChunk[ci], fChunkIndex[ci]};
+      assert(slot < fArrayVisitorPerSlot.size());
+      fArrayVisitorPerSlot[slot].SetChunk(*fChunks[ci]);
+      fArrayVisitorPerSlot[slot].SetEntry(entry - fFirstEntryPerChunk[ci]);
    }
 
    /// Set the current entry to be retrieved
    void SetEntry(unsigned int slot, ULong64_t entry)
    {
-      // Same entry as before
-      if (fLastEntryPerSlot[slot] == entry) {
+      const auto &range = fCurrentChunkRangePerSlot[slot];
+      // Same chunk as before: just move the pointer to the requested entry
+      if (entry >= range.first && entry < range.second) {
+         fArrayVisitorPerSlot[slot].SetEntry(entry - range.first);
          return;
       }
       UncachedSlotLookup(slot, entry);
@@ -516,20 +537,39 @@ void RArrowDS::InitSlot(unsigned int slot, ULong64_t entry)
    }
 }
 
-void splitInEqualRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges, int nRecords, unsigned int nSlots)
+/// Split the entries in ranges that do not cross the boundaries between the chunks (record batches) of the columns,
+/// so that each task reads entries from one chunk at a time. Consecutive chunks are grouped in ranges of about
+/// nRecords / nSlots entries; if there are fewer chunks than slots, chunks are split in equal parts.
+void splitInBatchAlignedRanges(std::vector<std::pair<ULong64_t, ULong64_t>> &ranges,
+                               const std::vector<ULong64_t> &batchEnds, unsigned int nSlots)
 {
    ranges.clear();
-   const auto chunkSize = nRecords / nSlots;
-   const auto remainder = 1U == nSlots ? 0 : nRecords % nSlots;
-   auto start = 0UL;
-   auto end = 0UL;
-   for (auto i : ROOT::TSeqU(nSlots)) {
-      start = end;
-      end += chunkSize;
-      ranges.emplace_back(start, end);
-      (void)i;
-   }
-   ranges.back().second += remainder;
+   if (batchEnds.empty() || batchEnds.back() == 0)
+      return;
+   const ULong64_t nRecords = batchEnds.back();
+   const auto nBatches = batchEnds.size();
+   if (nBatches < nSlots) {
+      const ULong64_t nPartsPerBatch = (nSlots + nBatches - 1) / nBatches;
+      ULong64_t start = 0ull;
+      for (auto end : batchEnds) {
+         // at least one entry per part, the remainder goes to the last part
+         const auto nParts = std::min(nPartsPerBatch, end - start);
+         const auto partSize = (end - start) / nParts;
+         for (auto i = 0ull; i < nParts; ++i)
+            ranges.emplace_back(start + i * partSize, i + 1 == nParts ? end : start + (i + 1) * partSize);
+         start = end;
+      }
+      return;
+   }
+
+   const auto targetSize = std::max(nRecords / nSlots, 1ull);
+   ULong64_t start = 0ull;
+   for (auto end : batchEnds) {
+      if (end - start >= targetSize || end == nRecords) {
+         ranges.emplace_back(start, end);
+         start = end;
+      }
+   }
 }
 
 int getNRecords(std::shared_ptr<arrow::Table> &table, std::vector<std::string> &columnNames)
@@ -588,8 +628,18 @@ std::vector<void *> RArrowDS::GetColumnReadersImpl(std::string_view colName, con
 
 void RArrowDS::Initialise()
 {
-   auto nRecords = getNRecords(fTable, fColumnNames);
-   splitInEqualRanges(fEntryRanges, nRecords, fNSlots);
+   // the boundaries between the chunks of all columns that are read
+   std::vector<ULong64_t> batchEnds;
+   for (auto &getter : fValueGetters) {
+      const auto &chunkEnds = getter->GetChunkEnds();
+      batchEnds.insert(batchEnds.end(), chunkEnds.begin(), chunkEnds.end());
+   }
+   if (batchEnds.empty())
+      batchEnds.push_back(getNRecords(fTable, fColumnNames));
+   std::sort(batchEnds.begin(), batchEnds.end());
+   batchEnds.erase(std::unique(batchEnds.begin(), batchEnds.end()), batchEnds.end());
+   batchEnds.erase(std::remove(batchEnds.begin(), batchEnds.end(), 0ull), batchEnds.end());
+   splitInBatchAlignedRanges(fEntryRanges, batchEnds, fNSlots);
 }
 
 std::string RArrowDS::GetLabel()
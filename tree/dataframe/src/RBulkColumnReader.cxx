@@ -0,0 +1,87 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RBulkColumnReader.hxx"
+
+#include <TBranch.h>
+#include <TBufferFile.h>
+#include <TClass.h>
+#include <TLeaf.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+
+#include <algorithm> // std::upper_bound
+#include <stdexcept>
+#include <string>
+
+using ROOT::Internal::RDF::RTreeBlockReader;
+
+RTreeBlockReader::RTreeBlockReader(TTreeReader &r, const std::string &branchName, EDataType type,
+                                   std::size_t valueSize)
+   : fTreeReader(&r), fBranchName(branchName), fType(type), fValueSize(valueSize),
+     fBuffer(new TBufferFile(TBuffer::kWrite, 10000))
+{
+}
+
+RTreeBlockReader::~RTreeBlockReader() = default;
+
+/// Return the branch to read from fTree, or nullptr if it cannot be read one basket at a time.
+TBranch *RTreeBlockReader::FindBranch() const
+{
+   auto *branch = fTree->GetBranch(fBranchName.c_str());
+   // branches of friend trees are excluded: their tree can change independently of fTree
+   if (branch == nullptr || branch->GetTree() != fTree || branch->IsA() != TBranch::Class() ||
+       !branch->GetBulkRead().SupportsBulkRead())
+      return nullptr;
+
+   auto *leaf = static_cast<TLeaf *>(branch->GetListOfLeaves()->UncheckedAt(0));
+   if (leaf->GetLeafCount() != nullptr || leaf->GetLenStatic() != 1)
+      return nullptr;
+
+   TClass *cl = nullptr;
+   EDataType type = kOther_t;
+   if (branch->GetExpectedType(cl, type) != 0 || cl != nullptr || type != fType)
+      return nullptr;
+
+   return branch;
+}
+
+Long64_t RTreeBlockReader::GetCurrentEntry()
+{
+   TTree *tree = fTreeReader->GetTree();
+   if (tree == nullptr)
+      return -1;
+   const auto treeNumber = tree->GetTreeNumber();
+   tree = tree->GetTree(); // the current tree of a TChain
+   // a TChain deletes its previous tree when it loads the next one, which might be allocated at the same address:
+   // the tree number tells them apart
+   if (tree != fTree || treeNumber != fTreeNumber) {
+      fTree = tree;
+      fTreeNumber = treeNumber;
+      fBranch = tree != nullptr ? FindBranch() : nullptr;
+      fBufferSize = 0;
+   }
+   return fBranch != nullptr ? fTree->GetReadEntry() : -1;
+}
+
+char *RTreeBlockReader::GetValue(Long64_t entry)
+{
+   if (entry < fBufferFirst || entry >= fBufferFirst + fBufferSize) {
+      // read the whole basket that contains the entry
+      const Long64_t *basketEntry = fBranch->GetBasketEntry();
+      const auto nBaskets = fBranch->GetWriteBasket() + 1; // the last one might only be in memory
+      const Long64_t first = *(std::upper_bound(basketEntry, basketEntry + nBaskets, entry) - 1);
+      const auto nRead = fBranch->GetBulkRead().GetEntriesSerialized(first, *fBuffer);
+      if (nRead <= 0 || entry >= first + nRead)
+         throw std::runtime_error("RDataFrame: could not read entries of branch \"" + fBranchName + "\" in bulk.");
+      fBufferFirst = first;
+      fBufferSize = nRead;
+   }
+
+   return fBuffer->GetCurrent() + (entry - fBufferFirst) * fValueSize;
+}
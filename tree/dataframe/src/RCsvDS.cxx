@@ -65,9 +65,23 @@ double-quote characters must be represented by a pair of double-quote characters
     2000,Mercury,Cougar
 ~~~
 
-The current implementation of RCsvDS reads the entire CSV file content into memory before
+By default, RCsvDS reads the entire CSV file content into memory before
 RDataFrame starts processing it. Therefore, before creating a CSV RDataFrame, it is
 important to check both how much memory is available and the size of the CSV file.
+The `linesChunkSize` parameter allows to read and process the file in chunks of lines instead.
+
+Large local files can instead be memory-mapped by setting ROOT::RDF::RCsvDS::ROptions::fMemoryMap:
+~~~{.cpp}
+ROOT::RDF::RCsvDS::ROptions opts;
+opts.fMemoryMap = true;
+auto df = ROOT::RDF::MakeCsvDataFrame("large.csv", opts);
+~~~
+In this mode the beginning of each line is located before the event loop, in parallel if implicit multi-threading
+is enabled, and each processing slot parses its lines only when they are processed, converting only the values of
+the columns that are actually read. The column types are inferred from the first
+ROOT::RDF::RCsvDS::ROptions::fNTypeInferenceLines lines (all lines if negative): columns with both integer and
+floating point values are read as `double`, columns with mixed kinds of values as `std::string`.
+Files that cannot be memory-mapped, e.g. remote files, are read in the default mode.
 */
 // clang-format on
 
@@ -75,14 +89,49 @@ important to check both how much memory is available and the size of the CSV fil
 #include <ROOT/TSeq.hxx>
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/RRawFile.hxx>
+#include <RConfigure.h> // R__USE_IMT
 #include <TError.h>
+#include <TROOT.h> // IsImplicitMTEnabled
+#ifdef R__USE_IMT
+#include <ROOT/TThreadExecutor.hxx>
+#endif
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <sstream>
 #include <string>
 
+namespace {
+/// Return the end of the line that starts at `begin`, excluding the line break, and set `next` to the beginning of the
+/// following line.
+const char *FindLineEnd(const char *begin, const char *end, const char *&next)
+{
+   auto lineEnd = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+   if (lineEnd == nullptr) {
+      lineEnd = end;
+      next = end;
+   } else {
+      next = lineEnd + 1;
+   }
+   if (lineEnd != begin && *(lineEnd - 1) == '\r')
+      --lineEnd;
+   return lineEnd;
+}
+
+/// Return the type that can represent values of both types: integers are promoted to floating point numbers, anything
+/// else to strings.
+char MergeColTypes(char t1, char t2)
+{
+   if (t1 == t2)
+      return t1;
+   if ((t1 == 'l' && t2 == 'd') || (t1 == 'd' && t2 == 'l'))
+      return 'd';
+   return 's';
+}
+} // anonymous namespace
+
 namespace ROOT {
 
 namespace RDF {
@@ -185,16 +234,70 @@ std::vector<void *> RCsvDS::GetColumnReadersImpl(std::string_view colName, const
    return ret;
 }
 
-void RCsvDS::InferColTypes(std::vector<std::string> &columns)
+void RCsvDS::IndexLines()
 {
-   auto i = 0U;
-   for (auto &col : columns) {
-      InferType(col, i);
-      ++i;
+   const auto data = static_cast<const char *>(fMapping);
+   const auto dataEnd = data + fMappingSize;
+   const auto nBytes = fMappingSize - fDataPos;
+
+   // Each chunk of the file records the offsets of the non-empty lines that begin in it
+   unsigned int nChunks = 1U;
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled()) {
+      const std::uint64_t minChunkSize = 1024 * 1024;
+      nChunks = std::max(1ULL, std::min<unsigned long long>(4 * ROOT::GetThreadPoolSize(), nBytes / minChunkSize));
+   }
+#endif
+   std::vector<std::vector<std::uint64_t>> chunkOffsets(nChunks);
+   auto indexChunk = [&](unsigned int chunk) {
+      auto pos = fDataPos + nBytes * chunk / nChunks;
+      const auto chunkEnd = fDataPos + nBytes * (chunk + 1) / nChunks;
+      if (pos == chunkEnd)
+         return;
+      if (chunk > 0U) {
+         // skip the end of the line that begins in the previous chunk
+         auto lineBreak = static_cast<const char *>(std::memchr(data + pos - 1, '\n', chunkEnd - pos));
+         if (lineBreak == nullptr)
+            return;
+         pos = lineBreak + 1 - data;
+      }
+      auto &offsets = chunkOffsets[chunk];
+      while (pos < chunkEnd) {
+         const char *next;
+         if (FindLineEnd(data + pos, dataEnd, next) != data + pos)
+            offsets.push_back(pos);
+         pos = next - data;
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (nChunks > 1U)
+      ROOT::TThreadExecutor().Foreach(indexChunk, ROOT::TSeqU(nChunks));
+   else
+#endif
+      indexChunk(0U);
+
+   fLineOffsets.clear();
+   for (auto &offsets : chunkOffsets)
+      fLineOffsets.insert(fLineOffsets.end(), offsets.begin(), offsets.end());
+   fLinesIndexed = true;
+}
+
+void RCsvDS::InferColTypes(const std::vector<std::vector<std::string>> &records)
+{
+   const auto &columns = records.front();
+   for (auto i = 0U; i < columns.size(); ++i) {
+      auto type = InferType(columns[i]);
+      for (auto r = 1U; r < records.size() && type != 's'; ++r) {
+         if (i < records[r].size())
+            type = MergeColTypes(type, InferType(records[r][i]));
+      }
+      fColTypes[fHeaders[i]] = type;
+      fColTypesList.push_back(type);
    }
 }
 
-void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
+RCsvDS::ColType_t RCsvDS::InferType(const std::string &col) const
 {
    ColType_t type;
    int dummy;
@@ -212,8 +315,57 @@ void RCsvDS::InferType(const std::string &col, unsigned int idxCol)
    }
    // TODO: Date
 
-   fColTypes[fHeaders[idxCol]] = type;
-   fColTypesList.push_back(type);
+   return type;
+}
+
+void RCsvDS::MapFile(std::string_view fileName)
+{
+   const auto size = fCsvFile->GetSize();
+   if (size > 0) {
+      std::uint64_t mapdOffset;
+      fMapping = fCsvFile->Map(size, 0, mapdOffset);
+      fMappingSize = size;
+   }
+   fMemoryMapped = true;
+
+   const auto data = static_cast<const char *>(fMapping);
+   const auto dataEnd = data + fMappingSize;
+   const char *lineBegin = data;
+   const char *next;
+
+   // Read the headers if present
+   if (fReadHeaders) {
+      if (size == 0) {
+         std::string msg = "Error reading headers of CSV file ";
+         msg += fileName;
+         throw std::runtime_error(msg);
+      }
+      FillHeaders(std::string(lineBegin, FindLineEnd(lineBegin, dataEnd, next)));
+      lineBegin = next;
+   }
+   fDataPos = lineBegin - data;
+
+   // Infer the column types from a sample of records
+   std::vector<std::vector<std::string>> sample;
+   while (lineBegin != dataEnd &&
+          (fNTypeInferenceLines < 0 || sample.size() < static_cast<std::size_t>(fNTypeInferenceLines))) {
+      std::string line(lineBegin, FindLineEnd(lineBegin, dataEnd, next));
+      if (!line.empty())
+         sample.emplace_back(ParseColumns(line));
+      lineBegin = next;
+   }
+   if (sample.empty()) {
+      std::string msg = "Could not infer column types of CSV file ";
+      msg += fileName;
+      throw std::runtime_error(msg);
+   }
+
+   // Generate headers if not present
+   if (!fReadHeaders) {
+      GenerateHeaders(sample.front().size());
+   }
+
+   InferColTypes(sample);
 }
 
 std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
@@ -229,27 +381,35 @@ std::vector<std::string> RCsvDS::ParseColumns(const std::string &line)
 
 size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &columns, size_t i)
 {
-   std::stringstream val;
+   std::string val;
+   const auto valEnd = ParseValue(line.data() + i, line.data() + line.size(), val);
+   columns.emplace_back(std::move(val));
+
+   return valEnd - line.data();
+}
+
+/// Parse the value that begins at `begin` into `val`, and return the position of the delimiter that ends it (or `end`).
+const char *RCsvDS::ParseValue(const char *begin, const char *end, std::string &val) const
+{
+   val.clear();
    bool quoted = false;
 
-   for (; i < line.size(); ++i) {
-      if (line[i] == fDelimiter && !quoted) {
+   for (; begin != end; ++begin) {
+      if (*begin == fDelimiter && !quoted) {
          break;
-      } else if (line[i] == '"') {
+      } else if (*begin == '"') {
          // Keep just one quote for escaped quotes, none for the normal quotes
-         if (line[i + 1] != '"') {
+         if (begin + 1 == end || *(begin + 1) != '"') {
             quoted = !quoted;
          } else {
-            val << line[++i];
+            val += *++begin;
          }
       } else {
-         val << line[i];
+         val += *begin;
       }
    }
 
-   columns.emplace_back(val.str());
-
-   return i;
+   return begin;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -258,12 +418,33 @@ size_t RCsvDS::ParseValue(const std::string &line, std::vector<std::string> &col
 /// \param[in] readHeaders `true` if the CSV file contains headers as first row, `false` otherwise
 ///                        (default `true`).
 /// \param[in] delimiter Delimiter character (default ',').
+/// \param[in] linesChunkSize Number of lines read into memory at once, -1 to read the whole file (default -1).
 RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long64_t linesChunkSize) // TODO: Let users specify types?
-   : fReadHeaders(readHeaders),
+   : RCsvDS(fileName, ROptions{readHeaders, delimiter, linesChunkSize})
+{
+}
+
+////////////////////////////////////////////////////////////////////////
+/// Constructor to create a CSV RDataSource for RDataFrame.
+/// \param[in] fileName Path or URL of the CSV file.
+/// \param[in] options Options that control how the file is read, see ROOT::RDF::RCsvDS::ROptions.
+RCsvDS::RCsvDS(std::string_view fileName, const ROptions &options)
+   : fReadHeaders(options.fHeaders),
+     fFileName(fileName),
      fCsvFile(ROOT::Internal::RRawFile::Create(fileName)),
-     fDelimiter(delimiter),
-     fLinesChunkSize(linesChunkSize)
+     fDelimiter(options.fDelimiter),
+     fLinesChunkSize(options.fLinesChunkSize),
+     fNTypeInferenceLines(options.fNTypeInferenceLines)
 {
+   if (options.fMemoryMap) {
+      if (fCsvFile->GetFeatures() & ROOT::Internal::RRawFile::kFeatureHasMmap) {
+         MapFile(fileName);
+         return;
+      }
+      Warning("RCsvDS", "CSV file %s cannot be memory-mapped, it will be read into memory",
+              std::string(fileName).c_str());
+   }
+
    std::string line;
 
    // Read the headers if present
@@ -291,7 +472,7 @@ RCsvDS::RCsvDS(std::string_view fileName, bool readHeaders, char delimiter, Long
       }
 
       // Infer types of columns with first record
-      InferColTypes(columns);
+      InferColTypes({columns});
 
       // rewind
       fCsvFile->Seek(fDataPos);
@@ -336,6 +517,14 @@ void RCsvDS::FreeRecords()
 RCsvDS::~RCsvDS()
 {
    FreeRecords();
+   if (fMapping != nullptr)
+      fCsvFile->Unmap(fMapping, fMappingSize);
+}
+
+void RCsvDS::Initialise()
+{
+   if (fMemoryMapped && !fLinesIndexed)
+      IndexLines();
 }
 
 void RCsvDS::Finalise()
@@ -353,29 +542,34 @@ const std::vector<std::string> &RCsvDS::GetColumnNames() const
 
 std::vector<std::pair<ULong64_t, ULong64_t>> RCsvDS::GetEntryRanges()
 {
+   std::size_t nRecords = 0;
+   if (fMemoryMapped) {
+      // All lines are available at once, the records are parsed in SetEntry
+      nRecords = 0ULL == fEntryRangesRequested ? fLineOffsets.size() : 0;
+   } else {
+      // Read records and store them in memory
+      auto linesToRead = fLinesChunkSize;
+      FreeRecords();
+
+      std::string line;
+      while ((-1LL == fLinesChunkSize || 0 != linesToRead) && fCsvFile->Readln(line)) {
+         if (line.empty()) continue; // skip empty lines
+         fRecords.emplace_back();
+         FillRecord(line, fRecords.back());
+         --linesToRead;
+      }
 
-   // Read records and store them in memory
-   auto linesToRead = fLinesChunkSize;
-   FreeRecords();
-
-   std::string line;
-   while ((-1LL == fLinesChunkSize || 0 != linesToRead) && fCsvFile->Readln(line)) {
-      if (line.empty()) continue; // skip empty lines
-      fRecords.emplace_back();
-      FillRecord(line, fRecords.back());
-      --linesToRead;
-   }
-
-   if (gDebug > 0) {
-      if (fLinesChunkSize == -1LL) {
-         Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", fRecords.size());
-      } else {
-         Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, fRecords.size());
+      if (gDebug > 0) {
+         if (fLinesChunkSize == -1LL) {
+            Info("GetEntryRanges", "Attempted to read entire CSV file into memory, %zu lines read", fRecords.size());
+         } else {
+            Info("GetEntryRanges", "Attempted to read chunk of %lld lines of CSV file into memory, %zu lines read", fLinesChunkSize, fRecords.size());
+         }
       }
+      nRecords = fRecords.size();
    }
 
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   const auto nRecords = fRecords.size();
    if (0 == nRecords)
       return entryRanges;
 
@@ -421,6 +615,40 @@ bool RCsvDS::HasColumn(std::string_view colName) const
 
 bool RCsvDS::SetEntry(unsigned int slot, ULong64_t entry)
 {
+   if (fMemoryMapped) {
+      const auto data = static_cast<const char *>(fMapping);
+      const char *next;
+      auto pos = data + fLineOffsets[entry];
+      const auto lineEnd = FindLineEnd(pos, data + fMappingSize, next);
+      auto &val = fSlotValues[slot];
+      int colIndex = 0;
+      for (auto &colType : fColTypesList) {
+         // strings are parsed in place, the values of the other columns are converted only if they are read
+         auto &dest = colType == 's' ? fStringEvtValues[colIndex][slot] : val;
+         pos = ParseValue(pos, lineEnd, dest);
+         if (pos != lineEnd)
+            ++pos; // skip the delimiter
+         if (colType != 's' && fColAddresses[colIndex][slot] != nullptr) {
+            switch (colType) {
+            case 'd': {
+               fDoubleEvtValues[colIndex][slot] = std::stod(val);
+               break;
+            }
+            case 'l': {
+               fLong64EvtValues[colIndex][slot] = std::stoll(val);
+               break;
+            }
+            case 'b': {
+               fBoolEvtValues[colIndex][slot] = val == "true";
+               break;
+            }
+            }
+         }
+         colIndex++;
+      }
+      return true;
+   }
+
    // Here we need to normalise the entry to the number of lines we already processed.
    const auto offset = (fEntryRangesRequested - 1) * fLinesChunkSize;
    const auto recordPos = entry - offset;
@@ -465,6 +693,7 @@ void RCsvDS::SetNSlots(unsigned int nSlots)
    fLong64EvtValues.resize(nColumns, std::vector<Long64_t>(fNSlots));
    fStringEvtValues.resize(nColumns, std::vector<std::string>(fNSlots));
    fBoolEvtValues.resize(nColumns, std::deque<bool>(fNSlots));
+   fSlotValues.resize(fNSlots);
 }
 
 std::string RCsvDS::GetLabel()
@@ -472,12 +701,25 @@ std::string RCsvDS::GetLabel()
    return "RCsv";
 }
 
+std::string RCsvDS::GetDatasetIdentifier()
+{
+   // the options that change the parsed values are part of the identifier too
+   return ROOT::Internal::RDF::GetFileIdentifier(fFileName) + " headers " + std::to_string(fReadHeaders) +
+          " delimiter " + fDelimiter;
+}
+
 RDataFrame MakeCsvDataFrame(std::string_view fileName, bool readHeaders, char delimiter, Long64_t linesChunkSize)
 {
    ROOT::RDataFrame tdf(std::make_unique<RCsvDS>(fileName, readHeaders, delimiter, linesChunkSize));
    return tdf;
 }
 
+RDataFrame MakeCsvDataFrame(std::string_view fileName, const RCsvDS::ROptions &options)
+{
+   ROOT::RDataFrame tdf(std::make_unique<RCsvDS>(fileName, options));
+   return tdf;
+}
+
 } // ns RDF
 
 } // ns ROOT
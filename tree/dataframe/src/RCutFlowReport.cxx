@@ -49,6 +49,22 @@ const TCutInfo &RCutFlowReport::operator[](std::string_view cutName)
    return *it;
 }
 
+/// Add the statistics of another report of the same cut flow, e.g. the report of another chunk of the same dataset.
+/// Throws if the two reports do not list the same cuts in the same order.
+void RCutFlowReport::Merge(const RCutFlowReport &other)
+{
+   const auto sameCuts =
+      fCutInfos.size() == other.fCutInfos.size() &&
+      std::equal(fCutInfos.begin(), fCutInfos.end(), other.fCutInfos.begin(),
+                 [](const TCutInfo &ci1, const TCutInfo &ci2) { return ci1.fName == ci2.fName; });
+   if (!sameCuts)
+      throw std::invalid_argument("Cannot merge the reports of different cut flows.");
+   for (std::size_t i = 0u; i < fCutInfos.size(); ++i) {
+      fCutInfos[i].fPass += other.fCutInfos[i].fPass;
+      fCutInfos[i].fAll += other.fCutInfos[i].fAll;
+   }
+}
+
 } // End NS RDF
 
 } // End NS ROOT
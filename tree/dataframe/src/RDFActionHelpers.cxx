@@ -9,6 +9,10 @@
  *************************************************************************/
 
 #include "ROOT/RDF/ActionHelpers.hxx"
+#include "TFileMerger.h"
+#include "TSystem.h"
+
+#include <cmath> // std::llround
 
 namespace ROOT {
 namespace Internal {
@@ -220,6 +224,71 @@ template void StdDevHelper::Exec(unsigned int, const std::vector<char> &);
 template void StdDevHelper::Exec(unsigned int, const std::vector<int> &);
 template void StdDevHelper::Exec(unsigned int, const std::vector<unsigned int> &);
 
+CountDistinctHelper::CountDistinctHelper(const std::shared_ptr<ULong64_t> &countPtr, unsigned int precision,
+                                         const unsigned int nSlots)
+   : fResultCount(countPtr), fSketches(nSlots, RHyperLogLog(precision))
+{
+}
+
+void CountDistinctHelper::Finalize()
+{
+   for (std::size_t i = 1u; i < fSketches.size(); ++i)
+      fSketches[0].Merge(fSketches[i]);
+   *fResultCount = std::llround(fSketches[0].Estimate());
+}
+
+QuantilesHelper::QuantilesHelper(const std::shared_ptr<std::vector<double>> &quantilesPtr,
+                                 const std::vector<double> &probabilities, double compression,
+                                 const unsigned int nSlots)
+   : fResultQuantiles(quantilesPtr), fProbabilities(probabilities),
+     fDigests(nSlots, RTDigest(compression))
+{
+}
+
+void QuantilesHelper::Exec(unsigned int slot, double v)
+{
+   fDigests[slot].Add(v);
+}
+
+void QuantilesHelper::Finalize()
+{
+   for (std::size_t i = 1u; i < fDigests.size(); ++i)
+      fDigests[0].Merge(fDigests[i]);
+   fResultQuantiles->clear();
+   for (auto p : fProbabilities)
+      fResultQuantiles->emplace_back(fDigests[0].Quantile(p));
+}
+
+template void QuantilesHelper::Exec(unsigned int, const std::vector<float> &);
+template void QuantilesHelper::Exec(unsigned int, const std::vector<double> &);
+template void QuantilesHelper::Exec(unsigned int, const std::vector<char> &);
+template void QuantilesHelper::Exec(unsigned int, const std::vector<int> &);
+template void QuantilesHelper::Exec(unsigned int, const std::vector<unsigned int> &);
+
+AdaptiveHistoHelper::AdaptiveHistoHelper(const std::shared_ptr<::TH1D> &h, ROOT::RDF::EAdaptiveBinning binning,
+                                         int nBins, double compression, const unsigned int nSlots)
+   : fResultHist(h), fBinning(binning), fNBins(nBins), fDigests(nSlots, RTDigest(compression))
+{
+}
+
+void AdaptiveHistoHelper::Exec(unsigned int slot, double v)
+{
+   fDigests[slot].Add(v);
+}
+
+void AdaptiveHistoHelper::Finalize()
+{
+   for (std::size_t i = 1u; i < fDigests.size(); ++i)
+      fDigests[0].Merge(fDigests[i]);
+   FillAdaptiveHisto(*fResultHist, fDigests[0], fBinning, fNBins);
+}
+
+template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<float> &);
+template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<double> &);
+template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<char> &);
+template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<int> &);
+template void AdaptiveHistoHelper::Exec(unsigned int, const std::vector<unsigned int> &);
+
 // External templates are disabled for gcc5 since this version wrongly omits the C++11 ABI attribute
 #if __GNUC__ > 5
 template class TakeHelper<bool, bool, std::vector<bool>>;
@@ -264,6 +333,44 @@ void ValidateSnapshotOutput(const RSnapshotOptions &opts, const std::string &tre
    }
 }
 
+void MergeSnapshotOutputs(const std::string &fileName, const std::string &dirName, const std::string &treeName,
+                          const RSnapshotOptions &opts, unsigned int nWorkers)
+{
+   const auto treePath = dirName.empty() ? treeName : dirName + "/" + treeName;
+   std::vector<std::string> partNames;
+   std::vector<std::string> toMerge;
+   for (auto i = 0u; i < nWorkers; ++i) {
+      partNames.emplace_back(GetPartialOutputName(fileName, i));
+      std::unique_ptr<TFile> part(TFile::Open(partNames.back().c_str(), "READ"));
+      if (!part || part->IsZombie())
+         throw std::runtime_error("Snapshot: could not open partial output file " + partNames.back());
+      // the branches of the output TTree are created when the first entry is written: workers that did not write any
+      // entry wrote a TTree without branches, which cannot be merged with the others
+      auto *tree = part->Get<TTree>(treePath.c_str());
+      if (tree != nullptr && tree->GetEntries() > 0)
+         toMerge.emplace_back(partNames.back());
+   }
+   if (toMerge.empty())
+      toMerge.emplace_back(partNames[0]);
+
+   bool ok = true;
+   {
+      // entries are written in the order of the workers, i.e. in the order of the input entries
+      TFileMerger merger(/*isLocal=*/false);
+      merger.SetMsgPrefix("Snapshot");
+      ok = merger.OutputFile(fileName.c_str(), opts.fMode.c_str(),
+                             ROOT::CompressionSettings(opts.fCompressionAlgorithm, opts.fCompressionLevel));
+      for (const auto &name : toMerge)
+         ok = ok && merger.AddFile(name.c_str(), /*cpProgress=*/false);
+      // in "update" mode the other contents of the output file are preserved
+      ok = ok && merger.PartialMerge(TFileMerger::kAllIncremental);
+   }
+   for (const auto &name : partNames)
+      gSystem->Unlink(name.c_str());
+   if (!ok)
+      throw std::runtime_error("Snapshot: could not merge the partial output files into " + fileName);
+}
+
 } // end NS RDF
 } // end NS Internal
 } // end NS ROOT
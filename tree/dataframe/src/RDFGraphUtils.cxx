@@ -10,6 +10,7 @@
 
 #include "ROOT/RDF/RBookedDefines.hxx"
 #include "ROOT/RDF/GraphUtils.hxx"
+#include "ROOT/RDF/RProfiler.hxx"
 
 #include <algorithm> // std::find
 
@@ -98,7 +99,10 @@ CreateDefineNode(const std::string &columnName, const ROOT::Detail::RDF::RDefine
       return duplicateDefine;
    }
 
-   auto node = std::make_shared<GraphNode>("Define\n" + columnName);
+   auto label = "Define\n" + columnName;
+   if (columnPtr->GetProfile() != nullptr && !columnPtr->GetProfile()->GetSummary().empty())
+      label += "\n" + columnPtr->GetProfile()->GetSummary();
+   auto node = std::make_shared<GraphNode>(label);
    node->SetDefine();
 
    sColumnsMap[columnPtr] = node;
@@ -116,6 +120,8 @@ std::shared_ptr<GraphNode> CreateFilterNode(const ROOT::Detail::RDF::RFilterBase
       return duplicateFilter;
    }
    auto filterName = (filterPtr->HasName() ? filterPtr->GetName() : "Filter");
+   if (filterPtr->GetProfile() != nullptr && !filterPtr->GetProfile()->GetSummary().empty())
+      filterName += "\n" + filterPtr->GetProfile()->GetSummary();
    auto node = std::make_shared<GraphNode>(filterName);
 
    sFiltersMap[filterPtr] = node;
@@ -133,7 +139,11 @@ std::shared_ptr<GraphNode> CreateRangeNode(const ROOT::Detail::RDF::RRangeBase *
       duplicateRange->SetIsNew(false);
       return duplicateRange;
    }
-   auto node = std::make_shared<GraphNode>("Range");
+   std::string name = "Range(" + std::to_string(rangePtr->GetStart()) + ", " + std::to_string(rangePtr->GetStop());
+   if (rangePtr->GetStride() != 1u)
+      name += ", " + std::to_string(rangePtr->GetStride());
+   name += ")";
+   auto node = std::make_shared<GraphNode>(name);
    node->SetRange();
 
    sRangesMap[rangePtr] = node;
@@ -20,6 +20,41 @@
 
 using ROOT::RDF::RResultHandle;
 
+void ROOT::RDF::EnableBulkProcessing(RNode node, unsigned int bulkSize)
+{
+   ROOT::Internal::RDF::GetLoopManager(node).SetBulkSize(bulkSize);
+}
+
+void ROOT::RDF::EnableGraphOptimization(RNode node, unsigned int nWarmUpEntries)
+{
+   ROOT::Internal::RDF::GetLoopManager(node).SetGraphOptimization(nWarmUpEntries);
+}
+
+void ROOT::RDF::EnableProfiling(RNode node, bool enable)
+{
+   ROOT::Internal::RDF::GetLoopManager(node).SetProfiling(enable);
+}
+
+void ROOT::RDF::EnableMultiProcessing(RNode node, unsigned int nWorkers)
+{
+   ROOT::Internal::RDF::GetLoopManager(node).SetNWorkers(nWorkers);
+}
+
+void ROOT::RDF::EnableIncrementalProcessing(RNode node, std::string_view stateFileName)
+{
+   ROOT::Internal::RDF::GetLoopManager(node).SetIncrementalStateFileName(std::string(stateFileName));
+}
+
+ROOT::RDF::RProfileReport ROOT::RDF::GetProfileReport(RNode node)
+{
+   return ROOT::Internal::RDF::GetLoopManager(node).GetProfileReport();
+}
+
+void ROOT::RDF::SetJitCacheDir(std::string_view dir)
+{
+   ROOT::Internal::RDF::SetJitCacheDir(dir);
+}
+
 void ROOT::RDF::RunGraphs(std::vector<RResultHandle> handles)
 {
    if (handles.empty()) {
@@ -9,19 +9,29 @@
  *************************************************************************/
 
 #include <ROOT/RDF/InterfaceUtils.hxx>
+#include <ROOT/RDF/RDefineBase.hxx>
+#include <ROOT/RDF/RFilterBase.hxx>
+#include <ROOT/RDF/RRangeBase.hxx>
+#include <ROOT/RDF/Utils.hxx> // RDFLogChannel
+#include <ROOT/InternalTreeUtils.hxx> // GetFileNamesFromTree, GetFriendInfo
 #include <ROOT/RDataFrame.hxx>
+#include <ROOT/RLogger.hxx>
 #include <ROOT/RStringView.hxx>
 #include <ROOT/TSeq.hxx>
 #include <RtypesCore.h>
 #include <TDirectory.h>
 #include <TChain.h>
+#include <TEntryList.h>
+#include <TFile.h>
 #include <TClass.h>
 #include <TClassEdit.h>
 #include <TFriendElement.h>
 #include <TInterpreter.h>
 #include <TObject.h>
+#include <TMD5.h>
 #include <TPRegexp.h>
 #include <TString.h>
+#include <TSystem.h>
 #include <TTree.h>
 
 // pragma to disable warnings on Rcpp which have
@@ -191,14 +201,11 @@ static std::unordered_map<std::string, std::string> &GetJittedExprs() {
    return jittedExpressions;
 }
 
-static std::string
-BuildLambdaString(const std::string &expr, const ColumnNames_t &vars, const ColumnNames_t &varTypes)
+/// Return the parameter list of the lambda that wraps a jitted expression, e.g. "const int x, MyClass& y".
+static std::string BuildLambdaParams(const ColumnNames_t &vars, const ColumnNames_t &varTypes)
 {
    assert(vars.size() == varTypes.size());
 
-   TPRegexp re(R"(\breturn\b)");
-   const bool hasReturnStmt = re.MatchB(expr);
-
    static const std::vector<std::string> fundamentalTypes = {
       "int",
       "signed",
@@ -233,7 +240,6 @@ BuildLambdaString(const std::string &expr, const ColumnNames_t &vars, const Colu
    };
 
    std::stringstream ss;
-   ss << "[](";
    for (auto i = 0u; i < vars.size(); ++i) {
       std::string fullType;
       const auto &type = varTypes[i];
@@ -247,16 +253,35 @@ BuildLambdaString(const std::string &expr, const ColumnNames_t &vars, const Colu
       }
       ss << fullType << vars[i] << ", ";
    }
+   std::string params = ss.str();
    if (!vars.empty())
-      ss.seekp(-2, ss.cur);
+      params.resize(params.size() - 2); // remove the last ", "
 
-   if (hasReturnStmt)
-      ss << "){";
-   else
-      ss << "){return ";
-   ss << expr << "\n;}";
+   return params;
+}
+
+/// Return the body of the lambda that wraps a jitted expression.
+static std::string BuildLambdaBody(const std::string &expr)
+{
+   TPRegexp re(R"(\breturn\b)");
+   const bool hasReturnStmt = re.MatchB(expr);
+   return (hasReturnStmt ? "{" : "{return ") + expr + "\n;}";
+}
 
-   return ss.str();
+static std::string
+BuildLambdaString(const std::string &expr, const ColumnNames_t &vars, const ColumnNames_t &varTypes)
+{
+   return "[](" + BuildLambdaParams(vars, varTypes) + ")" + BuildLambdaBody(expr);
+}
+
+/// Each jitted lambda comes with a lambda_ret_t type alias for its return type.
+/// Resolve that alias and return the true type as string.
+static std::string RetTypeOfLambda(const std::string &lambdaName)
+{
+   const auto dt = gROOT->GetType((lambdaName + "_ret_t").c_str());
+   R__ASSERT(dt != nullptr);
+   const auto type = dt->GetFullTypeName();
+   return type;
 }
 
 /// Declare a lambda expression to the interpreter in namespace R_rdf, return the name of the jitted lambda.
@@ -289,14 +314,49 @@ static std::string DeclareLambda(const std::string &expr, const ColumnNames_t &v
    return lambdaFullName;
 }
 
-/// Each jitted lambda comes with a lambda_ret_t type alias for its return type.
-/// Resolve that alias and return the true type as string.
-static std::string RetTypeOfLambda(const std::string &lambdaName)
+/// A jitted expression: the lambda declared to the interpreter or, if the expression was found in the jit cache, the
+/// compiled function that builds its node.
+struct RJittedExpr {
+   std::string fName;    ///< Identifies the expression, e.g. to merge equivalent nodes
+   std::string fRetType; ///< Return type of the expression
+   ROOT::Internal::RDF::JitCacheBookFunc_t fCachedBook = nullptr; ///< Non-null if the expression was in the jit cache
+};
+
+/// Declare a jitted expression to the interpreter (see DeclareLambda), unless the jit cache is enabled and already
+/// contains the expression compiled for the node of type `kind`, in which case nothing is jitted.
+static RJittedExpr JitExpression(ROOT::Internal::RDF::EJitCacheKind kind, const std::string &expr,
+                                 const ColumnNames_t &vars, const ColumnNames_t &varTypes)
 {
-   const auto dt = gROOT->GetType((lambdaName + "_ret_t").c_str());
-   R__ASSERT(dt != nullptr);
-   const auto type = dt->GetFullTypeName();
-   return type;
+   if (ROOT::Internal::RDF::GetJitCacheDir().empty()) {
+      const auto lambdaName = DeclareLambda(expr, vars, varTypes);
+      return {lambdaName, RetTypeOfLambda(lambdaName)};
+   }
+
+   const auto key = ROOT::Internal::RDF::GetJitCacheKey(kind, BuildLambdaString(expr, vars, varTypes), varTypes);
+   std::string retType;
+   if (auto book = ROOT::Internal::RDF::FindInJitCache(key, retType))
+      return {"R_rdf_jitcache::f_" + key, retType, book};
+
+   const auto lambdaName = DeclareLambda(expr, vars, varTypes);
+   retType = RetTypeOfLambda(lambdaName);
+   ROOT::Internal::RDF::AddToJitCache(kind, key, retType, BuildLambdaParams(vars, varTypes), BuildLambdaBody(expr),
+                                      varTypes);
+   return {lambdaName, retType};
+}
+
+/// Schedule the call to the function of the jit cache that builds a jitted node, in place of the jitted call to
+/// JitFilterHelper or JitDefineHelper. The pointers have the same meaning and lifetime as in those calls.
+static void BookCachedJitCall(ROOT::Detail::RDF::RLoopManager &lm, ROOT::Internal::RDF::JitCacheBookFunc_t book,
+                              const ColumnNames_t &cols, std::string_view name, void *wkNode, void *defines,
+                              void *prevNode)
+{
+   lm.ToCachedJitExec([book, cols, name = std::string(name), lmPtr = &lm, wkNode, defines, prevNode] {
+      // deleted by the helper, like the array built by the jitted call
+      auto colsPtr = new const char *[cols.size()];
+      for (auto i = 0u; i < cols.size(); ++i)
+         colsPtr[i] = cols[i].c_str();
+      book(colsPtr, cols.size(), name.c_str(), lmPtr, wkNode, defines, prevNode);
+   });
 }
 
 static void GetTopLevelBranchNamesImpl(TTree &t, std::set<std::string> &bNamesReg, ColumnNames_t &bNames,
@@ -336,6 +396,97 @@ static void GetTopLevelBranchNamesImpl(TTree &t, std::set<std::string> &bNamesRe
    }
 }
 
+/// Return a string that identifies the input dataset of a computation graph, for the purpose of persistent caching.
+/// For TTree datasets, it includes names, sizes and modification times of the input files (when available). Data
+/// sources identify their dataset via RDataSource::GetDatasetIdentifier: if they cannot, a `key` is required.
+std::string GetDatasetIdentifier(ROOT::Detail::RDF::RLoopManager &lm, std::string_view key)
+{
+   if (auto *ds = lm.GetDataSource()) {
+      const auto dsId = ds->GetDatasetIdentifier();
+      if (dsId.empty() && key.empty())
+         throw std::runtime_error("PersistentCache: the " + ds->GetLabel() +
+                                  " data source cannot identify its dataset. Pass a key that changes whenever the "
+                                  "dataset changes.");
+      std::string id = "data source " + ds->GetLabel() + "\n" + dsId + "\n";
+      for (const auto &col : ds->GetColumnNames())
+         id += col + "\n";
+      return id;
+   }
+
+   auto *tree = lm.GetTree();
+   if (tree == nullptr)
+      return "empty source " + std::to_string(lm.GetNEmptyEntries()) + "\n";
+
+   std::vector<std::string> fileNames;
+   try {
+      fileNames = ROOT::Internal::TreeUtils::GetFileNamesFromTree(*tree);
+   } catch (const std::runtime_error &) {
+      throw std::runtime_error("PersistentCache: datasets that are not stored in files cannot be cached persistently.");
+   }
+   for (const auto &friendFileNames : ROOT::Internal::TreeUtils::GetFriendInfo(*tree).fFriendFileNames)
+      fileNames.insert(fileNames.end(), friendFileNames.begin(), friendFileNames.end());
+
+   std::string id = "tree " + std::string(tree->GetName()) + "\n";
+   for (const auto &fileName : fileNames)
+      id += ROOT::Internal::RDF::GetFileIdentifier(fileName) + "\n";
+   if (auto *entryList = tree->GetEntryList())
+      id += "entry list " + std::string(entryList->GetName()) + " " + std::to_string(entryList->GetN()) + "\n";
+   return id;
+}
+
+/// Return a string that identifies the computation graph upstream of a node, for the purpose of persistent caching: it
+/// includes names and expressions of the upstream Filters, parameters of the upstream Ranges, names, types and
+/// expressions of the Defines available at the node and the aliases. Filters and Defines that evaluate C++ callables
+/// are only identified by their name: hasCallables is set to true if there are any.
+std::string GetGraphIdentifier(ROOT::Detail::RDF::RNodeBase *node, const ROOT::Internal::RDF::RBookedDefines &defines,
+                               ROOT::Detail::RDF::RLoopManager &lm, bool &hasCallables)
+{
+   std::string id;
+   hasCallables = false;
+   while (node != nullptr) {
+      if (auto *filter = dynamic_cast<ROOT::Detail::RDF::RFilterBase *>(node)) {
+         hasCallables |= filter->GetExpression().empty();
+         id += "filter " + filter->GetName() + ": " + filter->GetExpression() + "\n";
+         node = filter->GetPrevNode();
+      } else if (auto *range = dynamic_cast<ROOT::Detail::RDF::RRangeBase *>(node)) {
+         id += "range " + std::to_string(range->GetStart()) + " " + std::to_string(range->GetStop()) + " " +
+               std::to_string(range->GetStride()) + "\n";
+         node = range->GetPrevNode();
+      } else {
+         break; // the RLoopManager
+      }
+   }
+
+   // all the Defines upstream, sorted by name
+   for (const auto &nameAndDefine : defines.GetColumns()) {
+      if (ROOT::Internal::RDF::IsInternalColumn(nameAndDefine.first))
+         continue;
+      const auto &define = *nameAndDefine.second;
+      hasCallables |= define.GetExpression().empty();
+      id += "define " + nameAndDefine.first + " " + define.GetTypeName() + ": " + define.GetExpression() + "\n";
+   }
+   for (const auto &alias : lm.GetAliasMap())
+      id += "alias " + alias.first + " " + alias.second + "\n";
+   return id;
+}
+
+/// Check whether a cache file written by a previous PersistentCache call exists and contains the required columns.
+bool IsValidPersistentCache(const std::string &fileName, const std::string &treeName, const ColumnNames_t &columns)
+{
+   if (gSystem->AccessPathName(fileName.c_str()))
+      return false;
+
+   ::TDirectory::TContext ctxt;
+   std::unique_ptr<TFile> f(TFile::Open(fileName.c_str(), "READ"));
+   if (!f || f->IsZombie())
+      return false;
+   auto *tree = f->Get<TTree>(treeName.c_str());
+   if (tree == nullptr)
+      return false;
+   return std::all_of(columns.begin(), columns.end(),
+                      [tree](const std::string &col) { return tree->GetBranch(col.c_str()) != nullptr; });
+}
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -620,11 +771,27 @@ std::string PrettyPrintAddr(const void *const addr)
    return s.str();
 }
 
-/// Book the jitting of a Filter call
-void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
-                   std::shared_ptr<RDFDetail::RNodeBase> *prevNodeOnHeap, std::string_view name,
-                   std::string_view expression, const std::map<std::string, std::string> &aliasMap,
-                   const ColumnNames_t &branches, const RBookedDefines &customCols, TTree *tree, RDataSource *ds)
+/// Return a string that identifies a jitted Filter or Define for the purpose of merging equivalent nodes: nodes with
+/// the same key evaluate the same expression on the same input values. Input columns that are Defines are identified
+/// by the address of the RDefineBase object, other columns by their name.
+static std::string GetJittedNodeKey(const std::string &lambdaName, const ColumnNames_t &usedCols,
+                                    const RBookedDefines &customCols)
+{
+   const auto &defines = customCols.GetColumns();
+   std::string key = lambdaName;
+   for (const auto &col : usedCols) {
+      const auto defineIt = defines.find(col);
+      key += ';' + (defineIt != defines.end() ? PrettyPrintAddr(defineIt->second.get()) : col);
+   }
+   return key;
+}
+
+/// Book the jitting of a Filter call and return the corresponding node. If graph optimizations are enabled and an
+/// unnamed Filter with the same expression and input columns is already attached to the same node, return that one.
+std::shared_ptr<RJittedFilter>
+BookFilterJit(std::shared_ptr<RDFDetail::RNodeBase> *prevNodeOnHeap, std::string_view name,
+              std::string_view expression, const std::map<std::string, std::string> &aliasMap,
+              const ColumnNames_t &branches, const RBookedDefines &customCols, TTree *tree, RDataSource *ds)
 {
    const auto &dsColumns = ds ? ds->GetColumnNames() : ColumnNames_t{};
 
@@ -632,13 +799,40 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
       ParseRDFExpression(expression, branches, customCols.GetNames(), dsColumns, aliasMap);
    const auto exprVarTypes =
       GetValidatedArgTypes(parsedExpr.fUsedCols, customCols, tree, ds, "Filter", /*vector2rvec=*/true);
-   const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
-   const auto type = RetTypeOfLambda(lambdaName);
+   const auto jittedExpr = JitExpression(EJitCacheKind::kFilter, parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
+   const auto &lambdaName = jittedExpr.fName;
+   const auto &type = jittedExpr.fRetType;
    if (type != "bool")
       std::runtime_error("Filter: the following expression does not evaluate to bool:\n" + std::string(expression));
 
+   auto lm = (*prevNodeOnHeap)->GetLoopManagerUnchecked();
+   // named filters are never merged, as each of them must appear in the cut-flow report
+   const bool canMerge = lm->IsGraphOptimizationEnabled() && name.empty();
+   const auto key = canMerge ? GetJittedNodeKey(lambdaName, parsedExpr.fUsedCols, customCols) + ';' +
+                                  PrettyPrintAddr(prevNodeOnHeap->get())
+                             : std::string();
+   if (canMerge) {
+      if (auto equivalentFilter = lm->GetEquivalentJittedFilter(key)) {
+         delete prevNodeOnHeap;
+         return equivalentFilter;
+      }
+   }
+
+   const auto jittedFilter = std::make_shared<RDFDetail::RJittedFilter>(lm, name);
+   jittedFilter->SetExpression(expression);
+
    // definesOnHeap is deleted by the jitted call to JitFilterHelper
    ROOT::Internal::RDF::RBookedDefines *definesOnHeap = new ROOT::Internal::RDF::RBookedDefines(customCols);
+
+   if (jittedExpr.fCachedBook) {
+      BookCachedJitCall(*lm, jittedExpr.fCachedBook, parsedExpr.fUsedCols, name, MakeWeakOnHeap(jittedFilter),
+                        definesOnHeap, prevNodeOnHeap);
+      lm->Book(jittedFilter.get());
+      if (canMerge)
+         lm->RegisterJittedFilter(key, jittedFilter);
+      return jittedFilter;
+   }
+
    const auto definesOnHeapAddr = PrettyPrintAddr(definesOnHeap);
    const auto prevNodeAddr = PrettyPrintAddr(prevNodeOnHeap);
 
@@ -662,11 +856,16 @@ void BookFilterJit(const std::shared_ptr<RJittedFilter> &jittedFilter,
                     << "reinterpret_cast<ROOT::Internal::RDF::RBookedDefines*>(" << definesOnHeapAddr << ")"
                     << ");\n";
 
-   auto lm = jittedFilter->GetLoopManagerUnchecked();
    lm->ToJitExec(filterInvocation.str());
+   lm->Book(jittedFilter.get());
+   if (canMerge)
+      lm->RegisterJittedFilter(key, jittedFilter);
+
+   return jittedFilter;
 }
 
-/// Book the jitting of a Define call
+/// Book the jitting of a Define call. If graph optimizations are enabled and a Define with the same expression and
+/// input columns has already been booked, the returned node shares the computed values with that one.
 std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_view expression, RLoopManager &lm,
                                              RDataSource *ds, const RBookedDefines &customCols,
                                              const ColumnNames_t &branches,
@@ -680,12 +879,29 @@ std::shared_ptr<RJittedDefine> BookDefineJit(std::string_view name, std::string_
       ParseRDFExpression(expression, branches, customCols.GetNames(), dsColumns, aliasMap);
    const auto exprVarTypes =
       GetValidatedArgTypes(parsedExpr.fUsedCols, customCols, tree, ds, "Define", /*vector2rvec=*/true);
-   const auto lambdaName = DeclareLambda(parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
-   const auto type = RetTypeOfLambda(lambdaName);
+   const auto jittedExpr = JitExpression(EJitCacheKind::kDefine, parsedExpr.fExpr, parsedExpr.fVarNames, exprVarTypes);
+   const auto &lambdaName = jittedExpr.fName;
+   auto jittedDefine = std::make_shared<RDFDetail::RJittedDefine>(name, jittedExpr.fRetType, lm);
+   jittedDefine->SetExpression(expression);
+
+   const auto key =
+      lm.IsGraphOptimizationEnabled() ? GetJittedNodeKey(lambdaName, parsedExpr.fUsedCols, customCols) : std::string();
+   if (lm.IsGraphOptimizationEnabled()) {
+      if (auto equivalentDefine = lm.GetEquivalentJittedDefine(key)) {
+         jittedDefine->SetDefine(std::move(equivalentDefine));
+         delete upcastNodeOnHeap;
+         return jittedDefine;
+      }
+      lm.RegisterJittedDefine(key, jittedDefine);
+   }
 
    auto definesCopy = new RBookedDefines(customCols);
+   if (jittedExpr.fCachedBook) {
+      BookCachedJitCall(lm, jittedExpr.fCachedBook, parsedExpr.fUsedCols, name, MakeWeakOnHeap(jittedDefine),
+                        definesCopy, upcastNodeOnHeap);
+      return jittedDefine;
+   }
    auto definesAddr = PrettyPrintAddr(definesCopy);
-   auto jittedDefine = std::make_shared<RDFDetail::RJittedDefine>(name, type, lm.GetNSlots(), lm.GetDSValuePtrs());
 
    std::stringstream defineInvocation;
    defineInvocation << "ROOT::Internal::RDF::JitDefineHelper<ROOT::Internal::RDF::DefineTypes::RDefineTag>("
@@ -716,13 +932,19 @@ std::shared_ptr<RJittedDefine> BookDefinePerSampleJit(std::string_view name, std
                                                       RLoopManager &lm, const RBookedDefines &customCols,
                                                       std::shared_ptr<RNodeBase> *upcastNodeOnHeap)
 {
-   const auto lambdaName = DeclareLambda(std::string(expression), {"rdfslot_", "rdfsampleinfo_"},
-                                         {"unsigned int", "const ROOT::RDF::RSampleInfo"});
-   const auto retType = RetTypeOfLambda(lambdaName);
+   const auto jittedExpr = JitExpression(EJitCacheKind::kDefinePerSample, std::string(expression),
+                                         {"rdfslot_", "rdfsampleinfo_"}, {"unsigned int", "const ROOT::RDF::RSampleInfo"});
+   const auto &lambdaName = jittedExpr.fName;
 
    auto definesCopy = new RBookedDefines(customCols);
+   auto jittedDefine = std::make_shared<RDFDetail::RJittedDefine>(name, jittedExpr.fRetType, lm);
+   jittedDefine->SetExpression(expression);
+   if (jittedExpr.fCachedBook) {
+      BookCachedJitCall(lm, jittedExpr.fCachedBook, {}, name, MakeWeakOnHeap(jittedDefine), definesCopy,
+                        upcastNodeOnHeap);
+      return jittedDefine;
+   }
    auto definesAddr = PrettyPrintAddr(definesCopy);
-   auto jittedDefine = std::make_shared<RDFDetail::RJittedDefine>(name, retType, lm.GetNSlots(), lm.GetDSValuePtrs());
 
    std::stringstream defineInvocation;
    defineInvocation << "ROOT::Internal::RDF::JitDefineHelper<ROOT::Internal::RDF::DefineTypes::RDefinePerSampleTag>("
@@ -899,6 +1121,72 @@ void TriggerRun(ROOT::RDF::RNode &node){
    node.fLoopManager->Run();
 }
 
+ROOT::Detail::RDF::RLoopManager &GetLoopManager(ROOT::RDF::RNode &node)
+{
+   return *node.fLoopManager;
+}
+
+/// Return the path of the cache file for the columns of `node`, write it via `writeCache` if it does not exist yet.
+/// The name of the cache file is a hash of everything the cached values depend on: the computation graph upstream of
+/// `node` (including the expressions of jitted Filters and Defines and the types of the Defines), the cached columns
+/// and their types, the input dataset (including sizes and modification times of the input files) and the
+/// user-provided `key`. The code of C++ callables cannot be hashed: if the graph contains any, a `key` is required.
+/// `writeCache` is called with the name of the tree and of the file that must be written.
+/// Return a RLoopManager that reads the cached columns.
+std::shared_ptr<ROOT::Detail::RDF::RLoopManager>
+GetOrMakePersistentCache(ROOT::Detail::RDF::RNodeBase *node, const RBookedDefines &defines,
+                         ROOT::Detail::RDF::RLoopManager &lm, const ColumnNames_t &columns,
+                         const std::vector<std::string> &columnTypes, std::string_view cacheDir, std::string_view key,
+                         const std::function<void(const std::string &, const std::string &)> &writeCache)
+{
+   const std::string treeName = "rdfcache";
+
+   bool hasCallables = false;
+   std::string id = "RDataFrame persistent cache\n";
+   id += GetGraphIdentifier(node, defines, lm, hasCallables);
+   if (hasCallables && key.empty())
+      throw std::runtime_error(
+         "PersistentCache: the computation graph contains Filters or Defines that evaluate C++ callables, whose code "
+         "cannot be part of the cache identifier. Pass a key that changes whenever their code changes.");
+   for (auto i = 0u; i < columns.size(); ++i)
+      id += columns[i] + " " + columnTypes[i] + "\n";
+   id += GetDatasetIdentifier(lm, key);
+   id += "key " + std::string(key);
+
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(id.data()), id.size());
+   md5.Final();
+
+   const std::string dir = cacheDir.empty() ? std::string(".") : std::string(cacheDir);
+   if (gSystem->AccessPathName(dir.c_str()) && gSystem->mkdir(dir.c_str(), /*recursive=*/true) != 0)
+      throw std::runtime_error("PersistentCache: could not create directory \"" + dir + "\".");
+   const std::string fileName = dir + "/rdfcache_" + md5.AsString() + ".root";
+
+   if (IsValidPersistentCache(fileName, treeName, columns)) {
+      R__LOG_INFO(RDFLogChannel()) << "PersistentCache: reading cached columns from " << fileName << '.';
+   } else {
+      // write to a temporary file first, so that concurrent processes never read a partially written cache
+      const std::string tmpFileName = fileName + "." + std::to_string(gSystem->GetPid()) + ".tmp";
+      try {
+         writeCache(treeName, tmpFileName);
+      } catch (...) {
+         gSystem->Unlink(tmpFileName.c_str());
+         throw;
+      }
+      if (gSystem->Rename(tmpFileName.c_str(), fileName.c_str()) != 0) {
+         gSystem->Unlink(tmpFileName.c_str());
+         throw std::runtime_error("PersistentCache: could not write cache file \"" + fileName + "\".");
+      }
+      R__LOG_INFO(RDFLogChannel()) << "PersistentCache: cached columns written to " << fileName << '.';
+   }
+
+   auto cacheLm = std::make_shared<ROOT::Detail::RDF::RLoopManager>(nullptr, ColumnNames_t{});
+   auto chain = std::make_shared<TChain>(treeName.c_str());
+   chain->Add(fileName.c_str());
+   cacheLm->SetTree(chain);
+   return cacheLm;
+}
+
 } // namespace RDF
 } // namespace Internal
 } // namespace ROOT
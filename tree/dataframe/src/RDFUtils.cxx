@@ -25,10 +25,19 @@
 #include "TLeaf.h"
 #include "TROOT.h" // IsImplicitMTEnabled, GetThreadPoolSize
 #include "TTree.h"
+#include "TEnv.h"
+#include "TMD5.h"
+#include "TSystem.h"
+#include "TVirtualMutex.h" // R__LOCKGUARD
 
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <cstring>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <sstream>
 #include <typeinfo>
 
 using namespace ROOT::Detail::RDF;
@@ -365,6 +374,287 @@ Long64_t InterpreterCalc(const std::string &code, const std::string &context)
    return 0; // we used to forward the return value of Calc, but that's not possible anymore.
 }
 
+namespace {
+/// A jitted expression that will be compiled in the jit cache by WriteJitCache
+struct RJitCacheEntry {
+   std::string fKey;
+   std::string fRetType;
+   std::string fCode;
+   std::set<std::string> fHeaders;
+};
+
+std::string &JitCacheDir()
+{
+   static std::string dir = gEnv->GetValue("RDataFrame.JitCacheDir", "");
+   return dir;
+}
+
+std::vector<RJitCacheEntry> &PendingJitCacheEntries()
+{
+   static std::vector<RJitCacheEntry> entries;
+   return entries;
+}
+
+std::string JitCacheIndexFile(const std::string &key)
+{
+   return GetJitCacheDir() + "/rdfjit_" + key + ".txt";
+}
+
+std::string JitCacheBookFuncName(const std::string &key)
+{
+   return "R_rdf_jitcache_book_" + key;
+}
+
+std::string MD5Of(const std::string &str)
+{
+   TMD5 md5;
+   md5.Update(reinterpret_cast<const UChar_t *>(str.data()), str.size());
+   md5.Final();
+   return md5.AsString();
+}
+
+/// Return the headers that declare the classes among `types`.
+std::set<std::string> GetHeadersOfTypes(const std::vector<std::string> &types)
+{
+   std::set<std::string> headers;
+   for (const auto &type : types) {
+      auto *cl = TClass::GetClass(type.c_str());
+      if (cl != nullptr && cl->GetDeclFileName() != nullptr && std::strlen(cl->GetDeclFileName()) > 0)
+         headers.insert(cl->GetDeclFileName());
+   }
+   return headers;
+}
+
+/// Return the path of `header` in the include path of the interpreter, or an empty string if it cannot be found.
+std::string FindHeader(const std::string &header)
+{
+   if (gSystem->IsAbsoluteFileName(header.c_str()))
+      return gSystem->AccessPathName(header.c_str()) ? "" : header;
+
+   std::istringstream includePath(gInterpreter->GetIncludePath());
+   std::string flag;
+   while (includePath >> flag) {
+      if (flag.rfind("-I", 0) != 0)
+         continue;
+      std::string dir = flag.substr(2);
+      dir.erase(std::remove(dir.begin(), dir.end(), '"'), dir.end());
+      const auto path = dir + "/" + header;
+      if (!gSystem->AccessPathName(path.c_str()))
+         return path;
+   }
+   return "";
+}
+
+/// Write `content` to `fileName` atomically, i.e. via a temporary file, so that concurrent processes that use the
+/// same jit cache never read partially written files.
+void WriteFileAtomically(const std::string &fileName, const std::string &content)
+{
+   const auto tmpFileName = fileName + "." + std::to_string(gSystem->GetPid()) + ".tmp";
+   {
+      std::ofstream out(tmpFileName);
+      out << content;
+   }
+   if (gSystem->Rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+      gSystem->Unlink(tmpFileName.c_str());
+}
+
+/// Compile the code of `entries` with ACLiC in the library `libBaseName`. Return the name of the library, or an empty
+/// string if the compilation failed.
+std::string CompileJitCacheEntries(const std::vector<const RJitCacheEntry *> &entries, const std::string &libBaseName)
+{
+   std::set<std::string> headers;
+   for (const auto *e : entries)
+      headers.insert(e->fHeaders.begin(), e->fHeaders.end());
+
+   std::string code = "// Expressions jitted by RDataFrame, see ROOT::RDF::SetJitCacheDir\n"
+                      "#include \"ROOT/RDataFrame.hxx\"\n#include \"TMath.h\"\n#include <cmath>\n";
+   for (const auto &header : headers)
+      code += "#include \"" + header + "\"\n";
+   for (const auto *e : entries)
+      code += e->fCode;
+   const auto sourceFile = libBaseName + ".C";
+   WriteFileAtomically(sourceFile, code);
+
+   // ACLiC writes the library in place: it is built under a name that is private to this process and then renamed,
+   // so that concurrent processes never load a partially written library, nor overwrite one that is being loaded.
+   // The dictionary pcm keeps the private name, which is the one the library refers to.
+   const auto tmpBaseName = libBaseName + "_" + std::to_string(gSystem->GetPid());
+   // k: keep the library, c: do not load it in this process (the expressions have already been jitted),
+   // O: optimize, s: silence informational output
+   if (gSystem->CompileMacro(sourceFile.c_str(), "kcOs", tmpBaseName.c_str()) == 0)
+      return "";
+   gSystem->Unlink((tmpBaseName + "_C.d").c_str()); // the dependency file of a library that is never rebuilt
+   const auto tmpLibrary = tmpBaseName + "." + gSystem->GetSoExt();
+   const auto library = libBaseName + "." + gSystem->GetSoExt();
+   // if the library cannot be renamed, it is used under its private name
+   return gSystem->Rename(tmpLibrary.c_str(), library.c_str()) == 0 ? library : tmpLibrary;
+}
+} // anonymous namespace
+
+void SetJitCacheDir(std::string_view dir)
+{
+   R__LOCKGUARD(gROOTMutex);
+   std::string d(dir);
+   if (!d.empty() && !gSystem->IsAbsoluteFileName(d.c_str()))
+      d = std::string(gSystem->WorkingDirectory()) + "/" + d;
+   JitCacheDir() = std::move(d);
+}
+
+const std::string &GetJitCacheDir()
+{
+   return JitCacheDir();
+}
+
+std::string GetJitCacheKey(EJitCacheKind kind, const std::string &lambdaExpr, const std::vector<std::string> &types)
+{
+   // compiled code is only reused with the same ROOT version and the same contents of the headers it depends on
+   std::string keyStr = std::to_string(static_cast<int>(kind)) + ';' + lambdaExpr + ';' + gROOT->GetVersion();
+   for (const auto &header : GetHeadersOfTypes(types)) {
+      keyStr += ';' + header;
+      const auto path = FindHeader(header);
+      std::unique_ptr<TMD5> checksum(path.empty() ? nullptr : TMD5::FileChecksum(path.c_str()));
+      if (checksum)
+         keyStr += ':' + std::string(checksum->AsString());
+   }
+   return MD5Of(keyStr);
+}
+
+JitCacheBookFunc_t FindInJitCache(const std::string &key, std::string &retType)
+{
+   R__LOCKGUARD(gROOTMutex);
+   std::ifstream index(JitCacheIndexFile(key));
+   std::string library;
+   if (!index || !std::getline(index, library) || !std::getline(index, retType) || library.empty())
+      return nullptr; // not in the cache, or an expression that cannot be compiled outside of the interpreter
+
+   if (gSystem->AccessPathName(library.c_str()) || gSystem->Load(library.c_str()) < 0)
+      return nullptr;
+   auto book = reinterpret_cast<JitCacheBookFunc_t>(
+      gSystem->DynFindSymbol(library.c_str(), JitCacheBookFuncName(key).c_str()));
+   if (book == nullptr)
+      return nullptr;
+
+   R__LOG_DEBUG(10, RDFLogChannel()) << "Using jitted expression " << key << " from the jit cache (" << library << ")";
+   return book;
+}
+
+void AddToJitCache(EJitCacheKind kind, const std::string &key, const std::string &retType, const std::string &params,
+                   const std::string &body, const std::vector<std::string> &types)
+{
+   R__LOCKGUARD(gROOTMutex);
+   // an existing index file means that the expression is already cached or that it could not be compiled
+   if (!gSystem->AccessPathName(JitCacheIndexFile(key).c_str()))
+      return;
+   auto &entries = PendingJitCacheEntries();
+   if (std::any_of(entries.begin(), entries.end(), [&key](const RJitCacheEntry &e) { return e.fKey == key; }))
+      return;
+
+   // the function that builds the node is what JitFilterHelper or JitDefineHelper is called with by the jitted code
+   std::string bookCall;
+   switch (kind) {
+   case EJitCacheKind::kFilter:
+      bookCall = "   (void)lm;\n   ROOT::Internal::RDF::JitFilterHelper(R_rdf_jitcache::f_" + key +
+                 ", cols, nCols, name, "
+                 "static_cast<std::weak_ptr<ROOT::Detail::RDF::RJittedFilter> *>(wkNode), "
+                 "static_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase> *>(prevNode), "
+                 "static_cast<ROOT::Internal::RDF::RBookedDefines *>(defines));\n";
+      break;
+   case EJitCacheKind::kDefine:
+   case EJitCacheKind::kDefinePerSample:
+      bookCall = std::string("   ROOT::Internal::RDF::JitDefineHelper<ROOT::Internal::RDF::DefineTypes::") +
+                 (kind == EJitCacheKind::kDefine ? "RDefineTag" : "RDefinePerSampleTag") + ">(R_rdf_jitcache::f_" +
+                 key +
+                 ", cols, nCols, name, static_cast<ROOT::Detail::RDF::RLoopManager *>(lm), "
+                 "static_cast<std::weak_ptr<ROOT::Detail::RDF::RJittedDefine> *>(wkNode), "
+                 "static_cast<ROOT::Internal::RDF::RBookedDefines *>(defines), "
+                 "static_cast<std::shared_ptr<ROOT::Detail::RDF::RNodeBase> *>(prevNode));\n";
+      break;
+   }
+   auto code = "namespace R_rdf_jitcache {\nusing namespace ROOT::VecOps;\nauto f_" + key + " = [](" + params + ")" +
+               body + ";\n}\nextern \"C\" void " + JitCacheBookFuncName(key) +
+               "(const char **cols, std::size_t nCols, const char *name, void *lm, void *wkNode, void *defines, "
+               "void *prevNode)\n{\n" +
+               bookCall + "}\n";
+
+   auto allTypes = types;
+   allTypes.emplace_back(retType);
+   entries.push_back({key, retType, std::move(code), GetHeadersOfTypes(allTypes)});
+}
+
+void WriteJitCache()
+{
+   R__LOCKGUARD(gROOTMutex);
+   auto entries = std::move(PendingJitCacheEntries());
+   PendingJitCacheEntries().clear();
+   if (entries.empty())
+      return;
+
+   const auto &dir = GetJitCacheDir();
+   if (gSystem->AccessPathName(dir.c_str()) && gSystem->mkdir(dir.c_str(), /*recursive=*/true) != 0) {
+      R__LOG_WARNING(RDFLogChannel()) << "Could not create the jit cache directory " << dir
+                                      << ": jitted expressions will not be cached.";
+      return;
+   }
+
+   // All pending expressions are compiled in one go, in a library whose name depends on all of them. If that fails,
+   // e.g. because one of them uses functions that were declared interactively, each expression is compiled in its
+   // own library, so that a single expression does not prevent the others from being cached.
+   std::vector<const RJitCacheEntry *> all;
+   std::string keys;
+   for (const auto &e : entries) {
+      all.emplace_back(&e);
+      keys += e.fKey;
+   }
+   const auto batchLibrary = CompileJitCacheEntries(all, dir + "/rdfjit_" + MD5Of(keys));
+
+   unsigned int nFailed = 0u;
+   for (const auto &e : entries) {
+      auto library = batchLibrary;
+      if (library.empty() && entries.size() > 1u)
+         library = CompileJitCacheEntries({&e}, dir + "/rdfjit_" + e.fKey);
+      // an index file with no library records that the expression cannot be compiled outside of the interpreter,
+      // so we do not try again
+      WriteFileAtomically(JitCacheIndexFile(e.fKey), library.empty() ? "\n" : library + "\n" + e.fRetType + "\n");
+      if (library.empty())
+         ++nFailed;
+   }
+   if (nFailed > 0u)
+      R__LOG_WARNING(RDFLogChannel()) << nFailed << " jitted expression(s) could not be compiled in the jit cache (see "
+                                      << "the output above). They will be jitted again in subsequent runs.";
+}
+
+namespace {
+int &WorkerIndex()
+{
+   static int index = -1;
+   return index;
+}
+} // anonymous namespace
+
+void SetWorkerIndex(int index)
+{
+   WorkerIndex() = index;
+}
+
+int GetWorkerIndex()
+{
+   return WorkerIndex();
+}
+
+std::string GetPartialOutputName(const std::string &fileName, unsigned int index)
+{
+   return fileName + ".part" + std::to_string(index);
+}
+
+std::string GetFileIdentifier(const std::string &fileName)
+{
+   std::string id = fileName;
+   FileStat_t stat;
+   if (gSystem->GetPathInfo(fileName.c_str(), stat) == 0)
+      id += " " + std::to_string(stat.fSize) + " " + std::to_string(stat.fMtime);
+   return id;
+}
+
 bool IsInternalColumn(std::string_view colName)
 {
    const auto str = colName.data();
@@ -81,11 +81,12 @@ Transformations are a way to manipulate the data.
 |------------------|--------------------|
 | Alias() | Introduce an alias for a particular column name. |
 | Define() | Creates a new column in the dataset. Example usages include adding a column that contains the invariant mass of a particle, or a selection of elements of an array (e.g. only the `pt`s of "good" muons). |
+| DefineBatch() | Same as Define(), but the user-defined function receives the values of the input columns for a batch of entries as RVecs and returns an RVec of values. Meant for vectorized computations together with ROOT::RDF::EnableBulkProcessing(). |
 | DefinePerSample() | Define a new column that is updated when the input sample changes, e.g. when switching tree being processed in a chain. |
 | DefineSlot() | Same as Define(), but the user-defined function must take an extra `unsigned int slot` as its first parameter. `slot` will take a different value, `0` to `nThreads - 1`, for each thread of execution. This is meant as a helper in writing thread-safe Define() transformation when using RDataFrame after ROOT::EnableImplicitMT(). DefineSlot() works just as well with single-thread execution: in that case `slot` will always be `0`.  |
 | DefineSlotEntry() | Same as DefineSlot(), but the entry number is passed in addition to the slot number. This is meant as a helper in case some dependency on the entry number needs to be honoured. |
 | Filter() | Filter rows based on user-defined conditions. |
-| Range() | Filter rows based on entry number (single-thread only). |
+| Range() | Filter rows based on entry number. |
 
 ### Actions
 Actions aggregate data into a result. Each one is described in more detail in the reference guide.
@@ -98,10 +99,12 @@ produce many different results in one event loop. Instant actions trigger the ev
 
 | **Lazy action** | **Description** |
 |------------------|-----------------|
+| AdaptiveHisto1D() | Fill a one-dimensional histogram whose bins (equal-population or Freedman-Diaconis) are chosen at the end of the event loop from a t-digest of the processed column values, in a single pass. |
 | Aggregate() | Execute a user-defined accumulation operation on the processed column values. |
 | Book() | Book execution of a custom action using a user-defined helper object. |
 | Cache() | Caches in contiguous memory columns' entries. Custom columns can be cached as well, filtered entries are not cached. Users can specify which columns to save (default is all). |
 | Count() | Return the number of events processed. Useful e.g. to get a quick count of the number of events passing a Filter. |
+| CountDistinct() | Return the approximate number of distinct values (or tuples of values) of the specified columns, estimated with a HyperLogLog sketch of fixed size. |
 | Display() | Provides a printable representation of the dataset contents. The method returns a RDisplay() instance which can be queried to get a compressed tabular representation on the standard output or a complete representation as a string. |
 | Fill() | Fill a user-defined object with the values of the specified columns, as if by calling `Obj.Fill(col1, col2, ...). |
 | Graph() | Fills a TGraph with the two columns provided. If Multithread is enabled, the order of the points may not be the one expected, it is therefore suggested to sort if before drawing. |
@@ -110,6 +113,7 @@ produce many different results in one event loop. Instant actions trigger the ev
 | Mean() | Return the mean of processed column values.|
 | Min() | Return the minimum of processed column values. If the type of the column is inferred, the return type is `double`, the type of the column otherwise.|
 | Profile1D(), Profile2D() | Fill a one- or two-dimensional profile with the column values that passed all filters. |
+| Quantiles() | Return approximate quantiles of the processed column values, estimated with a t-digest of bounded size. |
 | Reduce() | Reduce (e.g. sum, merge) entries using the function (lambda, functor...) passed as argument. The function must have signature `T(T,T)` where `T` is the type of the column. Return the final result of the reduction operation. An optional parameter allows initialization of the result object to non-default values. |
 | Report() | Obtains statistics on how many entries have been accepted and rejected by the filters. See the section on [named filters](#named-filters-and-cutflow-reports) for a more detailed explanation. The method returns a RCutFlowReport instance which can be queried programmatically to get information about the effects of the individual cuts. |
 | Stats() | Return a TStatistic object filled with the input columns. |
@@ -121,6 +125,7 @@ produce many different results in one event loop. Instant actions trigger the ev
 |---------------------|-----------------|
 | Foreach() | Execute a user-defined function on each entry. Users are responsible for the thread-safety of this lambda when executing with implicit multi-threading enabled. |
 | ForeachSlot() | Same as Foreach(), but the user-defined function must take an extra `unsigned int slot` as its first parameter. `slot` will take a different value, `0` to `nThreads - 1`, for each thread of execution. This is meant as a helper in writing thread-safe Foreach() actions when using RDataFrame after ROOT::EnableImplicitMT(). ForeachSlot() works just as well with single-thread execution: in that case `slot` will always be `0`. |
+| PersistentCache() | Like Cache(), but the cached columns are written to a file on disk that later runs read back instead of re-running the computation graph. The cache is identified by a hash of the computation graph (including the expressions of jitted Filters and Defines), of the cached columns and of the input files (including their modification times). |
 | Snapshot() | Writes processed data-set to disk, in a new TTree and TFile. Custom columns can be saved as well, filtered entries are not saved. Users can specify which columns to save (default is all). Snapshot, by default, overwrites the output file if it already exists. Snapshot() can be made *lazy* setting the appropriate flage in the snapshot options.|
 
 
@@ -289,6 +294,9 @@ auto df = ROOT::RDF::MakeCsvDataFrame("input.csv");
 // use df as usual
 ~~~
 
+Entries that are produced while the analysis runs, e.g. received from a socket or a message queue, can be processed by
+pushing them to a ROOT::RDF::RStreamDS: the event loop processes them as they arrive, until the stream is closed.
+
 ### Filling a histogram
 Let's now tackle a very common task, filling a histogram:
 ~~~{.cpp}
@@ -408,7 +416,7 @@ auto d15on = d.Range(15, 0);
 // We can specify a stride too, in this case we pick an event every 3
 auto d15each3 = d.Range(0, 15, 3);
 ~~~
-Note that ranges are not available when multi-threading is enabled. More information on ranges is available
+Ranges are also available when multi-threading is enabled, with some caveats. More information on ranges is available
 [here](#ranges).
 
 ### Executing multiple actions in the same event loop
@@ -749,9 +757,8 @@ that has been run using the relevant RDataFrame.
 
 \anchor ranges
 ### Ranges
-When RDataFrame is not being used in a multi-thread environment (i.e. no call to EnableImplicitMT() was made),
-Range() transformations are available. These act very much like filters but instead of basing their decision on
-a filter expression, they rely on `begin`,`end` and `stride` parameters.
+Range() transformations act very much like filters but instead of basing their decision on a filter expression, they
+rely on `begin`,`end` and `stride` parameters.
 
 - `begin`: initial entry number considered for this range.
 - `end`: final entry number (excluded) considered for this range. 0 means that the range goes until the end of the dataset.
@@ -768,6 +775,13 @@ preceding filter*.
 Ranges allow "early quitting": if all branches of execution of a functional graph reached their `end` value of
 processed entries, the event-loop is immediately interrupted. This is useful for debugging and quick data explorations.
 
+In multi-thread event loops (i.e. after a call to EnableImplicitMT()) entries are not processed in order, so counting
+the entries that reach a Range() is not meaningful. Ranges that are applied directly to the RDataFrame (with no Filter
+or Range upstream) then select entries based on their global entry number, which yields the same entries as in
+single-thread runs (unless a data source skips some of its entries), and are evaluated in parallel. If all branches of the computation graph start with such a Range,
+only the entries that can be selected are read. Ranges that hang from other Filters or Ranges still act "locally":
+in that case RDataFrame logs a warning and runs the event loop on a single thread.
+
 \anchor custom-columns
 ### Custom columns
 Custom columns are created by invoking `Define(name, f, columnList)`. As usual, `f` can be any callable object
@@ -889,6 +903,41 @@ Also make sure not to count the just-in-time compilation time (which happens onc
 auto verbosity = ROOT::Experimental::RLogScopedVerbosity(ROOT::Detail::RDF::RDFLogChannel(), ROOT::Experimental::ELogLevel::kInfo);
 ~~~
 
+For simple analyses of flat datasets, the per-entry overhead of the event loop itself can dominate the runtime.
+ROOT::RDF::EnableBulkProcessing() instructs RDataFrame to process entries in bulks: column values are buffered for a
+number of entries, Filters produce a selection mask for the whole bulk and Defines and actions loop over the selected
+entries. Bulk processing only kicks in if all columns read are of fundamental types and all actions support it;
+otherwise entries are processed one by one as usual:
+~~~{.cpp}
+ROOT::RDataFrame df("tree", "file.root");
+ROOT::RDF::EnableBulkProcessing(df, 256); // process 256 entries at a time
+~~~
+In bulk mode, DefineBatch() lets Defines be computed with vectorized code: the callable receives the values of the
+selected entries of the bulk as RVecs and returns the defined values as an RVec.
+
+Computation graphs are executed as they are written. ROOT::RDF::EnableGraphOptimization() lets RDataFrame merge
+identical jitted Filters and Defines booked in different branches of the graph, so that they are evaluated once per
+entry. On request, it also evaluates chains of unnamed Filters starting from the cheapest and most selective ones, as
+measured during the first entries of the event loop. See its documentation for the conditions under which Filters can
+be reordered.
+
+To find out which parts of a computation graph are the most expensive, ROOT::RDF::EnableProfiling() makes RDataFrame
+record, for each Filter, Define and action, the number of evaluations, the time spent reading input columns and in user
+code, and the bytes read from the input files. ROOT::RDF::GetProfileReport() returns these statistics, which can be
+printed or saved in JSON format, and SaveGraph() adds them to the nodes of the graph it draws.
+
+The event loop stops as soon as the results of all booked actions are final, without reading further entries or
+clusters, both in single-thread and multi-thread runs. This is the case for Display() once enough rows have been
+collected, and for custom actions booked with Book() whose helper implements an `IsDone()` method, e.g. to collect a
+small sample of the passing entries.
+
+When reading ROOT files, the branches of all the columns that any Filter, Define or action of the computation graph
+can read, including jitted ones, are registered with the TTreeCache before the first entry is read, and the learning
+phase of the cache is skipped. The baskets of all these branches are then fetched with a few large reads per cluster,
+also for branches that are only read for few entries, which matters most for remote files. A warning is issued at the
+end of the event loop if some branches were nevertheless read outside of the cache, e.g. by user code that accesses
+the TTree directly.
+
 ### Memory usage
 
 There are two reasons why RDataFrame may consume more memory than expected. Firstly, each result is duplicated for each worker thread, which e.g. in case of many (possibly multi-dimensional) histograms with fine binning can result in visible memory consumption during the event loop. The thread-local copies of the results are destroyed when the final result is produced.
@@ -962,6 +1011,12 @@ Callbacks are registered to a ROOT::RDF::RResultPtr and must be callables that t
 and return nothing. RDataFrame will invoke registered callbacks passing partial action results as arguments to them
 (e.g. a histogram filled with a part of the selected events).
 
+Callbacks can also be executed periodically, e.g. to refresh a monitoring plot every few seconds independently of the
+rate at which entries are processed:
+~~~{.cpp}
+h.OnPartialResult(std::chrono::seconds(5), [](TH1D &h_) { h_.SaveAs("monitoring.root"); });
+~~~
+
 Read more on ROOT::RDF::RResultPtr::OnPartialResult().
 
 \anchor default-branches
@@ -9,7 +9,9 @@
  *************************************************************************/
 
 #include "ROOT/RDF/RCutFlowReport.hxx"
+#include "ROOT/RDF/RDefineBase.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RLoopManager.hxx"
 #include "ROOT/RDF/Utils.hxx"
 #include <numeric> // std::accumulate
 
@@ -20,8 +22,8 @@ RFilterBase::RFilterBase(RLoopManager *implPtr, std::string_view name, const uns
    : RNodeBase(implPtr), fLastCheckedEntry(std::vector<Long64_t>(nSlots * RDFInternal::CacheLineStep<Long64_t>(), -1)),
      fLastResult(nSlots * RDFInternal::CacheLineStep<int>()),
      fAccepted(nSlots * RDFInternal::CacheLineStep<ULong64_t>()),
-     fRejected(nSlots * RDFInternal::CacheLineStep<ULong64_t>()), fName(name), fColumnNames(columns), fDefines(defines),
-     fIsDefine(columns.size())
+     fRejected(nSlots * RDFInternal::CacheLineStep<ULong64_t>()), fLastBulkResult(nSlots), fName(name),
+     fColumnNames(columns), fDefines(defines), fIsDefine(columns.size())
 {
    const auto nColumns = fColumnNames.size();
    for (auto i = 0u; i < nColumns; ++i)
@@ -54,4 +56,7 @@ void RFilterBase::InitNode()
 {
    if (!fName.empty()) // if this is a named filter we care about its report count
       ResetReportCount();
+   fProfile = fLoopManager->GetNodeProfile(this, "Filter", fName);
+   for (auto &define : fDefines.GetColumns())
+      define.second->InitNode();
 }
@@ -0,0 +1,84 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RFilterChain.hxx"
+#include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RNodeBase.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <numeric> // std::iota
+
+using ROOT::Internal::RDF::RFilterChain;
+
+RFilterChain::RFilterChain(RNodeBase *upstream, const std::vector<RFilterBase *> &filters, unsigned int nSlots,
+                           ULong64_t nWarmUpEntries)
+   : fUpstream(upstream), fFilters(filters), fSlotStats(nSlots), fNWarmUpEntries(nWarmUpEntries)
+{
+   for (auto &stats : fSlotStats) {
+      stats.fOrder.resize(fFilters.size());
+      std::iota(stats.fOrder.begin(), stats.fOrder.end(), 0u);
+      stats.fTime.resize(fFilters.size(), 0.);
+      stats.fNEvaluated.resize(fFilters.size(), 0ull);
+      stats.fNPassed.resize(fFilters.size(), 0ull);
+   }
+}
+
+bool RFilterChain::CheckFilters(unsigned int slot, Long64_t entry)
+{
+   if (!fUpstream->CheckFilters(slot, entry))
+      return false;
+
+   auto &stats = fSlotStats[slot];
+   if (stats.fNWarmUp < fNWarmUpEntries)
+      return WarmUp(slot, entry);
+
+   for (auto idx : stats.fOrder) {
+      if (!fFilters[idx]->EvalFilter(slot, entry))
+         return false;
+   }
+   return true;
+}
+
+/// Evaluate the filters of the chain on the entry in booking order, stopping at the first that rejects it as without
+/// reordering, and record how long each evaluation took and its result.
+bool RFilterChain::WarmUp(unsigned int slot, Long64_t entry)
+{
+   auto &stats = fSlotStats[slot];
+   bool passed = true;
+   for (std::size_t i = 0u; i < fFilters.size() && passed; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      passed = fFilters[i]->EvalFilter(slot, entry);
+      const auto end = std::chrono::steady_clock::now();
+      stats.fTime[i] += std::chrono::duration<double, std::nano>(end - start).count();
+      ++stats.fNEvaluated[i];
+      stats.fNPassed[i] += passed;
+   }
+
+   if (++stats.fNWarmUp == fNWarmUpEntries)
+      Optimize(slot);
+
+   return passed;
+}
+
+/// Sort the filters by the average time they take per rejected entry, which minimizes the expected cost of evaluating
+/// the chain if the filters select entries independently of each other. The statistics of each filter only refer to
+/// the entries on which it was evaluated during the warm-up, i.e. the ones accepted by the filters that precede it.
+void RFilterChain::Optimize(unsigned int slot)
+{
+   auto &stats = fSlotStats[slot];
+   std::vector<double> rank(fFilters.size());
+   for (std::size_t i = 0u; i < fFilters.size(); ++i) {
+      const auto nRejected = stats.fNEvaluated[i] - stats.fNPassed[i];
+      // filters that did not reject any entry, or that were never evaluated, go last
+      rank[i] = nRejected > 0u ? stats.fTime[i] / nRejected : std::numeric_limits<double>::max();
+   }
+   std::stable_sort(stats.fOrder.begin(), stats.fOrder.end(),
+                    [&rank](std::size_t a, std::size_t b) { return rank[a] < rank[b]; });
+}
@@ -22,12 +22,36 @@ using ROOT::Detail::RDF::RLoopManager;
 
 RJittedAction::RJittedAction(RLoopManager &lm) : RActionBase(&lm, {}, ROOT::Internal::RDF::RBookedDefines{}) {}
 
+const ROOT::RDF::ColumnNames_t &RJittedAction::GetColumnNames() const
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->GetColumnNames();
+}
+
+const ROOT::Internal::RDF::RBookedDefines &RJittedAction::GetDefines() const
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->GetDefines();
+}
+
 void RJittedAction::Run(unsigned int slot, Long64_t entry)
 {
    assert(fConcreteAction != nullptr);
    fConcreteAction->Run(slot, entry);
 }
 
+void RJittedAction::RunBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries)
+{
+   assert(fConcreteAction != nullptr);
+   fConcreteAction->RunBulk(slot, entries);
+}
+
+bool RJittedAction::SupportsBulk() const
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->SupportsBulk();
+}
+
 void RJittedAction::Initialize()
 {
    assert(fConcreteAction != nullptr);
@@ -80,6 +104,12 @@ void RJittedAction::SetHasRun()
    return fConcreteAction->SetHasRun();
 }
 
+const ROOT::Internal::RDF::RNodeProfile *RJittedAction::GetProfile() const
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->GetProfile();
+}
+
 std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::GetGraph()
 {
    assert(fConcreteAction != nullptr);
@@ -92,10 +122,36 @@ std::shared_ptr<ROOT::Internal::RDF::GraphDrawing::GraphNode> RJittedAction::Get
 */
 std::unique_ptr<ROOT::Detail::RDF::RMergeableValueBase> RJittedAction::GetMergeableValue() const
 {
+   if (auto merged = CloneMergedValue())
+      return merged;
    assert(fConcreteAction != nullptr);
    return fConcreteAction->GetMergeableValue();
 }
 
+bool RJittedAction::HasPartialOutputs() const
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->HasPartialOutputs();
+}
+
+void RJittedAction::MergePartialOutputs(unsigned int nWorkers)
+{
+   assert(fConcreteAction != nullptr);
+   fConcreteAction->MergePartialOutputs(nWorkers);
+}
+
+bool RJittedAction::NeedsContiguousTasks() const
+{
+   assert(fConcreteAction != nullptr);
+   return fConcreteAction->NeedsContiguousTasks();
+}
+
+void RJittedAction::SetFirstEntry(ULong64_t firstEntry)
+{
+   assert(fConcreteAction != nullptr);
+   fConcreteAction->SetFirstEntry(firstEntry);
+}
+
 ROOT::RDF::SampleCallback_t RJittedAction::GetSampleCallback()
 {
    assert(fConcreteAction != nullptr);
@@ -20,6 +20,18 @@ void RJittedDefine::InitSlot(TTreeReader *r, unsigned int slot)
    fConcreteDefine->InitSlot(r, slot);
 }
 
+const ColumnNames_t &RJittedDefine::GetColumnNames() const
+{
+   assert(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetColumnNames();
+}
+
+const ROOT::Internal::RDF::RBookedDefines &RJittedDefine::GetDefines() const
+{
+   assert(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetDefines();
+}
+
 void *RJittedDefine::GetValuePtr(unsigned int slot)
 {
    assert(fConcreteDefine != nullptr);
@@ -49,3 +61,33 @@ void RJittedDefine::FinaliseSlot(unsigned int slot)
    assert(fConcreteDefine != nullptr);
    fConcreteDefine->FinaliseSlot(slot);
 }
+
+bool RJittedDefine::SupportsBulk() const
+{
+   assert(fConcreteDefine != nullptr);
+   return fConcreteDefine->SupportsBulk();
+}
+
+void RJittedDefine::UpdateBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries, const ROOT::RVecB &mask)
+{
+   assert(fConcreteDefine != nullptr);
+   fConcreteDefine->UpdateBulk(slot, entries, mask);
+}
+
+void *RJittedDefine::GetBulkValuePtr(unsigned int slot)
+{
+   assert(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetBulkValuePtr(slot);
+}
+
+void RJittedDefine::InitNode()
+{
+   assert(fConcreteDefine != nullptr);
+   fConcreteDefine->InitNode();
+}
+
+const ROOT::Internal::RDF::RNodeProfile *RJittedDefine::GetProfile() const
+{
+   assert(fConcreteDefine != nullptr);
+   return fConcreteDefine->GetProfile();
+}
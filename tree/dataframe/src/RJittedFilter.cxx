@@ -31,12 +31,36 @@ void RJittedFilter::InitSlot(TTreeReader *r, unsigned int slot)
    fConcreteFilter->InitSlot(r, slot);
 }
 
+const ColumnNames_t &RJittedFilter::GetColumnNames() const
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetColumnNames();
+}
+
+const ROOT::Internal::RDF::RBookedDefines &RJittedFilter::GetDefines() const
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetDefines();
+}
+
 bool RJittedFilter::CheckFilters(unsigned int slot, Long64_t entry)
 {
    assert(fConcreteFilter != nullptr);
    return fConcreteFilter->CheckFilters(slot, entry);
 }
 
+const ROOT::RVecB &RJittedFilter::CheckFiltersBulk(unsigned int slot, const ROOT::RVec<Long64_t> &entries)
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->CheckFiltersBulk(slot, entries);
+}
+
+bool RJittedFilter::SupportsBulk() const
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->SupportsBulk();
+}
+
 void RJittedFilter::Report(ROOT::RDF::RCutFlowReport &cr) const
 {
    assert(fConcreteFilter != nullptr);
@@ -91,6 +115,36 @@ void RJittedFilter::FinaliseSlot(unsigned int slot)
    fConcreteFilter->FinaliseSlot(slot);
 }
 
+RNodeBase *RJittedFilter::GetPrevNode() const
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetPrevNode();
+}
+
+unsigned int RJittedFilter::GetNChildren() const
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetNChildren();
+}
+
+bool RJittedFilter::EvalFilter(unsigned int slot, Long64_t entry)
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->EvalFilter(slot, entry);
+}
+
+void RJittedFilter::SetFilterChain(ROOT::Internal::RDF::RFilterChain *chain)
+{
+   assert(fConcreteFilter != nullptr);
+   fConcreteFilter->SetFilterChain(chain);
+}
+
+const ROOT::Internal::RDF::RNodeProfile *RJittedFilter::GetProfile() const
+{
+   assert(fConcreteFilter != nullptr);
+   return fConcreteFilter->GetProfile();
+}
+
 void RJittedFilter::InitNode()
 {
    assert(fConcreteFilter != nullptr);
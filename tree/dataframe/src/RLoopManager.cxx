@@ -11,8 +11,12 @@
 #include "ROOT/RDF/GraphNode.hxx"
 #include "ROOT/InternalTreeUtils.hxx" // GetTreeFullPaths
 #include "ROOT/RDF/RActionBase.hxx"
+#include "ROOT/RDF/RBulkColumnReader.hxx"
 #include "ROOT/RDF/RFilterBase.hxx"
+#include "ROOT/RDF/RJittedDefine.hxx"
+#include "ROOT/RDF/RJittedFilter.hxx"
 #include "ROOT/RDF/RLoopManager.hxx"
+#include "ROOT/RDF/RMergeableValue.hxx"
 #include "ROOT/RDF/RRangeBase.hxx"
 #include "ROOT/RDF/RSlotStack.hxx"
 #include "ROOT/RLogger.hxx"
@@ -21,11 +25,16 @@
 #include "TBranchElement.h"
 #include "TBranchObject.h"
 #include "TChain.h"
+#include "TClass.h"
 #include "TEntryList.h"
 #include "TFile.h"
 #include "TFriendElement.h"
+#include "TLeaf.h"
 #include "TInterpreter.h"
+#include "TObjString.h"
 #include "TROOT.h" // IsImplicitMTEnabled
+#include "TSystem.h"
+#include "TTreeCache.h"
 #include "TTreeReader.h"
 #include "TTree.h" // For MaxTreeSizeRAII. Revert when #6640 will be solved.
 
@@ -34,12 +43,21 @@
 #include "ROOT/TTreeProcessorMT.hxx"
 #endif
 
+#ifndef R__WIN32
+#include "ROOT/TProcessExecutor.hxx"
+#include "ROOT/TSeq.hxx"
+#include "TUrl.h"
+#include <fcntl.h>  // open
+#include <unistd.h> // dup2, close
+#endif
+
 #include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <exception>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -65,6 +83,14 @@ static std::string &GetCodeToJit()
    return code;
 }
 
+/// The calls that build the nodes whose code was found in the jit cache, see ROOT::RDF::SetJitCacheDir.
+/// They are executed together with the code in GetCodeToJit(), without invoking the interpreter.
+static std::vector<std::function<void()>> &GetCachedCallsToJit()
+{
+   static std::vector<std::function<void()>> calls;
+   return calls;
+}
+
 static bool ContainsLeaf(const std::set<TLeaf *> &leaves, TLeaf *leaf)
 {
    return (leaves.find(leaf) != leaves.end());
@@ -299,6 +325,59 @@ DatasetLogInfo TreeDatasetLogInfo(const TTreeReader &r, unsigned int slot)
    return {std::move(what), static_cast<ULong64_t>(entryRange.first), end, slot};
 }
 
+/// Return the names of the files of the dataset and the number of entries of the tree in each of them.
+std::vector<std::pair<std::string, ULong64_t>> GetFileEntries(TTree &tree)
+{
+   std::vector<std::pair<std::string, ULong64_t>> fileEntries;
+   if (auto *chain = dynamic_cast<TChain *>(&tree)) {
+      chain->GetEntries(); // loads all the trees of the chain to compute their offsets
+      const auto *offsets = chain->GetTreeOffset();
+      auto *files = chain->GetListOfFiles();
+      for (int i = 0; i < files->GetEntries(); ++i)
+         fileEntries.emplace_back(files->At(i)->GetTitle(), offsets[i + 1] - offsets[i]);
+   } else {
+      auto *file = tree.GetCurrentFile();
+      fileEntries.emplace_back(file != nullptr ? file->GetName() : "", tree.GetEntries());
+   }
+   return fileEntries;
+}
+
+#ifndef R__WIN32
+/// Give a worker process of a multi-process event loop its own descriptors for the local files that were opened for
+/// reading before it was forked. Descriptors inherited from the parent process share their file offset with the
+/// parent and the other workers, and TFile moves the offset before each read.
+void ReopenInputFiles()
+{
+   R__LOCKGUARD(gROOTMutex);
+   for (auto *obj : *gROOT->GetListOfFiles()) {
+      auto *file = dynamic_cast<TFile *>(obj);
+      if (file == nullptr || file->IsWritable() || file->GetFd() < 0)
+         continue;
+      const int fd = ::open(file->GetEndpointUrl()->GetFile(), O_RDONLY);
+      if (fd < 0)
+         continue;
+      ::dup2(fd, file->GetFd());
+      ::close(fd);
+   }
+}
+#endif
+
+/// Insert in `columns` the names of the columns of the dataset that are read by a node that reads `colNames`, either
+/// directly or via the Defines in `defines`. Defines in `visited` are not inspected again.
+void AddDataSetColumns(const ColumnNames_t &colNames, const RBookedDefines &defines, std::set<std::string> &columns,
+                       std::set<const RDefineBase *> &visited)
+{
+   for (const auto &colName : colNames) {
+      if (!defines.HasName(colName)) {
+         columns.insert(colName);
+         continue;
+      }
+      const RDefineBase *define = defines.GetColumns().at(colName).get();
+      if (visited.insert(define).second)
+         AddDataSetColumns(define->GetColumnNames(), define->GetDefines(), columns, visited);
+   }
+}
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -370,12 +449,16 @@ void RLoopManager::RunEmptySourceMT()
 #ifdef R__USE_IMT
    RSlotStack slotStack(fNSlots);
    // Working with an empty tree.
+   // Only the entries that can be selected by Range nodes (if any) are processed.
+   const auto firstEntry = std::min(fGlobalEntryBounds.first, fNEmptyEntries);
+   const auto endEntry = std::min(fGlobalEntryBounds.second, fNEmptyEntries);
+   const auto nEntries = endEntry - firstEntry;
    // Evenly partition the entries according to fNSlots. Produce around 2 tasks per slot.
-   const auto nEntriesPerSlot = fNEmptyEntries / (fNSlots * 2);
-   auto remainder = fNEmptyEntries % (fNSlots * 2);
+   const auto nEntriesPerSlot = nEntries / (fNSlots * 2);
+   auto remainder = nEntries % (fNSlots * 2);
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
-   ULong64_t start = 0;
-   while (start < fNEmptyEntries) {
+   ULong64_t start = firstEntry;
+   while (start < endEntry) {
       ULong64_t end = start + nEntriesPerSlot;
       if (remainder > 0) {
          ++end;
@@ -384,9 +467,16 @@ void RLoopManager::RunEmptySourceMT()
       entryRanges.emplace_back(start, end);
       start = end;
    }
+   // the ranges tile the entries starting at firstEntry
+   for (auto *action : fBookedActions)
+      if (action->NeedsContiguousTasks())
+         action->SetFirstEntry(firstEntry);
 
    // Each task will generate a subrange of entries
    auto genFunction = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+      // no need to start new tasks once the results of all actions are final
+      if (AllActionsDone())
+         return;
       RSlotRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
       RCallCleanUpTask cleanup(*this, slot);
@@ -394,9 +484,14 @@ void RLoopManager::RunEmptySourceMT()
       R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({"an empty source", range.first, range.second, slot});
       try {
          UpdateSampleInfo(slot, range);
-         for (auto currEntry = range.first; currEntry < range.second; ++currEntry) {
-            RunAndCheckFilters(slot, currEntry);
+         for (auto currEntry = range.first; currEntry < range.second && !AllActionsDone(); ++currEntry) {
+            if (fUseBulk)
+               PushBulkEntry(slot, currEntry);
+            else
+               RunAndCheckFilters(slot, currEntry);
          }
+         if (fUseBulk)
+            FlushBulk(slot);
       } catch (...) {
          // Error might throw in experiment frameworks like CMSSW
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
@@ -413,14 +508,22 @@ void RLoopManager::RunEmptySourceMT()
 /// Run event loop with no source files, in sequence.
 void RLoopManager::RunEmptySource()
 {
+   const auto begin = fEntryRange.first;
+   const auto end = std::min(fNEmptyEntries, fEntryRange.second);
    InitNodeSlots(nullptr, 0);
-   R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({"an empty source", 0, fNEmptyEntries, 0u});
+   R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({"an empty source", begin, end, 0u});
    RCallCleanUpTask cleanup(*this);
    try {
-      UpdateSampleInfo(/*slot*/0, {0, fNEmptyEntries});
-      for (ULong64_t currEntry = 0; currEntry < fNEmptyEntries && fNStopsReceived < fNChildren; ++currEntry) {
-         RunAndCheckFilters(0, currEntry);
+      UpdateSampleInfo(/*slot*/0, {begin, end});
+      for (ULong64_t currEntry = begin;
+           currEntry < end && fNStopsReceived < fNChildren && !AllActionsDone(); ++currEntry) {
+         if (fUseBulk)
+            PushBulkEntry(0, currEntry);
+         else
+            RunAndCheckFilters(0, currEntry);
       }
+      if (fUseBulk)
+         FlushBulk(0);
    } catch (...) {
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
@@ -431,13 +534,40 @@ void RLoopManager::RunEmptySource()
 void RLoopManager::RunTreeProcessorMT()
 {
 #ifdef R__USE_IMT
+   // nothing to process, e.g. an incremental event loop with no new entries
+   const auto beginEntry = std::max(fGlobalEntryBounds.first, fEntryRange.first);
+   const auto endEntry = std::min(fGlobalEntryBounds.second, fEntryRange.second);
+   if (beginEntry >= endEntry)
+      return;
+
    RSlotStack slotStack(fNSlots);
    const auto &entryList = fTree->GetEntryList() ? *fTree->GetEntryList() : TEntryList();
    auto tp = std::make_unique<ROOT::TTreeProcessorMT>(*fTree, entryList, fNSlots);
 
+   // Range nodes need global entry numbers: in that case we let TTreeProcessorMT number the entries and skip the ones
+   // that cannot be selected. Incremental event loops also process a range of global entries. With global entries,
+   // the entry ranges of the tasks tile the entries starting at beginEntry, as needed by some actions.
+   const bool needContiguousTasks = std::any_of(fBookedActions.begin(), fBookedActions.end(),
+                                                [](RActionBase *action) { return action->NeedsContiguousTasks(); });
+   const bool useGlobalEntries =
+      std::any_of(fBookedRanges.begin(), fBookedRanges.end(),
+                  [](RRangeBase *range) { return range->HasChildren(); }) ||
+      fEntryRange.first != 0ull || fEntryRange.second != std::numeric_limits<ULong64_t>::max() || needContiguousTasks;
+   if (useGlobalEntries) {
+      tp->SetGlobalEntryRange(static_cast<Long64_t>(beginEntry),
+                              endEntry == std::numeric_limits<ULong64_t>::max() ? -1ll
+                                                                                : static_cast<Long64_t>(endEntry));
+   }
+   for (auto *action : fBookedActions)
+      if (action->NeedsContiguousTasks())
+         action->SetFirstEntry(beginEntry);
+
    std::atomic<ULong64_t> entryCount(0ull);
 
-   tp->Process([this, &slotStack, &entryCount](TTreeReader &r) -> void {
+   tp->Process([this, &slotStack, &entryCount, useGlobalEntries](TTreeReader &r) -> void {
+      // the clusters of the remaining tasks are not read once the results of all actions are final
+      if (AllActionsDone())
+         return;
       RSlotRAII slotRAII(slotStack);
       auto slot = slotRAII.fSlot;
       RCallCleanUpTask cleanup(*this, slot, &r);
@@ -448,19 +578,29 @@ void RLoopManager::RunTreeProcessorMT()
       auto count = entryCount.fetch_add(nEntries);
       try {
          // recursive call to check filters and conditionally execute actions
-         while (r.Next()) {
+         while (!AllActionsDone() && r.Next()) {
             if (fNewSampleNotifier.CheckFlag(slot)) {
+               // the entries of a bulk must all belong to the same sample
+               if (fUseBulk)
+                  FlushBulk(slot);
                UpdateSampleInfo(slot, r);
+               SetupTreeCache(r);
             }
-            RunAndCheckFilters(slot, count++);
+            const auto entry = useGlobalEntries ? r.GetCurrentEntry() : count++;
+            if (fUseBulk)
+               PushBulkEntry(slot, entry);
+            else
+               RunAndCheckFilters(slot, entry);
          }
+         if (fUseBulk)
+            FlushBulk(slot);
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
       }
-      // fNStopsReceived < fNChildren is always true at the moment as we don't support event loop early quitting in
-      // multi-thread runs, but it costs nothing to be safe and future-proof in case we add support for that later.
-      if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && fNStopsReceived < fNChildren) {
+      // fNStopsReceived < fNChildren is always true at the moment as Range nodes do not stop multi-thread runs, but it
+      // costs nothing to be safe and future-proof in case we add support for that later.
+      if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && fNStopsReceived < fNChildren && !AllActionsDone()) {
          // something went wrong in the TTreeReader event loop
          throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
                                   std::to_string(r.GetEntryStatus()));
@@ -475,6 +615,12 @@ void RLoopManager::RunTreeReader()
    TTreeReader r(fTree.get(), fTree->GetEntryList());
    if (0 == fTree->GetEntriesFast())
       return;
+   // nothing to process, e.g. an incremental event loop with no new entries
+   if (fEntryRange.first >= fEntryRange.second)
+      return;
+   // in the worker processes of a multi-process event loop, or in incremental event loops
+   if (fEntryRange.second != std::numeric_limits<ULong64_t>::max())
+      r.SetEntriesRange(fEntryRange.first, fEntryRange.second);
    RCallCleanUpTask cleanup(*this, 0u, &r);
    InitNodeSlots(&r, 0);
    R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing(TreeDatasetLogInfo(r, 0u));
@@ -482,17 +628,26 @@ void RLoopManager::RunTreeReader()
    // recursive call to check filters and conditionally execute actions
    // in the non-MT case processing can be stopped early by ranges, hence the check on fNStopsReceived
    try {
-      while (r.Next() && fNStopsReceived < fNChildren) {
+      while (fNStopsReceived < fNChildren && !AllActionsDone() && r.Next()) {
          if (fNewSampleNotifier.CheckFlag(0)) {
+            // the entries of a bulk must all belong to the same sample
+            if (fUseBulk)
+               FlushBulk(0);
             UpdateSampleInfo(/*slot*/0, r);
+            SetupTreeCache(r);
          }
-         RunAndCheckFilters(0, r.GetCurrentEntry());
+         if (fUseBulk)
+            PushBulkEntry(0, r.GetCurrentEntry());
+         else
+            RunAndCheckFilters(0, r.GetCurrentEntry());
       }
+      if (fUseBulk)
+         FlushBulk(0);
    } catch (...) {
       std::cerr << "RDataFrame::Run: event loop was interrupted\n";
       throw;
    }
-   if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && fNStopsReceived < fNChildren) {
+   if (r.GetEntryStatus() != TTreeReader::kEntryBeyondEnd && fNStopsReceived < fNChildren && !AllActionsDone()) {
       // something went wrong in the TTreeReader event loop
       throw std::runtime_error("An error was encountered while processing the data. TTreeReader status code is: " +
                                std::to_string(r.GetEntryStatus()));
@@ -505,7 +660,7 @@ void RLoopManager::RunDataSource()
    assert(fDataSource != nullptr);
    fDataSource->Initialise();
    auto ranges = fDataSource->GetEntryRanges();
-   while (!ranges.empty() && fNStopsReceived < fNChildren) {
+   while (!ranges.empty() && fNStopsReceived < fNChildren && !AllActionsDone()) {
       InitNodeSlots(nullptr, 0u);
       fDataSource->InitSlot(0u, 0ull);
       RCallCleanUpTask cleanup(*this);
@@ -514,18 +669,26 @@ void RLoopManager::RunDataSource()
             const auto start = range.first;
             const auto end = range.second;
             R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({fDataSource->GetLabel(), start, end, 0u});
-            for (auto entry = start; entry < end && fNStopsReceived < fNChildren; ++entry) {
-               if (fDataSource->SetEntry(0u, entry)) {
+            for (auto entry = start; entry < end && fNStopsReceived < fNChildren && !AllActionsDone(); ++entry) {
+               const bool isValid = fDataSource->SetEntry(0u, entry);
+               if (fUseBulk)
+                  PushBulkEntry(0u, entry, isValid);
+               else if (isValid)
                   RunAndCheckFilters(0u, entry);
-               }
             }
+            if (fUseBulk)
+               FlushBulk(0u);
          }
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
       }
       fDataSource->FinaliseSlot(0u);
-      ranges = fDataSource->GetEntryRanges();
+      // do not wait for more entries (e.g. from a stream) if none of them would be processed
+      if (fNStopsReceived < fNChildren && !AllActionsDone())
+         ranges = fDataSource->GetEntryRanges();
+      else
+         ranges.clear();
    }
    fDataSource->Finalise();
 }
@@ -540,6 +703,9 @@ void RLoopManager::RunDataSourceMT()
 
    // Each task works on a subrange of entries
    auto runOnRange = [this, &slotStack](const std::pair<ULong64_t, ULong64_t> &range) {
+      // no need to start new tasks once the results of all actions are final
+      if (AllActionsDone())
+         return;
       RSlotRAII slotRAII(slotStack);
       const auto slot = slotRAII.fSlot;
       InitNodeSlots(nullptr, slot);
@@ -548,12 +714,18 @@ void RLoopManager::RunDataSourceMT()
       const auto start = range.first;
       const auto end = range.second;
       R__LOG_INFO(RDFLogChannel()) << LogRangeProcessing({fDataSource->GetLabel(), start, end, slot});
+      // entries beyond the ones that can be selected by Range nodes (if any) are not processed
+      const auto lastEntry = std::min(end, fGlobalEntryBounds.second);
       try {
-         for (auto entry = start; entry < end; ++entry) {
-            if (fDataSource->SetEntry(slot, entry)) {
+         for (auto entry = start; entry < lastEntry && !AllActionsDone(); ++entry) {
+            const bool isValid = fDataSource->SetEntry(slot, entry);
+            if (fUseBulk)
+               PushBulkEntry(slot, entry, isValid);
+            else if (isValid)
                RunAndCheckFilters(slot, entry);
-            }
          }
+         if (fUseBulk)
+            FlushBulk(slot);
       } catch (...) {
          std::cerr << "RDataFrame::Run: event loop was interrupted\n";
          throw;
@@ -565,6 +737,11 @@ void RLoopManager::RunDataSourceMT()
    auto ranges = fDataSource->GetEntryRanges();
    while (!ranges.empty()) {
       pool.Foreach(runOnRange, ranges);
+      ULong64_t maxEnd = 0ull;
+      for (const auto &range : ranges)
+         maxEnd = std::max(maxEnd, range.second);
+      if (maxEnd >= fGlobalEntryBounds.second || AllActionsDone())
+         break; // no more entries can be selected by Range nodes, or none is needed
       ranges = fDataSource->GetEntryRanges();
    }
    fDataSource->Finalise();
@@ -591,12 +768,82 @@ void RLoopManager::RunAndCheckFilters(unsigned int slot, Long64_t entry)
       callback(slot);
 }
 
+/// Add an entry to the current bulk of the given slot, loading the values of all columns read in bulk. The values are
+/// loaded right away, because the tree they come from might be deleted before the bulk is full (e.g. when a TChain
+/// moves to its next file). The bulk is processed as soon as it is full. Entries that are not valid (e.g. rejected by
+/// the RDataSource) are flagged in the bulk mask and skipped by all nodes.
+void RLoopManager::PushBulkEntry(unsigned int slot, Long64_t entry, bool isValid)
+{
+   auto &entries = fBulkEntries[slot];
+   const auto idx = entries.size();
+   // data-block callbacks run before the rest of the graph (the bulk is always flushed when a new sample starts)
+   if (idx == 0u && fNewSampleNotifier.CheckFlag(slot)) {
+      for (auto &callback : fSampleCallbacks) {
+         callback(slot, fSampleInfos[slot]);
+      }
+      fNewSampleNotifier.UnsetFlag(slot);
+   }
+
+   entries.push_back(entry);
+   fBulkMasks[slot].push_back(isValid);
+   if (isValid) {
+      for (auto *reader : fBulkReaders[slot])
+         reader->Load(idx, entry);
+   }
+
+   if (entries.size() == fBulkSize)
+      FlushBulk(slot);
+}
+
+/// Process the entries of the current bulk of the given slot, if any, and start a new bulk.
+void RLoopManager::FlushBulk(unsigned int slot)
+{
+   if (fBulkEntries[slot].empty())
+      return;
+   for (auto *reader : fBulkReaders[slot])
+      reader->LoadBulk(fBulkEntries[slot], fBulkMasks[slot]);
+   RunAndCheckFiltersBulk(slot);
+   fBulkEntries[slot].clear();
+   fBulkMasks[slot].clear();
+}
+
+/// Bulk version of RunAndCheckFilters: execute actions and named filters on all entries of the current bulk.
+/// Callbacks registered via RResultPtr::OnPartialResult are invoked once per valid entry, after the whole bulk has
+/// been processed.
+void RLoopManager::RunAndCheckFiltersBulk(unsigned int slot)
+{
+   const auto &entries = fBulkEntries[slot];
+   for (auto &actionPtr : fBookedActions)
+      actionPtr->RunBulk(slot, entries);
+   for (auto &namedFilterPtr : fBookedNamedFilters)
+      namedFilterPtr->CheckFiltersBulk(slot, entries);
+   if (!fCallbacks.empty()) {
+      for (auto isValid : fBulkMasks[slot]) {
+         if (!isValid)
+            continue;
+         for (auto &callback : fCallbacks)
+            callback(slot);
+      }
+   }
+}
+
+/// Return true if all booked actions and filters, together with the columns they read, can be processed in bulk.
+bool RLoopManager::CanRunInBulk() const
+{
+   const bool actionsSupportBulk = std::all_of(fBookedActions.begin(), fBookedActions.end(),
+                                               [](RDFInternal::RActionBase *a) { return a->SupportsBulk(); });
+   return actionsSupportBulk &&
+          std::all_of(fBookedFilters.begin(), fBookedFilters.end(), [](RFilterBase *f) { return f->SupportsBulk(); });
+}
+
 /// Build TTreeReaderValues for all nodes
 /// This method loops over all filters, actions and other booked objects and
 /// calls their `InitSlot` method, to get them ready for running a task.
 void RLoopManager::InitNodeSlots(TTreeReader *r, unsigned int slot)
 {
    SetupSampleCallbacks(r, slot);
+   if (fProfilingEnabled)
+      fProfiler->SetTreeReader(slot, r);
    for (auto &ptr : fBookedActions)
       ptr->InitSlot(r, slot);
    for (auto &ptr : fBookedFilters)
@@ -642,6 +889,94 @@ void RLoopManager::UpdateSampleInfo(unsigned int slot, TTreeReader &r) {
    fSampleInfos[slot] = RSampleInfo(fname + "/" + treename, range);
 }
 
+/// Register the branches corresponding to the dataset columns read by the computation graph with the TTreeCaches of
+/// the tree currently loaded by the reader and of its friends, and stop the learning phase of the caches.
+/// All columns that any node can read are known before the event loop starts, including the ones read by jitted nodes
+/// or by Defines that are only evaluated for few entries: the clusters of all the corresponding branches are then
+/// fetched with a single request, rather than with one request per basket for the branches missed by the learning
+/// phase. To be called every time a new tree is loaded.
+void RLoopManager::SetupTreeCache(TTreeReader &r)
+{
+   auto *tree = r.GetTree()->GetTree();
+   if (tree == nullptr || fCacheBranchNames.empty())
+      return;
+
+   std::set<TTreeCache *> caches;
+   for (const auto &colName : fCacheBranchNames) {
+      TBranch *branch = tree->GetBranch(colName.c_str());
+      if (branch == nullptr) {
+         auto *leaf = tree->FindLeaf(colName.c_str());
+         branch = leaf != nullptr ? leaf->GetBranch() : nullptr;
+      }
+      if (branch == nullptr)
+         continue;
+      // friend branches are cached by the TTreeCache of the friend tree
+      auto *branchTree = branch->GetTree();
+      auto *cache = branchTree->GetReadCache(branchTree->GetCurrentFile(), true);
+      if (cache == nullptr)
+         continue; // e.g. in-memory trees, or caching was disabled
+      cache->AddBranch(branch, /*subbranches=*/true);
+      // the sizes of variable-size arrays are stored in separate branches
+      for (auto *leaf : ROOT::Detail::TRangeStaticCast<TLeaf>(*branch->GetListOfLeaves())) {
+         if (auto *leafCount = leaf->GetLeafCount())
+            cache->AddBranch(leafCount->GetBranch(), /*subbranches=*/true);
+      }
+      caches.insert(cache);
+   }
+   for (auto *cache : caches)
+      cache->StopLearningPhase();
+}
+
+/// Collect the branches of the tree currently loaded by the reader that were read, but are not registered with its
+/// TTreeCache: each of their baskets required a separate read request.
+void RLoopManager::CollectUncachedBranches(TTreeReader &r, unsigned int slot)
+{
+   auto *tree = r.GetTree() != nullptr ? r.GetTree()->GetTree() : nullptr;
+   if (tree == nullptr || slot >= fUncachedBranches.size())
+      return;
+   auto *cache = tree->GetReadCache(tree->GetCurrentFile());
+   if (cache == nullptr || cache->GetCachedBranches() == nullptr)
+      return;
+   const auto *cachedBranches = cache->GetCachedBranches();
+   for (auto *leaf : ROOT::Detail::TRangeStaticCast<TLeaf>(*tree->GetListOfLeaves())) {
+      auto *branch = leaf->GetBranch();
+      if (branch->GetReadEntry() >= 0 && cachedBranches->IndexOf(branch) < 0)
+         fUncachedBranches[slot].insert(branch->GetName());
+   }
+}
+
+/// Rebuild fDataSetColumns from the nodes that are currently booked, so that the columns read by nodes that have since
+/// been destroyed (or that already ran) are not registered with the TTreeCache anymore. Must be called after Jit.
+void RLoopManager::UpdateDataSetColumns()
+{
+   fDataSetColumns.clear();
+   std::set<const RDefineBase *> visited;
+   for (const auto *actionPtr : fBookedActions)
+      AddDataSetColumns(actionPtr->GetColumnNames(), actionPtr->GetDefines(), fDataSetColumns, visited);
+   for (const auto *filterPtr : fBookedFilters)
+      AddDataSetColumns(filterPtr->GetColumnNames(), filterPtr->GetDefines(), fDataSetColumns, visited);
+}
+
+/// Warn about the branches that were read outside of the TTreeCache during the event loop, if any.
+void RLoopManager::WarnUncachedBranches()
+{
+   std::set<std::string> uncachedBranches;
+   for (auto &slotBranches : fUncachedBranches)
+      uncachedBranches.insert(slotBranches.begin(), slotBranches.end());
+   fUncachedBranches.clear();
+   if (uncachedBranches.empty())
+      return;
+
+   std::string branchList;
+   for (const auto &branchName : uncachedBranches)
+      branchList += (branchList.empty() ? "" : ", ") + branchName;
+   R__LOG_WARNING(RDFLogChannel())
+      << "The following branches were read outside of the TTreeCache, with one read request per basket: "
+      << branchList
+      << ". This happens if they are read directly rather than through RDataFrame columns, and can severely degrade "
+         "the performance of remote reads.";
+}
+
 /// Initialize all nodes of the functional graph before running the event loop.
 /// This method is called once per event-loop and performs generic initialization
 /// operations that do not depend on the specific processing slot (i.e. operations
@@ -662,9 +997,11 @@ void RLoopManager::CleanUpNodes()
 {
    fMustRunNamedFilters = false;
 
-   // forget RActions and detach TResultProxies
+   // forget RActions and detach TResultProxies. The results of actions that ran in a multi-process event loop are
+   // already final.
    for (auto &ptr : fBookedActions)
-      ptr->Finalize();
+      if (!ptr->HasRun())
+         ptr->Finalize();
 
    fRunActions.insert(fRunActions.begin(), fBookedActions.begin(), fBookedActions.end());
    fBookedActions.clear();
@@ -672,11 +1009,16 @@ void RLoopManager::CleanUpNodes()
    // reset children counts
    fNChildren = 0;
    fNStopsReceived = 0;
+   fNActionsDone = 0u;
    for (auto &ptr : fBookedFilters)
       ptr->ResetChildrenCount();
    for (auto &ptr : fBookedRanges)
       ptr->ResetChildrenCount();
 
+   for (auto &chain : fFilterChains)
+      chain->GetLast()->SetFilterChain(nullptr);
+   fFilterChains.clear();
+
    fCallbacks.clear();
    fCallbacksOnce.clear();
    fSampleCallbacks.clear();
@@ -685,21 +1027,34 @@ void RLoopManager::CleanUpNodes()
 /// Perform clean-up operations. To be called at the end of each task execution.
 void RLoopManager::CleanUpTask(TTreeReader *r, unsigned int slot)
 {
-   if (r != nullptr)
+   if (r != nullptr) {
+      CollectUncachedBranches(*r, slot);
       fNewSampleNotifier.GetChainNotifyLink(slot).RemoveLink(*r->GetTree());
+   }
    for (auto &ptr : fBookedActions)
       ptr->FinalizeSlot(slot);
    for (auto &ptr : fBookedFilters)
       ptr->FinaliseSlot(slot);
+   if (fUseBulk) {
+      // bulk column readers have been destroyed together with the readers of the nodes
+      fBulkReaders[slot].clear();
+      fBulkEntries[slot].clear();
+      fBulkMasks[slot].clear();
+   }
 }
 
 /// Add RDF nodes that require just-in-time compilation to the computation graph.
-/// This method also clears the contents of GetCodeToJit().
+/// This method also clears the contents of GetCodeToJit() and GetCachedCallsToJit().
 void RLoopManager::Jit()
 {
    // TODO this should be a read lock unless we find GetCodeToJit non-empty
    R__LOCKGUARD(gROOTMutex);
 
+   auto cachedCalls = std::move(GetCachedCallsToJit());
+   GetCachedCallsToJit().clear();
+   for (auto &call : cachedCalls)
+      call();
+
    const std::string code = std::move(GetCodeToJit());
    if (code.empty()) {
       R__LOG_INFO(RDFLogChannel()) << "Nothing to jit and execute.";
@@ -728,6 +1083,80 @@ void RLoopManager::EvalChildrenCounts()
       namedFilterPtr->TriggerChildrenCount();
 }
 
+/// Prepare the Range nodes for a multi-thread event loop.
+/// Entries are not processed in order in multi-thread event loops, so Range nodes select entries based on their
+/// global entry number. This is only possible for ranges that are applied directly to the RDataFrame: the entries
+/// that reach other ranges depend on the upstream filters. Return false if some active Range cannot be evaluated in
+/// parallel, in which case the event loop must run sequentially.
+/// If all active branches of the computation graph start with a Range, also restrict the event loop to the global
+/// entries that can be selected.
+bool RLoopManager::SetupRangesMT()
+{
+   for (auto *range : fBookedRanges)
+      if (range->HasChildren() && !range->IsGlobal())
+         return false;
+
+   unsigned int nActiveRanges = 0u;
+   ULong64_t firstEntry = std::numeric_limits<ULong64_t>::max();
+   ULong64_t endEntry = 0ull;
+   for (auto *range : fBookedRanges) {
+      if (!range->HasChildren())
+         continue;
+      range->SetUseGlobalEntries(true);
+      ++nActiveRanges;
+      firstEntry = std::min<ULong64_t>(firstEntry, range->GetStart());
+      endEntry = range->GetStop() == 0u ? std::numeric_limits<ULong64_t>::max()
+                                        : std::max<ULong64_t>(endEntry, range->GetStop());
+   }
+
+   if (nActiveRanges > 0u && nActiveRanges == fNChildren)
+      fGlobalEntryBounds = {firstEntry, endEntry};
+
+   return true;
+}
+
+/// Build the chains of unnamed Filters whose expressions are evaluated in an order optimized at runtime, see
+/// RFilterChain. A chain is a sequence of at least two unnamed filters, each of which is the only active child of the
+/// previous one: the intermediate results of the chain are not observable, so only the result of the last filter
+/// matters. Must be called after the children counts have been evaluated.
+void RLoopManager::SetupFilterChains()
+{
+   auto isUnnamedAndActive = [](RFilterBase *f) { return !f->HasName() && f->GetNChildren() > 0u; };
+
+   // map each unnamed filter whose only active child is an unnamed filter to that child
+   std::map<RNodeBase *, RFilterBase *> nextInChain;
+   for (auto *filter : fBookedFilters) {
+      if (!isUnnamedAndActive(filter))
+         continue;
+      auto *prev = filter->GetPrevNode();
+      auto prevIt = std::find(fBookedFilters.begin(), fBookedFilters.end(), prev);
+      if (prevIt != fBookedFilters.end() && !(*prevIt)->HasName() && (*prevIt)->GetNChildren() == 1u)
+         nextInChain[prev] = filter;
+   }
+
+   std::map<RNodeBase *, RFilterBase *> prevInChain;
+   for (auto &prevAndNext : nextInChain)
+      prevInChain[prevAndNext.second] = static_cast<RFilterBase *>(prevAndNext.first);
+
+   for (auto *filter : fBookedFilters) {
+      // each chain is built starting from its last filter
+      if (!isUnnamedAndActive(filter) || nextInChain.count(filter) > 0u || prevInChain.count(filter) == 0u)
+         continue;
+      std::vector<RFilterBase *> chain{filter};
+      for (auto it = prevInChain.find(filter); it != prevInChain.end(); it = prevInChain.find(it->second))
+         chain.push_back(it->second);
+      std::reverse(chain.begin(), chain.end());
+      auto *upstream = chain.front()->GetPrevNode();
+      fFilterChains.emplace_back(new RDFInternal::RFilterChain(upstream, chain, fNSlots, fNWarmUpEntries));
+      filter->SetFilterChain(fFilterChains.back().get());
+   }
+
+   if (!fFilterChains.empty())
+      R__LOG_INFO(RDFLogChannel()) << "The evaluation order of " << fFilterChains.size()
+                                   << " chain(s) of Filters will be optimized after " << fNWarmUpEntries
+                                   << " entries per processing slot.";
+}
+
 /// Start the event loop with a different mechanism depending on IMT/no IMT, data source/no data source.
 /// Also perform a few setup and clean-up operations (jit actions if necessary, clear booked actions after the loop...).
 void RLoopManager::Run()
@@ -741,11 +1170,98 @@ void RLoopManager::Run()
 
    Jit();
 
+   if (fProfilingEnabled)
+      fProfiler->Reset();
+
+   // with incremental processing, only the entries that were not processed by previous runs are processed
+   fEntryRange = {0ull, std::numeric_limits<ULong64_t>::max()};
+   const bool isIncremental = !fIncrementalStateFileName.empty();
+   auto storedResults = isIncremental ? LoadIncrementalState() : decltype(LoadIncrementalState()){};
+   const bool hasNewEntries = fEntryRange.first < fEntryRange.second;
+   // CleanUpNodes moves the booked actions to the list of actions that already ran
+   const auto actions = fBookedActions;
+
+   TStopwatch s;
+   s.Start();
+   if (fNWorkers != 1u && CanRunMultiProcess())
+      RunMultiProcess();
+   else
+      RunEventLoop();
+   s.Stop();
+
+   CleanUpNodes();
+   fUseBulk = false;
+
+   // if enabled, store the expressions that were jitted for the first time in the jit cache for later processes.
+   // This happens after the event loop, so that the compilation does not delay it.
+   if (!RDFInternal::GetJitCacheDir().empty())
+      RDFInternal::WriteJitCache();
+   fGlobalEntryBounds = {0ull, std::numeric_limits<ULong64_t>::max()};
+   fEntryRange = {0ull, std::numeric_limits<ULong64_t>::max()};
+
+   if (isIncremental)
+      SaveIncrementalState(actions, std::move(storedResults), hasNewEntries);
+
+   fNRuns++;
+
+   R__LOG_INFO(RDFLogChannel()) << "Finished event loop number " << fNRuns - 1 << " (" << s.CpuTime() << "s CPU, "
+                                << s.RealTime() << "s elapsed).";
+}
+
+/// Initialize the nodes of the computation graph and run the event loop in this process, sequentially or in parallel.
+void RLoopManager::RunEventLoop()
+{
    InitNodes();
 
+   fUseBulk = fBulkSize > 1u && CanRunInBulk();
+   if (fUseBulk) {
+      fBulkReaders.assign(fNSlots, {});
+      fBulkEntries.assign(fNSlots, {});
+      fBulkMasks.assign(fNSlots, {});
+      for (auto slot = 0u; slot < fNSlots; ++slot) {
+         fBulkEntries[slot].reserve(fBulkSize);
+         fBulkMasks[slot].reserve(fBulkSize);
+      }
+   } else if (fBulkSize > 1u) {
+      R__LOG_WARNING(RDFLogChannel())
+         << "Bulk processing was requested, but some of the booked operations cannot be executed over bulks of "
+            "entries (e.g. Snapshot, or columns that are not of fundamental types). Processing entries one by one.";
+   }
+
+   // Filters are reordered entry by entry: this optimization does not apply to bulk processing
+   if (fOptimizeGraph && fNWarmUpEntries > 0u && !fUseBulk)
+      SetupFilterChains();
+
+   auto loopType = fLoopType;
+   const bool isMT = fLoopType == ELoopType::kNoFilesMT || fLoopType == ELoopType::kROOTFilesMT ||
+                     fLoopType == ELoopType::kDataSourceMT;
+   if (isMT && !SetupRangesMT()) {
+      R__LOG_WARNING(RDFLogChannel())
+         << "Range can only be evaluated in multi-thread event loops if it is applied directly to the RDataFrame, "
+            "with no Filter or Range upstream. Processing entries sequentially.";
+      switch (fLoopType) {
+      case ELoopType::kNoFilesMT: loopType = ELoopType::kNoFiles; break;
+      case ELoopType::kROOTFilesMT: loopType = ELoopType::kROOTFiles; break;
+      case ELoopType::kDataSourceMT: loopType = ELoopType::kDataSource; break;
+      default: break;
+      }
+   }
+
+   // the branches that are registered with the TTreeCache, see SetupTreeCache
+   UpdateDataSetColumns();
+   fCacheBranchNames.clear();
+   if (fTree) {
+      const auto &branchNames = GetBranchNames();
+      std::copy_if(fDataSetColumns.begin(), fDataSetColumns.end(), std::back_inserter(fCacheBranchNames),
+                   [&branchNames](const std::string &colName) {
+                      return std::find(branchNames.begin(), branchNames.end(), colName) != branchNames.end();
+                   });
+   }
+   fUncachedBranches.assign(fNSlots, {});
+
    TStopwatch s;
    s.Start();
-   switch (fLoopType) {
+   switch (loopType) {
    case ELoopType::kNoFilesMT: RunEmptySourceMT(); break;
    case ELoopType::kROOTFilesMT: RunTreeProcessorMT(); break;
    case ELoopType::kDataSourceMT: RunDataSourceMT(); break;
@@ -755,12 +1271,287 @@ void RLoopManager::Run()
    }
    s.Stop();
 
-   CleanUpNodes();
+   WarnUncachedBranches();
 
-   fNRuns++;
+   if (fProfilingEnabled)
+      fProfiler->SetEventLoopTime(s.RealTime());
+}
 
-   R__LOG_INFO(RDFLogChannel()) << "Finished event loop number " << fNRuns - 1 << " (" << s.CpuTime() << "s CPU, "
-                                << s.RealTime() << "s elapsed).";
+/// Return true if the next event loop can run in worker processes, see ROOT::RDF::EnableMultiProcessing. Otherwise,
+/// emit a warning: the event loop runs in this process.
+bool RLoopManager::CanRunMultiProcess() const
+{
+#ifdef R__WIN32
+   return false;
+#else
+   std::string reason;
+   if (fLoopType != ELoopType::kNoFiles && fLoopType != ELoopType::kROOTFiles) {
+      reason = "only event loops over TTrees or over an empty source can be split across processes";
+   } else if (!fBookedRanges.empty()) {
+      reason = "Range nodes need to process the entries in order";
+   } else if (!std::all_of(fBookedActions.begin(), fBookedActions.end(),
+                           [](RDFInternal::RActionBase *a) { return a->SupportsMultiProcess(); })) {
+      reason = "the results of some of the booked actions cannot be merged (e.g. Foreach, Display, or Take of a type "
+               "without dictionary)";
+   }
+   if (reason.empty())
+      return true;
+   R__LOG_WARNING(RDFLogChannel()) << "A multi-process event loop was requested, but " << reason
+                                   << ". Processing entries in this process.";
+   return false;
+#endif
+}
+
+/// Run the event loop in worker processes forked from this one, each processing a contiguous share of the entries,
+/// then merge the partial results of the actions. See ROOT::RDF::EnableMultiProcessing.
+void RLoopManager::RunMultiProcess()
+{
+#ifndef R__WIN32
+   ULong64_t nEntries = fNEmptyEntries;
+   if (fLoopType == ELoopType::kROOTFiles) {
+      // TTreeReader entry ranges refer to the entries of the entry list, if any
+      const auto *entryList = fTree->GetEntryList();
+      nEntries = entryList != nullptr ? entryList->GetN() : fTree->GetEntries();
+   }
+   // incremental event loops only process the new entries
+   const auto firstEntry = std::min(fEntryRange.first, nEntries);
+   nEntries = std::min(fEntryRange.second, nEntries) - firstEntry;
+
+   ROOT::TProcessExecutor pool(fNWorkers);
+   const auto nWorkers = static_cast<unsigned int>(std::min<ULong64_t>(pool.GetPoolSize(), nEntries));
+   if (nWorkers < 2u) {
+      RunEventLoop();
+      return;
+   }
+
+   std::vector<std::pair<ULong64_t, ULong64_t>> ranges;
+   for (auto i = 0u; i < nWorkers; ++i)
+      ranges.emplace_back(firstEntry + nEntries * i / nWorkers, firstEntry + nEntries * (i + 1u) / nWorkers);
+
+   const std::string prefix = TString::Format("%s/rdf_mp_%d_%p_%u_", gSystem->TempDirectory(), gSystem->GetPid(),
+                                              static_cast<void *>(this), fNRuns)
+                                 .Data();
+   auto partialFileName = [&prefix](unsigned int i) { return prefix + std::to_string(i) + ".root"; };
+
+   R__LOG_INFO(RDFLogChannel()) << "Processing " << nEntries << " entries in " << nWorkers << " worker processes.";
+   const auto statuses = pool.Map(
+      [this, &ranges, &partialFileName](unsigned int i) { return RunWorker(i, ranges[i], partialFileName(i)); },
+      ROOT::TSeqU(nWorkers));
+
+   // read the partial results of the actions (or the error messages) written by the workers
+   std::vector<RDFInternal::RActionBase::MergeableValues_t> partials(fBookedActions.size());
+   std::string error = statuses.size() == nWorkers ? "" : "the worker processes could not be started";
+   for (auto i = 0u; i < nWorkers; ++i) {
+      const auto fileName = partialFileName(i);
+      if (gSystem->AccessPathName(fileName.c_str())) {
+         if (error.empty())
+            error = "worker " + std::to_string(i) + " did not write its results";
+         continue;
+      }
+      {
+         std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+         if (file == nullptr || file->IsZombie()) {
+            error = "the results of worker " + std::to_string(i) + " could not be read";
+         } else if (auto *msg = file->Get<TObjString>("error")) {
+            error = msg->GetString().Data();
+            delete msg;
+         } else {
+            for (std::size_t a = 0u; a < fBookedActions.size() && error.empty(); ++a) {
+               if (fBookedActions[a]->HasPartialOutputs())
+                  continue;
+               try {
+                  partials[a].emplace_back(ReadMergeableValue(*file, "action_" + std::to_string(a)));
+               } catch (const std::runtime_error &e) {
+                  error = e.what();
+               }
+            }
+         }
+      }
+      gSystem->Unlink(fileName.c_str());
+   }
+   if (!error.empty())
+      throw std::runtime_error("RDataFrame: the multi-process event loop failed: " + error);
+
+   for (std::size_t a = 0u; a < fBookedActions.size(); ++a) {
+      auto *action = fBookedActions[a];
+      if (action->HasPartialOutputs())
+         action->MergePartialOutputs(nWorkers);
+      else
+         action->SetMergedResult(std::move(partials[a]));
+      // the results are final: CleanUpNodes must not finalize the action again
+      action->SetHasRun();
+   }
+#endif // not implemented otherwise (never called)
+}
+
+/// Process the entries in `range` in a worker process of a multi-process event loop, and write the partial results of
+/// the booked actions to `fileName`. Return 0 on success. Otherwise, return 1 and write the error message to the file.
+int RLoopManager::RunWorker(unsigned int index, const std::pair<ULong64_t, ULong64_t> &range,
+                            const std::string &fileName)
+{
+#ifndef R__WIN32
+   ReopenInputFiles();
+   RDFInternal::SetWorkerIndex(static_cast<int>(index));
+   fEntryRange = range;
+   // CleanUpNodes moves the booked actions to the list of actions that already ran
+   const auto actions = fBookedActions;
+
+   std::string error;
+   try {
+      RunEventLoop();
+      CleanUpNodes();
+   } catch (const std::exception &e) {
+      error = e.what();
+   } catch (...) {
+      error = "unknown error in worker " + std::to_string(index);
+   }
+
+   TDirectory::TContext ctxt; // the file is created in this scope only
+   std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "RECREATE"));
+   if (file == nullptr || file->IsZombie())
+      return 1;
+   for (std::size_t a = 0u; a < actions.size() && error.empty(); ++a) {
+      if (actions[a]->HasPartialOutputs())
+         continue;
+      try {
+         WriteMergeableValue(*actions[a]->GetMergeableValue(), *file, "action_" + std::to_string(a));
+      } catch (const std::exception &e) {
+         error = e.what();
+      }
+   }
+   if (error.empty())
+      return 0;
+   TObjString msg(error.c_str());
+   file->WriteTObject(&msg, "error");
+   return 1;
+#else
+   (void)index;
+   (void)range;
+   (void)fileName;
+   return 1;
+#endif
+}
+
+/// Read the state of an incremental event loop, see ROOT::RDF::EnableIncrementalProcessing. Restrict the entries
+/// processed by the event loop to the ones that the previous runs did not process, and return the results of the booked
+/// actions stored by the previous runs (none for the first run).
+std::vector<std::unique_ptr<RMergeableValueBase>> RLoopManager::LoadIncrementalState()
+{
+   const auto &stateFile = fIncrementalStateFileName;
+   if (fTree->GetEntryList() != nullptr)
+      throw std::runtime_error("Incremental processing is not supported for datasets with an entry list.");
+   if (!fBookedRanges.empty())
+      throw std::runtime_error("Incremental processing cannot be combined with Range.");
+   for (auto *action : fBookedActions) {
+      if (!action->HasStreamableResult())
+         throw std::runtime_error("Incremental processing requires that the results of all actions can be merged and "
+                                  "stored: this is not the case e.g. for Foreach, Display and Snapshot.");
+   }
+
+   std::vector<std::unique_ptr<RMergeableValueBase>> storedResults;
+   if (gSystem->AccessPathName(stateFile.c_str()))
+      return storedResults; // first run: all entries are processed
+
+   const std::string fromScratch = " Remove " + stateFile + " to process the dataset from scratch.";
+   std::unique_ptr<TFile> file(TFile::Open(stateFile.c_str(), "READ"));
+   auto *treeName = file != nullptr ? file->Get<TObjString>("tree") : nullptr;
+   auto *fileNames = file != nullptr ? file->Get<std::vector<std::string>>("files") : nullptr;
+   auto *fileEntries = file != nullptr ? file->Get<std::vector<ULong64_t>>("entries") : nullptr;
+   auto *storedClasses = file != nullptr ? file->Get<std::vector<std::string>>("actions") : nullptr;
+   std::unique_ptr<TObject> treeNameDeleter(treeName);
+   std::unique_ptr<std::vector<std::string>> fileNamesDeleter(fileNames), storedClassesDeleter(storedClasses);
+   std::unique_ptr<std::vector<ULong64_t>> fileEntriesDeleter(fileEntries);
+   if (treeName == nullptr || fileNames == nullptr || fileEntries == nullptr || storedClasses == nullptr ||
+       fileNames->size() != fileEntries->size())
+      throw std::runtime_error("Could not read the state of the incremental event loop from " + stateFile + ".");
+
+   // the results stored by previous runs must come from the same actions
+   if (treeName->GetString() != fTree->GetName() || storedClasses->size() != fBookedActions.size())
+      throw std::runtime_error("The state stored in " + stateFile +
+                               " was produced by a different computation graph or dataset." + fromScratch);
+   for (std::size_t a = 0u; a < fBookedActions.size(); ++a) {
+      const auto mergeable = fBookedActions[a]->GetMergeableValue();
+      const auto &m = *mergeable;
+      if ((*storedClasses)[a] != TClass::GetClass(typeid(m))->GetName())
+         throw std::runtime_error("The state stored in " + stateFile +
+                                  " was produced by a different computation graph." + fromScratch);
+      storedResults.emplace_back(ReadMergeableValue(*file, "action_" + std::to_string(a)));
+   }
+
+   // the files processed by previous runs must be the first files of the dataset, and only the last of them can have
+   // grown since then
+   const auto currentFiles = GetFileEntries(*fTree);
+   const auto nStored = fileNames->size();
+   ULong64_t firstNewEntry = 0ull;
+   for (std::size_t i = 0u; i < nStored; ++i) {
+      const bool isLast = i + 1u == nStored;
+      const auto storedEntries = (*fileEntries)[i];
+      if (i >= currentFiles.size() || currentFiles[i].first != (*fileNames)[i] ||
+          (isLast ? currentFiles[i].second < storedEntries : currentFiles[i].second != storedEntries))
+         throw std::runtime_error("The files processed by the previous runs, listed in " + stateFile +
+                                  ", are not the first files of the dataset, or some of their entries changed." +
+                                  fromScratch);
+      firstNewEntry += storedEntries;
+   }
+   ULong64_t nEntries = 0ull;
+   for (const auto &f : currentFiles)
+      nEntries += f.second;
+   fEntryRange = {firstNewEntry, nEntries};
+   R__LOG_INFO(RDFLogChannel()) << "Incremental event loop: skipping the " << firstNewEntry
+                                << " entries processed by previous runs.";
+   return storedResults;
+}
+
+/// Merge the results of the booked actions with the ones stored by previous runs of an incremental event loop, and
+/// store them in the state file together with the entries processed so far, see
+/// ROOT::RDF::EnableIncrementalProcessing. If the event loop did not process any new entry, the stored results are
+/// used as they are: the partial results of an empty event loop are not always neutral when merged (e.g. StdDev).
+void RLoopManager::SaveIncrementalState(const std::vector<RDFInternal::RActionBase *> &actions,
+                                        std::vector<std::unique_ptr<RMergeableValueBase>> &&storedResults,
+                                        bool hasNewEntries)
+{
+   if (!storedResults.empty()) {
+      for (std::size_t a = 0u; a < actions.size(); ++a) {
+         RDFInternal::RActionBase::MergeableValues_t results;
+         results.emplace_back(std::move(storedResults[a]));
+         if (hasNewEntries)
+            results.emplace_back(actions[a]->GetMergeableValue());
+         actions[a]->SetMergedResult(std::move(results));
+      }
+   }
+
+   std::vector<std::string> fileNames;
+   std::vector<ULong64_t> fileEntries;
+   for (auto &f : GetFileEntries(*fTree)) {
+      fileNames.emplace_back(std::move(f.first));
+      fileEntries.emplace_back(f.second);
+   }
+   std::vector<std::string> actionClasses;
+   for (auto *action : actions) {
+      const auto mergeable = action->GetMergeableValue();
+      const auto &m = *mergeable;
+      actionClasses.emplace_back(TClass::GetClass(typeid(m))->GetName());
+   }
+
+   // write a new file and replace the old state only once it is complete
+   const auto &stateFile = fIncrementalStateFileName;
+   const auto tmpFile = stateFile + ".tmp";
+   {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(tmpFile.c_str(), "RECREATE"));
+      if (file == nullptr || file->IsZombie())
+         throw std::runtime_error("Could not write the state of the incremental event loop to " + tmpFile + ".");
+      TObjString treeName(fTree->GetName());
+      file->WriteTObject(&treeName, "tree");
+      file->WriteObject(&fileNames, "files");
+      file->WriteObject(&fileEntries, "entries");
+      file->WriteObject(&actionClasses, "actions");
+      for (std::size_t a = 0u; a < actions.size(); ++a)
+         WriteMergeableValue(*actions[a]->GetMergeableValue(), *file, "action_" + std::to_string(a));
+      file->Close();
+   }
+   if (gSystem->Rename(tmpFile.c_str(), stateFile.c_str()) != 0)
+      throw std::runtime_error("Could not write the state of the incremental event loop to " + stateFile + ".");
 }
 
 /// Return the list of default columns -- empty if none was provided when constructing the RDataFrame
@@ -816,6 +1607,121 @@ bool RLoopManager::CheckFilters(unsigned int, Long64_t)
    return true;
 }
 
+/// End of recursive chain of calls: return the mask of the entries of the current bulk that should be processed.
+const ROOT::RVecB &RLoopManager::CheckFiltersBulk(unsigned int slot, const ROOT::RVec<Long64_t> &)
+{
+   return fBulkMasks[slot];
+}
+
+/// Set the number of entries that the next event loops will process at a time, see GetBulkSize.
+/// A bulk size of 1 (the default) means that entries are processed one by one.
+void RLoopManager::SetBulkSize(unsigned int bulkSize)
+{
+   if (bulkSize == 0u)
+      throw std::invalid_argument("The bulk size must be larger than zero.");
+   fBulkSize = bulkSize;
+}
+
+/// Register a column reader that must be filled with the values of each entry of the current bulk of the given slot.
+void RLoopManager::RegisterBulkReader(unsigned int slot, RDFInternal::RBulkColumnReaderBase *reader)
+{
+   fBulkReaders[slot].emplace_back(reader);
+}
+
+/// Enable the optimizations of the computation graph described in ROOT::RDF::EnableGraphOptimization.
+void RLoopManager::SetGraphOptimization(ULong64_t nWarmUpEntries)
+{
+   fOptimizeGraph = true;
+   fNWarmUpEntries = nWarmUpEntries;
+}
+
+namespace {
+/// Return the node registered with the given key, if it is still alive. Expired entries are removed.
+template <typename Node_t>
+std::shared_ptr<Node_t>
+GetRegisteredNode(std::unordered_map<std::string, std::weak_ptr<Node_t>> &registry, const std::string &key)
+{
+   auto it = registry.find(key);
+   if (it == registry.end())
+      return nullptr;
+   auto node = it->second.lock();
+   if (node == nullptr)
+      registry.erase(it);
+   return node;
+}
+} // anonymous namespace
+
+/// Return a jitted Filter previously booked with the same key, or nullptr if there is none.
+/// Keys identify the filter expression, its input columns and the node the filter is attached to.
+std::shared_ptr<RJittedFilter> RLoopManager::GetEquivalentJittedFilter(const std::string &key)
+{
+   return GetRegisteredNode(fJittedFilters, key);
+}
+
+void RLoopManager::RegisterJittedFilter(const std::string &key, const std::shared_ptr<RJittedFilter> &filter)
+{
+   fJittedFilters[key] = filter;
+}
+
+/// Return a jitted Define previously booked with the same key, or nullptr if there is none.
+/// Keys identify the expression of the Define and its input columns.
+std::shared_ptr<RJittedDefine> RLoopManager::GetEquivalentJittedDefine(const std::string &key)
+{
+   return GetRegisteredNode(fJittedDefines, key);
+}
+
+void RLoopManager::RegisterJittedDefine(const std::string &key, const std::shared_ptr<RJittedDefine> &define)
+{
+   fJittedDefines[key] = define;
+}
+
+/// Set the number of worker processes of the next event loops, see ROOT::RDF::EnableMultiProcessing.
+void RLoopManager::SetNWorkers(unsigned int nWorkers)
+{
+   if (nWorkers != 1u) {
+#ifdef R__WIN32
+      throw std::runtime_error("Multi-process event loops are not supported on Windows.");
+#endif
+      if (fNSlots > 1u)
+         throw std::runtime_error(
+            "Multi-process event loops cannot be enabled for a RDataFrame that uses implicit multi-threading.");
+   }
+   fNWorkers = nWorkers;
+}
+
+/// Set the file that stores the state of incremental event loops, see ROOT::RDF::EnableIncrementalProcessing.
+void RLoopManager::SetIncrementalStateFileName(const std::string &fileName)
+{
+   if (!fileName.empty() && fLoopType != ELoopType::kROOTFiles && fLoopType != ELoopType::kROOTFilesMT)
+      throw std::runtime_error("Incremental processing is only supported for RDataFrames that read a TTree or TChain.");
+   fIncrementalStateFileName = fileName;
+}
+
+/// Enable or disable the collection of runtime statistics of the nodes of the graph, see ROOT::RDF::EnableProfiling.
+void RLoopManager::SetProfiling(bool enable)
+{
+   fProfilingEnabled = enable;
+   if (enable && !fProfiler)
+      fProfiler.reset(new RDFInternal::RProfiler(fNSlots));
+}
+
+/// Return the object in which the runtime statistics of the given node are recorded, or nullptr if profiling is not
+/// enabled. To be called before the event loop starts, e.g. in InitNode.
+RDFInternal::RNodeProfile *
+RLoopManager::GetNodeProfile(const void *node, std::string_view kind, std::string_view name)
+{
+   return fProfilingEnabled ? fProfiler->GetNodeProfile(node, kind, name) : nullptr;
+}
+
+/// Return the runtime statistics of the nodes that ran in the last event loop. Throw if profiling is not enabled.
+ROOT::RDF::RProfileReport RLoopManager::GetProfileReport() const
+{
+   if (!fProfilingEnabled)
+      throw std::runtime_error("Profiling is not enabled for this RDataFrame: call ROOT::RDF::EnableProfiling "
+                               "before running the event loop.");
+   return fProfiler->GetReport();
+}
+
 /// Call `FillReport` on all booked filters
 void RLoopManager::Report(ROOT::RDF::RCutFlowReport &rep) const
 {
@@ -829,6 +1735,12 @@ void RLoopManager::ToJitExec(const std::string &code) const
    GetCodeToJit().append(code);
 }
 
+void RLoopManager::ToCachedJitExec(std::function<void()> &&call) const
+{
+   R__LOCKGUARD(gROOTMutex);
+   GetCachedCallsToJit().emplace_back(std::move(call));
+}
+
 void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(unsigned int)> &&f)
 {
    if (everyNEvents == 0ull)
@@ -837,6 +1749,13 @@ void RLoopManager::RegisterCallback(ULong64_t everyNEvents, std::function<void(u
       fCallbacks.emplace_back(everyNEvents, std::move(f), fNSlots);
 }
 
+void RLoopManager::RegisterCallback(std::chrono::steady_clock::duration period, std::function<void(unsigned int)> &&f)
+{
+   if (period <= std::chrono::steady_clock::duration::zero())
+      throw std::runtime_error("The period of a callback must be positive.");
+   fCallbacks.emplace_back(period, std::move(f), fNSlots);
+}
+
 std::vector<std::string> RLoopManager::GetFiltersNames()
 {
    std::vector<std::string> filters;
@@ -0,0 +1,145 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RMergeableValue.hxx"
+#include "TBufferFile.h"
+#include "TClass.h"
+#include "TDirectory.h"
+#include "TError.h" // Warning
+#include "TFile.h"
+#include "TKey.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <typeinfo>
+
+using ROOT::Detail::RDF::RMergeableValueBase;
+
+namespace {
+/// Marks the start of the buffers filled by SerializeMergeableValue ("RDFM").
+constexpr UInt_t kMergeableMagic = 0x5244464d;
+/// The version of the layout of the buffers filled by SerializeMergeableValue.
+constexpr UShort_t kMergeableFormatVersion = 1;
+
+TClass *GetMergeableClass(const RMergeableValueBase &value)
+{
+   auto *cl = TClass::GetClass(typeid(value));
+   if (cl == nullptr)
+      throw std::runtime_error(std::string("No dictionary is available for the mergeable of type ") +
+                               typeid(value).name() + ": it cannot be serialized.");
+   return cl;
+}
+} // anonymous namespace
+
+std::vector<char> ROOT::Detail::RDF::SerializeMergeableValue(const RMergeableValueBase &value)
+{
+   auto *cl = GetMergeableClass(value);
+   const std::string className = cl->GetName();
+
+   TBufferFile buf(TBuffer::kWrite);
+   buf.WriteUInt(kMergeableMagic);
+   buf.WriteUShort(kMergeableFormatVersion);
+   buf.WriteStdString(&className);
+   buf.WriteUInt(cl->GetCheckSum());
+   buf.WriteObjectAny(&value, cl);
+   return std::vector<char>(buf.Buffer(), buf.Buffer() + buf.Length());
+}
+
+std::unique_ptr<RMergeableValueBase> ROOT::Detail::RDF::DeserializeMergeableValue(const char *buffer, std::size_t size)
+{
+   if (buffer == nullptr || size < sizeof(UInt_t) + sizeof(UShort_t))
+      throw std::runtime_error("The buffer does not contain a serialized mergeable.");
+
+   TBufferFile buf(TBuffer::kRead, size, const_cast<char *>(buffer), /*adopt=*/kFALSE);
+   UInt_t magic = 0;
+   UShort_t version = 0;
+   buf.ReadUInt(magic);
+   buf.ReadUShort(version);
+   if (magic != kMergeableMagic)
+      throw std::runtime_error("The buffer does not contain a serialized mergeable.");
+   if (version > kMergeableFormatVersion)
+      throw std::runtime_error("The mergeable was serialized with a newer version of ROOT (buffer format version " +
+                               std::to_string(version) + ").");
+
+   std::string className;
+   buf.ReadStdString(&className);
+   UInt_t checksum = 0;
+   buf.ReadUInt(checksum);
+   if (static_cast<std::size_t>(buf.Length()) > size)
+      throw std::runtime_error("The buffer of the serialized mergeable is truncated.");
+
+   auto *cl = TClass::GetClass(className.c_str());
+   if (cl == nullptr || !cl->InheritsFrom(TClass::GetClass<RMergeableValueBase>()))
+      throw std::runtime_error("Unknown mergeable type " + className + ": cannot deserialize it.");
+   if (cl->GetCheckSum() != checksum)
+      throw std::runtime_error("The layout of " + className +
+                               " differs from the one of the serialized mergeable: read it from a ROOT file instead.");
+
+   auto *obj = buf.ReadObjectAny(TClass::GetClass<RMergeableValueBase>());
+   if (obj == nullptr)
+      throw std::runtime_error("The serialized mergeable of type " + className + " could not be read.");
+   return std::unique_ptr<RMergeableValueBase>(static_cast<RMergeableValueBase *>(obj));
+}
+
+void ROOT::Detail::RDF::WriteMergeableValue(const RMergeableValueBase &value, TDirectory &dir,
+                                            const std::string &name)
+{
+   auto *cl = GetMergeableClass(value);
+   if (dir.WriteObjectAny(&value, cl, name.c_str(), "Overwrite") <= 0)
+      throw std::runtime_error("Could not write the mergeable \"" + name + "\" to " + dir.GetPath() + ".");
+}
+
+std::unique_ptr<RMergeableValueBase> ROOT::Detail::RDF::ReadMergeableValue(TDirectory &dir, const std::string &name)
+{
+   auto *value = dir.Get<RMergeableValueBase>(name.c_str());
+   if (value == nullptr)
+      throw std::runtime_error("Could not read a mergeable called \"" + name + "\" from " + dir.GetPath() + ".");
+   return std::unique_ptr<RMergeableValueBase>(value);
+}
+
+void ROOT::Detail::RDF::MergeMergeableFiles(const std::string &outputFileName,
+                                            const std::vector<std::string> &inputFileNames)
+{
+   auto *baseClass = TClass::GetClass<RMergeableValueBase>();
+
+   // the merged mergeables, in the order in which they were first found
+   std::vector<std::pair<std::string, std::unique_ptr<RMergeableValueBase>>> merged;
+   for (const auto &inputFileName : inputFileNames) {
+      std::unique_ptr<TFile> inputFile(TFile::Open(inputFileName.c_str(), "READ"));
+      if (inputFile == nullptr || inputFile->IsZombie())
+         throw std::runtime_error("Could not open the input file " + inputFileName + ".");
+
+      std::set<std::string> seen; // the keys are sorted by decreasing cycle: only read the latest one
+      for (auto *obj : *inputFile->GetListOfKeys()) {
+         auto *key = static_cast<TKey *>(obj);
+         const std::string name = key->GetName();
+         if (!seen.insert(name).second)
+            continue;
+         auto *cl = TClass::GetClass(key->GetClassName());
+         if (cl == nullptr || !cl->InheritsFrom(baseClass)) {
+            Warning("MergeMergeableFiles", "Skipping \"%s\" in %s: it is not a RDataFrame mergeable result.",
+                    name.c_str(), inputFileName.c_str());
+            continue;
+         }
+         auto value = ReadMergeableValue(*inputFile, name);
+         auto it = std::find_if(merged.begin(), merged.end(), [&name](const auto &m) { return m.first == name; });
+         if (it == merged.end())
+            merged.emplace_back(name, std::move(value));
+         else
+            MergeValues(*it->second, *value);
+      }
+   }
+
+   std::unique_ptr<TFile> outputFile(TFile::Open(outputFileName.c_str(), "RECREATE"));
+   if (outputFile == nullptr || outputFile->IsZombie())
+      throw std::runtime_error("Could not create the output file " + outputFileName + ".");
+   for (const auto &m : merged)
+      WriteMergeableValue(*m.second, *outputFile, m.first);
+   outputFile->Close();
+}
@@ -0,0 +1,109 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfileReport.hxx"
+#include "TString.h" // Printf
+
+#include <cstdio> // std::snprintf
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+std::string EscapeJSON(const std::string &str)
+{
+   std::string escaped;
+   for (const char c : str) {
+      switch (c) {
+      case '"': escaped += "\\\""; break;
+      case '\\': escaped += "\\\\"; break;
+      case '\n': escaped += "\\n"; break;
+      case '\t': escaped += "\\t"; break;
+      default:
+         if (static_cast<unsigned char>(c) < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            escaped += buf;
+         } else {
+            escaped += c;
+         }
+      }
+   }
+   return escaped;
+}
+
+void WriteStatsJSON(std::ostream &os, const ROOT::RDF::RNodeSlotStats &stats)
+{
+   os << "\"calls\": " << stats.fNCalls << ", \"time\": " << stats.fTime << ", \"readTime\": " << stats.fReadTime
+      << ", \"userTime\": " << stats.fTime - stats.fReadTime << ", \"bytesRead\": " << stats.fBytesRead;
+}
+} // anonymous namespace
+
+namespace ROOT {
+namespace RDF {
+
+RNodeSlotStats RNodeProfileInfo::GetTotal() const
+{
+   RNodeSlotStats total;
+   for (const auto &stats : fSlotStats) {
+      total.fNCalls += stats.fNCalls;
+      total.fTime += stats.fTime;
+      total.fReadTime += stats.fReadTime;
+      total.fBytesRead += stats.fBytesRead;
+   }
+   return total;
+}
+
+/// Print the statistics summed over all processing slots, one line per node. Times are in seconds.
+void RProfileReport::Print() const
+{
+   Printf("%-8s %-24s %12s %12s %12s %12s %14s", "Kind", "Name", "Calls", "Time", "Read time", "User time",
+          "Bytes read");
+   for (const auto &node : fNodes) {
+      const auto total = node.GetTotal();
+      const auto &name = node.GetName().empty() ? std::string("(unnamed)") : node.GetName();
+      Printf("%-8s %-24s %12llu %12.6f %12.6f %12.6f %14lld", node.GetKind().c_str(), name.c_str(), total.fNCalls,
+             total.fTime, total.fReadTime, total.fTime - total.fReadTime, total.fBytesRead);
+   }
+   Printf("Event loop time: %.6f s", fEventLoopTime);
+}
+
+/// Return the report in JSON format. Times are in seconds. Per-slot statistics are listed in the "slots" array of
+/// each node.
+std::string RProfileReport::AsJSON() const
+{
+   std::ostringstream os;
+   os << "{\n  \"eventLoopTime\": " << fEventLoopTime << ",\n  \"nodes\": [";
+   for (std::size_t i = 0u; i < fNodes.size(); ++i) {
+      const auto &node = fNodes[i];
+      os << (i == 0u ? "\n" : ",\n") << "    {\"kind\": \"" << EscapeJSON(node.GetKind()) << "\", \"name\": \""
+         << EscapeJSON(node.GetName()) << "\", ";
+      WriteStatsJSON(os, node.GetTotal());
+      os << ",\n     \"slots\": [";
+      const auto &slotStats = node.GetSlotStats();
+      for (std::size_t slot = 0u; slot < slotStats.size(); ++slot) {
+         os << (slot == 0u ? "" : ", ") << "{";
+         WriteStatsJSON(os, slotStats[slot]);
+         os << "}";
+      }
+      os << "]}";
+   }
+   os << "\n  ]\n}\n";
+   return os.str();
+}
+
+void RProfileReport::SaveJSON(const std::string &fileName) const
+{
+   std::ofstream out(fileName);
+   if (!out.is_open())
+      throw std::runtime_error("Could not open output file \"" + fileName + "\" for writing");
+   out << AsJSON();
+}
+
+} // namespace RDF
+} // namespace ROOT
@@ -0,0 +1,120 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RProfiler.hxx"
+#include "TFile.h"
+#include "TTree.h"
+#include "TTreeReader.h"
+
+#include <algorithm> // std::max
+#include <cstdio>    // std::snprintf
+
+using ROOT::Internal::RDF::RNodeProfile;
+using ROOT::Internal::RDF::RProfiler;
+
+RNodeProfile::RScope::RScope(RNodeProfile &profile, unsigned int slot)
+   : fProfile(profile), fSlot(slot), fStart(Clock_t::now()), fReadEnd(fStart),
+     fStartBytes(profile.fProfiler.GetBytesRead(slot)), fReadEndBytes(fStartBytes)
+{
+}
+
+void RNodeProfile::RScope::ReadDone()
+{
+   fReadEnd = Clock_t::now();
+   fReadEndBytes = fProfile.fProfiler.GetBytesRead(fSlot);
+}
+
+RNodeProfile::RScope::~RScope()
+{
+   const auto end = Clock_t::now();
+   auto &stats = fProfile.GetSlotStats(fSlot);
+   ++stats.fNCalls;
+   stats.fTime += std::chrono::duration<double>(end - fStart).count();
+   stats.fReadTime += std::chrono::duration<double>(fReadEnd - fStart).count();
+   // the counter of bytes read restarts when the TChain switches to a new file
+   stats.fBytesRead += std::max(fReadEndBytes - fStartBytes, 0ll);
+}
+
+RNodeProfile::RNodeProfile(RProfiler &profiler, std::string_view kind, std::string_view name, unsigned int nSlots)
+   : fProfiler(profiler)
+{
+   fInfo.fKind = std::string(kind);
+   fInfo.fName = std::string(name);
+   fInfo.fSlotStats.resize(nSlots * CacheLineStep<ROOT::RDF::RNodeSlotStats>());
+}
+
+void RNodeProfile::Reset()
+{
+   std::fill(fInfo.fSlotStats.begin(), fInfo.fSlotStats.end(), ROOT::RDF::RNodeSlotStats{});
+}
+
+std::string RNodeProfile::GetSummary() const
+{
+   const auto total = GetInfo().GetTotal();
+   if (total.fNCalls == 0ull)
+      return "";
+   char buf[128];
+   std::snprintf(buf, sizeof(buf), "%llu calls, %.3g ms (read %.3g ms)", total.fNCalls, total.fTime * 1e3,
+                 total.fReadTime * 1e3);
+   return buf;
+}
+
+/// Return the statistics of the node, without the padding used to avoid false sharing between slots.
+ROOT::RDF::RNodeProfileInfo RNodeProfile::GetInfo() const
+{
+   ROOT::RDF::RNodeProfileInfo info;
+   info.fKind = fInfo.fKind;
+   info.fName = fInfo.fName;
+   const auto step = CacheLineStep<ROOT::RDF::RNodeSlotStats>();
+   for (std::size_t i = 0u; i < fInfo.fSlotStats.size(); i += step)
+      info.fSlotStats.emplace_back(fInfo.fSlotStats[i]);
+   return info;
+}
+
+/// Return the profile of the given node, creating it if needed.
+/// Not thread-safe: nodes retrieve their profile before the event loop starts.
+RNodeProfile *RProfiler::GetNodeProfile(const void *node, std::string_view kind, std::string_view name)
+{
+   auto &profile = fProfilesByNode[node];
+   // a new node might have been allocated at the address of a node that has been deleted in the meantime
+   if (profile == nullptr || profile->fInfo.GetKind() != kind || profile->fInfo.GetName() != name) {
+      fProfiles.emplace_back(new RNodeProfile(*this, kind, name, fNSlots));
+      profile = fProfiles.back().get();
+   }
+   return profile;
+}
+
+/// Return the number of bytes read so far from the file currently read by the given slot.
+Long64_t RProfiler::GetBytesRead(unsigned int slot) const
+{
+   auto *r = fTreeReaders[slot];
+   auto *tree = r != nullptr ? r->GetTree() : nullptr;
+   auto *file = tree != nullptr ? tree->GetCurrentFile() : nullptr;
+   return file != nullptr ? file->GetBytesRead() : 0ll;
+}
+
+void RProfiler::Reset()
+{
+   for (auto &profile : fProfiles)
+      profile->Reset();
+   std::fill(fTreeReaders.begin(), fTreeReaders.end(), nullptr);
+   fEventLoopTime = 0.;
+}
+
+/// Return the statistics of the nodes that were evaluated in the last event loop.
+ROOT::RDF::RProfileReport RProfiler::GetReport() const
+{
+   ROOT::RDF::RProfileReport report;
+   for (const auto &profile : fProfiles) {
+      auto info = profile->GetInfo();
+      if (info.GetTotal().fNCalls > 0ull)
+         report.fNodes.emplace_back(std::move(info));
+   }
+   report.fEventLoopTime = fEventLoopTime;
+   return report;
+}
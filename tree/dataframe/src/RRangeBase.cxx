@@ -15,13 +15,14 @@ using ROOT::Detail::RDF::RLoopManager;
 
 RRangeBase::RRangeBase(RLoopManager *implPtr, unsigned int start, unsigned int stop, unsigned int stride,
                        const unsigned int nSlots)
-   : RNodeBase(implPtr), fStart(start), fStop(stop), fStride(stride), fNSlots(nSlots) { }
+   : RNodeBase(implPtr), fStart(start), fStop(stop), fStride(stride), fLastBulkResults(nSlots), fNSlots(nSlots) { }
 
 void RRangeBase::ResetCounters()
 {
    fLastCheckedEntry = -1;
    fNProcessedEntries = 0;
    fHasStopped = false;
+   fUseGlobalEntries = false;
 }
 
 // outlined to pin virtual table
@@ -168,6 +168,14 @@ std::string RRootDS::GetLabel()
    return "Root";
 }
 
+std::string RRootDS::GetDatasetIdentifier()
+{
+   std::string id = "tree " + fTreeName;
+   for (auto *file : *fModelChain.GetListOfFiles())
+      id += "\n" + ROOT::Internal::RDF::GetFileIdentifier(file->GetTitle());
+   return id;
+}
+
 RDataFrame MakeRootDataFrame(std::string_view treeName, std::string_view fileNameGlob)
 {
    return ROOT::RDataFrame(treeName, fileNameGlob);
@@ -0,0 +1,263 @@
+/*************************************************************************
+ * Copyright (C) 1995-2021, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#include "ROOT/RDF/RSketches.hxx"
+#include "TH1.h"
+
+#include <algorithm> // std::max, std::min, std::sort
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility> // std::pair
+
+using ROOT::Detail::RDF::RHyperLogLog;
+using ROOT::Detail::RDF::RTDigest;
+
+namespace {
+constexpr double kPi = 3.14159265358979323846;
+
+/// The k1 scale function of the t-digest: centroids can span at most one unit of k.
+double QuantileToScale(double q, double compression)
+{
+   return compression / (2. * kPi) * std::asin(std::min(std::max(2. * q - 1., -1.), 1.));
+}
+
+double ScaleToQuantile(double k, double compression)
+{
+   const auto x = std::min(std::max(k * 2. * kPi / compression, -kPi / 2.), kPi / 2.);
+   return (std::sin(x) + 1.) / 2.;
+}
+} // anonymous namespace
+
+RHyperLogLog::RHyperLogLog(unsigned int precision) : fPrecision(precision)
+{
+   if (precision < 4u || precision > 18u)
+      throw std::invalid_argument("RHyperLogLog: the precision must be between 4 and 18, it is " +
+                                  std::to_string(precision) + ".");
+   fRegisters.resize(1u << precision, 0u);
+}
+
+void RHyperLogLog::Merge(const RHyperLogLog &other)
+{
+   if (other.fPrecision != fPrecision)
+      throw std::invalid_argument("RHyperLogLog: cannot merge sketches with different precisions.");
+   for (std::size_t i = 0u; i < fRegisters.size(); ++i)
+      fRegisters[i] = std::max(fRegisters[i], other.fRegisters[i]);
+}
+
+/// Return the estimated number of distinct values added to the sketch.
+double RHyperLogLog::Estimate() const
+{
+   const double m = fRegisters.size();
+   double alpha = 0.7213 / (1. + 1.079 / m);
+   if (fRegisters.size() == 16u)
+      alpha = 0.673;
+   else if (fRegisters.size() == 32u)
+      alpha = 0.697;
+   else if (fRegisters.size() == 64u)
+      alpha = 0.709;
+
+   double sum = 0.;
+   std::size_t nZeros = 0u;
+   for (auto r : fRegisters) {
+      sum += std::ldexp(1., -int(r));
+      if (r == 0u)
+         ++nZeros;
+   }
+   const double estimate = alpha * m * m / sum;
+   // small cardinalities: linear counting of the empty registers is more accurate
+   if (estimate <= 2.5 * m && nZeros > 0u)
+      return m * std::log(m / nZeros);
+   return estimate;
+}
+
+RTDigest::RTDigest(double compression) : fCompression(compression)
+{
+   if (!(compression > 0.))
+      throw std::invalid_argument("RTDigest: the compression must be strictly positive.");
+}
+
+std::size_t RTDigest::GetBufferCapacity() const
+{
+   return 5u * static_cast<std::size_t>(std::ceil(fCompression));
+}
+
+void RTDigest::MergeCentroids(std::vector<std::pair<double, double>> &centroids)
+{
+   std::sort(centroids.begin(), centroids.end(),
+             [](const std::pair<double, double> &a, const std::pair<double, double> &b) { return a.first < b.first; });
+
+   // sweep the sorted centroids, merging neighbours as long as the merged centroid spans less than one unit of k
+   fMeans.clear();
+   fWeights.clear();
+   double weightSoFar = 0.;
+   double mean = centroids[0].first;
+   double weight = centroids[0].second;
+   double weightLimit = fTotalWeight * ScaleToQuantile(QuantileToScale(0., fCompression) + 1., fCompression);
+   for (std::size_t i = 1u; i < centroids.size(); ++i) {
+      const auto &c = centroids[i];
+      if (weightSoFar + weight + c.second <= weightLimit) {
+         weight += c.second;
+         mean += (c.first - mean) * c.second / weight;
+      } else {
+         weightSoFar += weight;
+         fMeans.push_back(mean);
+         fWeights.push_back(weight);
+         weightLimit = fTotalWeight * ScaleToQuantile(QuantileToScale(weightSoFar / fTotalWeight, fCompression) + 1.,
+                                                      fCompression);
+         mean = c.first;
+         weight = c.second;
+      }
+   }
+   fMeans.push_back(mean);
+   fWeights.push_back(weight);
+}
+
+void RTDigest::Compress()
+{
+   if (fBuffer.empty())
+      return;
+
+   std::vector<std::pair<double, double>> centroids;
+   centroids.reserve(fMeans.size() + fBuffer.size());
+   for (std::size_t i = 0u; i < fMeans.size(); ++i)
+      centroids.emplace_back(fMeans[i], fWeights[i]);
+   for (auto x : fBuffer)
+      centroids.emplace_back(x, 1.);
+   fBuffer.clear();
+   MergeCentroids(centroids);
+}
+
+void RTDigest::Merge(const RTDigest &other)
+{
+   if (other.fTotalWeight == 0.)
+      return;
+   if (fTotalWeight == 0. || other.fMin < fMin)
+      fMin = other.fMin;
+   if (fTotalWeight == 0. || other.fMax > fMax)
+      fMax = other.fMax;
+   fTotalWeight += other.fTotalWeight;
+
+   std::vector<std::pair<double, double>> centroids;
+   centroids.reserve(fMeans.size() + fBuffer.size() + other.fMeans.size() + other.fBuffer.size());
+   auto addCentroids = [&centroids](const RTDigest &digest) {
+      for (std::size_t i = 0u; i < digest.fMeans.size(); ++i)
+         centroids.emplace_back(digest.fMeans[i], digest.fWeights[i]);
+      for (auto x : digest.fBuffer)
+         centroids.emplace_back(x, 1.);
+   };
+   addCentroids(*this);
+   addCentroids(other);
+   fBuffer.clear();
+   MergeCentroids(centroids);
+}
+
+double RTDigest::Quantile(double q)
+{
+   if (fTotalWeight == 0.)
+      return std::numeric_limits<double>::quiet_NaN();
+   Compress();
+
+   q = std::min(std::max(q, 0.), 1.);
+   const auto n = fMeans.size();
+   if (n == 1u)
+      return fMeans[0];
+
+   // each centroid is assumed to be centred on its mean: interpolate linearly between the centres of neighbouring
+   // centroids, and between the extremes of the distribution and the centres of the first and last centroid
+   const double target = q * fTotalWeight;
+   double cumulative = fWeights[0] / 2.;
+   if (target <= cumulative)
+      return fMin + (fMeans[0] - fMin) * target / cumulative;
+   for (std::size_t i = 0u; i + 1u < n; ++i) {
+      const double step = (fWeights[i] + fWeights[i + 1u]) / 2.;
+      if (target <= cumulative + step)
+         return fMeans[i] + (fMeans[i + 1u] - fMeans[i]) * (target - cumulative) / step;
+      cumulative += step;
+   }
+   const double lastHalfWeight = fWeights[n - 1u] / 2.;
+   return std::min(fMeans[n - 1u] + (fMax - fMeans[n - 1u]) * (target - cumulative) / lastHalfWeight, fMax);
+}
+
+double RTDigest::Cdf(double x)
+{
+   if (fTotalWeight == 0.)
+      return std::numeric_limits<double>::quiet_NaN();
+   Compress();
+
+   if (x < fMin)
+      return 0.;
+   if (x >= fMax)
+      return 1.;
+
+   // invert the piecewise linear interpolation of Quantile(): the knots are the extremes of the distribution and the
+   // centres of the centroids
+   double prevWeight = 0.;
+   double prevValue = fMin;
+   double weightBefore = 0.;
+   for (std::size_t i = 0u; i < fMeans.size(); ++i) {
+      const double centreWeight = weightBefore + fWeights[i] / 2.;
+      if (x < fMeans[i])
+         return (prevWeight + (centreWeight - prevWeight) * (x - prevValue) / (fMeans[i] - prevValue)) / fTotalWeight;
+      prevWeight = centreWeight;
+      prevValue = fMeans[i];
+      weightBefore += fWeights[i];
+   }
+   return (prevWeight + (fTotalWeight - prevWeight) * (x - prevValue) / (fMax - prevValue)) / fTotalWeight;
+}
+
+void ROOT::Internal::RDF::FillAdaptiveHisto(TH1D &h, RTDigest &digest, ROOT::RDF::EAdaptiveBinning binning, int nBins)
+{
+   const double nEntries = digest.GetTotalWeight();
+   nBins = std::max(nBins, 1);
+   if (nEntries == 0.) {
+      h.SetBins(nBins, 0., 1.);
+      return;
+   }
+
+   const double min = digest.GetMin();
+   // the upper edge of the last bin is excluded from the bin
+   const double max = std::nextafter(digest.GetMax(), std::numeric_limits<double>::infinity());
+   std::vector<double> edges;
+   if (digest.GetMin() == digest.GetMax()) {
+      edges = {min - 0.5, min + 0.5};
+   } else if (binning == ROOT::RDF::EAdaptiveBinning::kEqualPopulation) {
+      edges.push_back(min);
+      for (int i = 1; i < nBins; ++i) {
+         const double edge = digest.Quantile(double(i) / nBins);
+         // several quantiles might coincide, e.g. for discrete distributions
+         if (edge > edges.back() && edge < max)
+            edges.push_back(edge);
+      }
+      edges.push_back(max);
+   } else {
+      const double iqr = digest.Quantile(0.75) - digest.Quantile(0.25);
+      const double width = 2. * iqr / std::cbrt(nEntries);
+      int n = 1;
+      if (width > 0.)
+         n = static_cast<int>(std::min(std::ceil((max - min) / width), double(nBins)));
+      for (int i = 0; i < n; ++i)
+         edges.push_back(min + (max - min) * i / n);
+      edges.push_back(max);
+   }
+
+   // all values are between the first and the last edge
+   std::vector<double> cdf(edges.size(), 0.);
+   for (std::size_t i = 1u; i + 1u < edges.size(); ++i)
+      cdf[i] = digest.Cdf(edges[i]);
+   cdf.back() = 1.;
+
+   h.SetBins(edges.size() - 1u, edges.data());
+   for (std::size_t i = 0u; i + 1u < edges.size(); ++i) {
+      const double content = nEntries * (cdf[i + 1u] - cdf[i]);
+      h.SetBinContent(i + 1, content);
+      h.SetBinError(i + 1, std::sqrt(content));
+   }
+   h.ResetStats();
+   h.SetEntries(nEntries);
+}
@@ -321,6 +321,41 @@ static bool RegisterSqliteVfs()
    return (retval == SQLITE_OK);
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// Opens a read-only connection to the database through the custom VFS module
+int OpenReadOnlyDb(const std::string &fileName, sqlite3 **db)
+{
+   int retval = sqlite3_open_v2(fileName.c_str(), db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, gSQliteVfsName);
+   if (retval != SQLITE_OK)
+      return retval;
+
+   // Certain complex queries trigger creation of temporary tables. Depending on the build options of sqlite,
+   // sqlite may try to store such temporary tables on disk, using our custom VFS module to do so.
+   // Creation of new database files, however, is not supported by the custom VFS module.  Thus we set the behavior
+   // of the database connection to "temp_store=2", meaning that temporary tables should always be maintained
+   // in memory.
+   return sqlite3_exec(*db, "PRAGMA temp_store=2;", nullptr, nullptr, nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// Quotes a column name for use in an SQL statement
+std::string QuoteIdentifier(const std::string &name)
+{
+   std::string quoted = "\"";
+   for (auto c : name) {
+      if (c == '"')
+         quoted += '"';
+      quoted += c;
+   }
+   return quoted + '"';
+}
+
+////////////////////////////////////////////////////////////////////////////
+/// The number of entries of the range handed out for each partition of a partitioned query by GetEntryRanges.
+/// The rows of a partition are not counted in advance: the entries of the range beyond the last row of the partition
+/// are skipped.
+constexpr ULong64_t kPartitionRangeSize = 10000;
+
 } // anonymous namespace
 
 namespace ROOT {
@@ -331,8 +366,36 @@ namespace Internal {
 ////////////////////////////////////////////////////////////////////////////
 /// The state of an open dataset in terms of the sqlite3 C library.
 struct RSqliteDSDataSet {
+   /// The query restricted to a range of values of the partitioning key, on its own connection
+   struct RPartition {
+      sqlite3 *fDb = nullptr;
+      sqlite3_stmt *fQuery = nullptr;
+      bool fIsDone = false; ///< Whether all the rows of the partition have been read in the current event loop
+   };
+
    sqlite3 *fDb = nullptr;
    sqlite3_stmt *fQuery = nullptr;
+
+   std::string fFileName;
+   /// The query of a partition, with the bounds of the key range as parameters. Empty if the query is not partitioned.
+   std::string fPartitionQuery;
+   Long64_t fKeyMin = 0;
+   Long64_t fKeyMax = -1; ///< Smaller than fKeyMin if the result set has no rows with a non-NULL key
+   std::vector<RPartition> fPartitions;
+   /// The partitions of the ranges of entries returned by the last call to GetEntryRanges
+   std::vector<std::size_t> fRangePartitions;
+   ULong64_t fFirstRangeEntry = 0;
+
+   /// Frees the statements and closes the connections of the partitions.
+   void ClosePartitions()
+   {
+      for (auto &partition : fPartitions) {
+         sqlite3_finalize(partition.fQuery);
+         sqlite3_close(partition.fDb);
+      }
+      fPartitions.clear();
+      fRangePartitions.clear();
+   }
 };
 }
 
@@ -358,7 +421,7 @@ constexpr char const *RSqliteDS::fgTypeNames[];
 ///
 /// The constructor opens the sqlite file, prepares the query engine and determines the column names and types.
 RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
-   : fDataSet(std::make_unique<Internal::RSqliteDSDataSet>()), fNSlots(0), fNRow(0)
+   : fDataSet(std::make_unique<Internal::RSqliteDSDataSet>()), fNSlots(0), fNRow(0), fNPartitions(0)
 {
    static bool hasSqliteVfs = RegisterSqliteVfs();
    if (!hasSqliteVfs)
@@ -366,17 +429,8 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
 
    int retval;
 
-   retval = sqlite3_open_v2(fileName.c_str(), &fDataSet->fDb, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX,
-                            gSQliteVfsName);
-   if (retval != SQLITE_OK)
-      SqliteError(retval);
-
-   // Certain complex queries trigger creation of temporary tables. Depending on the build options of sqlite,
-   // sqlite may try to store such temporary tables on disk, using our custom VFS module to do so.
-   // Creation of new database files, however, is not supported by the custom VFS module.  Thus we set the behavior
-   // of the database connection to "temp_store=2", meaning that temporary tables should always be maintained
-   // in memory.
-   retval = sqlite3_exec(fDataSet->fDb, "PRAGMA temp_store=2;", nullptr, nullptr, nullptr);
+   fDataSet->fFileName = fileName;
+   retval = OpenReadOnlyDb(fileName, &fDataSet->fDb);
    if (retval != SQLITE_OK)
       SqliteError(retval);
 
@@ -389,7 +443,6 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
    if ((retval != SQLITE_ROW) && (retval != SQLITE_DONE))
       SqliteError(retval);
 
-   fValues.reserve(colCount);
    for (int i = 0; i < colCount; ++i) {
       fColumnNames.emplace_back(sqlite3_column_name(fDataSet->fQuery, i));
       int type = SQLITE_NULL;
@@ -417,34 +470,81 @@ RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query)
       switch (type) {
       case SQLITE_INTEGER:
          fColumnTypes.push_back(ETypes::kInteger);
-         fValues.emplace_back(ETypes::kInteger);
          break;
       case SQLITE_FLOAT:
          fColumnTypes.push_back(ETypes::kReal);
-         fValues.emplace_back(ETypes::kReal);
          break;
       case SQLITE_TEXT:
          fColumnTypes.push_back(ETypes::kText);
-         fValues.emplace_back(ETypes::kText);
          break;
       case SQLITE_BLOB:
          fColumnTypes.push_back(ETypes::kBlob);
-         fValues.emplace_back(ETypes::kBlob);
          break;
       case SQLITE_NULL:
          // TODO: Null values in first rows are not well handled
          fColumnTypes.push_back(ETypes::kNull);
-         fValues.emplace_back(ETypes::kNull);
          break;
       default: throw std::runtime_error("Unhandled data type");
       }
    }
 }
 
+////////////////////////////////////////////////////////////////////////////
+/// \brief Build the dataframe for reading the result set in parallel
+/// \param[in] fileName The path to an sqlite3 file, will be opened read-only
+/// \param[in] query A valid sqlite3 SELECT query, without LIMIT clause
+/// \param[in] keyColumn The name of an integer column of the query whose range of values is partitioned
+/// \param[in] nPartitions The number of partitions of the key range, by default one per processing slot
+///
+/// In addition to what the other constructor does, this constructor determines the range of values of the key.
+/// The connections used to read the partitions are opened once the number of processing slots is known.
+RSqliteDS::RSqliteDS(const std::string &fileName, const std::string &query, const std::string &keyColumn,
+                     unsigned int nPartitions)
+   : RSqliteDS(fileName, query)
+{
+   const auto keyIt = std::find(fColumnNames.begin(), fColumnNames.end(), keyColumn);
+   if (keyIt == fColumnNames.end() || fColumnTypes[std::distance(fColumnNames.begin(), keyIt)] != ETypes::kInteger)
+      throw std::runtime_error("The partitioning key \"" + keyColumn + "\" is not an integer column of the query.");
+   if (sqlite3_threadsafe() == 0)
+      throw std::runtime_error("SQlite was built without support for threads: the query cannot be partitioned.");
+   fNPartitions = nPartitions;
+
+   // The query is used as a subquery: sqlite moves the conditions on the key inside it if possible, so that a range
+   // of the rowid or of an indexed column is searched rather than the full table.
+   std::string subquery = query;
+   while (!subquery.empty() && (std::isspace(static_cast<unsigned char>(subquery.back())) || subquery.back() == ';'))
+      subquery.pop_back();
+   const auto key = QuoteIdentifier(keyColumn);
+   fDataSet->fPartitionQuery = "SELECT * FROM (" + subquery + ") WHERE " + key + " BETWEEN ?1 AND ?2";
+
+   // Two separate queries: sqlite only optimizes a single MIN or MAX aggregate into an index lookup
+   auto getKeyBound = [&](const std::string &aggregate, Long64_t &bound) {
+      const auto boundQuery = "SELECT " + aggregate + "(" + key + ") FROM (" + subquery + ")";
+      sqlite3_stmt *stmt = nullptr;
+      int retval = sqlite3_prepare_v2(fDataSet->fDb, boundQuery.c_str(), -1, &stmt, nullptr);
+      if (retval != SQLITE_OK)
+         SqliteError(retval);
+      retval = sqlite3_step(stmt);
+      const bool hasBound = retval == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL;
+      if (hasBound)
+         bound = sqlite3_column_int64(stmt, 0);
+      sqlite3_finalize(stmt);
+      if (retval != SQLITE_ROW)
+         SqliteError(retval);
+      return hasBound;
+   };
+   if (!getKeyBound("MIN", fDataSet->fKeyMin) || !getKeyBound("MAX", fDataSet->fKeyMax)) {
+      // no rows with a non-NULL key
+      fDataSet->fKeyMin = 0;
+      fDataSet->fKeyMax = -1;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////
 /// Frees the sqlite resources and closes the file.
 RSqliteDS::~RSqliteDS()
 {
+   fDataSet->ClosePartitions();
    // sqlite3_finalize returns the error code of the most recent operation on fQuery.
    sqlite3_finalize(fDataSet->fQuery);
    // Closing can possibly fail with SQLITE_BUSY, in which case resources are leaked. This should not happen
@@ -479,16 +579,34 @@ RDataSource::Record_t RSqliteDS::GetColumnReadersImpl(std::string_view name, con
       throw std::runtime_error(errmsg);
    }
 
-   fValues[index].fIsActive = true;
-   return std::vector<void *>{fNSlots, &fValues[index].fPtr};
+   std::vector<void *> ptrs;
+   for (auto &values : fValues) {
+      values[index].fIsActive = true;
+      ptrs.emplace_back(&values[index].fPtr);
+   }
+   return ptrs;
 }
 
 ////////////////////////////////////////////////////////////////////////////
 /// Returns a range of size 1 as long as more rows are available in the SQL result set.
 /// This inherently serialized the RDF independent of the number of slots.
+/// If the query is partitioned, returns instead one range for each partition that has more rows.
 std::vector<std::pair<ULong64_t, ULong64_t>> RSqliteDS::GetEntryRanges()
 {
    std::vector<std::pair<ULong64_t, ULong64_t>> entryRanges;
+   if (!fDataSet->fPartitionQuery.empty()) {
+      fDataSet->fRangePartitions.clear();
+      fDataSet->fFirstRangeEntry = fNRow;
+      for (std::size_t i = 0; i < fDataSet->fPartitions.size(); ++i) {
+         if (fDataSet->fPartitions[i].fIsDone)
+            continue;
+         entryRanges.emplace_back(fNRow, fNRow + kPartitionRangeSize);
+         fDataSet->fRangePartitions.emplace_back(i);
+         fNRow += kPartitionRangeSize;
+      }
+      return entryRanges;
+   }
+
    int retval = sqlite3_step(fDataSet->fQuery);
    switch (retval) {
    case SQLITE_DONE: return entryRanges;
@@ -532,6 +650,11 @@ void RSqliteDS::Initialise()
    int retval = sqlite3_reset(fDataSet->fQuery);
    if (retval != SQLITE_OK)
       throw std::runtime_error("SQlite error, reset");
+   for (auto &partition : fDataSet->fPartitions) {
+      if (sqlite3_reset(partition.fQuery) != SQLITE_OK)
+         throw std::runtime_error("SQlite error, reset");
+      partition.fIsDone = false;
+   }
 }
 
 std::string RSqliteDS::GetLabel()
@@ -539,6 +662,13 @@ std::string RSqliteDS::GetLabel()
    return "RSqliteDS";
 }
 
+std::string RSqliteDS::GetDatasetIdentifier()
+{
+   // with a partitioning key, rows whose key is NULL are skipped: the partition query is part of the identifier too
+   return ROOT::Internal::RDF::GetFileIdentifier(fDataSet->fFileName) + "\nquery " +
+          sqlite3_sql(fDataSet->fQuery) + "\npartition query " + fDataSet->fPartitionQuery;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Factory method to create a SQlite RDataFrame.
 /// \param[in] fileName Path of the sqlite file.
@@ -549,34 +679,68 @@ RDataFrame MakeSqliteDataFrame(std::string_view fileName, std::string_view query
    return rdf;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Factory method to create a SQlite RDataFrame that reads partitions of the result set in parallel.
+/// \param[in] fileName Path of the sqlite file.
+/// \param[in] query SQL query that defines the data set.
+/// \param[in] keyColumn Integer column of the query whose range of values is partitioned, e.g. the rowid.
+/// \param[in] nPartitions Number of partitions, by default one per processing slot.
+RDataFrame MakeSqliteDataFrame(std::string_view fileName, std::string_view query, std::string_view keyColumn,
+                               unsigned int nPartitions)
+{
+   ROOT::RDataFrame rdf(std::make_unique<RSqliteDS>(std::string(fileName), std::string(query), std::string(keyColumn),
+                                                    nPartitions));
+   return rdf;
+}
+
 ////////////////////////////////////////////////////////////////////////////
 /// Stores the result of the current active sqlite query row as a C++ value.
-bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
-{
-   assert(entry + 1 == fNRow);
-   (void)entry;
-   unsigned N = fValues.size();
+/// If the query is partitioned, steps the query of the partition of the entry to its next row first: entries beyond
+/// the last row of the partition are skipped.
+bool RSqliteDS::SetEntry(unsigned int slot, ULong64_t entry)
+{
+   sqlite3_stmt *query = fDataSet->fQuery;
+   if (!fDataSet->fPartitionQuery.empty()) {
+      const auto rangeIdx = (entry - fDataSet->fFirstRangeEntry) / kPartitionRangeSize;
+      auto &partition = fDataSet->fPartitions[fDataSet->fRangePartitions[rangeIdx]];
+      if (partition.fIsDone)
+         return false;
+      int retval = sqlite3_step(partition.fQuery);
+      if (retval == SQLITE_DONE) {
+         partition.fIsDone = true;
+         return false;
+      }
+      if (retval != SQLITE_ROW)
+         SqliteError(retval);
+      query = partition.fQuery;
+   } else {
+      assert(entry + 1 == fNRow);
+      (void)entry;
+   }
+
+   auto &values = fValues[slot];
+   unsigned N = values.size();
    for (unsigned i = 0; i < N; ++i) {
-      if (!fValues[i].fIsActive)
+      if (!values[i].fIsActive)
          continue;
 
       int nbytes;
-      switch (fValues[i].fType) {
-      case ETypes::kInteger: fValues[i].fInteger = sqlite3_column_int64(fDataSet->fQuery, i); break;
-      case ETypes::kReal: fValues[i].fReal = sqlite3_column_double(fDataSet->fQuery, i); break;
+      switch (values[i].fType) {
+      case ETypes::kInteger: values[i].fInteger = sqlite3_column_int64(query, i); break;
+      case ETypes::kReal: values[i].fReal = sqlite3_column_double(query, i); break;
       case ETypes::kText:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
+         nbytes = sqlite3_column_bytes(query, i);
          if (nbytes == 0) {
-            fValues[i].fText = "";
+            values[i].fText = "";
          } else {
-            fValues[i].fText = reinterpret_cast<const char *>(sqlite3_column_text(fDataSet->fQuery, i));
+            values[i].fText = reinterpret_cast<const char *>(sqlite3_column_text(query, i));
          }
          break;
       case ETypes::kBlob:
-         nbytes = sqlite3_column_bytes(fDataSet->fQuery, i);
-         fValues[i].fBlob.resize(nbytes);
+         nbytes = sqlite3_column_bytes(query, i);
+         values[i].fBlob.resize(nbytes);
          if (nbytes > 0) {
-            std::memcpy(fValues[i].fBlob.data(), sqlite3_column_blob(fDataSet->fQuery, i), nbytes);
+            std::memcpy(values[i].fBlob.data(), sqlite3_column_blob(query, i), nbytes);
          }
          break;
       case ETypes::kNull: break;
@@ -587,14 +751,64 @@ bool RSqliteDS::SetEntry(unsigned int /* slot */, ULong64_t entry)
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
-/// Almost a no-op, many slots can in fact reduce the performance due to thread synchronization.
+/// Creates the column values of each slot. Unless the query is partitioned, many slots can in fact reduce the
+/// performance due to thread synchronization.
 void RSqliteDS::SetNSlots(unsigned int nSlots)
 {
-   if (nSlots > 1) {
+   if (nSlots > 1 && fDataSet->fPartitionQuery.empty()) {
       ::Warning("SetNSlots", "Currently the SQlite data source faces performance degradation in multi-threaded mode. "
                              "Consider turning off IMT.");
    }
    fNSlots = nSlots;
+
+   fValues.clear();
+   for (unsigned int slot = 0; slot < fNSlots; ++slot) {
+      // The values are not moved once created: their fPtr members point to themselves
+      std::vector<Value_t> values;
+      values.reserve(fColumnTypes.size());
+      for (auto type : fColumnTypes)
+         values.emplace_back(type);
+      fValues.emplace_back(std::move(values));
+   }
+
+   if (!fDataSet->fPartitionQuery.empty())
+      SetupPartitions();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////
+/// Splits the range of values of the partitioning key in partitions of equal width, and prepares the query of each
+/// partition on its own connection, so that the partitions can be read concurrently.
+void RSqliteDS::SetupPartitions()
+{
+   auto &dataSet = *fDataSet;
+   // the partitions of a previous call, e.g. with a different number of slots
+   dataSet.ClosePartitions();
+   if (dataSet.fKeyMax < dataSet.fKeyMin)
+      return; // nothing to read
+
+   // Unsigned arithmetic, as the key range can span all the values of Long64_t
+   const ULong64_t width = static_cast<ULong64_t>(dataSet.fKeyMax) - static_cast<ULong64_t>(dataSet.fKeyMin);
+   ULong64_t nPartitions = std::max(fNPartitions > 0 ? fNPartitions : fNSlots, 1u);
+   if (width < nPartitions)
+      nPartitions = width + 1;
+   auto partitionBegin = [&](ULong64_t i) {
+      return static_cast<Long64_t>(static_cast<ULong64_t>(dataSet.fKeyMin) + (width / nPartitions) * i +
+                                   (width % nPartitions) * i / nPartitions);
+   };
+
+   for (ULong64_t i = 0; i < nPartitions; ++i) {
+      dataSet.fPartitions.emplace_back();
+      auto &partition = dataSet.fPartitions.back();
+      int retval = OpenReadOnlyDb(dataSet.fFileName, &partition.fDb);
+      if (retval != SQLITE_OK)
+         SqliteError(retval);
+      retval = sqlite3_prepare_v2(partition.fDb, dataSet.fPartitionQuery.c_str(), -1, &partition.fQuery, nullptr);
+      if (retval != SQLITE_OK)
+         SqliteError(retval);
+      const Long64_t keyEnd = i + 1 < nPartitions ? partitionBegin(i + 1) - 1 : dataSet.fKeyMax;
+      sqlite3_bind_int64(partition.fQuery, 1, partitionBegin(i));
+      sqlite3_bind_int64(partition.fQuery, 2, keyEnd);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,356 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RTrivialDS.hxx"
+#include "ROOT/RVec.hxx"
+#include "TChain.h"
+#include "TEntryList.h"
+#include "TFile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+
+// fixture that provides an in-memory TTree with a few flat branches
+class RDFBulk : public ::testing::Test {
+protected:
+   std::unique_ptr<TTree> fTree;
+
+   RDFBulk() : fTree(new TTree("t", "t"))
+   {
+      fTree->SetDirectory(nullptr);
+      double x = 0.;
+      int i = 0;
+      fTree->Branch("x", &x);
+      fTree->Branch("i", &i);
+      for (i = 0; i < 1000; ++i) {
+         x = i * 0.5;
+         fTree->Fill();
+      }
+      fTree->ResetBranchAddresses();
+   }
+};
+
+TEST(RDFBulkSize, ZeroBulkSizeThrows)
+{
+   RDataFrame df(1);
+   EXPECT_THROW(EnableBulkProcessing(df, 0u), std::invalid_argument);
+}
+
+TEST(RDFBulkEmptySource, FilterDefineActions)
+{
+   auto makeResults = [](unsigned int bulkSize) {
+      RDataFrame df(103);
+      EnableBulkProcessing(df, bulkSize);
+      auto d = df.Define("x", [](ULong64_t e) { return double(e) * 2.; }, {"rdfentry_"})
+                  .Define("y", [](double x) { return x + 1.; }, {"x"});
+      auto f = d.Filter([](double x) { return x > 10.; }, {"x"});
+      auto sum = f.Sum<double>("y");
+      auto count = f.Count();
+      auto takeEntries = f.Take<ULong64_t>("rdfentry_");
+      auto max = d.Max<double>("y");
+      return std::make_tuple(*sum, *count, *takeEntries, *max);
+   };
+
+   const auto reference = makeResults(1u);
+   for (auto bulkSize : {2u, 7u, 103u, 256u})
+      EXPECT_EQ(makeResults(bulkSize), reference) << "bulk size: " << bulkSize;
+}
+
+TEST(RDFBulkEmptySource, Ranges)
+{
+   RDataFrame df(100);
+   EnableBulkProcessing(df, 16u);
+   auto even = df.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"});
+   auto t = even.Range(3, 20, 4).Take<ULong64_t>("rdfentry_");
+   auto c = df.Range(42).Count();
+   EXPECT_EQ(*t, std::vector<ULong64_t>({6, 14, 22, 30, 38}));
+   EXPECT_EQ(*c, 42u);
+}
+
+TEST(RDFBulkEmptySource, Report)
+{
+   RDataFrame df(50);
+   EnableBulkProcessing(df, 8u);
+   auto f1 = df.Filter([](ULong64_t e) { return e < 40; }, {"rdfentry_"}, "f1");
+   auto f2 = f1.Filter([](ULong64_t e) { return e % 4 == 0; }, {"rdfentry_"}, "f2");
+   auto c = f2.Count();
+   auto r = df.Report();
+   EXPECT_EQ(*c, 10u);
+   EXPECT_EQ((*r)["f1"].GetPass(), 40u);
+   EXPECT_EQ((*r)["f1"].GetAll(), 50u);
+   EXPECT_EQ((*r)["f2"].GetPass(), 10u);
+   EXPECT_EQ((*r)["f2"].GetAll(), 40u);
+}
+
+TEST(RDFBulkEmptySource, Jitted)
+{
+   RDataFrame df(100);
+   EnableBulkProcessing(df, 32u);
+   auto m = df.Define("x", "rdfentry_ * 3.").Filter("x < 150").Mean<double>("x");
+   EXPECT_DOUBLE_EQ(*m, 73.5);
+}
+
+TEST(RDFBulkEmptySource, FallbackToEntryByEntry)
+{
+   RDataFrame df(10);
+   EnableBulkProcessing(df, 4u);
+   // a Define that does not return a fundamental type cannot be evaluated in bulk
+   auto d = df.Define("v", [](ULong64_t e) { return std::vector<int>(e, 1); }, {"rdfentry_"});
+   auto s = d.Define("n", [](const std::vector<int> &v) { return v.size(); }, {"v"}).Sum<std::size_t>("n");
+   EXPECT_EQ(*s, 45u);
+}
+
+TEST_F(RDFBulk, TTree)
+{
+   auto makeResults = [this](unsigned int bulkSize) {
+      RDataFrame df(*fTree);
+      EnableBulkProcessing(df, bulkSize);
+      auto f = df.Filter([](int i) { return i % 3 != 0; }, {"i"});
+      auto sumX = f.Sum<double>("x");
+      auto minI = f.Min<int>("i");
+      auto sumY = f.Define("y", [](double x, int i) { return x * i; }, {"x", "i"}).Sum<double>("y");
+      return std::make_tuple(*sumX, *minI, *sumY);
+   };
+
+   const auto reference = makeResults(1u);
+   for (auto bulkSize : {3u, 64u, 5000u})
+      EXPECT_EQ(makeResults(bulkSize), reference) << "bulk size: " << bulkSize;
+}
+
+// write a TTree with branches of several fundamental types and baskets of 37 entries, so that bulks span several
+// baskets and baskets span several bulks
+void WriteBulkTestFile(const std::string &fname, int firstValue, int nEntries = 500)
+{
+   TFile f(fname.c_str(), "recreate");
+   TTree t("t", "t");
+   double x = 0.;
+   float y = 0.f;
+   bool b = false;
+   Long64_t l = 0;
+   unsigned short u = 0;
+   char c = 0;
+   t.Branch("x", &x);
+   t.Branch("y", &y);
+   t.Branch("b", &b);
+   t.Branch("l", &l);
+   t.Branch("u", &u);
+   t.Branch("c", &c);
+   t.SetAutoFlush(37);
+   for (int i = firstValue; i < firstValue + nEntries; ++i) {
+      x = i * 0.5;
+      y = -i * 0.25f;
+      b = i % 3 == 0;
+      l = Long64_t(i) << 33;
+      u = static_cast<unsigned short>(i);
+      c = static_cast<char>(i % 100);
+      t.Fill();
+   }
+   t.Write();
+}
+
+auto MakeBulkTestResults(RNode df, unsigned int bulkSize)
+{
+   EnableBulkProcessing(df, bulkSize);
+   auto f = df.Filter([](bool b) { return !b; }, {"b"});
+   auto x = f.Take<double>("x");
+   auto y = f.Sum<float>("y");
+   auto l = df.Sum<Long64_t>("l");
+   auto u = f.Max<unsigned short>("u");
+   auto c = df.Define("c2", [](char c, double x) { return c * x; }, {"c", "x"}).Sum<double>("c2");
+   return std::make_tuple(*x, *y, *l, *u, *c);
+}
+
+TEST(RDFBulkTTree, BlockReads)
+{
+   const std::vector<std::string> fnames{"dataframe_bulk_blockreads_1.root", "dataframe_bulk_blockreads_2.root"};
+   WriteBulkTestFile(fnames[0], 0);
+   WriteBulkTestFile(fnames[1], 500);
+
+   TChain c("t");
+   for (const auto &fname : fnames)
+      c.Add(fname.c_str());
+   const auto reference = MakeBulkTestResults(RDataFrame(c), 1u);
+   EXPECT_EQ(std::get<0>(reference).size(), 666u);
+   for (auto bulkSize : {2u, 37u, 64u, 1000u})
+      EXPECT_EQ(MakeBulkTestResults(RDataFrame(c), bulkSize), reference) << "bulk size: " << bulkSize;
+
+   for (const auto &fname : fnames)
+      gSystem->Unlink(fname.c_str());
+}
+
+TEST(RDFBulkTTree, BulksSpanningFiles)
+{
+   // the chain deletes the tree of a file when it moves to the next one, while the bulk is still being filled
+   std::vector<std::string> fnames;
+   TChain c("t");
+   for (int i = 0; i < 4; ++i) {
+      fnames.emplace_back("dataframe_bulk_spanningfiles_" + std::to_string(i) + ".root");
+      WriteBulkTestFile(fnames.back(), i * 60, 60);
+      c.Add(fnames.back().c_str());
+   }
+
+   const auto reference = MakeBulkTestResults(RDataFrame(c), 1u);
+   EXPECT_EQ(std::get<0>(reference).size(), 160u);
+   for (auto bulkSize : {100u, 1000u})
+      EXPECT_EQ(MakeBulkTestResults(RDataFrame(c), bulkSize), reference) << "bulk size: " << bulkSize;
+
+   for (const auto &fname : fnames)
+      gSystem->Unlink(fname.c_str());
+}
+
+TEST(RDFBulkTTree, EntryList)
+{
+   const auto fname = "dataframe_bulk_entrylist.root";
+   WriteBulkTestFile(fname, 0);
+
+   TFile f(fname);
+   auto *t = f.Get<TTree>("t");
+   // do NOT pass treename and filename to the TEntryList here, see ROOT-10775
+   TEntryList elist("e", "e");
+   t->SetEntryList(&elist);
+   // non-contiguous entries, with runs that cross basket and bulk boundaries
+   for (int i = 0; i < 500; ++i) {
+      if (i % 7 == 0 || (i > 100 && i < 200))
+         elist.Enter(i);
+   }
+
+   const auto reference = MakeBulkTestResults(RDataFrame(*t), 1u);
+   auto entries = RDataFrame(*t).Take<ULong64_t>("rdfentry_");
+   EXPECT_EQ(entries->size(), static_cast<std::size_t>(elist.GetN()));
+   for (auto bulkSize : {2u, 10u, 64u, 1000u})
+      EXPECT_EQ(MakeBulkTestResults(RDataFrame(*t), bulkSize), reference) << "bulk size: " << bulkSize;
+
+   t->SetEntryList(nullptr);
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFBulkDataSource, SkippedEntries)
+{
+   // odd entries only: RTrivialDS::SetEntry returns false for even entries
+   auto df = MakeTrivialDataFrame(20, /*skipEvenEntries*/ true);
+   EnableBulkProcessing(df, 6u);
+   auto t = df.Take<ULong64_t>("col0");
+   auto s = df.Filter([](ULong64_t e) { return e > 10; }, {"col0"}).Sum<ULong64_t>("col0");
+   EXPECT_EQ(*t, std::vector<ULong64_t>({1, 3, 5, 7, 9, 11, 13, 15, 17, 19}));
+   EXPECT_EQ(*s, 75u);
+}
+
+TEST(RDFBulkDefineBatch, SameResultsAsDefine)
+{
+   auto makeResults = [](unsigned int bulkSize) {
+      RDataFrame df(103);
+      EnableBulkProcessing(df, bulkSize);
+      std::size_t maxBatchSize = 0u;
+      auto d = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+                  .Filter([](double x) { return int(x) % 3 != 0; }, {"x"})
+                  .DefineBatch("y",
+                               [&maxBatchSize](const RVecD &x, const RVec<ULong64_t> &e) {
+                                  maxBatchSize = std::max(maxBatchSize, x.size());
+                                  return x * x + e;
+                               },
+                               {"x", "rdfentry_"});
+      auto sum = d.Sum<double>("y");
+      auto take = d.Filter([](double y) { return y > 100.; }, {"y"}).Take<double>("y");
+      return std::make_tuple(*sum, *take, maxBatchSize);
+   };
+
+   const auto reference = makeResults(1u);
+   EXPECT_EQ(std::get<2>(reference), 1u);
+   for (auto bulkSize : {7u, 103u, 256u}) {
+      const auto results = makeResults(bulkSize);
+      EXPECT_EQ(std::get<0>(results), std::get<0>(reference)) << "bulk size: " << bulkSize;
+      EXPECT_EQ(std::get<1>(results), std::get<1>(reference)) << "bulk size: " << bulkSize;
+      // only the entries that pass the filter are passed to the expression
+      EXPECT_LE(std::get<2>(results), (bulkSize * 2u) / 3u + 1u) << "bulk size: " << bulkSize;
+      EXPECT_GT(std::get<2>(results), 1u) << "bulk size: " << bulkSize;
+   }
+}
+
+TEST(RDFBulkDefineBatch, EntryByEntry)
+{
+   // no EnableBulkProcessing: the expression is called with batches of one entry
+   RDataFrame df(10);
+   std::vector<std::size_t> batchSizes;
+   auto d = df.Define("x", [](ULong64_t e) { return double(e) + 0.5; }, {"rdfentry_"})
+               .DefineBatch("y",
+                            [&batchSizes](const RVecD &x, const RVec<ULong64_t> &e) {
+                               batchSizes.push_back(x.size());
+                               return x * 2. + e;
+                            },
+                            {"x", "rdfentry_"});
+   auto take = d.Take<double>("y");
+   EXPECT_EQ(*take, std::vector<double>({1., 4., 7., 10., 13., 16., 19., 22., 25., 28.}));
+   EXPECT_EQ(batchSizes, std::vector<std::size_t>(10u, 1u));
+}
+
+TEST(RDFBulkDefineBatch, EvaluatedOncePerEntry)
+{
+   RDataFrame df(100);
+   EnableBulkProcessing(df, 10u);
+   unsigned int nEvaluated = 0u;
+   auto d = df.DefineBatch("x",
+                           [&nEvaluated](const RVec<ULong64_t> &e) {
+                              nEvaluated += e.size();
+                              return e * 1.;
+                           },
+                           {"rdfentry_"});
+   // two branches of the graph select different, overlapping entries
+   auto s1 = d.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}).Sum<double>("x");
+   auto s2 = d.Filter([](ULong64_t e) { return e < 50; }, {"rdfentry_"}).Sum<double>("x");
+   EXPECT_DOUBLE_EQ(*s1, 2450.);
+   EXPECT_DOUBLE_EQ(*s2, 1225.);
+   EXPECT_EQ(nEvaluated, 75u);
+}
+
+TEST(RDFBulkDefineBatch, WrongNumberOfValues)
+{
+   RDataFrame df(10);
+   EnableBulkProcessing(df, 4u);
+   auto d = df.DefineBatch("x", [](const RVec<ULong64_t> &e) { return RVecD(e.size() + 1u); }, {"rdfentry_"});
+   EXPECT_THROW(d.Sum<double>("x").GetValue(), std::runtime_error);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFBulkTTreeMT, FilterActions)
+{
+   const auto fname = "dataframe_bulk_ttreemt.root";
+   RDataFrame(1000)
+      .Define("i", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+      .Define("x", [](int i) { return i * 0.5; }, {"i"})
+      .Snapshot<int, double>("t", fname, {"i", "x"});
+
+   ROOT::EnableImplicitMT(4);
+   RDataFrame df("t", fname);
+   EnableBulkProcessing(df, 10u);
+   auto c = df.Filter([](double x) { return x >= 100.; }, {"x"}).Count();
+   auto s = df.Sum<int>("i");
+   EXPECT_EQ(*c, 800u);
+   EXPECT_EQ(*s, 499500);
+   ROOT::DisableImplicitMT();
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFBulkEmptySourceMT, FilterDefineActions)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame df(1000);
+   EnableBulkProcessing(df, 16u);
+   auto s = df.Define("x", [](ULong64_t e) { return e * 2u; }, {"rdfentry_"})
+               .Filter([](ULong64_t x) { return x % 4 == 0; }, {"x"})
+               .Sum<ULong64_t>("x");
+   EXPECT_EQ(*s, 499000u);
+   ROOT::DisableImplicitMT();
+}
+#endif
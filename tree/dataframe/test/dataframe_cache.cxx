@@ -1,3 +1,4 @@
+#include "ROOT/RCsvDS.hxx"
 #include "ROOT/RDataFrame.hxx"
 #include "ROOT/TSeq.hxx"
 #include "ROOT/RTrivialDS.hxx"
@@ -8,6 +9,7 @@
 #include "gtest/gtest.h"
 
 #include <algorithm>
+#include <fstream>
 
 using namespace ROOT::RDF;
 using namespace ROOT::VecOps;
@@ -346,3 +348,107 @@ TEST(Cache, Alias)
    auto df4 = df3.Cache({"y"});
    EXPECT_EQ(df4.Sum("y").GetValue(), 3u);
 }
+
+TEST(Cache, PersistentCache)
+{
+   const std::string cacheDir = "dataframe_cache_persistent";
+   const auto inputFile = "dataframe_cache_persistent_input.root";
+   auto writeInput = [inputFile](int nEntries) {
+      ROOT::RDataFrame(nEntries)
+         .Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+         .Snapshot<int>("t", inputFile, {"x"});
+   };
+
+   int nCalls = 0;
+   auto makeCache = [&](std::string_view key) {
+      ROOT::RDataFrame df("t", inputFile);
+      return df.Filter("x % 2 == 0", "even")
+         .Define("y",
+                 [&nCalls](int x) {
+                    ++nCalls;
+                    return x * 2;
+                 },
+                 {"x"})
+         .PersistentCache({"x", "y"}, cacheDir, key);
+   };
+
+   writeInput(10);
+   auto c1 = makeCache("v1");
+   EXPECT_EQ(nCalls, 5);
+   EXPECT_EQ(c1.Sum<int>("y").GetValue(), 40);
+
+   // cache hit: the upstream computation graph does not run again
+   auto c2 = makeCache("v1");
+   EXPECT_EQ(nCalls, 5);
+   EXPECT_EQ(c2.Sum<int>("y").GetValue(), 40);
+
+   // a different key is a different cache
+   makeCache("v2");
+   EXPECT_EQ(nCalls, 10);
+
+   // modifying the input file invalidates the cache
+   writeInput(20);
+   auto c3 = makeCache("v1");
+   EXPECT_EQ(nCalls, 20);
+   EXPECT_EQ(c3.Count().GetValue(), 10u);
+
+   // the code of C++ callables is not part of the cache identifier: a key is required
+   EXPECT_THROW(makeCache(""), std::runtime_error);
+   EXPECT_EQ(nCalls, 20);
+
+   // the expressions of jitted Filters and Defines are part of the cache identifier, also for unnamed Filters
+   auto makeJittedCache = [&](const std::string &filter, const std::string &define) {
+      ROOT::RDataFrame df("t", inputFile);
+      return df.Filter(filter).Define("z", define).PersistentCache({"z"}, cacheDir);
+   };
+   EXPECT_EQ(makeJittedCache("x % 2 == 0", "x * 2").Sum<int>("z").GetValue(), 180);
+   EXPECT_EQ(makeJittedCache("x % 2 == 0", "x * 2").Sum<int>("z").GetValue(), 180);
+   EXPECT_EQ(makeJittedCache("x % 2 == 1", "x * 2").Sum<int>("z").GetValue(), 200);
+   EXPECT_EQ(makeJittedCache("x % 2 == 1", "x * 3").Sum<int>("z").GetValue(), 300);
+   EXPECT_DOUBLE_EQ(makeJittedCache("x % 2 == 1", "x * 3.").Sum<double>("z").GetValue(), 300.);
+
+   EXPECT_THROW(ROOT::RDataFrame(1).PersistentCache({}, cacheDir), std::runtime_error);
+
+   void *dir = gSystem->OpenDirectory(cacheDir.c_str());
+   while (const char *entry = gSystem->GetDirEntry(dir)) {
+      const std::string name(entry);
+      if (name != "." && name != "..")
+         gSystem->Unlink((cacheDir + "/" + name).c_str());
+   }
+   gSystem->FreeDirectory(dir);
+   gSystem->Unlink(cacheDir.c_str());
+   gSystem->Unlink(inputFile);
+}
+
+TEST(Cache, PersistentCacheDataSource)
+{
+   const std::string cacheDir = "dataframe_cache_persistent_ds";
+   const std::vector<std::string> csvFiles{"dataframe_cache_persistent_1.csv", "dataframe_cache_persistent_2.csv"};
+   {
+      std::ofstream(csvFiles[0]) << "x\n1\n2\n3\n";
+      std::ofstream(csvFiles[1]) << "x\n10\n20\n";
+   }
+
+   // two CSV files with the same columns are different datasets
+   auto makeCache = [&](const std::string &fileName) {
+      return ROOT::RDF::MakeCsvDataFrame(fileName).Define("y", "x * 2").PersistentCache({"y"}, cacheDir);
+   };
+   EXPECT_EQ(makeCache(csvFiles[0]).Sum<Long64_t>("y").GetValue(), 12);
+   EXPECT_EQ(makeCache(csvFiles[1]).Sum<Long64_t>("y").GetValue(), 60);
+   EXPECT_EQ(makeCache(csvFiles[0]).Sum<Long64_t>("y").GetValue(), 12);
+
+   // data sources that cannot identify their dataset require a key
+   EXPECT_THROW(ROOT::RDF::MakeTrivialDataFrame(10).PersistentCache({"col0"}, cacheDir), std::runtime_error);
+   EXPECT_EQ(ROOT::RDF::MakeTrivialDataFrame(10).PersistentCache({"col0"}, cacheDir, "v1").Count().GetValue(), 10u);
+
+   void *dir = gSystem->OpenDirectory(cacheDir.c_str());
+   while (const char *entry = gSystem->GetDirEntry(dir)) {
+      const std::string name(entry);
+      if (name != "." && name != "..")
+         gSystem->Unlink((cacheDir + "/" + name).c_str());
+   }
+   gSystem->FreeDirectory(dir);
+   gSystem->Unlink(cacheDir.c_str());
+   for (const auto &fileName : csvFiles)
+      gSystem->Unlink(fileName.c_str());
+}
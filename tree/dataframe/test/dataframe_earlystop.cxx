@@ -0,0 +1,139 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDF/ActionHelpers.hxx"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+
+// An action that collects the first nEntries values it receives, and then reports that its result is final.
+class FirstNHelper : public ROOT::Detail::RDF::RActionImpl<FirstNHelper> {
+   std::shared_ptr<std::vector<ULong64_t>> fResult;
+   std::vector<std::vector<ULong64_t>> fPerSlot;
+   std::unique_ptr<std::atomic<ULong64_t>> fNTaken;
+   ULong64_t fNEntries;
+
+public:
+   using Result_t = std::vector<ULong64_t>;
+   FirstNHelper(ULong64_t nEntries, unsigned int nSlots)
+      : fResult(std::make_shared<Result_t>()), fPerSlot(nSlots), fNTaken(new std::atomic<ULong64_t>(0ull)),
+        fNEntries(nEntries)
+   {
+   }
+   FirstNHelper(FirstNHelper &&) = default;
+   std::shared_ptr<Result_t> GetResultPtr() const { return fResult; }
+   void Initialize() {}
+   void InitTask(TTreeReader *, unsigned int) {}
+   void Exec(unsigned int slot, ULong64_t e)
+   {
+      if (fNTaken->fetch_add(1ull) < fNEntries)
+         fPerSlot[slot].push_back(e);
+   }
+   bool IsDone() const { return *fNTaken >= fNEntries; }
+   void Finalize()
+   {
+      for (auto &v : fPerSlot)
+         fResult->insert(fResult->end(), v.begin(), v.end());
+   }
+   std::string GetActionName() { return "FirstN"; }
+};
+
+TEST(RDFEarlyStop, EmptySource)
+{
+   RDataFrame df(1000);
+   std::atomic<ULong64_t> nEvaluated{0ull};
+   auto d = df.Define("e", [&nEvaluated](ULong64_t e) { ++nEvaluated; return e; }, {"rdfentry_"});
+   auto r = d.Book<ULong64_t>(FirstNHelper(10, df.GetNSlots()), {"e"});
+   EXPECT_EQ(r->size(), 10u);
+   EXPECT_EQ(nEvaluated, 10u);
+}
+
+TEST(RDFEarlyStop, NotAllActionsDone)
+{
+   RDataFrame df(1000);
+   auto r = df.Book<ULong64_t>(FirstNHelper(10, df.GetNSlots()), {"rdfentry_"});
+   auto c = df.Count();
+   EXPECT_EQ(r->size(), 10u);
+   EXPECT_EQ(*c, 1000u);
+}
+
+TEST(RDFEarlyStop, WithFilters)
+{
+   RDataFrame df(1000);
+   ULong64_t nChecked1 = 0ull;
+   ULong64_t nChecked2 = 0ull;
+   auto r1 = df.Filter([&nChecked1](ULong64_t e) { ++nChecked1; return e % 100 == 0; }, {"rdfentry_"})
+                .Book<ULong64_t>(FirstNHelper(3, df.GetNSlots()), {"rdfentry_"});
+   auto r2 = df.Filter([&nChecked2](ULong64_t e) { ++nChecked2; return e > 100; }, {"rdfentry_"})
+                .Book<ULong64_t>(FirstNHelper(5, df.GetNSlots()), {"rdfentry_"});
+   EXPECT_EQ(*r1, std::vector<ULong64_t>({0, 100, 200}));
+   EXPECT_EQ(*r2, std::vector<ULong64_t>({101, 102, 103, 104, 105}));
+   // the event loop stops after entry 200, the second action does not process entries after 105
+   EXPECT_EQ(nChecked1, 201u);
+   EXPECT_EQ(nChecked2, 106u);
+}
+
+TEST(RDFEarlyStop, TTree)
+{
+   const auto fname = "dataframe_earlystop_ttree.root";
+   RDataFrame(1000)
+      .Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"})
+      .Snapshot<ULong64_t>("t", fname, {"x"});
+
+   RDataFrame df("t", fname);
+   std::atomic<ULong64_t> nEvaluated{0ull};
+   auto d = df.Define("y", [&nEvaluated](ULong64_t x) { ++nEvaluated; return x; }, {"x"});
+   auto r1 = d.Book<ULong64_t>(FirstNHelper(10, df.GetNSlots()), {"y"});
+   auto r2 = d.Book<ULong64_t>(FirstNHelper(20, df.GetNSlots()), {"x"});
+   EXPECT_EQ(r1->size(), 10u);
+   EXPECT_EQ(r2->size(), 20u);
+   EXPECT_EQ(r2->back(), 19u);
+   EXPECT_EQ(nEvaluated, 10u);
+
+   gSystem->Unlink(fname);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFEarlyStopMT, EmptySource)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame df(1000000);
+   std::atomic<ULong64_t> nEvaluated{0ull};
+   auto d = df.Define("e", [&nEvaluated](ULong64_t e) { ++nEvaluated; return e; }, {"rdfentry_"});
+   auto r = d.Book<ULong64_t>(FirstNHelper(10, df.GetNSlots()), {"e"});
+   EXPECT_EQ(r->size(), 10u);
+   // tasks stop as soon as the action is done
+   EXPECT_LT(nEvaluated, 1000000u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFEarlyStopMT, TTree)
+{
+   const auto fname = "dataframe_earlystopmt_ttree.root";
+   {
+      // many small clusters
+      RSnapshotOptions opts;
+      opts.fAutoFlush = 100;
+      RDataFrame(100000)
+         .Define("x", [](ULong64_t e) { return e; }, {"rdfentry_"})
+         .Snapshot<ULong64_t>("t", fname, {"x"}, opts);
+   }
+
+   ROOT::EnableImplicitMT(4);
+   RDataFrame df("t", fname);
+   std::atomic<ULong64_t> nEvaluated{0ull};
+   auto d = df.Define("y", [&nEvaluated](ULong64_t x) { ++nEvaluated; return x; }, {"x"});
+   auto r = d.Book<ULong64_t>(FirstNHelper(10, df.GetNSlots()), {"y"});
+   EXPECT_EQ(r->size(), 10u);
+   EXPECT_LT(nEvaluated, 100000u);
+   ROOT::DisableImplicitMT();
+
+   gSystem->Unlink(fname);
+}
+#endif
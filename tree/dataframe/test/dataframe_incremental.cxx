@@ -0,0 +1,143 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
+#include "TChain.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+
+// fixture that provides files with a TTree of consecutive integers, and a state file that is removed at the end
+class RDFIncremental : public ::testing::Test {
+protected:
+   const std::string fStateFileName = "dataframe_incremental_state.root";
+   std::vector<std::string> fFileNames;
+
+   // write a file with entries `first` to `first + n - 1`
+   void WriteFile(int first, int n)
+   {
+      const auto fileName = "dataframe_incremental_" + std::to_string(fFileNames.size()) + ".root";
+      TFile f(fileName.c_str(), "RECREATE");
+      TTree t("t", "t");
+      int x = 0;
+      t.Branch("x", &x);
+      for (x = first; x < first + n; ++x)
+         t.Fill();
+      t.Write();
+      fFileNames.emplace_back(fileName);
+   }
+
+   void TearDown() override
+   {
+      for (const auto &fileName : fFileNames)
+         gSystem->Unlink(fileName.c_str());
+      gSystem->Unlink(fStateFileName.c_str());
+   }
+};
+
+TEST_F(RDFIncremental, GrowingChain)
+{
+   // run over the files of the chain, returns the results and the number of entries actually processed
+   auto run = [this]() {
+      TChain chain("t");
+      for (const auto &fileName : fFileNames)
+         chain.Add(fileName.c_str());
+      RDataFrame df(chain);
+      EnableIncrementalProcessing(df, fStateFileName);
+      auto nProcessed = std::make_shared<int>(0);
+      auto d = df.Define("y",
+                         [nProcessed](int x) {
+                            ++*nProcessed;
+                            return double(x);
+                         },
+                         {"x"});
+      auto count = d.Count();
+      auto sum = d.Sum<double>("y");
+      auto mean = d.Mean<double>("y");
+      auto stdDev = d.StdDev<double>("y");
+      auto h = d.Histo1D<double>({"h", "h", 10, 0., 200.}, "y");
+      auto taken = d.Filter([](double y) { return int(y) % 50 == 0; }, {"y"}).Take<int>("x");
+      return std::make_tuple(*count, *sum, *mean, *stdDev, h->GetEntries(), *taken, *nProcessed);
+   };
+
+   WriteFile(0, 100);
+   const auto r1 = run();
+   EXPECT_EQ(std::get<0>(r1), 100ull);
+   EXPECT_EQ(std::get<6>(r1), 100);
+
+   // a new file is added: only its entries are processed
+   WriteFile(100, 50);
+   const auto r2 = run();
+   EXPECT_EQ(std::get<0>(r2), 150ull);
+   EXPECT_DOUBLE_EQ(std::get<1>(r2), 149. * 150. / 2.);
+   EXPECT_DOUBLE_EQ(std::get<2>(r2), 74.5);
+   EXPECT_NEAR(std::get<3>(r2), std::sqrt(150. * 151. / 12.), 1e-9);
+   EXPECT_DOUBLE_EQ(std::get<4>(r2), 150.);
+   EXPECT_EQ(std::get<5>(r2), std::vector<int>({0, 50, 100}));
+   EXPECT_EQ(std::get<6>(r2), 50);
+
+   // no new entries: the stored results are returned
+   const auto r3 = run();
+   EXPECT_EQ(std::get<0>(r3), 150ull);
+   EXPECT_DOUBLE_EQ(std::get<1>(r3), std::get<1>(r2));
+   EXPECT_NEAR(std::get<3>(r3), std::get<3>(r2), 1e-9);
+   EXPECT_EQ(std::get<5>(r3), std::get<5>(r2));
+   EXPECT_EQ(std::get<6>(r3), 0);
+}
+
+TEST_F(RDFIncremental, DifferentActionsThrow)
+{
+   WriteFile(0, 10);
+   {
+      RDataFrame df("t", fFileNames[0]);
+      EnableIncrementalProcessing(df, fStateFileName);
+      EXPECT_EQ(*df.Count(), 10ull);
+   }
+   RDataFrame df("t", fFileNames[0]);
+   EnableIncrementalProcessing(df, fStateFileName);
+   auto sum = df.Sum<int>("x");
+   EXPECT_THROW(*sum, std::runtime_error);
+}
+
+TEST_F(RDFIncremental, ChangedFilesThrow)
+{
+   WriteFile(0, 10);
+   WriteFile(10, 10);
+   {
+      TChain chain("t");
+      chain.Add(fFileNames[0].c_str());
+      chain.Add(fFileNames[1].c_str());
+      RDataFrame df(chain);
+      EnableIncrementalProcessing(df, fStateFileName);
+      EXPECT_EQ(*df.Count(), 20ull);
+   }
+   // the first file is not part of the dataset anymore
+   RDataFrame df("t", fFileNames[1]);
+   EnableIncrementalProcessing(df, fStateFileName);
+   auto count = df.Count();
+   EXPECT_THROW(*count, std::runtime_error);
+}
+
+TEST_F(RDFIncremental, UnsupportedActionsThrow)
+{
+   WriteFile(0, 10);
+   RDataFrame df("t", fFileNames[0]);
+   EnableIncrementalProcessing(df, fStateFileName);
+   auto range = df.Range(5).Count();
+   EXPECT_THROW(*range, std::runtime_error);
+}
+
+TEST(RDFIncrementalEmptySource, Throws)
+{
+   RDataFrame df(10);
+   EXPECT_THROW(EnableIncrementalProcessing(df, "dataframe_incremental_unused.root"), std::runtime_error);
+   EXPECT_NO_THROW(EnableIncrementalProcessing(df, ""));
+}
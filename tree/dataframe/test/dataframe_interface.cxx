@@ -3,14 +3,18 @@
 
 #include "ROOT/RCsvDS.hxx"
 #include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
+#include "ROOT/RLogger.hxx"
 #include "ROOT/RStringView.hxx"
 #include "ROOT/RTrivialDS.hxx"
+#include "TInterpreter.h"
 #include "TMemFile.h"
 #include "TSystem.h"
 #include "TTree.h"
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <thread>
 
 using namespace ROOT;
@@ -776,3 +780,59 @@ TEST(RDataFrameInterface, SnapshotWithDuplicateColumns)
       std::logic_error);
    EXPECT_THROW((ROOT::RDataFrame(1).Snapshot("t", "neverwritten.root", {"rdfentry_", "rdfentry_"})), std::logic_error);
 }
+
+// Collects the messages of the RDataFrame log channel
+class RDFLogCollector : public ROOT::Experimental::RLogHandler {
+   std::vector<std::string> *fMessages;
+
+public:
+   RDFLogCollector(std::vector<std::string> &messages) : fMessages(&messages) {}
+   bool Emit(const ROOT::Experimental::RLogEntry &entry) override
+   {
+      if (entry.fChannel == &ROOT::Detail::RDF::RDFLogChannel())
+         fMessages->emplace_back(entry.fMessage);
+      return true;
+   }
+};
+
+TEST(RDataFrameInterface, JitCache)
+{
+   const auto cacheDir = std::string(gSystem->TempDirectory()) + "/rdf_jitcache_" + std::to_string(gSystem->GetPid());
+   // an expression that cannot be compiled outside of the interpreter
+   gInterpreter->Declare("bool rdfJitCacheInteractive(double x) { return x < 60.; }");
+
+   // a separate process jits the expressions, then compiles them in the cache at the end of its event loop. The
+   // compilation of the expression that uses interactively declared code fails, the others are cached nonetheless.
+   EXPECT_EXIT(
+      {
+         SetJitCacheDir(cacheDir);
+         auto df = ROOT::RDataFrame(10).Define("x", "rdfentry_ * 7.5 + 0.25").Filter("x > 20.");
+         auto m = df.Mean<double>("x");
+         auto c = df.Filter("rdfJitCacheInteractive(x)").Count();
+         std::exit(*m == 45.25 && *c == 5ull ? 0 : 1);
+      },
+      ::testing::ExitedWithCode(0), "");
+
+   // this process never jitted the expressions: the nodes are built from the compiled code in the cache
+   std::vector<std::string> messages;
+   auto collector = std::make_unique<RDFLogCollector>(messages);
+   auto *collectorPtr = collector.get();
+   ROOT::Experimental::RLogManager::Get().PushFront(std::move(collector));
+   {
+      ROOT::Experimental::RLogScopedVerbosity verbosity(ROOT::Detail::RDF::RDFLogChannel(),
+                                                        ROOT::Experimental::ELogLevel::kInfo);
+      SetJitCacheDir(cacheDir);
+      auto m = ROOT::RDataFrame(10).Define("x", "rdfentry_ * 7.5 + 0.25").Filter("x > 20.").Mean<double>("x");
+      EXPECT_DOUBLE_EQ(*m, 45.25);
+      SetJitCacheDir("");
+   }
+   ROOT::Experimental::RLogManager::Get().Remove(collectorPtr);
+   EXPECT_NE(std::find(messages.begin(), messages.end(), "Nothing to jit and execute."), messages.end());
+   EXPECT_EQ(std::find_if(messages.begin(), messages.end(),
+                          [](const std::string &msg) {
+                             return msg.find("Just-in-time compilation phase completed") != std::string::npos;
+                          }),
+             messages.end());
+
+   gSystem->Exec(("rm -rf " + cacheDir).c_str());
+}
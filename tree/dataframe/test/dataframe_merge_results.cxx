@@ -1,10 +1,13 @@
 #include <ROOT/RDataFrame.hxx>
 #include <ROOT/RResultPtr.hxx> // GetMergeableValue
+#include <TFile.h>
+#include <TSystem.h>
 #include <stdexcept>
 #include <gtest/gtest.h>
 
 using ROOT::Detail::RDF::GetMergeableValue;
 using ROOT::Detail::RDF::MergeValues;
+using ROOT::Detail::RDF::RMergeableValue;
 
 TEST(RDataFrameMergeResults, MergeCount)
 {
@@ -336,3 +339,182 @@ TEST(RDataFrameMergeResults, WrongMergeMinMax)
       FAIL() << "Expected std::invalid_argument error.";
    }
 }
+
+TEST(RDataFrameMergeResults, MergeCountDistinct)
+{
+   ROOT::RDataFrame df1{10000};
+   ROOT::RDataFrame df2{10000};
+
+   // 0..4999 and 2500..7499: the distinct counts cannot simply be added
+   auto col1 = df1.Define("x", [](ULong64_t e) { return int(e % 5000); }, {"rdfentry_"});
+   auto col2 = df2.Define("x", [](ULong64_t e) { return int(e % 5000 + 2500); }, {"rdfentry_"});
+
+   auto count1 = col1.CountDistinct<int>({"x"});
+   auto count2 = col2.CountDistinct<int>({"x"});
+
+   auto mc1 = GetMergeableValue(count1);
+   auto mc2 = GetMergeableValue(count2);
+
+   auto mergedptr = MergeValues(std::move(mc1), std::move(mc2));
+   const auto &mc = mergedptr->GetValue();
+
+   EXPECT_NEAR(double(mc), 7500., 7500. * 0.05);
+}
+
+TEST(RDataFrameMergeResults, MergeQuantiles)
+{
+   ROOT::RDataFrame df1{50000};
+   ROOT::RDataFrame df2{50000};
+
+   auto col1 = df1.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto col2 = df2.Define("x", [](ULong64_t e) { return double(e + 50000); }, {"rdfentry_"});
+
+   auto q1 = col1.Quantiles<double>("x", {0., 0.5, 1.});
+   auto q2 = col2.Quantiles<double>("x", {0., 0.5, 1.});
+   auto q3 = col2.Quantiles<double>("x", {0.5});
+
+   auto mq1 = GetMergeableValue(q1);
+   auto mq2 = GetMergeableValue(q2);
+   auto mq3 = GetMergeableValue(q3);
+
+   EXPECT_THROW(MergeValues(*mq1, *mq3), std::invalid_argument);
+
+   auto mergedptr = MergeValues(std::move(mq1), std::move(mq2));
+   const auto &mq = mergedptr->GetValue();
+
+   ASSERT_EQ(mq.size(), 3u);
+   EXPECT_DOUBLE_EQ(mq[0], 0.);
+   EXPECT_NEAR(mq[1], 50000., 100000. * 0.01);
+   EXPECT_DOUBLE_EQ(mq[2], 99999.);
+}
+
+TEST(RDataFrameMergeResults, MergeAdaptiveHisto)
+{
+   ROOT::RDataFrame df1{50000};
+   ROOT::RDataFrame df2{50000};
+
+   auto col1 = df1.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto col2 = df2.Define("x", [](ULong64_t e) { return double(e + 50000); }, {"rdfentry_"});
+
+   auto h1 = col1.AdaptiveHisto1D<double>({"h", "h", 4, 0., 0.}, "x");
+   auto h2 = col2.AdaptiveHisto1D<double>({"h", "h", 4, 0., 0.}, "x");
+
+   auto mh1 = GetMergeableValue(h1);
+   auto mh2 = GetMergeableValue(h2);
+
+   auto mergedptr = MergeValues(std::move(mh1), std::move(mh2));
+   const auto &mh = mergedptr->GetValue();
+
+   // the bins are chosen again from the merged values, [0, 100000) in 4 quartiles
+   ASSERT_EQ(mh.GetNbinsX(), 4);
+   EXPECT_DOUBLE_EQ(mh.GetEntries(), 100000.);
+   EXPECT_DOUBLE_EQ(mh.GetXaxis()->GetXmin(), 0.);
+   EXPECT_NEAR(mh.GetXaxis()->GetBinUpEdge(2), 50000., 100000. * 0.01);
+   EXPECT_NEAR(mh.GetBinContent(1), 25000., 25000. * 0.02);
+}
+
+TEST(RDataFrameMergeResults, MergeTake)
+{
+   ROOT::RDataFrame df1{3};
+   ROOT::RDataFrame df2{2};
+
+   auto take1 = df1.Take<ULong64_t>("rdfentry_");
+   auto take2 = df2.Define("x", [](ULong64_t e) { return e + 10; }, {"rdfentry_"}).Take<ULong64_t>("x");
+
+   auto mt1 = GetMergeableValue(take1);
+   auto mt2 = GetMergeableValue(take2);
+
+   auto mergedptr = MergeValues(std::move(mt1), std::move(mt2));
+   const std::vector<ULong64_t> expected{0, 1, 2, 10, 11};
+   EXPECT_EQ(mergedptr->GetValue(), expected);
+}
+
+TEST(RDataFrameMergeResults, MergeReport)
+{
+   auto makeReport = [](ULong64_t nEntries) {
+      ROOT::RDataFrame df{nEntries};
+      return df.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}, "even")
+         .Filter([](ULong64_t e) { return e % 3 == 0; }, {"rdfentry_"}, "multiple of 6")
+         .Report();
+   };
+   auto report1 = makeReport(10);
+   auto report2 = makeReport(20);
+
+   ROOT::RDataFrame df{10};
+   auto otherReport = df.Filter([] { return true; }, {}, "other").Report();
+
+   auto mr1 = GetMergeableValue(report1);
+   auto mr2 = GetMergeableValue(report2);
+   auto mr3 = GetMergeableValue(otherReport);
+
+   EXPECT_THROW(MergeValues(*mr1, *mr3), std::invalid_argument);
+
+   auto mergedptr = MergeValues(std::move(mr1), std::move(mr2));
+   auto mr = mergedptr->GetValue();
+   EXPECT_EQ(mr["even"].GetAll(), 30ull);
+   EXPECT_EQ(mr["even"].GetPass(), 15ull);
+   EXPECT_EQ(mr["multiple of 6"].GetAll(), 15ull);
+   EXPECT_EQ(mr["multiple of 6"].GetPass(), 6ull);
+}
+
+TEST(RDataFrameMergeResults, SerializeMergeables)
+{
+   ROOT::RDataFrame df{100};
+
+   auto col = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto histo = col.Histo1D<double>({"h", "h", 10, 0., 100.}, "x");
+   auto mean = col.Mean<double>("x");
+
+   const auto buffer = ROOT::Detail::RDF::SerializeMergeableValue(*GetMergeableValue(histo));
+   auto mh1 = ROOT::Detail::RDF::DeserializeMergeableValue(buffer.data(), buffer.size());
+   auto mh2 = ROOT::Detail::RDF::DeserializeMergeableValue(buffer.data(), buffer.size());
+   MergeValues(*mh1, *mh2);
+   const auto &mh = dynamic_cast<RMergeableValue<TH1D> &>(*mh1).GetValue();
+   EXPECT_DOUBLE_EQ(mh.GetEntries(), 200.);
+   EXPECT_DOUBLE_EQ(mh.GetBinContent(1), 20.);
+
+   // results of different actions cannot be merged, even if their types are only known at runtime
+   const auto meanBuffer = ROOT::Detail::RDF::SerializeMergeableValue(*GetMergeableValue(mean));
+   auto mm = ROOT::Detail::RDF::DeserializeMergeableValue(meanBuffer.data(), meanBuffer.size());
+   EXPECT_THROW(MergeValues(*mh1, *mm), std::invalid_argument);
+
+   // corrupted buffers are rejected
+   auto badBuffer = buffer;
+   badBuffer[0] = 'x';
+   EXPECT_THROW(ROOT::Detail::RDF::DeserializeMergeableValue(badBuffer.data(), badBuffer.size()), std::runtime_error);
+   EXPECT_THROW(ROOT::Detail::RDF::DeserializeMergeableValue(buffer.data(), 2u), std::runtime_error);
+}
+
+TEST(RDataFrameMergeResults, MergeMergeableFiles)
+{
+   const std::vector<std::string> inputFileNames{"dataframe_merge_results_0.root", "dataframe_merge_results_1.root"};
+   const auto outputFileName = "dataframe_merge_results_out.root";
+
+   for (auto i = 0u; i < inputFileNames.size(); ++i) {
+      ROOT::RDataFrame df{100};
+      auto col = df.Define("x", [i](ULong64_t e) { return double(e + 100 * i); }, {"rdfentry_"});
+      auto count = col.Filter([](double x) { return x > 50.; }, {"x"}).Count();
+      auto max = col.Max<double>("x");
+      TFile f(inputFileNames[i].c_str(), "RECREATE");
+      ROOT::Detail::RDF::WriteMergeableValue(*GetMergeableValue(count), f, "count");
+      ROOT::Detail::RDF::WriteMergeableValue(*GetMergeableValue(max), f, "max");
+   }
+
+   ROOT::Detail::RDF::MergeMergeableFiles(outputFileName, inputFileNames);
+
+   {
+      TFile f(outputFileName);
+      auto count = ROOT::Detail::RDF::ReadMergeableValue(f, "count");
+      auto max = ROOT::Detail::RDF::ReadMergeableValue(f, "max");
+      EXPECT_EQ(dynamic_cast<RMergeableValue<ULong64_t> &>(*count).GetValue(), 149ull);
+      EXPECT_DOUBLE_EQ(dynamic_cast<RMergeableValue<double> &>(*max).GetValue(), 199.);
+      EXPECT_THROW(ROOT::Detail::RDF::ReadMergeableValue(f, "missing"), std::runtime_error);
+   }
+
+   EXPECT_THROW(ROOT::Detail::RDF::MergeMergeableFiles(outputFileName, {"dataframe_merge_results_missing.root"}),
+                std::runtime_error);
+
+   for (const auto &fileName : inputFileNames)
+      gSystem->Unlink(fileName.c_str());
+   gSystem->Unlink(outputFileName);
+}
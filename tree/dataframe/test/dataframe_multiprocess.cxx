@@ -0,0 +1,175 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
+#include "TFile.h"
+#include "TH1D.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+
+// fixture that writes a TTree with a few flat branches to a file
+class RDFMultiProcess : public ::testing::Test {
+protected:
+   const char *fFileName = "dataframe_multiprocess.root";
+
+   void SetUp() override
+   {
+      TFile f(fFileName, "RECREATE");
+      TTree t("t", "t");
+      double x = 0.;
+      int i = 0;
+      t.Branch("x", &x);
+      t.Branch("i", &i);
+      for (i = 0; i < 1000; ++i) {
+         x = i * 0.5;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   void TearDown() override { gSystem->Unlink(fFileName); }
+};
+
+TEST(RDFMultiProcessEmptySource, SameResultsAsSequential)
+{
+   auto makeResults = [](unsigned int nWorkers) {
+      RDataFrame df(1003);
+      EnableMultiProcessing(df, nWorkers);
+      auto d = df.Define("x", [](ULong64_t e) { return double(e) * 2.; }, {"rdfentry_"});
+      auto f = d.Filter([](double x) { return x > 10.; }, {"x"});
+      auto count = f.Count();
+      auto sum = f.Sum<double>("x");
+      auto mean = d.Mean<double>("x");
+      auto max = d.Max<double>("x");
+      auto h = f.Histo1D<double>({"h", "h", 100, 0., 2000.}, "x");
+      return std::make_tuple(*count, *sum, *mean, *max, h->GetEntries(), h->GetMean(), h->GetBinContent(42));
+   };
+
+   const auto reference = makeResults(1u);
+   const auto results = makeResults(4u);
+   EXPECT_EQ(std::get<0>(results), std::get<0>(reference));
+   EXPECT_DOUBLE_EQ(std::get<1>(results), std::get<1>(reference));
+   EXPECT_DOUBLE_EQ(std::get<2>(results), std::get<2>(reference));
+   EXPECT_DOUBLE_EQ(std::get<3>(results), std::get<3>(reference));
+   EXPECT_DOUBLE_EQ(std::get<4>(results), std::get<4>(reference));
+   EXPECT_DOUBLE_EQ(std::get<5>(results), std::get<5>(reference));
+   EXPECT_DOUBLE_EQ(std::get<6>(results), std::get<6>(reference));
+}
+
+TEST(RDFMultiProcessEmptySource, MoreWorkersThanEntries)
+{
+   RDataFrame df(3);
+   EnableMultiProcessing(df, 8);
+   EXPECT_EQ(*df.Count(), 3ull);
+}
+
+TEST(RDFMultiProcessEmptySource, SeveralEventLoops)
+{
+   RDataFrame df(100);
+   EnableMultiProcessing(df, 2);
+   auto d = df.Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"});
+   EXPECT_EQ(*d.Sum<int>("x"), 4950);
+   EXPECT_EQ(*d.Filter("x % 2 == 0").Count(), 50ull);
+   EXPECT_EQ(*d.Min<int>("x"), 0);
+}
+
+TEST(RDFMultiProcessEmptySource, TakeAndReport)
+{
+   RDataFrame df(10);
+   EnableMultiProcessing(df, 2);
+   auto f = df.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}, "even");
+   auto entries = f.Take<ULong64_t>("rdfentry_");
+   auto report = f.Report();
+   // the partial results of the workers are concatenated in entry order
+   const std::vector<ULong64_t> expected{0, 2, 4, 6, 8};
+   EXPECT_EQ(*entries, expected);
+   EXPECT_EQ(report->At("even").GetAll(), 10ull);
+   EXPECT_EQ(report->At("even").GetPass(), 5ull);
+}
+
+TEST(RDFMultiProcessEmptySource, FallbackForRange)
+{
+   RDataFrame df(10);
+   EnableMultiProcessing(df, 2);
+   auto entries = df.Range(2, 5).Take<ULong64_t>("rdfentry_");
+   auto count = df.Count();
+   const std::vector<ULong64_t> expected{2, 3, 4};
+   EXPECT_EQ(*entries, expected);
+   EXPECT_EQ(*count, 10ull);
+}
+
+TEST(RDFMultiProcessEmptySource, ErrorInWorker)
+{
+   RDataFrame df(10);
+   EnableMultiProcessing(df, 2);
+   auto sum = df.Define("x",
+                        [](ULong64_t e) {
+                           if (e == 7)
+                              throw std::runtime_error("bad entry");
+                           return int(e);
+                        },
+                        {"rdfentry_"})
+                 .Sum<int>("x");
+   EXPECT_THROW(*sum, std::runtime_error);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFMultiProcessEmptySource, ThrowsWithIMT)
+{
+   ROOT::EnableImplicitMT(2);
+   RDataFrame df(10);
+   EXPECT_THROW(EnableMultiProcessing(df, 2), std::runtime_error);
+   EXPECT_NO_THROW(EnableMultiProcessing(df, 1));
+   ROOT::DisableImplicitMT();
+}
+#endif
+
+TEST_F(RDFMultiProcess, TTreeInput)
+{
+   auto makeResults = [this](unsigned int nWorkers) {
+      RDataFrame df("t", fFileName);
+      EnableMultiProcessing(df, nWorkers);
+      auto f = df.Filter("i % 3 == 0");
+      auto count = f.Count();
+      auto sum = f.Sum<double>("x");
+      auto stdDev = df.StdDev<double>("x");
+      return std::make_tuple(*count, *sum, *stdDev);
+   };
+
+   const auto reference = makeResults(1u);
+   const auto results = makeResults(3u);
+   EXPECT_EQ(std::get<0>(results), std::get<0>(reference));
+   EXPECT_DOUBLE_EQ(std::get<1>(results), std::get<1>(reference));
+   EXPECT_NEAR(std::get<2>(results), std::get<2>(reference), 1e-9);
+}
+
+TEST_F(RDFMultiProcess, Snapshot)
+{
+   const auto outFileName = "dataframe_multiprocess_snapshot.root";
+   {
+      RDataFrame df("t", fFileName);
+      EnableMultiProcessing(df, 4);
+      auto snap = df.Filter("i >= 10").Snapshot<int, double>("out", outFileName, {"i", "x"});
+      auto count = snap->Count();
+      EXPECT_EQ(*count, 990ull);
+   }
+
+   // the parts written by the workers are combined in entry order
+   RDataFrame out("out", outFileName);
+   auto is = out.Take<int>("i");
+   ASSERT_EQ(is->size(), 990u);
+   for (auto n = 0u; n < is->size(); ++n)
+      EXPECT_EQ((*is)[n], int(n) + 10);
+   for (auto n = 0u; n < 4u; ++n)
+      EXPECT_TRUE(gSystem->AccessPathName((std::string(outFileName) + ".part" + std::to_string(n)).c_str()));
+
+   gSystem->Unlink(outFileName);
+}
@@ -0,0 +1,179 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
+#include "TInterpreter.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <string>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+
+// the functions used in the jitted expressions count how many times they are invoked
+class RDFOptimization : public ::testing::Test {
+protected:
+   static void SetUpTestCase()
+   {
+      gInterpreter->Declare("std::atomic_int rdfOptNCheap{0};"
+                            "std::atomic_int rdfOptNExpensive{0};"
+                            "std::atomic_int rdfOptNSquare{0};"
+                            "bool rdfOptCheap(ULong64_t e) { ++rdfOptNCheap; return e % 10 == 0; }"
+                            "bool rdfOptExpensive(ULong64_t e) {"
+                            "   ++rdfOptNExpensive;"
+                            "   volatile double x = e;"
+                            "   for (int i = 0; i < 20000; ++i)"
+                            "      x = x * 0.5 + 1.;"
+                            "   return e % 2 == 0 && x > 0.;"
+                            "}"
+                            "double rdfOptSquare(double x) { ++rdfOptNSquare; return x * x; }");
+   }
+
+   RDFOptimization()
+   {
+      gInterpreter->ProcessLine("rdfOptNCheap = 0; rdfOptNExpensive = 0; rdfOptNSquare = 0;");
+   }
+
+   static int GetCounter(const std::string &name)
+   {
+      return int(*reinterpret_cast<std::atomic_int *>(gInterpreter->Calc(name.c_str())));
+   }
+};
+
+TEST_F(RDFOptimization, MergeFilters)
+{
+   RDataFrame df(100);
+   EnableGraphOptimization(df);
+   auto c1 = df.Filter("rdfOptCheap(rdfentry_)").Count();
+   auto c2 = df.Filter("rdfOptCheap(rdfentry_)").Sum<ULong64_t>("rdfentry_");
+   // named filters are never merged
+   auto r = df.Filter("rdfOptCheap(rdfentry_)", "cheap").Count();
+   EXPECT_EQ(*c1, 10u);
+   EXPECT_EQ(*c2, 450u);
+   EXPECT_EQ(*r, 10u);
+   EXPECT_EQ(GetCounter("rdfOptNCheap"), 200);
+}
+
+TEST_F(RDFOptimization, NoMergeWithoutOptimization)
+{
+   RDataFrame df(100);
+   auto c1 = df.Filter("rdfOptCheap(rdfentry_)").Count();
+   auto c2 = df.Filter("rdfOptCheap(rdfentry_)").Count();
+   EXPECT_EQ(*c1, 10u);
+   EXPECT_EQ(*c2, 10u);
+   EXPECT_EQ(GetCounter("rdfOptNCheap"), 200);
+}
+
+TEST_F(RDFOptimization, MergeDefines)
+{
+   RDataFrame df(100);
+   EnableGraphOptimization(df);
+   auto d = df.Define("x", "double(rdfentry_)");
+   auto s1 = d.Define("a", "rdfOptSquare(x)").Sum<double>("a");
+   auto s2 = d.Define("b", "rdfOptSquare(x)").Filter("b < 100.").Sum<double>("b");
+   // same expression, but on a different input column: not merged
+   auto s3 = d.Define("y", "2. * x").Define("c", "rdfOptSquare(y)").Max<double>("c");
+   EXPECT_DOUBLE_EQ(*s1, 328350.);
+   EXPECT_DOUBLE_EQ(*s2, 285.);
+   EXPECT_DOUBLE_EQ(*s3, 39204.);
+   EXPECT_EQ(GetCounter("rdfOptNSquare"), 200);
+}
+
+TEST_F(RDFOptimization, ReorderFilters)
+{
+   RDataFrame df(1000);
+   EnableGraphOptimization(df, 10u);
+   auto f = df.Filter("rdfOptExpensive(rdfentry_)").Filter("rdfOptCheap(rdfentry_)");
+   auto c = f.Count();
+   auto s = f.Sum<ULong64_t>("rdfentry_");
+   EXPECT_EQ(*c, 100u);
+   EXPECT_EQ(*s, 49500u);
+   // during the warm-up the filters are evaluated in booking order, afterwards the cheap and selective one comes first
+   EXPECT_EQ(GetCounter("rdfOptNCheap"), 5 + 990);
+   EXPECT_EQ(GetCounter("rdfOptNExpensive"), 10 + 99);
+}
+
+TEST_F(RDFOptimization, NoReorderByDefault)
+{
+   RDataFrame df(1000);
+   EnableGraphOptimization(df);
+   auto c = df.Filter("rdfOptExpensive(rdfentry_)").Filter("rdfOptCheap(rdfentry_)").Count();
+   EXPECT_EQ(*c, 100u);
+   EXPECT_EQ(GetCounter("rdfOptNExpensive"), 1000);
+   EXPECT_EQ(GetCounter("rdfOptNCheap"), 500);
+}
+
+TEST_F(RDFOptimization, WarmUpRespectsGuards)
+{
+   RDataFrame df(100);
+   EnableGraphOptimization(df, 10u);
+   // the second filter must never be evaluated on empty vectors: the warm-up evaluates the filters in booking order,
+   // and the second filter never rejects entries, so it is still evaluated last afterwards
+   auto c = df.Define("v", [](ULong64_t e) { return ROOT::RVecI(e % 2, 1); }, {"rdfentry_"})
+               .Filter("v.size() > 0")
+               .Filter("v.at(0) == 1")
+               .Count();
+   EXPECT_EQ(*c, 50u);
+}
+
+TEST_F(RDFOptimization, NoReorderIfIntermediateResultIsUsed)
+{
+   RDataFrame df(1000);
+   EnableGraphOptimization(df, 10u);
+   auto f1 = df.Filter("rdfOptExpensive(rdfentry_)");
+   auto f2 = f1.Filter("rdfOptCheap(rdfentry_)");
+   auto c1 = f1.Count();
+   auto c2 = f2.Count();
+   EXPECT_EQ(*c1, 500u);
+   EXPECT_EQ(*c2, 100u);
+   EXPECT_EQ(GetCounter("rdfOptNExpensive"), 1000);
+   EXPECT_EQ(GetCounter("rdfOptNCheap"), 500);
+}
+
+TEST_F(RDFOptimization, ReorderWithNamedFilterDownstream)
+{
+   RDataFrame df(1000);
+   EnableGraphOptimization(df, 10u);
+   auto f = df.Filter("rdfOptExpensive(rdfentry_)").Filter("rdfOptCheap(rdfentry_)").Filter("rdfentry_ > 500", "last");
+   auto r = f.Report();
+   auto c = f.Count();
+   EXPECT_EQ(*c, 49u);
+   EXPECT_EQ((*r)["last"].GetAll(), 100u);
+   EXPECT_EQ((*r)["last"].GetPass(), 49u);
+}
+
+TEST_F(RDFOptimization, ReorderKeepsReport)
+{
+   auto makeReport = [](unsigned int nWarmUpEntries) {
+      RDataFrame df(1000);
+      if (nWarmUpEntries > 0)
+         EnableGraphOptimization(df, nWarmUpEntries);
+      auto r = df.Filter("rdfentry_ % 3 == 0", "first")
+                  .Filter("rdfOptExpensive(rdfentry_)")
+                  .Filter("rdfOptCheap(rdfentry_)")
+                  .Filter("rdfentry_ > 500", "last")
+                  .Report();
+      std::vector<std::pair<ULong64_t, ULong64_t>> counts;
+      for (auto &&cut : *r)
+         counts.emplace_back(cut.GetAll(), cut.GetPass());
+      return counts;
+   };
+   EXPECT_EQ(makeReport(10u), makeReport(0u));
+}
+
+#ifdef R__USE_IMT
+TEST_F(RDFOptimization, ReorderFiltersMT)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      RDataFrame df(10000);
+      EnableGraphOptimization(df, 10u);
+      auto s = df.Filter("rdfOptExpensive(rdfentry_)").Filter("rdfOptCheap(rdfentry_)").Sum<ULong64_t>("rdfentry_");
+      EXPECT_EQ(*s, 4995000u);
+      EXPECT_EQ(GetCounter("rdfOptNCheap"), 10000);
+      EXPECT_LT(GetCounter("rdfOptNExpensive"), 10000);
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
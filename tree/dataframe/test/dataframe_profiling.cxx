@@ -0,0 +1,129 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDFHelpers.hxx"
+#include "TROOT.h"
+#include "TSystem.h"
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <string>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+
+namespace {
+RNodeProfileInfo GetNodeInfo(const RProfileReport &report, const std::string &kind, const std::string &name)
+{
+   for (const auto &node : report)
+      if (node.GetKind() == kind && node.GetName() == name)
+         return node;
+   throw std::runtime_error("No " + kind + " node called \"" + name + "\" in the profile report");
+}
+} // anonymous namespace
+
+TEST(RDFProfiling, NotEnabled)
+{
+   RDataFrame df(10);
+   auto c = df.Count();
+   EXPECT_EQ(*c, 10u);
+   EXPECT_THROW(GetProfileReport(df), std::runtime_error);
+}
+
+TEST(RDFProfiling, CallCounts)
+{
+   RDataFrame df(100);
+   EnableProfiling(df);
+   auto s = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+               .Filter([](double x) { return x < 50.; }, {"x"}, "half")
+               .Sum<double>("x");
+   EXPECT_DOUBLE_EQ(*s, 1225.);
+
+   const auto report = GetProfileReport(df);
+   EXPECT_EQ(report.size(), 3u);
+   EXPECT_GT(report.GetEventLoopTime(), 0.);
+
+   const auto filter = GetNodeInfo(report, "Filter", "half").GetTotal();
+   EXPECT_EQ(filter.fNCalls, 100u);
+   EXPECT_GE(filter.fTime, filter.fReadTime);
+   EXPECT_GE(filter.fReadTime, 0.);
+   EXPECT_EQ(GetNodeInfo(report, "Define", "x").GetTotal().fNCalls, 100u);
+   const auto action = GetNodeInfo(report, "Action", "Sum");
+   EXPECT_EQ(action.GetTotal().fNCalls, 50u);
+   EXPECT_EQ(action.GetSlotStats().size(), 1u);
+   // no input file
+   EXPECT_EQ(action.GetTotal().fBytesRead, 0);
+}
+
+TEST(RDFProfiling, ResetAtEachEventLoop)
+{
+   RDataFrame df(10);
+   EnableProfiling(df);
+   auto f = df.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}, "even");
+   EXPECT_EQ(*f.Count(), 5u);
+   EXPECT_EQ(*f.Count(), 5u);
+   const auto report = GetProfileReport(df);
+   EXPECT_EQ(GetNodeInfo(report, "Filter", "even").GetTotal().fNCalls, 10u);
+   EXPECT_EQ(GetNodeInfo(report, "Action", "Count").GetTotal().fNCalls, 5u);
+
+   EnableProfiling(df, false);
+   EXPECT_EQ(*f.Count(), 5u);
+   EXPECT_THROW(GetProfileReport(df), std::runtime_error);
+}
+
+TEST(RDFProfiling, JitAndOutputFormats)
+{
+   RDataFrame df(20);
+   EnableProfiling(df);
+   auto m = df.Define("y", "rdfentry_ * 2.").Filter("y > 10", "large").Mean("y");
+   EXPECT_DOUBLE_EQ(*m, 25.);
+
+   const auto report = GetProfileReport(df);
+   EXPECT_EQ(GetNodeInfo(report, "Filter", "large").GetTotal().fNCalls, 20u);
+   EXPECT_EQ(GetNodeInfo(report, "Define", "y").GetTotal().fNCalls, 20u);
+   EXPECT_EQ(GetNodeInfo(report, "Action", "Mean").GetTotal().fNCalls, 14u);
+
+   const auto json = report.AsJSON();
+   EXPECT_NE(json.find("\"eventLoopTime\": "), std::string::npos);
+   EXPECT_NE(json.find("{\"kind\": \"Filter\", \"name\": \"large\", \"calls\": 20, "), std::string::npos);
+   EXPECT_NE(json.find("{\"kind\": \"Action\", \"name\": \"Mean\", \"calls\": 14, "), std::string::npos);
+
+   const auto graph = SaveGraph(df);
+   EXPECT_NE(graph.find("large\n20 calls"), std::string::npos);
+   EXPECT_NE(graph.find("Define\ny\n20 calls"), std::string::npos);
+   EXPECT_NE(graph.find("Mean\n14 calls"), std::string::npos);
+}
+
+TEST(RDFProfiling, BytesRead)
+{
+   const auto fname = "dataframe_profiling_bytesread.root";
+   RDataFrame(1000)
+      .Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+      .Snapshot<double>("t", fname, {"x"});
+
+   RDataFrame df("t", fname);
+   EnableProfiling(df);
+   auto s = df.Sum<double>("x");
+   EXPECT_DOUBLE_EQ(*s, 499500.);
+   const auto action = GetNodeInfo(GetProfileReport(df), "Action", "Sum").GetTotal();
+   EXPECT_EQ(action.fNCalls, 1000u);
+   EXPECT_GT(action.fBytesRead, 0);
+
+   gSystem->Unlink(fname);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFProfilingMT, PerSlotStatistics)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame df(1000);
+   EnableProfiling(df);
+   auto c = df.Filter([](ULong64_t e) { return e < 100; }, {"rdfentry_"}, "first").Count();
+   EXPECT_EQ(*c, 100u);
+   const auto report = GetProfileReport(df);
+   const auto filter = GetNodeInfo(report, "Filter", "first");
+   EXPECT_EQ(filter.GetSlotStats().size(), df.GetNSlots());
+   EXPECT_EQ(filter.GetTotal().fNCalls, 1000u);
+   EXPECT_EQ(GetNodeInfo(report, "Action", "Count").GetTotal().fNCalls, 100u);
+   ROOT::DisableImplicitMT();
+}
+#endif
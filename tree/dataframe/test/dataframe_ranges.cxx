@@ -1,5 +1,10 @@
 #include "ROOT/RDataFrame.hxx"
 #include <TROOT.h>
+#include <TSystem.h>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -91,18 +96,69 @@ TEST_F(RDFRanges, NoEarlyStopping)
 }
 
 #ifdef R__USE_IMT
-TEST(RDFRangesMT, ThrowIfIMT)
+TEST(RDFRangesMT, EmptySource)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(100);
+   auto c1 = d.Range(0).Count();
+   auto c2 = d.Range(10).Count();
+   auto m = d.Range(5, 50).Max<ULong64_t>("rdfentry_");
+   auto t = d.Range(5, 20, 3).Take<ULong64_t>("rdfentry_");
+   EXPECT_EQ(*c1, 100u);
+   EXPECT_EQ(*c2, 10u);
+   EXPECT_EQ(*m, 49u);
+   auto sorted = *t;
+   std::sort(sorted.begin(), sorted.end());
+   EXPECT_EQ(sorted, std::vector<ULong64_t>({5, 8, 11, 14, 17}));
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, EarlyStop)
 {
-   bool hasThrown = false;
-   ROOT::EnableImplicitMT();
-   RDataFrame d(0);
-   try {
-      d.Range(0);
-   } catch (const std::exception &e) {
-      hasThrown = true;
-      EXPECT_STREQ(e.what(), "Range was called with ImplicitMT enabled, but multi-thread is not supported.");
-   }
-   EXPECT_TRUE(hasThrown);
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(1000);
+   std::atomic<unsigned int> count(0u);
+   auto t = d.Define("counter",
+                     [&count]() {
+                        ++count;
+                        return 42;
+                     })
+               .Range(20, 40)
+               .Take<int>("counter");
+   EXPECT_EQ(*t, std::vector<int>(20, 42));
+   // only entries that can pass the range are processed
+   EXPECT_EQ(count.load(), 20u);
+   ROOT::DisableImplicitMT();
+}
+
+TEST(RDFRangesMT, TTree)
+{
+   const auto fname = "dataframe_ranges_mt.root";
+   RDataFrame(1000).Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>("t", fname, {"x"});
+
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d("t", fname);
+   auto s1 = d.Range(100, 200).Sum<int>("x");
+   auto s2 = d.Range(900, 0, 10).Sum<int>("x");
+   auto c = d.Count();
+   EXPECT_EQ(*s1, 14950);
+   EXPECT_EQ(*s2, 9540);
+   EXPECT_EQ(*c, 1000u);
+   ROOT::DisableImplicitMT();
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFRangesMT, FallbackToSingleThread)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame d(100);
+   // ranges hanging from filters or other ranges count the entries that reach them, in order
+   auto min = d.Range(10, 50).Range(10, 20).Min<ULong64_t>("rdfentry_");
+   auto t = d.Filter([](ULong64_t e) { return e % 2 == 0; }, {"rdfentry_"}).Range(2, 5).Take<ULong64_t>("rdfentry_");
+   EXPECT_EQ(*min, 20u);
+   EXPECT_EQ(*t, std::vector<ULong64_t>({4, 6, 8}));
+   ROOT::DisableImplicitMT();
 }
 #endif
 
@@ -0,0 +1,171 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDF/RSketches.hxx"
+#include "ROOT/RVec.hxx"
+#include "TH1D.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+using ROOT::Detail::RDF::RHyperLogLog;
+using ROOT::Detail::RDF::RTDigest;
+using ROOT::Internal::RDF::HashValue;
+
+TEST(RDFSketches, HyperLogLogMerge)
+{
+   RHyperLogLog a, b;
+   for (int i = 0; i < 20000; ++i)
+      (i < 15000 ? a : b).Add(HashValue(i % 10000 + (i >= 15000 ? 5000 : 0)));
+   a.Merge(b);
+   // 0..9999 in a, 10000..14999 in b
+   EXPECT_NEAR(a.Estimate(), 15000., 15000. * 0.05);
+
+   RHyperLogLog c(10);
+   EXPECT_THROW(a.Merge(c), std::invalid_argument);
+   EXPECT_THROW(RHyperLogLog(2), std::invalid_argument);
+}
+
+TEST(RDFSketches, TDigestMerge)
+{
+   RTDigest a, b;
+   EXPECT_TRUE(std::isnan(a.Quantile(0.5)));
+   for (int i = 0; i < 100000; ++i)
+      (i % 2 ? a : b).Add(i);
+   a.Merge(b);
+   EXPECT_EQ(a.GetTotalWeight(), 100000.);
+   EXPECT_LE(a.GetNCentroids(), 200u);
+   EXPECT_DOUBLE_EQ(a.Quantile(0.), 0.);
+   EXPECT_DOUBLE_EQ(a.Quantile(1.), 99999.);
+   EXPECT_NEAR(a.Quantile(0.5), 50000., 100000. * 0.01);
+   EXPECT_NEAR(a.Quantile(0.01), 1000., 100000. * 0.001);
+}
+
+TEST(RDFSketches, CountDistinct)
+{
+   RDataFrame df(100000);
+   auto d = df.Define("x", [](ULong64_t e) { return int(e % 5000); }, {"rdfentry_"})
+               .Define("y", [](ULong64_t e) { return e % 3 == 0; }, {"rdfentry_"});
+   auto c1 = d.CountDistinct<int>({"x"});
+   auto c2 = d.CountDistinct({"x"});
+   // gcd(5000, 3) == 1, so each value of x appears with both values of y
+   auto c3 = d.CountDistinct<int, bool>({"x", "y"});
+   auto c4 = d.CountDistinct<int>({"x"}, 16);
+   auto c5 = d.Filter([](int x) { return x < 10; }, {"x"}).CountDistinct<int>({"x"});
+   EXPECT_NEAR(double(*c1), 5000., 5000. * 0.05);
+   EXPECT_EQ(*c1, *c2);
+   EXPECT_NEAR(double(*c3), 10000., 10000. * 0.05);
+   EXPECT_NEAR(double(*c4), 5000., 5000. * 0.02);
+   EXPECT_EQ(*c5, 10u);
+
+   EXPECT_THROW(d.CountDistinct<int>({"x"}, 19), std::runtime_error);
+}
+
+TEST(RDFSketches, CountDistinctStringsAndCollections)
+{
+   RDataFrame df(1000);
+   auto d = df.Define("s", [](ULong64_t e) { return std::to_string(e % 100); }, {"rdfentry_"})
+               .Define("v", [](ULong64_t e) { return RVecI{int(e % 10), int(e % 20)}; }, {"rdfentry_"});
+   auto cs = d.CountDistinct<std::string>({"s"});
+   auto cv = d.CountDistinct<RVecI>({"v"});
+   // at small cardinalities the estimate is exact up to hash collisions
+   EXPECT_NEAR(double(*cs), 100., 2.);
+   EXPECT_NEAR(double(*cv), 20., 2.);
+}
+
+TEST(RDFSketches, Quantiles)
+{
+   RDataFrame df(100001);
+   auto d = df.Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"});
+   auto q1 = d.Quantiles<double>("x", {0., 0.25, 0.5, 0.75, 1.});
+   auto q2 = d.Quantiles("x", {0.5});
+   auto q3 = d.Filter([](double x) { return x > 1e6; }, {"x"}).Quantiles<double>("x", {0.5});
+   ASSERT_EQ(q1->size(), 5u);
+   EXPECT_DOUBLE_EQ(q1->at(0), 0.);
+   EXPECT_NEAR(q1->at(1), 25000., 100000. * 0.01);
+   EXPECT_NEAR(q1->at(2), 50000., 100000. * 0.01);
+   EXPECT_NEAR(q1->at(3), 75000., 100000. * 0.01);
+   EXPECT_DOUBLE_EQ(q1->at(4), 100000.);
+   EXPECT_DOUBLE_EQ(q2->at(0), q1->at(2));
+   ASSERT_EQ(q3->size(), 1u);
+   EXPECT_TRUE(std::isnan(q3->at(0)));
+
+   EXPECT_THROW(d.Quantiles<double>("x", {1.5}), std::runtime_error);
+   EXPECT_THROW(d.Quantiles<double>("x", {0.5}, 0.), std::runtime_error);
+}
+
+TEST(RDFSketches, QuantilesOfCollections)
+{
+   RDataFrame df(1000);
+   auto d = df.Define("v", [](ULong64_t e) { return RVecF{float(e), float(e + 1000)}; }, {"rdfentry_"});
+   auto q = d.Quantiles<RVecF>("v", {0.5});
+   EXPECT_NEAR(q->at(0), 1000., 2000. * 0.01);
+}
+
+TEST(RDFSketches, AdaptiveHistoEqualPopulation)
+{
+   RDataFrame df(100000);
+   // exponential distribution: a long tail that fixed-width bins resolve poorly
+   auto d = df.Define("x", [](ULong64_t e) { return -std::log(1. - (e + 0.5) / 100000.); }, {"rdfentry_"});
+   auto h = d.AdaptiveHisto1D<double>({"h", "h", 10, 0., 0.}, "x");
+   EXPECT_STREQ(h->GetName(), "h");
+   ASSERT_EQ(h->GetNbinsX(), 10);
+   EXPECT_DOUBLE_EQ(h->GetEntries(), 100000.);
+   EXPECT_NEAR(h->Integral(), 100000., 1e-6);
+   EXPECT_DOUBLE_EQ(h->GetBinContent(0), 0.);
+   EXPECT_DOUBLE_EQ(h->GetBinContent(11), 0.);
+   for (int i = 1; i <= 10; ++i)
+      EXPECT_NEAR(h->GetBinContent(i), 10000., 10000. * 0.05);
+   // the edges are the deciles of the distribution, -log(1 - q)
+   EXPECT_NEAR(h->GetXaxis()->GetBinUpEdge(5), std::log(2.), 0.01);
+   EXPECT_NEAR(h->GetXaxis()->GetBinUpEdge(9), std::log(10.), 0.05);
+   EXPECT_GT(h->GetXaxis()->GetXmax(), d.Max<double>("x").GetValue());
+   EXPECT_DOUBLE_EQ(h->GetXaxis()->GetXmin(), d.Min<double>("x").GetValue());
+}
+
+TEST(RDFSketches, AdaptiveHistoFreedmanDiaconis)
+{
+   RDataFrame df(100000);
+   auto d = df.Define("x", [](ULong64_t e) { return (e % 1000) / 100.; }, {"rdfentry_"});
+   auto h = d.AdaptiveHisto1D<double>({"h", "h", 1000, 0., 0.}, "x", EAdaptiveBinning::kFreedmanDiaconis);
+   auto hMax = d.AdaptiveHisto1D<double>({"hMax", "hMax", 10, 0., 0.}, "x", EAdaptiveBinning::kFreedmanDiaconis);
+   // uniform in [0, 10): IQR == 5, so the bin width is 10 / cbrt(1e5)
+   EXPECT_NEAR(h->GetNbinsX(), std::cbrt(1e5), 1.);
+   EXPECT_NEAR(h->GetBinWidth(1), 10. / std::cbrt(1e5), 0.01);
+   EXPECT_NEAR(h->GetMean(), 4.995, 0.01);
+   EXPECT_NEAR(h->Integral(), 100000., 1e-6);
+   EXPECT_EQ(hMax->GetNbinsX(), 10);
+   EXPECT_NEAR(hMax->GetBinContent(5), 10000., 10000. * 0.05);
+
+   // a single value
+   auto hOne = d.Filter([](double x) { return x == 1.; }, {"x"}).AdaptiveHisto1D<double>("x");
+   ASSERT_EQ(hOne->GetNbinsX(), 1);
+   EXPECT_DOUBLE_EQ(hOne->GetBinContent(1), 100.);
+   EXPECT_DOUBLE_EQ(hOne->GetBinCenter(1), 1.);
+
+   EXPECT_THROW(d.AdaptiveHisto1D<double>({"h", "h", 0, 0., 0.}, "x"), std::runtime_error);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFSketchesMT, AllSketches)
+{
+   ROOT::EnableImplicitMT(4);
+   RDataFrame df(1000000);
+   auto d = df.Define("x", [](ULong64_t e) { return double(e % 200000); }, {"rdfentry_"});
+   auto c = d.CountDistinct<double>({"x"});
+   auto q = d.Quantiles<double>("x", {0.1, 0.5, 0.9});
+   auto h = d.AdaptiveHisto1D("x");
+   EXPECT_NEAR(double(*c), 200000., 200000. * 0.05);
+   EXPECT_EQ(h->GetNbinsX(), 128);
+   EXPECT_NEAR(h->Integral(), 1000000., 1e-3);
+   EXPECT_NEAR(q->at(0), 20000., 200000. * 0.01);
+   EXPECT_NEAR(q->at(1), 100000., 200000. * 0.01);
+   EXPECT_NEAR(q->at(2), 180000., 200000. * 0.01);
+   ROOT::DisableImplicitMT();
+}
+#endif
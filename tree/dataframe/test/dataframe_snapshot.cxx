@@ -1183,6 +1183,74 @@ TEST(RDFSnapshotMore, SetMaxTreeSizeMT)
    TTree::SetMaxTreeSize(old_maxtreesize);
 }
 
+TEST(RDFSnapshotMore, AsyncWritingMT)
+{
+   const auto fname = "snapshot_asyncwritingmt.root";
+   {
+      TIMTEnabler imt(4);
+      RSnapshotOptions opts;
+      opts.fAsyncWriting = true;
+      opts.fAutoFlush = 100;
+      opts.fCompressionLevel = 6;
+      ROOT::RDataFrame(10000)
+         .Define("x", [](ULong64_t e) { return double(e); }, {"rdfentry_"})
+         .Filter([](double x) { return int(x) % 3 != 0; }, {"x"})
+         .Snapshot<double>("t", fname, {"x"}, opts);
+   }
+
+   // read back sequentially: the output entries are in the order of the input entries
+   ROOT::RDataFrame out("t", fname);
+   auto xs = out.Take<double>("x");
+   std::vector<double> expected;
+   for (int i = 0; i < 10000; ++i)
+      if (i % 3 != 0)
+         expected.push_back(i);
+   EXPECT_EQ(*xs, expected);
+
+   gSystem->Unlink(fname);
+}
+
+TEST(RDFSnapshotMore, AsyncWritingTreeInputMT)
+{
+   const auto inName = "snapshot_asyncwritingtreemt_in.root";
+   const auto fname = "snapshot_asyncwritingtreemt.root";
+   {
+      RSnapshotOptions opts;
+      opts.fAutoFlush = 500;
+      ROOT::RDataFrame(20000).Define("x", [](ULong64_t e) { return int(e); }, {"rdfentry_"}).Snapshot<int>(
+         "t", inName, {"x"}, opts);
+   }
+   {
+      TIMTEnabler imt(4);
+      RSnapshotOptions opts;
+      opts.fAsyncWriting = true;
+      opts.fAutoFlush = 100;
+      ROOT::RDataFrame("t", inName).Filter([](int x) { return x % 7 != 0; }, {"x"}).Snapshot<int>("t", fname, {"x"},
+                                                                                                 opts);
+   }
+
+   TFile f(fname);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   EXPECT_FALSE(t->TestBit(TTree::kEntriesReshuffled));
+   int x = 0;
+   t->SetBranchAddress("x", &x);
+   std::vector<int> xs;
+   for (Long64_t i = 0; i < t->GetEntries(); ++i) {
+      t->GetEntry(i);
+      xs.push_back(x);
+   }
+   std::vector<int> expected;
+   for (int i = 0; i < 20000; ++i)
+      if (i % 7 != 0)
+         expected.push_back(i);
+   EXPECT_EQ(xs, expected);
+
+   f.Close();
+   gSystem->Unlink(fname);
+   gSystem->Unlink(inName);
+}
+
 TEST(RDFSnapshotMore, ZeroOutputEntriesMT)
 {
    const auto fname = "snapshot_zerooutputentriesmt.root";
@@ -0,0 +1,114 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RNTuple.hxx>
+#include <ROOT/RVec.hxx>
+#include <TROOT.h>
+#include <TSystem.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace ROOT::RDF;
+using ROOT::Experimental::RNTupleReader;
+using ROOT::VecOps::RVec;
+
+namespace {
+RSnapshotOptions NTupleOptions()
+{
+   RSnapshotOptions opts;
+   opts.fOutputFormat = ESnapshotOutputFormat::kRNTuple;
+   return opts;
+}
+
+// a dataframe with scalar, RVec and nested collection columns
+ROOT::RDF::RNode MakeSource(ULong64_t nEntries)
+{
+   return ROOT::RDataFrame(nEntries)
+      .Define("i", [](ULong64_t e) { return int(e); }, {"rdfentry_"})
+      .Define("x", [](int i) { return 0.5 * i; }, {"i"})
+      .Define("jets", [](int i) { return RVec<float>(i % 4, float(i)); }, {"i"})
+      .Define("nested", [](int i) { return std::vector<std::vector<int>>{{i}, {}, {i, i}}; }, {"i"});
+}
+} // namespace
+
+TEST(RDFSnapshotNTuple, Fields)
+{
+   const auto fileName = "dataframe_snapshot_ntuple_fields.root";
+   auto snap =
+      MakeSource(100).Snapshot<int, double, RVec<float>, std::vector<std::vector<int>>>(
+         "ntuple", fileName, {"i", "x", "jets", "nested"}, NTupleOptions());
+
+   // the returned dataframe reads the output RNTuple
+   EXPECT_EQ(*snap->Count(), 100ull);
+   EXPECT_DOUBLE_EQ(*snap->Sum<double>("x"), 0.5 * 99. * 100. / 2.);
+
+   auto reader = RNTupleReader::Open("ntuple", fileName);
+   ASSERT_EQ(reader->GetNEntries(), 100u);
+   auto i = reader->GetView<int>("i");
+   auto jets = reader->GetView<RVec<float>>("jets");
+   auto nested = reader->GetView<std::vector<std::vector<int>>>("nested");
+   for (auto e : reader->GetEntryRange()) {
+      EXPECT_EQ(i(e), int(e));
+      EXPECT_EQ(jets(e).size(), e % 4);
+      ASSERT_EQ(nested(e).size(), 3u);
+      EXPECT_EQ(nested(e)[2], std::vector<int>({int(e), int(e)}));
+   }
+   reader.reset();
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFSnapshotNTuple, Jitted)
+{
+   const auto fileName = "dataframe_snapshot_ntuple_jitted.root";
+   auto opts = NTupleOptions();
+   opts.fAutoFlush = 10;
+   auto snap = MakeSource(35).Snapshot("ntuple", fileName, {"i", "jets"}, opts);
+   EXPECT_EQ(*snap->Count(), 35ull);
+
+   // one cluster per fAutoFlush entries
+   auto reader = RNTupleReader::Open("ntuple", fileName);
+   EXPECT_EQ(reader->GetDescriptor().GetNClusters(), 4u);
+   reader.reset();
+   gSystem->Unlink(fileName);
+}
+
+TEST(RDFSnapshotNTuple, SubdirectoryThrows)
+{
+   const auto fileName = "dataframe_snapshot_ntuple_subdir.root";
+   EXPECT_THROW(MakeSource(1).Snapshot<int>("dir/ntuple", fileName, {"i"}, NTupleOptions()), std::runtime_error);
+   gSystem->Unlink(fileName);
+}
+
+#ifdef R__USE_IMT
+TEST(RDFSnapshotNTuple, MultiThread)
+{
+   const auto fileName = "dataframe_snapshot_ntuple_mt.root";
+   {
+      ROOT::EnableImplicitMT(4);
+      auto opts = NTupleOptions();
+      opts.fAutoFlush = 1000;
+      MakeSource(20000).Snapshot<int, RVec<float>>("ntuple", fileName, {"i", "jets"}, opts);
+      ROOT::DisableImplicitMT();
+   }
+
+   auto reader = RNTupleReader::Open("ntuple", fileName);
+   ASSERT_EQ(reader->GetNEntries(), 20000u);
+   // clusters have exactly fAutoFlush entries: the entries left in the buffers of the slots at the end of the event
+   // loop are merged in full clusters too
+   const auto &descriptor = reader->GetDescriptor();
+   EXPECT_EQ(descriptor.GetNClusters(), 20u);
+   for (const auto &cluster : descriptor.GetClusterIterable())
+      EXPECT_EQ(cluster.GetNEntries(), 1000u);
+   auto i = reader->GetView<int>("i");
+   auto jets = reader->GetView<RVec<float>>("jets");
+   long long sum = 0;
+   for (auto e : reader->GetEntryRange()) {
+      sum += i(e);
+      EXPECT_EQ(jets(e).size(), std::size_t(i(e) % 4));
+   }
+   EXPECT_EQ(sum, 19999ll * 20000ll / 2ll);
+   reader.reset();
+   gSystem->Unlink(fileName);
+}
+#endif
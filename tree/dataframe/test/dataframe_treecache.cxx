@@ -0,0 +1,94 @@
+#include "ROOT/RDataFrame.hxx"
+#include "ROOT/RDF/Utils.hxx" // RDFLogChannel
+#include "ROOT/RLogger.hxx"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace ROOT;
+using namespace ROOT::RDF;
+
+// fixture that writes a TTree with three branches to a file
+class RDFTreeCache : public ::testing::Test {
+protected:
+   const char *fFileName = "dataframe_treecache.root";
+
+   void SetUp() override
+   {
+      TFile f(fFileName, "RECREATE");
+      TTree t("t", "t");
+      int x = 0, y = 0, z = 0;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      t.Branch("z", &z);
+      for (x = 0; x < 1000; ++x) {
+         y = 2 * x;
+         z = 3 * x;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   void TearDown() override { gSystem->Unlink(fFileName); }
+};
+
+TEST_F(RDFTreeCache, AllColumnsAreRegistered)
+{
+   TFile f(fFileName);
+   auto *t = f.Get<TTree>("t");
+   RDataFrame df(*t);
+   // y is only read for the last few entries, by a Define downstream of a jitted Filter
+   auto sum = df.Filter("x >= 990").Define("y2", [](int y) { return y * 2; }, {"y"}).Sum<int>("y2");
+   ROOT::Experimental::RLogScopedDiagCount diagCount(ROOT::Detail::RDF::RDFLogChannel());
+   EXPECT_EQ(*sum, 4 * 9945);
+   EXPECT_EQ(diagCount.GetAccumulatedWarnings(), 0);
+
+   auto *cache = t->GetReadCache(&f);
+   ASSERT_NE(cache, nullptr);
+   EXPECT_FALSE(cache->IsLearning());
+   const auto *cachedBranches = cache->GetCachedBranches();
+   EXPECT_NE(cachedBranches->FindObject("x"), nullptr);
+   EXPECT_NE(cachedBranches->FindObject("y"), nullptr);
+   EXPECT_EQ(cachedBranches->FindObject("z"), nullptr);
+}
+
+TEST_F(RDFTreeCache, WarnAboutUncachedBranches)
+{
+   TFile f(fFileName);
+   auto *t = f.Get<TTree>("t");
+   RDataFrame df(*t);
+   // z is read directly from the tree, bypassing RDataFrame
+   auto *z = t->GetBranch("z");
+   auto count = df.Filter([z](ULong64_t entry) { return z->GetEntry(entry) > 0; }, {"rdfentry_"})
+                   .Filter([](int x) { return x % 2 == 0; }, {"x"})
+                   .Count();
+   ROOT::Experimental::RLogScopedDiagCount diagCount(ROOT::Detail::RDF::RDFLogChannel());
+   EXPECT_EQ(*count, 500ull);
+   EXPECT_EQ(diagCount.GetAccumulatedWarnings(), 1);
+}
+
+TEST_F(RDFTreeCache, DestroyedNodesAreNotRegistered)
+{
+   TFile f(fFileName);
+   auto *t = f.Get<TTree>("t");
+   RDataFrame df(*t);
+   {
+      // booked and destroyed before the event loop runs: z must not be registered
+      auto filterOnZ = df.Filter([](int z) { return z > 0; }, {"z"});
+      auto defineOnY = df.Define("y2", [](int y) { return y * 2; }, {"y"});
+   }
+   auto sum = df.Sum<int>("x");
+   EXPECT_EQ(*sum, 499500);
+
+   auto *cache = t->GetReadCache(&f);
+   ASSERT_NE(cache, nullptr);
+   const auto *cachedBranches = cache->GetCachedBranches();
+   EXPECT_NE(cachedBranches->FindObject("x"), nullptr);
+   EXPECT_EQ(cachedBranches->FindObject("y"), nullptr);
+   EXPECT_EQ(cachedBranches->FindObject("z"), nullptr);
+}
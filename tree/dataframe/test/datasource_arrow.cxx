@@ -72,6 +72,46 @@ std::shared_ptr<Table> createTestTable()
    return table_;
 }
 
+template <typename T>
+std::shared_ptr<T> makeChunkedColumn(std::shared_ptr<Field> field, arrow::ArrayVector chunks)
+{
+   return std::make_shared<T>(field, chunks);
+}
+
+template <>
+std::shared_ptr<arrow::ChunkedArray>
+makeChunkedColumn<arrow::ChunkedArray>(std::shared_ptr<Field>, arrow::ArrayVector chunks)
+{
+   return std::make_shared<arrow::ChunkedArray>(chunks);
+}
+
+// Two record batches of 3 and 4 entries. Entry x holds x % 3 values in the list column.
+std::shared_ptr<Table> createChunkedTestTable(arrow::ArrayVector *listChunks = nullptr)
+{
+   auto schema_ = schema({field("x", arrow::int64()), field("v", arrow::list(arrow::float64()))});
+   const std::vector<std::vector<int64_t>> xs = {{0, 1, 2}, {3, 4, 5, 6}};
+   arrow::ArrayVector xChunks(2);
+   arrow::ArrayVector vChunks(2);
+   for (auto c : {0, 1}) {
+      arrow::ArrayFromVector<Int64Type, int64_t>(xs[c], &xChunks[c]);
+      ListBuilder builder(default_memory_pool(), std::make_shared<DoubleBuilder>());
+      auto &valueBuilder = static_cast<DoubleBuilder &>(*builder.value_builder());
+      for (auto x : xs[c]) {
+         EXPECT_TRUE(builder.Append().ok());
+         for (auto i = 0; i < x % 3; ++i)
+            EXPECT_TRUE(valueBuilder.Append(x + 0.5 * i).ok());
+      }
+      EXPECT_TRUE(builder.Finish(&vChunks[c]).ok());
+   }
+   if (listChunks)
+      *listChunks = vChunks;
+
+   using ColumnType = typename decltype(std::declval<arrow::Table>().column(0))::element_type;
+   std::vector<std::shared_ptr<ColumnType>> columns_ = {makeChunkedColumn<ColumnType>(schema_->field(0), xChunks),
+                                                        makeChunkedColumn<ColumnType>(schema_->field(1), vChunks)};
+   return Table::Make(schema_, columns_);
+}
+
 TEST(RArrowDS, ColTypeNames)
 {
    RArrowDS tds(createTestTable(), {"Name", "Age", "Height", "Married", "Babies"});
@@ -112,6 +152,62 @@ TEST(RArrowDS, EntryRanges)
    EXPECT_EQ(6U, ranges[2].second);
 }
 
+TEST(RArrowDS, EntryRangesChunked)
+{
+   using Ranges_t = std::vector<std::pair<ULong64_t, ULong64_t>>;
+   {
+      // ranges do not cross the boundaries between record batches
+      RArrowDS tds(createChunkedTestTable(), {});
+      tds.SetNSlots(2U);
+      tds.Initialise();
+      EXPECT_EQ(tds.GetEntryRanges(), Ranges_t({{0, 3}, {3, 7}}));
+   }
+   {
+      // record batches are split if there are more slots than batches
+      RArrowDS tds(createChunkedTestTable(), {});
+      tds.SetNSlots(4U);
+      tds.Initialise();
+      EXPECT_EQ(tds.GetEntryRanges(), Ranges_t({{0, 1}, {1, 3}, {3, 5}, {5, 7}}));
+   }
+   {
+      // consecutive record batches are grouped if there are more batches than slots
+      RArrowDS tds(createChunkedTestTable(), {});
+      tds.SetNSlots(1U);
+      tds.Initialise();
+      EXPECT_EQ(tds.GetEntryRanges(), Ranges_t({{0, 7}}));
+   }
+}
+
+TEST(RArrowDS, ColumnReadersListNoCopy)
+{
+   arrow::ArrayVector vChunks;
+   RArrowDS tds(createChunkedTestTable(&vChunks), {});
+   tds.SetNSlots(1U);
+   auto valsX = tds.GetColumnReaders<Long64_t>("x");
+   auto valsV = tds.GetColumnReaders<ROOT::RVecD>("v");
+   tds.Initialise();
+
+   for (auto &&range : tds.GetEntryRanges()) {
+      tds.InitSlot(0U, range.first);
+      for (auto entry = range.first; entry < range.second; ++entry) {
+         tds.SetEntry(0U, entry);
+         const auto x = **valsX[0];
+         EXPECT_EQ(x, Long64_t(entry));
+         const auto &v = **valsV[0];
+         ASSERT_EQ(v.size(), std::size_t(x % 3));
+         for (auto i = 0u; i < v.size(); ++i)
+            EXPECT_DOUBLE_EQ(v[i], x + 0.5 * i);
+
+         // the RVec points into the Arrow buffer
+         const auto chunkIdx = entry < 3 ? 0 : 1;
+         const auto idxInChunk = entry < 3 ? entry : entry - 3;
+         const auto &list = static_cast<const ListArray &>(*vChunks[chunkIdx]);
+         const auto &values = static_cast<const DoubleArray &>(*list.values());
+         EXPECT_EQ(v.data(), values.raw_values() + list.value_offset(idxInChunk));
+      }
+   }
+}
+
 TEST(RArrowDS, ColumnReaders)
 {
    RArrowDS tds(createTestTable(), {});
@@ -238,6 +334,17 @@ TEST(RArrowDS, FromARDFMT)
    EXPECT_DOUBLE_EQ(.8, *min);
 }
 
+TEST(RArrowDS, FromARDFChunkedMT)
+{
+   auto tdf = MakeArrowDataFrame(createChunkedTestTable(), {});
+   auto sumX = tdf.Sum<Long64_t>("x");
+   auto sumV = tdf.Define("s", [](const ROOT::RVecD &v) { return ROOT::VecOps::Sum(v); }, {"v"}).Sum<double>("s");
+
+   EXPECT_EQ(21, *sumX);
+   // x + 0.5 * i for the x % 3 elements of each entry
+   EXPECT_DOUBLE_EQ(1. + 2. + 2.5 + 4. + 5. + 5.5, *sumV);
+}
+
 TEST(RArrowDS, FromARDFWithJittingMT)
 {
    std::unique_ptr<RDataSource> tds(new RArrowDS(createTestTable(), {}));
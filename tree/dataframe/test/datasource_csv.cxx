@@ -2,9 +2,11 @@
 #include <ROOT/RCsvDS.hxx>
 #include <ROOT/TSeq.hxx>
 #include <TROOT.h>
+#include <TSystem.h>
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <iostream>
 
 using namespace ROOT::RDF;
@@ -197,6 +199,82 @@ TEST(RCsvDS, ProgressiveReadingRDF)
    EXPECT_EQ(6U, *c2);
 }
 
+RCsvDS::ROptions MemoryMapOptions()
+{
+   RCsvDS::ROptions opts;
+   opts.fMemoryMap = true;
+   return opts;
+}
+
+TEST(RCsvDS, MemoryMappedColumnReaders)
+{
+   RCsvDS tds(fileName0, MemoryMapOptions());
+   const auto nSlots = 3U;
+   tds.SetNSlots(nSlots);
+   auto names = tds.GetColumnReaders<std::string>("Name");
+   auto ages = tds.GetColumnReaders<Long64_t>("Age");
+   auto heights = tds.GetColumnReaders<double>("Height");
+   auto married = tds.GetColumnReaders<bool>("Married");
+   tds.Initialise();
+   auto ranges = tds.GetEntryRanges();
+   EXPECT_EQ(3U, ranges.size());
+   EXPECT_EQ(6U, ranges.back().second);
+   EXPECT_TRUE(tds.GetEntryRanges().empty());
+
+   std::vector<std::string> namesRef = {"Harry", "Bob,Bob", "\"Joe\"", "Tom", " John  ", " Mary Ann "};
+   std::vector<Long64_t> agesRef = {60, 50, 40, 30, 1, -1};
+   std::vector<double> heightsRef = {185.2, 180.0, 200.5, 170., .7, .7};
+   std::vector<bool> marriedRef = {true, true, false, false, false, true};
+   auto slot = 0U;
+   for (auto &&range : ranges) {
+      tds.InitSlot(slot, range.first);
+      for (auto i : ROOT::TSeq<int>(range.first, range.second)) {
+         tds.SetEntry(slot, i);
+         EXPECT_EQ(namesRef[i], **names[slot]);
+         EXPECT_EQ(agesRef[i], **ages[slot]);
+         EXPECT_DOUBLE_EQ(heightsRef[i], **heights[slot]);
+         EXPECT_EQ(marriedRef[i], **married[slot]);
+      }
+      slot++;
+   }
+   tds.Finalise();
+}
+
+TEST(RCsvDS, MemoryMappedTypeInference)
+{
+   auto opts = MemoryMapOptions();
+   opts.fHeaders = false;
+   // "False" in the fourth line is not a boolean value
+   RCsvDS tds(fileName1, opts);
+   EXPECT_EQ("std::string", tds.GetTypeName("Col0"));
+   EXPECT_EQ("Long64_t", tds.GetTypeName("Col1"));
+   EXPECT_EQ("double", tds.GetTypeName("Col2"));
+   EXPECT_EQ("std::string", tds.GetTypeName("Col3"));
+
+   opts.fNTypeInferenceLines = 3;
+   RCsvDS tds2(fileName1, opts);
+   EXPECT_EQ("bool", tds2.GetTypeName("Col3"));
+}
+
+TEST(RCsvDS, MemoryMappedEmptyFile)
+{
+   EXPECT_THROW(RCsvDS(fileName2, MemoryMapOptions()), std::runtime_error);
+   auto opts = MemoryMapOptions();
+   opts.fHeaders = false;
+   EXPECT_THROW(RCsvDS(fileName2, opts), std::runtime_error);
+}
+
+TEST(RCsvDS, MemoryMappedRDF)
+{
+   auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName0, MemoryMapOptions());
+   EXPECT_EQ(6U, *tdf.Count());
+   EXPECT_EQ(180LL, *tdf.Sum<Long64_t>("Age"));
+   EXPECT_EQ(30, *tdf.Filter("Age<40").Max("Age"));
+
+   auto tdf2 = ROOT::RDF::MakeCsvDataFrame(fileName3, MemoryMapOptions());
+   EXPECT_EQ(6U, *tdf2.Count());
+}
+
 #ifndef NDEBUG
 
 TEST(RCsvDS, SetNSlotsTwice)
@@ -323,6 +401,33 @@ TEST(RCsvDS, ProgressiveReadingRDFMT)
    EXPECT_EQ(6U, *c2);
 }
 
+TEST(RCsvDS, MemoryMappedMT)
+{
+   const auto fileName = "RCsvDS_test_memorymapped_mt.csv";
+   const auto nLines = 200000ULL;
+   {
+      std::ofstream f(fileName);
+      f << "x,y,s\n";
+      for (auto i = 0ULL; i < nLines; ++i)
+         f << i << ',' << i * 0.5 << ",\"line " << i << "\"\n";
+   }
+
+   // the file is large enough to be indexed in parallel chunks
+   auto tdf = ROOT::RDF::MakeCsvDataFrame(fileName, MemoryMapOptions());
+   auto c = tdf.Count();
+   auto sx = tdf.Sum<Long64_t>("x");
+   auto sy = tdf.Sum<double>("y");
+   auto nMatching = tdf.Filter([](Long64_t x, const std::string &s) { return s == "line " + std::to_string(x); },
+                               {"x", "s"})
+                       .Count();
+   EXPECT_EQ(nLines, *c);
+   EXPECT_EQ(Long64_t(nLines * (nLines - 1) / 2), *sx);
+   EXPECT_DOUBLE_EQ(nLines * (nLines - 1) / 4., *sy);
+   EXPECT_EQ(nLines, *nMatching);
+
+   gSystem->Unlink(fileName);
+}
+
 #endif // R__USE_IMT
 
 #endif // R__B64
@@ -194,8 +194,64 @@ TEST(RSqliteDS, SetEntry)
    EXPECT_EQ(nullptr, **vnull[0]);
 }
 
+TEST(RSqliteDS, Partitioned)
+{
+   auto rdf = MakeSqliteDataFrame(fileName0, "SELECT rowid AS id, fint, ftext FROM test;", "id", 2);
+   EXPECT_EQ(2U, *rdf.Count());
+   EXPECT_EQ(3, *rdf.Sum("fint"));
+   auto texts = *rdf.Take<std::string>("ftext");
+   std::sort(texts.begin(), texts.end());
+   EXPECT_EQ(std::vector<std::string>({"1", "2"}), texts);
+
+   // the partitioning key must be an integer column of the query
+   EXPECT_THROW(RSqliteDS(fileName0, query0, "ftext"), std::runtime_error);
+   EXPECT_THROW(RSqliteDS(fileName0, query0, "nonexistent"), std::runtime_error);
+}
+
+TEST(RSqliteDS, PartitionedEntryRanges)
+{
+   RSqliteDS rds(fileName0, "SELECT rowid AS id, fint FROM test", "id");
+   rds.SetNSlots(2);
+   auto vint = rds.GetColumnReaders<Long64_t>("fint");
+   rds.Initialise();
+   // one range per partition: the key range [1, 2] is split in two
+   auto ranges = rds.GetEntryRanges();
+   ASSERT_EQ(2U, ranges.size());
+   EXPECT_TRUE(rds.SetEntry(0, ranges[0].first));
+   EXPECT_EQ(1, **vint[0]);
+   EXPECT_FALSE(rds.SetEntry(0, ranges[0].first + 1)); // beyond the last row of the partition
+   EXPECT_TRUE(rds.SetEntry(1, ranges[1].first));
+   EXPECT_EQ(2, **vint[1]);
+   EXPECT_FALSE(rds.SetEntry(1, ranges[1].first + 1));
+   EXPECT_TRUE(rds.GetEntryRanges().empty());
+
+   // New event loop
+   rds.Initialise();
+   EXPECT_EQ(2U, rds.GetEntryRanges().size());
+}
+
+TEST(RSqliteDS, PartitionedSetNSlotsTwice)
+{
+   RSqliteDS rds(fileName0, "SELECT rowid AS id, fint FROM test", "id");
+   rds.SetNSlots(1);
+   // the partitions of the first call are replaced, not added to
+   rds.SetNSlots(2);
+   rds.Initialise();
+   EXPECT_EQ(2U, rds.GetEntryRanges().size());
+   EXPECT_TRUE(rds.GetEntryRanges().empty());
+}
+
 #ifdef R__USE_IMT
 
+TEST(RSqliteDS, PartitionedIMT)
+{
+   ROOT::EnableImplicitMT(4);
+   auto rdf = MakeSqliteDataFrame(fileName0, "SELECT rowid AS id, fint, freal FROM test", "id");
+   EXPECT_EQ(3, *rdf.Sum("fint"));
+   EXPECT_NEAR(3.0, *rdf.Sum("freal"), epsilon);
+   ROOT::DisableImplicitMT();
+}
+
 TEST(RSqliteDS, IMT)
 {
    using Blob_t = std::vector<unsigned char>;
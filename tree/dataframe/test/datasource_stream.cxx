@@ -0,0 +1,151 @@
+#include <ROOT/RDataFrame.hxx>
+#include <ROOT/RStreamDS.hxx>
+#include <TROOT.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace ROOT::RDF;
+
+TEST(RStreamDS, Constructor)
+{
+   RStreamDS<int, double> ds({"i", "x"});
+   EXPECT_EQ(ds.GetColumnNames(), std::vector<std::string>({"i", "x"}));
+   EXPECT_TRUE(ds.HasColumn("x"));
+   EXPECT_FALSE(ds.HasColumn("y"));
+   EXPECT_EQ(ds.GetTypeName("i"), "int");
+   EXPECT_EQ(ds.GetTypeName("x"), "double");
+   EXPECT_FALSE(ds.IsClosed());
+
+   using DS_t = RStreamDS<int, double>;
+   EXPECT_THROW(DS_t({"i"}), std::runtime_error);
+   EXPECT_THROW(DS_t({"i", "x"}, 0u), std::runtime_error);
+}
+
+TEST(RStreamDS, TryPush)
+{
+   RStreamDS<int> ds({"i"}, /*capacity*/ 2);
+   EXPECT_TRUE(ds.TryPush(1));
+   EXPECT_TRUE(ds.TryPush(2));
+   EXPECT_FALSE(ds.TryPush(3)); // the buffer is full
+   EXPECT_EQ(ds.GetNBuffered(), 2u);
+   ds.Close();
+   EXPECT_TRUE(ds.IsClosed());
+   EXPECT_FALSE(ds.Push(4));
+}
+
+TEST(RStreamDS, Producer)
+{
+   // a small buffer makes the producer wait for the event loop
+   auto source = std::make_unique<RStreamDS<int, double>>(std::vector<std::string>{"i", "x"}, /*capacity*/ 10,
+                                                           /*batchSize*/ 4);
+   auto &stream = *source;
+   ROOT::RDataFrame df(std::move(source));
+   auto count = df.Count();
+   auto sum = df.Sum<double>("x");
+   auto is = df.Take<int>("i");
+
+   std::thread producer([&stream] {
+      for (int i = 0; i < 1000; ++i)
+         stream.Push(i, i * 0.5);
+      stream.Close();
+   });
+   EXPECT_EQ(*count, 1000ull);
+   producer.join();
+
+   EXPECT_DOUBLE_EQ(*sum, 0.5 * 999. * 1000. / 2.);
+   std::vector<int> expected(1000);
+   std::iota(expected.begin(), expected.end(), 0);
+   EXPECT_EQ(*is, expected);
+}
+
+TEST(RStreamDS, EarlyStopClosesTheStream)
+{
+   auto source = std::make_unique<RStreamDS<int>>(std::vector<std::string>{"i"}, /*capacity*/ 8);
+   auto &stream = *source;
+   ROOT::RDataFrame df(std::move(source));
+   auto first = df.Range(5).Take<int>("i");
+
+   int nPushed = 0;
+   std::thread producer([&stream, &nPushed] {
+      // an endless stream: Push returns false once the event loop ended
+      while (stream.Push(nPushed))
+         ++nPushed;
+   });
+   EXPECT_EQ(*first, std::vector<int>({0, 1, 2, 3, 4}));
+   producer.join();
+   EXPECT_TRUE(stream.IsClosed());
+   EXPECT_GE(nPushed, 5);
+}
+
+TEST(RStreamDS, PeriodicCallback)
+{
+   auto source = std::make_unique<RStreamDS<int>>(std::vector<std::string>{"i"}, /*capacity*/ 100, /*batchSize*/ 100,
+                                                   /*maxLatency*/ std::chrono::milliseconds(1));
+   auto &stream = *source;
+   ROOT::RDataFrame df(std::move(source));
+   auto count = df.Count();
+   std::vector<ULong64_t> partialCounts;
+   count.OnPartialResult(std::chrono::milliseconds(5),
+                         [&partialCounts](ULong64_t &c) { partialCounts.emplace_back(c); });
+
+   std::thread producer([&stream] {
+      for (int i = 0; i < 50; ++i) {
+         stream.Push(i);
+         std::this_thread::sleep_for(std::chrono::milliseconds(2));
+      }
+      stream.Close();
+   });
+   EXPECT_EQ(*count, 50ull);
+   producer.join();
+
+   // the entries are processed while they are produced, and the callback is invoked a few times meanwhile
+   ASSERT_FALSE(partialCounts.empty());
+   EXPECT_TRUE(std::is_sorted(partialCounts.begin(), partialCounts.end()));
+   EXPECT_LE(partialCounts.back(), 50ull);
+}
+
+TEST(RStreamDS, NonPositivePeriodThrows)
+{
+   ROOT::RDataFrame df(1);
+   auto count = df.Count();
+   EXPECT_THROW(count.OnPartialResult(std::chrono::seconds(0), [](ULong64_t &) {}), std::runtime_error);
+}
+
+#ifdef R__USE_IMT
+TEST(RStreamDS, ProducerMT)
+{
+   ROOT::EnableImplicitMT(4);
+   {
+      auto source = std::make_unique<RStreamDS<int>>(std::vector<std::string>{"i"}, /*capacity*/ 64, /*batchSize*/ 8);
+      auto &stream = *source;
+      ROOT::RDataFrame df(std::move(source));
+      auto count = df.Count();
+      auto sum = df.Sum<int>("i");
+
+      // two producers push to the same stream
+      auto produce = [&stream](int first) {
+         for (int i = first; i < first + 500; ++i)
+            stream.Push(i);
+      };
+      std::thread p1(produce, 0);
+      std::thread p2(produce, 500);
+      std::thread closer([&] {
+         p1.join();
+         p2.join();
+         stream.Close();
+      });
+      EXPECT_EQ(*count, 1000ull);
+      EXPECT_EQ(*sum, 999 * 1000 / 2);
+      closer.join();
+   }
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -57,6 +57,8 @@ private:
    // Manage buffer ownership.
    void   DisownBuffer();
    void   AdoptBuffer(TBuffer *user_buffer);
+   void   MapBuffer(char *mapped, Int_t len, TFile *file);
+   void   UnmapBuffer();
 
 protected:
    Int_t       fBufferSize{0};                    ///< fBuffer length in bytes
@@ -67,6 +69,9 @@ protected:
    UChar_t     fIOBits{0};                        ///<!IO feature flags.  Serialized in custom portion of streamer to avoid forward compat issues unless needed.
    Bool_t      fOwnsCompressedBuffer{kFALSE};     ///<! Whether or not we own the compressed buffer.
    Bool_t      fReadEntryOffset{kFALSE};          ///<!Set to true if offset array was read from a file.
+   Bool_t      fBufferAdopted{kFALSE};            ///<!True if fBufferRef was adopted from an external entity, see AdoptBuffer
+   Bool_t      fBufferMapped{kFALSE};             ///<!True if fBufferRef points to the memory mapping of the file, see MapBuffer
+   TBuffer    *fUnmappedBufferRef{nullptr};       ///<!Buffer owned by the basket while fBufferRef is mapped
    Int_t      *fDisplacement{nullptr};            ///<![fNevBuf] Displacement of entries in fBuffer(TKey)
    Int_t      *fEntryOffset{nullptr};             ///<[fNevBuf] Offset of entries in fBuffer(TKey); generated at runtime.  Special value
                                                   /// of `-1` indicates that the offset generation MUST be performed on first read.
@@ -75,6 +80,7 @@ protected:
    Int_t       fLastWriteBufferSize[3] = {0,0,0}; ///<! Size of the buffer last three buffers we wrote it to disk
    Bool_t      fResetAllocation{false};           ///<! True if last reset re-allocated the memory
    UChar_t     fNextBufferSizeRecord{0};          ///<! Index into fLastWriteBufferSize of the last buffer written to disk
+   Int_t       fCompressedLen{-1};                ///<! Length of the object prepared in fBuffer by CompressBuffer, -1 if none
 #ifdef R__TRACK_BASKET_ALLOC_TIME
    ULong64_t   fResetAllocationTime{0};           ///<! Time spent reallocating baskets in microseconds during last Reset operation.
 #endif
@@ -116,6 +122,7 @@ public:
    virtual ~TBasket();
 
    virtual void    AdjustSize(Int_t newsize);
+           Int_t   CompressBuffer();
    virtual void    DeleteEntryOffset();
    virtual Int_t   DropBuffers();
    TBranch        *GetBranch() const {return fBranch;}
@@ -75,6 +75,9 @@ class TTreeCache;
 class TTreeCloner;
 class TFileMergeInfo;
 class TVirtualPerfStats;
+namespace ROOT {
+class TThreadExecutor;
+}
 
 class TTree : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
@@ -140,6 +143,10 @@ protected:
    UInt_t         fNEntriesSinceSorting;  ///<! Number of entries processed since the last re-sorting of branches
    std::vector<std::pair<Long64_t,TBranch*>> fSortedBranches; ///<! Branches to be processed in parallel when IMT is on, sorted by average task time
    std::vector<TBranch*> fSeqBranches;    ///<! Branches to be processed sequentially when IMT is on
+   Int_t          fIMTFillThreshold{0};   ///<! Minimum number of top-level branches for Fill to fill them in parallel when IMT is on, 0 to never do it
+   std::vector<Int_t> fSeqFillBranches;   ///<! Indices of the branches filled sequentially, before the others, by a parallel Fill
+   std::vector<Int_t> fParFillBranches;   ///<! Indices of the branches filled in parallel by a parallel Fill
+   ROOT::TThreadExecutor *fFillExecutor{nullptr}; ///<! Executor of the tasks of a parallel Fill
    Float_t fTargetMemoryRatio{1.1f};      ///<! Ratio for memory usage in uncompressed buffers versus actual occupancy.  1.0
                                            /// indicates basket should be resized to exact memory usage, but causes significant
 /// memory churn.
@@ -159,6 +166,8 @@ private:
 
    void             InitializeBranchLists(bool checkLeafCount);
    void             SortBranchesByTime();
+   void             InitializeFillBranchLists();
+   std::vector<Int_t> FillBranchesParallel();
    Int_t            FlushBasketsImpl() const;
    void             MarkEventCluster();
    Long64_t         GetMedianClusterSize();
@@ -474,6 +483,7 @@ public:
    virtual const char     *GetFriendAlias(TTree*) const;
    TH1                    *GetHistogram() { return GetPlayer()->GetHistogram(); }
    virtual Bool_t          GetImplicitMT() { return fIMTEnabled; }
+           Int_t           GetImplicitMTFillThreshold() const { return fIMTFillThreshold; }
    virtual Int_t          *GetIndex() { return &fIndex.fArray[0]; }
    virtual Double_t       *GetIndexValues() { return &fIndexValues.fArray[0]; }
            ROOT::TIOFeatures GetIOFeatures() const;
@@ -615,6 +625,7 @@ public:
    virtual void            SetEventList(TEventList* list);
    virtual void            SetEntryList(TEntryList* list, Option_t *opt="");
    virtual void            SetImplicitMT(Bool_t enabled) { fIMTEnabled = enabled; }
+           void            SetImplicitMTFillThreshold(Int_t nbranches);
    virtual void            SetMakeClass(Int_t make);
    virtual void            SetMaxEntryLoop(Long64_t maxev = kMaxEntries) { fMaxEntryLoop = maxev; } // *MENU*
    static  void            SetMaxTreeSize(Long64_t maxsize = 100000000000LL);
@@ -63,7 +63,10 @@ protected:
    Bool_t       fEnabled{kTRUE};      ///<! cache enabled for cached reading
    EPrefillType fPrefillType;         ///<  Whether a pre-filling is enabled (and if applicable which type)
    static Int_t fgLearnEntries;       ///<  number of entries used for learning mode
+   static TString fgTrainingFile;     ///<  file where the learnt branches are persisted
+   static TString fgTrainingAnalysis; ///<  identifier of the analysis the learnt branches are persisted for
    Bool_t       fAutoCreated{kFALSE}; ///<! true if cache was automatically created
+   Bool_t       fTrainingChecked{kFALSE}; ///<! true if the persisted training was already looked up
 
    Bool_t       fLearnPrefilling{kFALSE}; ///<! true if we are in the process of executing LearnPrefill
 
@@ -119,6 +122,7 @@ private:
                          int len); ///< Check the miss cache for a particular buffer, fetching if deemed necessary.
    Bool_t FillMissCache();         ///< Fill the miss cache from the current set of active branches.
    Bool_t CalculateMissCache();    ///< Calculate the appropriate miss cache to fetch; helper function for FillMissCache
+   TString GetTrainingKey() const; ///< Key of the persisted training of this cache.
    IOPos  FindBranchBasketPos(TBranch &, Long64_t entry); ///< Given a branch and an entry, determine the file location
                                                           ///< (offset / size) of the corresponding basket.
    TBranch *CalculateMissEntries(Long64_t, int, bool);    ///< Given an file read, try to determine the corresponding branch.
@@ -146,6 +150,7 @@ public:
    virtual EPrefillType GetLearnPrefill() const {return fPrefillType;}
    Double_t             GetMissEfficiency() const;
    Double_t             GetMissEfficiencyRel() const;
+   static const char   *GetTrainingFile();
    TTree               *GetTree() const {return fTree;}
    Bool_t               IsAutoCreated() const {return fAutoCreated;}
    virtual Bool_t       IsEnabled() const {return fEnabled;}
@@ -154,12 +159,14 @@ public:
    virtual Bool_t       FillBuffer();
    virtual Int_t        LearnBranch(TBranch *b, Bool_t subgbranches = kFALSE);
    virtual void         LearnPrefill();
+   virtual Int_t        LoadTraining(const char *location = nullptr);
 
    virtual void         Print(Option_t *option="") const;
    virtual Int_t        ReadBuffer(char *buf, Long64_t pos, Int_t len);
    virtual Int_t        ReadBufferNormal(char *buf, Long64_t pos, Int_t len);
    virtual Int_t        ReadBufferPrefetch(char *buf, Long64_t pos, Int_t len);
    virtual void         ResetCache();
+   virtual Int_t        SaveTraining(const char *location = nullptr) const;
    void                 ResetMissCache(); // Reset the miss cache.
    void                 SetAutoCreated(Bool_t val) {fAutoCreated = val;}
    virtual Int_t        SetBufferSize(Int_t buffersize);
@@ -168,6 +175,7 @@ public:
    virtual void         SetLearnPrefill(EPrefillType type = kNoPrefill);
    static void          SetLearnEntries(Int_t n = 10);
    void                 SetOptimizeMisses(Bool_t opt);
+   static void          SetTrainingFile(const char *location, const char *analysis = "");
    void                 StartLearningPhase();
    virtual void         StopLearningPhase();
    virtual void         UpdateBranches(TTree *tree);
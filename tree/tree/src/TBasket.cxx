@@ -106,7 +106,9 @@ TBasket::~TBasket()
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
    if (fBufferRef) delete fBufferRef;
+   if (fUnmappedBufferRef) delete fUnmappedBufferRef;
    fBufferRef = 0;
+   fUnmappedBufferRef = nullptr;
    fBuffer = 0;
    fDisplacement= 0;
    // Note we only delete the compressed buffer if we own it
@@ -177,8 +179,12 @@ Int_t TBasket::DropBuffers()
    if (fDisplacement) delete [] fDisplacement;
    ResetEntryOffset();
    if (fBufferRef)    delete fBufferRef;
+   if (fUnmappedBufferRef) delete fUnmappedBufferRef;
    if (fCompressedBufferRef && fOwnsCompressedBuffer) delete fCompressedBufferRef;
    fBufferRef   = 0;
+   fUnmappedBufferRef = nullptr;
+   fBufferMapped = kFALSE;
+   fBufferAdopted = kFALSE;
    fCompressedBufferRef = 0;
    fBuffer      = 0;
    fDisplacement= 0;
@@ -244,6 +250,7 @@ Int_t TBasket::GetEntryPointer(Int_t entry)
 
 Int_t TBasket::LoadBasketBuffers(Long64_t pos, Int_t len, TFile *file, TTree *tree)
 {
+   UnmapBuffer();
    if (fBufferRef) {
       // Reuse the buffer if it exist.
       fBufferRef->Reset();
@@ -470,9 +477,41 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
    Bool_t oldCase;
    char *rawUncompressedBuffer, *rawCompressedBuffer;
    Int_t uncompressedBufferLen;
+   char *mappedBuffer;
+   TFileCacheRead *pf = nullptr;
+
+   // Files opened with option READ_MMAP: read the basket from the memory mapping of the file, bypassing the cache.
+   mappedBuffer = file->GetMappedBuffer(pos, len);
+   if (mappedBuffer) {
+      fBranch->GetTree()->IncrementTotalBuffers(-fBufferSize);
+      {
+         // Unstream the key header without touching fBufferRef, which might be a buffer adopted from the user.
+         TBufferFile header(TBuffer::kRead, len, mappedBuffer, kFALSE);
+         header.SetParent(file);
+         Streamer(header);
+      }
+      if (IsZombie()) {
+         return 1;
+      }
+      if (fObjlen + fKeylen == fNbytes) {
+         if (!fBufferAdopted) {
+            // The basket is not compressed: its content is used in place, without any copy.
+            MapBuffer(mappedBuffer, len, file);
+         } else {
+            fBufferRef = R__InitializeReadBasketBuffer(fBufferRef, len, file);
+            memcpy(fBufferRef->Buffer(), mappedBuffer, len);
+         }
+         fBuffer = fBufferRef->Buffer();
+         goto AfterBuffer;
+      }
+      // The basket is decompressed straight from the mapping into the buffer of the basket.
+      UnmapBuffer();
+      rawCompressedBuffer = mappedBuffer;
+      goto Decompress;
+   }
+   UnmapBuffer();
 
    // See if the cache has already unzipped the buffer for us.
-   TFileCacheRead *pf = nullptr;
    {
       R__LOCKGUARD_IMT(gROOTMutex); // Lock for parallel TTree I/O
       pf = fBranch->GetTree()->GetReadCache(file);
@@ -577,6 +616,7 @@ Int_t TBasket::ReadBasketBuffers(Long64_t pos, Int_t len, TFile *file)
       }
    }
 
+Decompress:
    // Initialize buffer to hold the uncompressed data
    // Note that in previous versions we didn't allocate buffers until we verified
    // the zip headers; this is no longer beforehand as the buffer lifetime is scoped
@@ -713,6 +753,7 @@ Int_t TBasket::ReadBasketBytes(Long64_t pos, TFile *file)
 void TBasket::DisownBuffer()
 {
    fBufferRef = NULL;
+   fBufferAdopted = kFALSE;
 }
 
 
@@ -720,8 +761,42 @@ void TBasket::DisownBuffer()
 /// Adopt a buffer from an external entity
 void TBasket::AdoptBuffer(TBuffer *user_buffer)
 {
+   UnmapBuffer();
    delete fBufferRef;
    fBufferRef = user_buffer;
+   fBufferAdopted = kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Point fBufferRef to the bytes [mapped, mapped + len) of the memory mapping
+/// of the file, see TFile option READ_MMAP. The buffer owned by the basket, if
+/// any, is kept aside to be reused by UnmapBuffer.
+
+void TBasket::MapBuffer(char *mapped, Int_t len, TFile *file)
+{
+   if (fBufferMapped) {
+      fBufferRef->SetBuffer(mapped, len, kFALSE);
+      fBufferRef->Reset();
+   } else {
+      fUnmappedBufferRef = fBufferRef;
+      fBufferRef = new TBufferFile(TBuffer::kRead, len, mapped, kFALSE);
+      fBufferMapped = kTRUE;
+   }
+   fBufferRef->SetParent(file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Restore the buffer owned by the basket if fBufferRef points to the memory
+/// mapping of the file, see MapBuffer.
+
+void TBasket::UnmapBuffer()
+{
+   if (!fBufferMapped)
+      return;
+   delete fBufferRef;
+   fBufferRef = fUnmappedBufferRef;
+   fUnmappedBufferRef = nullptr;
+   fBufferMapped = kFALSE;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -740,6 +815,7 @@ void TBasket::ReadResetBuffer(Int_t basketnumber)
 
    // Downsize the buffer if needed.
 
+   UnmapBuffer();
    const auto maxbaskets = fBranch->GetMaxBaskets();
    if (!fBufferRef || basketnumber >= maxbaskets)
       return;
@@ -1122,53 +1198,27 @@ void TBasket::Update(Int_t offset, Int_t skipped)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Write buffer of this basket on the current file.
+/// Prepare the content of this basket to be written by WriteBuffer: transfer
+/// the entry offsets at the end of the buffer and compress it.
 ///
-/// The function returns the number of bytes committed to the memory.
-/// If a write error occurs, the number of bytes returned is -1.
-/// If no data are written, the number of bytes returned is 0.
+/// This does not access the file, so that it can be run in parallel tasks
+/// while WriteBuffer is then called for each basket in a given order, see
+/// TTree::SetImplicitMTFillThreshold. The basket must not be filled between
+/// the two calls. If it is not called beforehand, WriteBuffer calls it.
+///
+/// The function returns the number of bytes of the object to be written,
+/// -1 in case of error.
 
-Int_t TBasket::WriteBuffer()
+Int_t TBasket::CompressBuffer()
 {
    constexpr Int_t kWrite = 1;
 
-   TFile *file = fBranch->GetFile(kWrite);
-   if (!file) return 0;
-   if (!file->IsWritable()) {
-      return -1;
-   }
-   fMotherDir = file; // fBranch->GetDirectory();
-
-   // This mutex prevents multiple TBasket::WriteBuffer invocations from interacting
-   // with the underlying TFile at once - TFile is assumed to *not* be thread-safe.
-   //
-   // The only parallelism we'd like to exploit (right now!) is the compression
-   // step - everything else should be serialized at the TFile level.
-#ifdef R__USE_IMT
-   std::unique_lock<std::mutex> sentry(file->fWriteMutex);
-#endif  // R__USE_IMT
-
-   if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed))) {
-      // Read the basket information that was saved inside the buffer.
-      Bool_t writing = fBufferRef->IsWriting();
-      fBufferRef->SetReadMode();
-      fBufferRef->SetBufferOffset(0);
-
-      Streamer(*fBufferRef);
-      if (writing) fBufferRef->SetWriteMode();
-      Int_t nout = fNbytes - fKeylen;
-
-      fBuffer = fBufferRef->Buffer();
-
-      Create(nout,file);
-      fBufferRef->SetBufferOffset(0);
-      fHeaderOnly = kTRUE;
+   // A basket holding an already compressed buffer is written as is, see WriteBuffer.
+   if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed)))
+      return 0;
 
-      Streamer(*fBufferRef);         //write key itself again
-      int nBytes = WriteFileKeepBuffer();
-      fHeaderOnly = kFALSE;
-      return nBytes>0 ? fKeylen+nout : -1;
-   }
+   TFile *file = fBranch->GetFile(kWrite);
+   if (!file) return -1;
 
    // Transfer fEntryOffset table at the end of fBuffer.
    fLast = fBufferRef->Length();
@@ -1208,8 +1258,6 @@ Int_t TBasket::WriteBuffer()
 
    fObjlen = fBufferRef->Length() - fKeylen;
 
-   fHeaderOnly = kTRUE;
-   fCycle = fBranch->GetWriteBasket();
    Int_t cxlevel = fBranch->GetCompressionLevel();
    if (cxlevel == ROOT::RCompressionSetting::ELevel::kInherit)
       cxlevel = file->GetCompressionLevel();
@@ -1236,16 +1284,10 @@ Int_t TBasket::WriteBuffer()
          // Compress the buffer.  Note that we allow multiple TBasket compressions to occur at once
          // for a given TFile: that's because the compression buffer when we use IMT is no longer
          // shared amongst several threads.
-#ifdef R__USE_IMT
-         sentry.unlock();
-#endif  // R__USE_IMT
          // NOTE this is declared with C linkage, so it shouldn't except.  Also, when
          // USE_IMT is defined, we are guaranteed that the compression buffer is unique per-branch.
          // (see fCompressedBufferRef in constructor).
          R__zipMultipleAlgorithm(cxlevel, &bufmax, objbuf, &bufmax, bufcur, &nout, cxAlgorithm);
-#ifdef R__USE_IMT
-         sentry.lock();
-#endif  // R__USE_IMT
 
          // test if buffer has really been compressed. In case of small buffers
          // when the buffer contains random data, it may happen that the compressed
@@ -1255,37 +1297,93 @@ Int_t TBasket::WriteBuffer()
             // We used to delete fBuffer here, we no longer want to since
             // the buffer (held by fCompressedBufferRef) might be re-used later.
             fBuffer = fBufferRef->Buffer();
-            Create(fObjlen,file);
-            fBufferRef->SetBufferOffset(0);
-
-            Streamer(*fBufferRef);         //write key itself again
             if ((nout+fKeylen)>buflen) {
                Warning("WriteBuffer","Possible memory corruption due to compression algorithm, wrote %d bytes past the end of a block of %d bytes. fNbytes=%d, fObjLen=%d, fKeylen=%d",
-                  (nout+fKeylen-buflen),buflen,fNbytes,fObjlen,fKeylen);
+                  (nout+fKeylen-buflen),buflen,nout+fKeylen,fObjlen,fKeylen);
             }
-            goto WriteFile;
+            fCompressedLen = nout;
+            return fCompressedLen;
          }
          bufcur += nout;
          noutot += nout;
          objbuf += kMAXZIPBUF;
          nzip   += kMAXZIPBUF;
       }
-      nout = noutot;
-      Create(noutot,file);
+      fCompressedLen = noutot;
+   } else {
+      fBuffer = fBufferRef->Buffer();
+      fCompressedLen = fObjlen;
+   }
+   return fCompressedLen;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write buffer of this basket on the current file.
+///
+/// The function returns the number of bytes committed to the memory.
+/// If a write error occurs, the number of bytes returned is -1.
+/// If no data are written, the number of bytes returned is 0.
+
+Int_t TBasket::WriteBuffer()
+{
+   constexpr Int_t kWrite = 1;
+
+   TFile *file = fBranch->GetFile(kWrite);
+   if (!file) return 0;
+   if (!file->IsWritable()) {
+      return -1;
+   }
+   fMotherDir = file; // fBranch->GetDirectory();
+
+   // The compression does not access the file: it is done before taking the lock below.
+   if (R__likely(!fBufferRef->TestBit(TBufferFile::kNotDecompressed)) && fCompressedLen < 0) {
+      if (CompressBuffer() < 0)
+         return -1;
+   }
+
+   // This mutex prevents multiple TBasket::WriteBuffer invocations from interacting
+   // with the underlying TFile at once - TFile is assumed to *not* be thread-safe.
+   //
+   // The only parallelism we'd like to exploit (right now!) is the compression
+   // step - everything else should be serialized at the TFile level.
+#ifdef R__USE_IMT
+   std::lock_guard<std::mutex> sentry(file->fWriteMutex);
+#endif  // R__USE_IMT
+
+   if (R__unlikely(fBufferRef->TestBit(TBufferFile::kNotDecompressed))) {
+      // Read the basket information that was saved inside the buffer.
+      Bool_t writing = fBufferRef->IsWriting();
+      fBufferRef->SetReadMode();
       fBufferRef->SetBufferOffset(0);
 
-      Streamer(*fBufferRef);         //write key itself again
-      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
-   } else {
+      Streamer(*fBufferRef);
+      if (writing) fBufferRef->SetWriteMode();
+      Int_t nout = fNbytes - fKeylen;
+
       fBuffer = fBufferRef->Buffer();
-      Create(fObjlen,file);
+
+      Create(nout,file);
       fBufferRef->SetBufferOffset(0);
+      fHeaderOnly = kTRUE;
 
       Streamer(*fBufferRef);         //write key itself again
-      nout = fObjlen;
+      int nBytes = WriteFileKeepBuffer();
+      fHeaderOnly = kFALSE;
+      return nBytes>0 ? fKeylen+nout : -1;
    }
 
-WriteFile:
+   const Int_t nout = fCompressedLen;
+   fCompressedLen = -1;
+
+   fHeaderOnly = kTRUE;
+   fCycle = fBranch->GetWriteBasket();
+   Create(nout,file);
+   fBufferRef->SetBufferOffset(0);
+
+   Streamer(*fBufferRef);         //write key itself again
+   if (fBuffer != fBufferRef->Buffer())
+      memcpy(fBuffer,fBufferRef->Buffer(),fKeylen);
+
    Int_t nBytes = WriteFileKeepBuffer();
    fHeaderOnly = kFALSE;
    return nBytes>0 ? fKeylen+nout : -1;
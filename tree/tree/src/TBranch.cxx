@@ -16,6 +16,7 @@
 #include "Bytes.h"
 #include "Compression.h"
 #include "TBasket.h"
+#include "TBranchElement.h"
 #include "TBranchBrowsable.h"
 #include "TBrowser.h"
 #include "TBuffer.h"
@@ -28,6 +29,7 @@
 #include "TLeafC.h"
 #include "TLeafD.h"
 #include "TLeafD32.h"
+#include "TLeafElement.h"
 #include "TLeafF.h"
 #include "TLeafF16.h"
 #include "TLeafI.h"
@@ -43,6 +45,7 @@
 #include "TTree.h"
 #include "TTreeCache.h"
 #include "TTreeCacheUnzip.h"
+#include "TVirtualCollectionProxy.h"
 #include "TVirtualMutex.h"
 #include "TVirtualPad.h"
 #include "TVirtualPerfStats.h"
@@ -57,6 +60,7 @@
 #include <cstddef>
 #include <cstring>
 #include <cstdio>
+#include <string>
 
 
 Int_t TBranch::fgCount = 0;
@@ -1493,7 +1497,7 @@ Int_t TBranch::GetBulkEntries(Long64_t entry, TBuffer &user_buf)
       // The basket was already in memory and might (and might not) be backed by persistent
       // storage.
       R__ASSERT(result == fReadBasket);
-      if (fBasketSeek[fReadBasket]) {
+      if (fBasketSeek[fReadBasket] && buf->TestBit(TBufferIO::kIsOwner)) {
          // It is backed, so we can be destructive
          user_buf.SetBuffer(buf->Buffer(), buf->BufferSize());
          buf->ResetBit(TBufferIO::kIsOwner);
@@ -1573,7 +1577,7 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
       // The basket was already in memory and might (and might not) be backed by persistent
       // storage.
       R__ASSERT(result == fReadBasket);
-      if (fBasketSeek[fReadBasket]) {
+      if (fBasketSeek[fReadBasket] && buf->TestBit(TBufferIO::kIsOwner)) {
          // It is backed, so we can be destructive
          user_buf.SetBuffer(buf->Buffer(), buf->BufferSize());
          buf->ResetBit(TBufferIO::kIsOwner);
@@ -1622,6 +1626,228 @@ Int_t TBranch::GetEntriesSerialized(Long64_t entry, TBuffer &user_buf, TBuffer *
    return N;
 }
 
+namespace {
+
+const UInt_t kByteCountMask = 0x40000000; // Set in the byte count that precedes a versioned object.
+
+/// The kinds of branches whose entries can be read in bulk as offsets plus contiguous values.
+enum class EJaggedBulkKind { kUnsupported, kLeafCountArray, kSTLVector, kSTLString };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the kind of jagged data stored by the branch, and the type of its values.
+
+EJaggedBulkKind GetJaggedBulkKind(TBranch &branch, EDataType &valueType)
+{
+   valueType = kOther_t;
+   if (branch.GetListOfLeaves()->GetEntriesFast() != 1)
+      return EJaggedBulkKind::kUnsupported;
+   TLeaf *leaf = static_cast<TLeaf *>(branch.GetListOfLeaves()->UncheckedAt(0));
+   TClass *cl = nullptr;
+
+   if (!dynamic_cast<TLeafElement *>(leaf)) {
+      // A variable-size array of a leaf list, e.g. "x[n]/F": an entry holds the values only.
+      const auto type = leaf->GetDeserializeType();
+      if (!leaf->GetLeafCount() ||
+          (type != TLeaf::DeserializeType::kInPlace && type != TLeaf::DeserializeType::kZeroCopy) ||
+          branch.GetExpectedType(cl, valueType))
+         return EJaggedBulkKind::kUnsupported;
+      return EJaggedBulkKind::kLeafCountArray;
+   }
+
+   // A std::vector of fundamental types or a std::string, either a top-level branch or a data member of a split
+   // object: an entry holds the object header, the size and the values.
+   auto &element = static_cast<TBranchElement &>(branch);
+   if (element.GetType() != 0 || element.GetListOfBranches()->GetEntriesFast() > 0 ||
+       branch.GetExpectedType(cl, valueType) || !cl)
+      return EJaggedBulkKind::kUnsupported;
+   if (cl == TClass::GetClass<std::string>()) {
+      valueType = kChar_t;
+      return EJaggedBulkKind::kSTLString;
+   }
+   auto proxy = cl->GetCollectionProxy();
+   if (!proxy || proxy->GetCollectionType() != ROOT::kSTLvector || proxy->GetValueClass())
+      return EJaggedBulkKind::kUnsupported;
+   valueType = proxy->GetType();
+   switch (valueType) {
+   case kChar_t:
+   case kUChar_t:
+   case kShort_t:
+   case kUShort_t:
+   case kInt_t:
+   case kUInt_t:
+   case kLong64_t:
+   case kULong64_t:
+   case kFloat_t:
+   case kDouble_t: return EJaggedBulkKind::kSTLVector;
+   default: return EJaggedBulkKind::kUnsupported;
+   }
+}
+
+} // anonymous namespace
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if the entries of this branch can be read with GetBulkEntriesJagged,
+/// false otherwise.
+///
+/// This is the case for variable-size arrays of a leaf list (e.g. "x[n]/F"),
+/// std::vector of fundamental types and std::string, both as top-level branches
+/// and as data members of a split object.
+
+Bool_t TBranch::SupportsJaggedBulkRead() const
+{
+   EDataType valueType;
+   return GetJaggedBulkKind(const_cast<TBranch &>(*this), valueType) != EJaggedBulkKind::kUnsupported;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read as many events of a branch holding variable-size entries as possible
+/// into the given buffer, see SupportsJaggedBulkRead for the supported types.
+///
+/// Returns -1 in case of a failure.  On success, returns the (non-zero) number
+/// of events N currently in the buffer.
+///
+/// On success, the values of all events are stored contiguously, in host byte
+/// order, at static_cast<T*>(buf.GetCurrent()), where T is the type of the
+/// values (char for std::string).  `offsets` holds N+1 elements: the values of
+/// event `entry + i` are the ones in [offsets[i], offsets[i+1]).
+///
+/// As for GetBulkEntries, the values are deserialized in place, without calling
+/// the streamers, and `entry` must be the first entry of a basket.
+
+Int_t TBranch::GetBulkEntriesJagged(Long64_t entry, TBuffer &user_buf, std::vector<Int_t> &offsets)
+{
+   EDataType valueType;
+   const auto kind = GetJaggedBulkKind(*this, valueType);
+   if (R__unlikely(kind == EJaggedBulkKind::kUnsupported)) return -1;
+   const Int_t valueSize = TDataType::GetDataType(valueType)->Size();
+
+   // Remember which entry we are reading.
+   fReadEntry = entry;
+
+   Bool_t enabled = !TestBit(kDoNotProcess);
+   if (R__unlikely(!enabled)) return -1;
+   TBasket *basket = nullptr;
+   Long64_t first;
+   Int_t result = GetBasketAndFirst(basket, first, &user_buf);
+   if (R__unlikely(result < 0)) return -1;
+   // Only support reading from full clusters.
+   if (R__unlikely(entry != first)) {
+      Error("GetBulkEntriesJagged", "Failed to read from full cluster; first entry is %lld; requested entry is %lld.\n", first, entry);
+      return -1;
+   }
+
+   basket->PrepareBasket(entry);
+   TBuffer* buf = basket->GetBufferRef();
+
+   // Test for very old ROOT files.
+   if (R__unlikely(!buf)) {
+      Error("GetBulkEntriesJagged", "Failed to get a new buffer.\n");
+      return -1;
+   }
+   // Test for displacements, which aren't supported in fast mode.
+   if (R__unlikely(basket->GetDisplacement())) {
+      Error("GetBulkEntriesJagged", "Basket has displacement.\n");
+      return -1;
+   }
+   const Int_t *entryOffset = basket->GetEntryOffset();
+   if (R__unlikely(!entryOffset)) {
+      Error("GetBulkEntriesJagged", "Basket has no entry offsets.\n");
+      return -1;
+   }
+   // The end of the data: baskets read from the file record it, baskets being filled did not yet.
+   const Int_t last = fBasketSeek[result] ? basket->GetLast() : buf->Length();
+
+   if (&user_buf != buf) {
+      // The basket was already in memory and might (and might not) be backed by persistent
+      // storage.
+      R__ASSERT(result == fReadBasket);
+      if (fBasketSeek[fReadBasket] && buf->TestBit(TBufferIO::kIsOwner)) {
+         // It is backed, so we can be destructive
+         user_buf.SetBuffer(buf->Buffer(), buf->BufferSize());
+         buf->ResetBit(TBufferIO::kIsOwner);
+         fCurrentBasket = nullptr;
+         fBaskets[fReadBasket] = nullptr;
+      } else {
+         // This is the only copy, we can't return it as is to the user, just make a copy.
+         if (user_buf.BufferSize() < buf->BufferSize()) {
+            user_buf.AutoExpand(buf->BufferSize());
+         }
+         memcpy(user_buf.Buffer(), buf->Buffer(), buf->BufferSize());
+      }
+   }
+
+   Int_t bufbegin = basket->GetKeylen();
+   Int_t N = ((fNextBasketEntry < 0) ? fEntryNumber : fNextBasketEntry) - first;
+
+   // Move the values of all events next to each other, dropping the per-event headers and sizes. The values never
+   // move towards the end of the buffer, so this can be done in place.
+   char *data = user_buf.Buffer();
+   char *values = data + bufbegin;
+   Int_t nValues = 0;
+   offsets.resize(N + 1);
+   offsets[0] = 0;
+   for (Int_t i = 0; i < N; ++i) {
+      char *cursor = data + entryOffset[i];
+      char *end = data + ((i + 1 < N) ? entryOffset[i + 1] : last);
+      Int_t n = 0;
+      if (kind == EJaggedBulkKind::kLeafCountArray) {
+         n = (end - cursor) / valueSize;
+      } else {
+         if (end - cursor >= 6) {
+            // Skip the byte count and version of the object, if any.
+            char *header = cursor;
+            UInt_t byteCount;
+            frombuf(header, &byteCount);
+            if ((byteCount & kByteCountMask) && (byteCount & ~kByteCountMask) == UInt_t(end - cursor - 4))
+               cursor += 6;
+         }
+         if (kind == EJaggedBulkKind::kSTLVector) {
+            if (R__likely(end - cursor >= 4))
+               frombuf(cursor, &n);
+            else
+               n = -1;
+         } else if (R__likely(end - cursor >= 1)) {
+            // Same encoding as TBuffer::WriteStdString
+            UChar_t len;
+            frombuf(cursor, &len);
+            n = len;
+            if (len == 255) {
+               if (R__likely(end - cursor >= 4))
+                  frombuf(cursor, &n);
+               else
+                  n = -1;
+            }
+         } else {
+            n = -1;
+         }
+      }
+      if (R__unlikely(n < 0 || cursor + Long64_t(n) * valueSize != end)) {
+         Error("GetBulkEntriesJagged", "Unexpected layout of entry %lld.\n", first + i);
+         return -1;
+      }
+      char *target = values + Long64_t(nValues) * valueSize;
+      if (target != cursor)
+         memmove(target, cursor, Long64_t(n) * valueSize);
+      nValues += n;
+      offsets[i + 1] = nValues;
+   }
+
+   user_buf.SetBufferOffset(bufbegin);
+   if (valueSize > 1 && R__unlikely(!user_buf.ByteSwapBuffer(nValues, valueType))) {
+      Error("GetBulkEntriesJagged", "Failed to byte-swap the values.\n");
+      return -1;
+   }
+   user_buf.SetBufferOffset(bufbegin);
+
+   if (fCurrentBasket == nullptr) {
+      R__ASSERT(fExtraBasket == nullptr && "fExtraBasket should have been set to nullptr by GetFreshBasket");
+      fExtraBasket = basket;
+      basket->DisownBuffer();
+   }
+
+   return N;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Read all leaves of entry and return total number of bytes read.
 ///
@@ -3182,7 +3408,10 @@ Int_t TBranch::WriteBasketImpl(TBasket* basket, Int_t where, ROOT::Internal::TBr
       }
       return nout;
    };
-   if (imtHelper) {
+   if (imtHelper && imtHelper->IsQueueing()) {
+      imtHelper->Queue(basket, doUpdates);
+      return 0;
+   } else if (imtHelper) {
       imtHelper->Run(doUpdates);
       return 0;
    } else {
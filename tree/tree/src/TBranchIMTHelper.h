@@ -14,12 +14,21 @@
 
 #include "RtypesCore.h"
 
+#include <functional>
+#include <utility>
+#include <vector>
+
 #ifdef R__USE_IMT
 #include "ROOT/TTaskGroup.hxx"
 #endif
 
+class TBasket;
+
 /** \class ROOT::Internal::TBranchIMTHelper
  A helper class for managing IMT work during TTree:Fill operations.
+
+ In queueing mode, the writes of the full baskets are not run but queued, to be
+ run later in a given order (see TTree::SetImplicitMTFillThreshold).
 */
 
 namespace ROOT {
@@ -32,6 +41,8 @@ using TaskGroup_t = ROOT::Experimental::TTaskGroup;
 #endif
 
 public:
+   using QueuedWrite_t = std::pair<TBasket *, std::function<Int_t()>>;
+
    template<typename FN> void Run(const FN &lambda) {
 #ifdef R__USE_IMT
       if (!fGroup) { fGroup.reset(new TaskGroup_t()); }
@@ -57,7 +68,14 @@ public:
    Long64_t GetNbytes() { return fBytes; }
    Long64_t GetNerrors() {  return fNerrors; }
 
+   Bool_t IsQueueing() const { return fQueueing; }
+   void SetQueueing(Bool_t queueing) { fQueueing = queueing; }
+   template<typename FN> void Queue(TBasket *basket, const FN &write) { fQueue.emplace_back(basket, write); }
+   std::vector<QueuedWrite_t> &GetQueue() { return fQueue; }
+
 private:
+   Bool_t                fQueueing{kFALSE}; ///< True if the writes are queued rather than run.
+   std::vector<QueuedWrite_t> fQueue;       ///< Writes of the full baskets, in the order they were queued.
    std::atomic<Long64_t> fBytes{0};   ///< Total number of bytes written by this helper.
    std::atomic<Int_t>    fNerrors{0}; ///< Total error count of all tasks done by this helper.
 #ifdef R__USE_IMT
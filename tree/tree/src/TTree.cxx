@@ -975,6 +975,10 @@ TTree::~TTree()
    // FIXME: We must consider what to do with the reset of these if we are a clone.
    delete fPlayer;
    fPlayer = 0;
+#ifdef R__USE_IMT
+   delete fFillExecutor;
+   fFillExecutor = nullptr;
+#endif
    if (fExternalFriends) {
       using namespace ROOT::Detail;
       for(auto fetree : TRangeStaticCast<TFriendElement>(*fExternalFriends))
@@ -4569,6 +4573,10 @@ void TTree::DropBuffers(Int_t)
 /// \note This method calls `TTree::ChangeFile` when the tree reaches a size
 ///       greater than `TTree::fgMaxTreeSize`. This doesn't happen if the tree is
 ///       attached to a `TMemFile` or derivate.
+///
+/// \note When implicit multi-threading is enabled and the tree has at least
+///       as many top-level branches as set with SetImplicitMTFillThreshold,
+///       the branches are serialized in parallel tasks.
 
 Int_t TTree::Fill()
 {
@@ -4585,6 +4593,9 @@ Int_t TTree::Fill()
    if (fBranchRef)
       fBranchRef->Clear();
 
+   // The bytes written by each branch, if the branches were filled in parallel.
+   std::vector<Int_t> parNwrite;
+
 #ifdef R__USE_IMT
    const auto useIMT = ROOT::IsImplicitMTEnabled() && fIMTEnabled;
    ROOT::Internal::TBranchIMTHelper imtHelper;
@@ -4592,6 +4603,9 @@ Int_t TTree::Fill()
       fIMTFlush = true;
       fIMTZipBytes.store(0);
       fIMTTotBytes.store(0);
+      // The first entry is filled sequentially, as it initializes the streaming of the branches.
+      if (fIMTFillThreshold > 0 && nbranches >= fIMTFillThreshold && !fBranchRef && fEntries > 0)
+         parNwrite = FillBranchesParallel();
    }
 #endif
 
@@ -4602,11 +4616,15 @@ Int_t TTree::Fill()
       if (branch->TestBit(kDoNotProcess))
          continue;
 
+      if (!parNwrite.empty()) {
+         nwrite = parNwrite[i];
+      } else {
 #ifndef R__USE_IMT
-      nwrite = branch->FillImpl(nullptr);
+         nwrite = branch->FillImpl(nullptr);
 #else
-      nwrite = branch->FillImpl(useIMT ? &imtHelper : nullptr);
+         nwrite = branch->FillImpl(useIMT ? &imtHelper : nullptr);
 #endif
+      }
       if (nwrite < 0) {
          if (nerror < 2) {
             Error("Fill", "Failed filling branch:%s.%s, nbytes=%d, entry=%lld\n"
@@ -5056,6 +5074,25 @@ struct BoolRAIIToggle {
    BoolRAIIToggle(Bool_t &val) : m_val(val) { m_val = true; }
    ~BoolRAIIToggle() { m_val = false; }
 };
+
+/// Collect the baskets of a branch and of its sub-branches that TBranch::FlushBaskets writes.
+void CollectBasketsToFlush(TBranch *branch, std::vector<TBasket *> &baskets)
+{
+   if (branch->GetDirectory()) {
+      TObjArray *list = branch->GetListOfBaskets();
+      const Int_t maxbasket = std::min(branch->GetWriteBasket() + 1, list->GetEntriesFast());
+      for (Int_t i = 0; i < maxbasket; ++i) {
+         auto basket = static_cast<TBasket *>(list->UncheckedAt(i));
+         if (basket && basket->GetNevBuf() && !branch->GetBasketSeek(i) && !basket->GetBufferRef()->IsReading())
+            baskets.push_back(basket);
+      }
+   }
+   TObjArray *subBranches = branch->GetListOfBranches();
+   for (Int_t i = 0; i < subBranches->GetEntriesFast(); ++i) {
+      if (auto subBranch = static_cast<TBranch *>(subBranches->UncheckedAt(i)))
+         CollectBasketsToFlush(subBranch, baskets);
+   }
+}
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -5117,7 +5154,21 @@ Int_t TTree::FlushBasketsImpl() const
 
 #ifdef R__USE_IMT
    const auto useIMT = ROOT::IsImplicitMTEnabled() && fIMTEnabled;
-   if (useIMT) {
+   if (useIMT && fIMTFillThreshold > 0 && nb >= fIMTFillThreshold) {
+      // As for a parallel Fill, the baskets are compressed in parallel but written below in the order of a
+      // sequential flush, so that the layout of the file does not depend on the scheduling of the tasks.
+      std::vector<TBasket *> baskets;
+      for (Int_t j = 0; j < nb; ++j) {
+         if (auto branch = static_cast<TBranch *>(lb->UncheckedAt(j)))
+            CollectBasketsToFlush(branch, baskets);
+      }
+      if (baskets.size() > 1) {
+         if (!fFillExecutor)
+            const_cast<TTree *>(this)->fFillExecutor = new ROOT::TThreadExecutor();
+         fFillExecutor->Foreach([&baskets](unsigned j) { baskets[j]->CompressBuffer(); },
+                                ROOT::TSeq<unsigned>(unsigned(baskets.size())));
+      }
+   } else if (useIMT) {
       // ROOT-9668: here we need to check if the size of fSortedBranches is different from the
       // size of the list of branches before triggering the initialisation of the fSortedBranches
       // container to cover two cases:
@@ -5817,6 +5868,98 @@ void TTree::SortBranchesByTime()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Divides the top-level branches into the ones filled sequentially and the
+/// ones filled in parallel by Fill. The branches holding the count of an array
+/// stored in another top-level branch are filled first and sequentially, since
+/// filling the array reads the maximum value of its count.
+
+void TTree::InitializeFillBranchLists()
+{
+   Int_t nbranches = fBranches.GetEntriesFast();
+   std::vector<bool> isSeq(nbranches, false);
+   TObjArray *leaves = GetListOfLeaves();
+   Int_t nleaves = leaves->GetEntriesFast();
+   for (Int_t i = 0; i < nleaves; ++i) {
+      TLeaf *leaf = (TLeaf *)leaves->UncheckedAt(i);
+      TLeaf *leafCount = leaf->GetLeafCount();
+      if (!leafCount)
+         continue;
+      TBranch *countBranch = leafCount->GetBranch()->GetMother();
+      if (countBranch != leaf->GetBranch()->GetMother()) {
+         Int_t index = fBranches.IndexOf(countBranch);
+         if (index >= 0)
+            isSeq[index] = true;
+      }
+   }
+
+   fSeqFillBranches.clear();
+   fParFillBranches.clear();
+   for (Int_t i = 0; i < nbranches; ++i) {
+      if (isSeq[i])
+         fSeqFillBranches.push_back(i);
+      else
+         fParFillBranches.push_back(i);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the top-level branches in parallel tasks, see SetImplicitMTFillThreshold.
+/// Returns the number of bytes written by each branch, -1 on error.
+///
+/// The tasks only serialize the entry into the baskets: the writes of the full
+/// baskets are queued. The queued baskets are then compressed in parallel and
+/// written by the calling thread in the order of a sequential fill, so that the
+/// layout of the file does not depend on the scheduling of the tasks.
+
+std::vector<Int_t> TTree::FillBranchesParallel()
+{
+   Int_t nbranches = fBranches.GetEntriesFast();
+   std::vector<Int_t> nwrite(nbranches, 0);
+#ifdef R__USE_IMT
+   if (fSeqFillBranches.size() + fParFillBranches.size() != unsigned(nbranches))
+      InitializeFillBranchLists();
+   if (!fFillExecutor)
+      fFillExecutor = new ROOT::TThreadExecutor();
+
+   std::vector<ROOT::Internal::TBranchIMTHelper> queues(nbranches);
+   auto fillBranch = [this, &nwrite, &queues](Int_t i) {
+      TBranch *branch = (TBranch *)fBranches.UncheckedAt(i);
+      if (!branch->TestBit(kDoNotProcess)) {
+         queues[i].SetQueueing(kTRUE);
+         nwrite[i] = branch->FillImpl(&queues[i]);
+      }
+   };
+
+   for (auto i : fSeqFillBranches)
+      fillBranch(i);
+
+   const unsigned npar = fParFillBranches.size();
+   const unsigned nchunks = std::min(npar, 4 * fFillExecutor->GetPoolSize());
+   fFillExecutor->Foreach([this, &fillBranch](unsigned j) { fillBranch(fParFillBranches[j]); },
+                          ROOT::TSeq<unsigned>(npar), nchunks);
+
+   std::vector<TBasket *> fullBaskets;
+   for (auto &queue : queues) {
+      for (auto &write : queue.GetQueue())
+         fullBaskets.push_back(write.first);
+   }
+   if (fullBaskets.empty())
+      return nwrite;
+   if (fullBaskets.size() > 1) {
+      fFillExecutor->Foreach([&fullBaskets](unsigned j) { fullBaskets[j]->CompressBuffer(); },
+                             ROOT::TSeq<unsigned>(unsigned(fullBaskets.size())));
+   }
+   for (Int_t i = 0; i < nbranches; ++i) {
+      for (auto &write : queues[i].GetQueue()) {
+         if (write.second() < 0)
+            nwrite[i] = -1;
+      }
+   }
+#endif
+   return nwrite;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Returns the entry list assigned to this tree
 
@@ -9093,6 +9236,23 @@ ROOT::TIOFeatures TTree::SetIOFeatures(const ROOT::TIOFeatures &features)
    return newSettings;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the minimum number of top-level branches for which TTree::Fill
+/// serializes the branches in parallel when implicit multi-threading is
+/// enabled. Each task then serializes the entry into the baskets of a group
+/// of branches. The full baskets are compressed in parallel and written in
+/// the same order as by a sequential fill, so the file layout is unchanged.
+/// A value of 0 (the default) disables this mode: only the compression of
+/// the full baskets is then done in parallel.
+///
+/// The first entry and the trees containing references (TRef) are always
+/// filled sequentially.
+
+void TTree::SetImplicitMTFillThreshold(Int_t nbranches)
+{
+   fIMTFillThreshold = nbranches;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set fFileNumber to number.
 /// fFileNumber is used by TTree::Fill to set the file name
@@ -20,6 +20,7 @@
 - [General Description](\ref description)
 - [Changes in behaviour](\ref changesbehaviour)
 - [Self-optimization](\ref cachemisses)
+- [Persisting the learning phase](\ref training)
 - [Examples of usage](\ref examples)
 - [Check performance and stats](\ref checkPerf)
 
@@ -129,6 +130,26 @@ Additionally, on the first miss of an event, we must iterate through all the
 This can be potentially a CPU-expensive operation compared to, e.g., the
 latency of a SSD.  This is why the miss cache is currently disabled by default.
 
+\anchor training
+## Persisting the learning phase across jobs
+
+During the learning phase the branches which are read are not yet in the
+cache, and are read with many small requests. When the same analysis runs over
+many files, e.g. in many batch jobs, this cost is paid again for each file.
+The branches learnt by a job can instead be stored in a training file, so that
+the following jobs start with a trained cache and skip the learning phase:
+~~~ {.cpp}
+TTreeCache::SetTrainingFile("/shared/myAnalysis.cachetraining", "myAnalysis-v3");
+~~~
+or, equivalently, by setting `TTreeCache.Training` (or the environment variable
+`ROOT_TTREECACHE_TRAINING`) and `TTreeCache.TrainingAnalysis` in the rootrc file.
+The trainings are keyed by the name of the tree and a hash of the analysis
+identifier, which must change when the set of branches read by the analysis
+changes. The training is saved when a learning phase ends (see SaveTraining),
+and looked up when the cache learns its first branch (see LoadTraining).
+Branches which are read but were not part of the training are not cached:
+use a different analysis identifier to start learning again.
+
 \anchor examples
 ## Example usages of TTreeCache
 
@@ -300,8 +321,23 @@ myTreeOrChain.GetTree()->PrintCacheStats();
 #include "TBranchCacheInfo.h"
 #include "TVirtualPerfStats.h"
 #include <limits.h>
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 Int_t TTreeCache::fgLearnEntries = 100;
+TString TTreeCache::fgTrainingFile;
+TString TTreeCache::fgTrainingAnalysis;
 
 ClassImp(TTreeCache);
 
@@ -358,7 +394,18 @@ Int_t TTreeCache::LearnBranch(TBranch *b, Bool_t subbranches /*= kFALSE*/)
    // the expected TTree), then prefill the cache.  (We expect that in future
    // release the Prefill-ing will be the default so we test for that inside the
    // LearnPrefill call).
-   if (!fLearnPrefilling && fNbranches == 0) LearnPrefill();
+   if (!fLearnPrefilling && fNbranches == 0) {
+      // Start from the branches learnt by a previous job, if any were persisted.
+      if (!fTrainingChecked) {
+         fTrainingChecked = kTRUE;
+         if (LoadTraining() > 0) {
+            Int_t res = AddBranch(b, subbranches);
+            StopLearningPhase();
+            return res;
+         }
+      }
+      LearnPrefill();
+   }
 
    return AddBranch(b, subbranches);
 }
@@ -1777,6 +1824,10 @@ Bool_t TTreeCache::FillBuffer()
          fFirstTime = kFALSE;
       }
    }
+   if (fIsLearning && !fIsManual && !fLearnPrefilling) {
+      // The learning phase ends: persist its outcome for the next jobs, if requested.
+      SaveTraining();
+   }
    fIsLearning = kFALSE;
    return kTRUE;
 }
@@ -1863,6 +1914,32 @@ Int_t TTreeCache::GetLearnEntries()
    return fgLearnEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning the file where the learnt branches are persisted,
+/// see SetTrainingFile. Returns an empty string if the training is not persisted.
+
+const char *TTreeCache::GetTrainingFile()
+{
+   if (!fgTrainingFile.IsNull())
+      return fgTrainingFile.Data();
+   const char *stcp = gSystem->Getenv("ROOT_TTREECACHE_TRAINING");
+   if (stcp && *stcp)
+      return stcp;
+   return gEnv->GetValue("TTreeCache.Training", "");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key of the persisted training of this cache: the name of the
+/// tree and a hash of the analysis identifier.
+
+TString TTreeCache::GetTrainingKey() const
+{
+   TString analysis = fgTrainingAnalysis;
+   if (analysis.IsNull())
+      analysis = gEnv->GetValue("TTreeCache.TrainingAnalysis", "");
+   return TString::Format("%s:%08x", fTree ? fTree->GetName() : "", analysis.Hash());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Print cache statistics. Like:
 ///
@@ -2148,6 +2225,210 @@ void TTreeCache::SetLearnPrefill(TTreeCache::EPrefillType type /* = kNoPrefill *
    fPrefillType = type;
 }
 
+namespace {
+/// The learnt branches of a tree for an analysis, as stored in a training file.
+struct TrainingRecord {
+   std::string fKey;
+   Int_t fPrefillType = 0;
+   std::vector<std::string> fBranchNames;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the records of a training file. Each record is a line
+/// `@ <prefill type> <number of branches> <key>` followed by one line per
+/// branch name. Returns false if the file is malformed.
+
+Bool_t ReadTrainingFile(const char *location, std::vector<TrainingRecord> &records)
+{
+   std::ifstream in(location);
+   std::string line;
+   while (std::getline(in, line)) {
+      if (line.empty() || line[0] == '#')
+         continue;
+      TrainingRecord record;
+      std::size_t nBranches = 0;
+      int nChars = 0;
+      if (sscanf(line.c_str(), "@ %d %zu %n", &record.fPrefillType, &nBranches, &nChars) != 2 || nChars == 0)
+         return kFALSE;
+      record.fKey = line.substr(nChars);
+      for (std::size_t i = 0; i < nBranches; ++i) {
+         if (!std::getline(in, line))
+            return kFALSE;
+         record.fBranchNames.emplace_back(line);
+      }
+      records.emplace_back(std::move(record));
+   }
+   return kTRUE;
+}
+
+/// Advisory lock serializing the updates of a training file across threads and
+/// processes, held on `<location>.lock` for the lifetime of the object.
+/// Without flock (Windows) the updates are not serialized.
+class TrainingFileLock {
+   int fFd = -1;
+
+public:
+   explicit TrainingFileLock(const char *location)
+   {
+#ifndef WIN32
+      const TString lockName = TString::Format("%s.lock", location);
+      fFd = open(lockName.Data(), O_RDWR | O_CREAT, 0644);
+      if (fFd >= 0 && flock(fFd, LOCK_EX) != 0) {
+         close(fFd);
+         fFd = -1;
+      }
+#else
+      (void)location;
+#endif
+   }
+   ~TrainingFileLock()
+   {
+#ifndef WIN32
+      if (fFd >= 0) {
+         flock(fFd, LOCK_UN);
+         close(fFd);
+      }
+#endif
+   }
+   TrainingFileLock(const TrainingFileLock &) = delete;
+   TrainingFileLock &operator=(const TrainingFileLock &) = delete;
+#ifndef WIN32
+   bool IsLocked() const { return fFd >= 0; }
+#else
+   bool IsLocked() const { return true; }
+#endif
+};
+} // Anonymous namespace.
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the branches learnt by a previous job to the cache, and stop the
+/// learning phase. The branches are read from the given training file, or from
+/// the one configured with SetTrainingFile if location is null.
+/// Returns:
+///  - the number of branches added to the cache
+///  - 0 if no training was stored for this tree and analysis
+///  - -1 on error
+
+Int_t TTreeCache::LoadTraining(const char *location /* = nullptr */)
+{
+   if (!location)
+      location = GetTrainingFile();
+   if (!location || !*location || !fTree || !fTree->GetTree())
+      return 0;
+   if (gSystem->AccessPathName(location))
+      return 0; // Nothing learnt yet.
+
+   std::vector<TrainingRecord> records;
+   if (!ReadTrainingFile(location, records)) {
+      Error("LoadTraining", "The training file %s is malformed", location);
+      return -1;
+   }
+   const std::string key = GetTrainingKey().Data();
+   auto record = std::find_if(records.begin(), records.end(), [&key](const TrainingRecord &r) { return r.fKey == key; });
+   if (record == records.end())
+      return 0;
+
+   Int_t nAdded = 0;
+   TTree *tree = fTree->GetTree();
+   for (const auto &name : record->fBranchNames) {
+      TBranch *b = tree->GetBranch(name.c_str());
+      if (b && AddBranch(b, kFALSE) == 0)
+         ++nAdded;
+   }
+   if (nAdded > 0) {
+      fPrefillType = static_cast<EPrefillType>(record->fPrefillType);
+      StopLearningPhase();
+   }
+   if (gDebug > 0)
+      Info("LoadTraining", "Added %d branches learnt for %s from %s", nAdded, key.c_str(), location);
+   return nAdded;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the branches currently in the cache in the given training file, or in
+/// the one configured with SetTrainingFile if location is null, for use by the
+/// next jobs (see LoadTraining). The trainings stored for other trees or
+/// analyses are preserved. Concurrent updates, from threads or processes, are
+/// serialized by an advisory lock on `<location>.lock`, and the file is replaced
+/// atomically so that readers never see a partially written file. The file is
+/// not rewritten if it already holds the same training.
+/// Returns:
+///  - the number of branches stored
+///  - 0 if no training file is configured or the cache has no branches
+///  - -1 on error
+
+Int_t TTreeCache::SaveTraining(const char *location /* = nullptr */) const
+{
+   if (!location)
+      location = GetTrainingFile();
+   if (!location || !*location || !fTree || !fBrNames || fBrNames->GetEntries() == 0)
+      return 0;
+
+   TrainingFileLock lock(location);
+   if (!lock.IsLocked()) {
+      Error("SaveTraining", "Cannot lock the training file %s", location);
+      return -1;
+   }
+
+   std::vector<TrainingRecord> records;
+   if (!gSystem->AccessPathName(location) && !ReadTrainingFile(location, records)) {
+      Warning("SaveTraining", "The training file %s is malformed and will be overwritten", location);
+      records.clear();
+   }
+
+   TrainingRecord record;
+   record.fKey = GetTrainingKey().Data();
+   record.fPrefillType = fPrefillType;
+   TIter next(fBrNames);
+   while (auto os = static_cast<TObjString *>(next()))
+      record.fBranchNames.emplace_back(os->GetName());
+   const Int_t nBranches = record.fBranchNames.size();
+   auto existing = std::find_if(records.begin(), records.end(),
+                                [&record](const TrainingRecord &r) { return r.fKey == record.fKey; });
+   if (existing != records.end()) {
+      if (existing->fPrefillType == record.fPrefillType && existing->fBranchNames == record.fBranchNames)
+         return nBranches; // Already stored, nothing to rewrite.
+      *existing = std::move(record);
+   } else {
+      records.emplace_back(std::move(record));
+   }
+
+   // The name is unique per process and thread, so that no two writers share it.
+   const std::size_t threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+   TString tmpName = TString::Format("%s.%d.%zx.tmp", location, gSystem->GetPid(), threadId);
+   std::ofstream out(tmpName.Data());
+   out << "# TTreeCache training file, see TTreeCache::SetTrainingFile\n";
+   for (const auto &r : records) {
+      out << "@ " << r.fPrefillType << ' ' << r.fBranchNames.size() << ' ' << r.fKey << '\n';
+      for (const auto &name : r.fBranchNames)
+         out << name << '\n';
+   }
+   out.close();
+   if (!out || gSystem->Rename(tmpName, location)) {
+      Error("SaveTraining", "Cannot write the training file %s", location);
+      gSystem->Unlink(tmpName);
+      return -1;
+   }
+   return nBranches;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function to persist the branches learnt by the caches in a training
+/// file, so that later jobs start with a trained cache instead of going through
+/// a learning phase, see LoadTraining and SaveTraining.
+/// The trainings are keyed by tree name and by a hash of `analysis`, an
+/// identifier of the analysis (e.g. its name and version) that must change when
+/// the set of branches it reads changes.
+/// If location or analysis are empty, the values of TTreeCache.Training (or of
+/// the environment variable ROOT_TTREECACHE_TRAINING) and of
+/// TTreeCache.TrainingAnalysis are used. By default no training is persisted.
+
+void TTreeCache::SetTrainingFile(const char *location, const char *analysis /* = "" */)
+{
+   fgTrainingFile = location ? location : "";
+   fgTrainingAnalysis = analysis ? analysis : "";
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The name should be enough to explain the method.
 /// The only additional comments is that the cache is cleaned before
@@ -0,0 +1,124 @@
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class BulkApiJaggedTest : public ::testing::Test {
+public:
+   static constexpr Long64_t fEventCount = 20000;
+   const std::string fFileName = "BulkApiJagged.root";
+
+protected:
+   void SetUp() override
+   {
+      TFile f(fFileName.c_str(), "RECREATE");
+      TTree t("T", "A tree of variable-length branches.");
+      int n = 0;
+      float arr[10];
+      std::vector<float> vf;
+      std::vector<Long64_t> vl;
+      std::string s;
+      t.Branch("n", &n, "n/I");
+      t.Branch("arr", arr, "arr[n]/F");
+      t.Branch("vf", &vf);
+      t.Branch("vl", &vl);
+      t.Branch("s", &s);
+      for (Long64_t ev = 0; ev < fEventCount; ++ev) {
+         n = ev % 10;
+         vf.clear();
+         vl.clear();
+         for (int i = 0; i < n; ++i) {
+            arr[i] = ev + i;
+            vf.push_back(ev - i);
+            vl.push_back(ev * 1000 + i);
+         }
+         // also exercise the long string encoding
+         s = std::string(ev % 300, 'a' + ev % 26);
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   void TearDown() override { gSystem->Unlink(fFileName.c_str()); }
+
+   // Read all the entries of a branch in bulk, and check them with the provided function.
+   template <typename T, typename F>
+   void ReadJagged(const char *branchName, F &&check)
+   {
+      std::unique_ptr<TFile> f(TFile::Open(fFileName.c_str()));
+      auto t = f->Get<TTree>("T");
+      ASSERT_NE(t, nullptr);
+      auto branch = t->GetBranch(branchName);
+      ASSERT_NE(branch, nullptr);
+      ASSERT_TRUE(branch->GetBulkRead().SupportsJaggedBulkRead());
+
+      TBufferFile buf(TBuffer::kWrite, 32 * 1024);
+      std::vector<Int_t> offsets;
+      Long64_t entry = 0;
+      while (entry < fEventCount) {
+         auto count = branch->GetBulkRead().GetBulkEntriesJagged(entry, buf, offsets);
+         ASSERT_GT(count, 0);
+         ASSERT_EQ(offsets.size(), std::size_t(count + 1));
+         auto values = reinterpret_cast<T *>(buf.GetCurrent());
+         for (Int_t i = 0; i < count; ++i)
+            check(entry + i, values + offsets[i], offsets[i + 1] - offsets[i]);
+         entry += count;
+      }
+      EXPECT_EQ(entry, fEventCount);
+   }
+};
+
+constexpr Long64_t BulkApiJaggedTest::fEventCount;
+
+TEST_F(BulkApiJaggedTest, LeafCountArray)
+{
+   ReadJagged<float>("arr", [](Long64_t ev, const float *values, Int_t size) {
+      ASSERT_EQ(size, ev % 10);
+      for (Int_t i = 0; i < size; ++i)
+         ASSERT_FLOAT_EQ(values[i], ev + i);
+   });
+}
+
+TEST_F(BulkApiJaggedTest, VectorFloat)
+{
+   ReadJagged<float>("vf", [](Long64_t ev, const float *values, Int_t size) {
+      ASSERT_EQ(size, ev % 10);
+      for (Int_t i = 0; i < size; ++i)
+         ASSERT_FLOAT_EQ(values[i], ev - i);
+   });
+}
+
+TEST_F(BulkApiJaggedTest, VectorLong64)
+{
+   ReadJagged<Long64_t>("vl", [](Long64_t ev, const Long64_t *values, Int_t size) {
+      ASSERT_EQ(size, ev % 10);
+      for (Int_t i = 0; i < size; ++i)
+         ASSERT_EQ(values[i], ev * 1000 + i);
+   });
+}
+
+TEST_F(BulkApiJaggedTest, String)
+{
+   ReadJagged<char>("s", [](Long64_t ev, const char *values, Int_t size) {
+      ASSERT_EQ(std::string(values, size), std::string(ev % 300, 'a' + ev % 26));
+   });
+}
+
+TEST_F(BulkApiJaggedTest, Unsupported)
+{
+   std::unique_ptr<TFile> f(TFile::Open(fFileName.c_str()));
+   auto t = f->Get<TTree>("T");
+   ASSERT_NE(t, nullptr);
+   auto branch = t->GetBranch("n");
+   EXPECT_FALSE(branch->GetBulkRead().SupportsJaggedBulkRead());
+   TBufferFile buf(TBuffer::kWrite, 32 * 1024);
+   std::vector<Int_t> offsets;
+   EXPECT_EQ(branch->GetBulkRead().GetBulkEntriesJagged(0, buf, offsets), -1);
+}
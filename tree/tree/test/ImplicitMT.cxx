@@ -1,8 +1,12 @@
+#include "TBranch.h"
 #include "TFile.h"
 #include "TROOT.h"
 #include "TSystem.h"
 #include "TTree.h"
 
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #ifdef R__USE_IMT
@@ -28,4 +32,104 @@ TEST(TTreeImplicitMT, flushBaskets)
    gSystem->Unlink(ofileName);
 }
 
+const int kWideTreeBranches = 32;
+const int kWideTreeEntries = 20000;
+
+// Write a tree with many branches, serializing them in parallel or not.
+void WriteWideTree(const char *fileName, bool parallel)
+{
+   TFile f(fileName, "RECREATE");
+   TTree t("t", "t");
+   if (parallel) {
+      t.SetImplicitMTFillThreshold(8);
+      EXPECT_EQ(8, t.GetImplicitMTFillThreshold());
+   } else {
+      t.SetImplicitMT(false);
+   }
+   t.SetAutoFlush(3000);
+   std::vector<double> values(kWideTreeBranches);
+   int n = 0;
+   float arr[10];
+   for (int b = 0; b < kWideTreeBranches; ++b)
+      t.Branch(("b" + std::to_string(b)).c_str(), &values[b], 4000);
+   // The count and the array are in different top-level branches.
+   t.Branch("n", &n);
+   t.Branch("arr", arr, "arr[n]/F");
+   for (int e = 0; e < kWideTreeEntries; ++e) {
+      for (int b = 0; b < kWideTreeBranches; ++b)
+         values[b] = e * kWideTreeBranches + b;
+      n = e % 10;
+      for (int i = 0; i < n; ++i)
+         arr[i] = e + i;
+      EXPECT_GT(t.Fill(), 0);
+   }
+   t.Write();
+}
+
+TEST(TTreeImplicitMT, parallelFill)
+{
+   ROOT::EnableImplicitMT();
+   const auto ofileName = "parallelFillMT.root";
+   WriteWideTree(ofileName, true);
+
+   TFile f(ofileName);
+   auto t = f.Get<TTree>("t");
+   ASSERT_NE(nullptr, t);
+   EXPECT_EQ(kWideTreeEntries, t->GetEntries());
+   std::vector<double> values(kWideTreeBranches);
+   int n = 0;
+   float arr[10];
+   for (int b = 0; b < kWideTreeBranches; ++b)
+      t->SetBranchAddress(("b" + std::to_string(b)).c_str(), &values[b]);
+   t->SetBranchAddress("n", &n);
+   t->SetBranchAddress("arr", arr);
+   for (int e = 0; e < kWideTreeEntries; ++e) {
+      t->GetEntry(e);
+      for (int b = 0; b < kWideTreeBranches; ++b)
+         EXPECT_EQ(e * kWideTreeBranches + b, values[b]);
+      ASSERT_EQ(e % 10, n);
+      for (int i = 0; i < n; ++i)
+         EXPECT_EQ(e + i, arr[i]);
+   }
+   f.Close();
+   gSystem->Unlink(ofileName);
+}
+
+// The baskets written by a parallel fill are the same, and at the same place, as the ones of a sequential fill.
+TEST(TTreeImplicitMT, parallelFillLayout)
+{
+   ROOT::EnableImplicitMT();
+   // The file names have the same length, so that the baskets can be at the same offsets.
+   const auto seqFileName = "parallelFillSeq.root";
+   const auto parFileName = "parallelFillPar.root";
+   WriteWideTree(seqFileName, false);
+   WriteWideTree(parFileName, true);
+
+   TFile seqFile(seqFileName);
+   TFile parFile(parFileName);
+   auto seqTree = seqFile.Get<TTree>("t");
+   auto parTree = parFile.Get<TTree>("t");
+   ASSERT_NE(nullptr, seqTree);
+   ASSERT_NE(nullptr, parTree);
+   EXPECT_EQ(seqTree->GetZipBytes(), parTree->GetZipBytes());
+   EXPECT_EQ(seqTree->GetTotBytes(), parTree->GetTotBytes());
+   for (auto obj : *seqTree->GetListOfBranches()) {
+      auto seqBranch = static_cast<TBranch *>(obj);
+      auto parBranch = parTree->GetBranch(seqBranch->GetName());
+      ASSERT_NE(nullptr, parBranch);
+      const Int_t nbaskets = seqBranch->GetWriteBasket();
+      ASSERT_GT(nbaskets, 1) << seqBranch->GetName();
+      ASSERT_EQ(nbaskets, parBranch->GetWriteBasket()) << seqBranch->GetName();
+      for (Int_t i = 0; i < nbaskets; ++i) {
+         EXPECT_EQ(seqBranch->GetBasketSeek(i), parBranch->GetBasketSeek(i)) << seqBranch->GetName() << " " << i;
+         EXPECT_EQ(seqBranch->GetBasketBytes()[i], parBranch->GetBasketBytes()[i]) << seqBranch->GetName() << " " << i;
+         EXPECT_EQ(seqBranch->GetBasketEntry()[i], parBranch->GetBasketEntry()[i]) << seqBranch->GetName() << " " << i;
+      }
+   }
+   seqFile.Close();
+   parFile.Close();
+   gSystem->Unlink(seqFileName);
+   gSystem->Unlink(parFileName);
+}
+
 #endif // R__USE_IMT
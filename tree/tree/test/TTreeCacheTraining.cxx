@@ -0,0 +1,188 @@
+#include "TBranch.h"
+#include "TFile.h"
+#include "TObjArray.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCache.h"
+
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+class TTreeCacheTraining : public ::testing::Test {
+protected:
+   const char *fFileName = "ttreecache_training.root";
+   const char *fTrainingFileName = "ttreecache_training.txt";
+
+   void SetUp() override
+   {
+      TFile f(fFileName, "RECREATE");
+      TTree t("t", "t");
+      int x = 0, y = 0, z = 0;
+      t.Branch("x", &x);
+      t.Branch("y", &y);
+      t.Branch("z", &z);
+      // small clusters, so that baskets are read after the learning phase
+      t.SetAutoFlush(50);
+      for (int i = 0; i < 1000; ++i) {
+         x = y = z = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   void TearDown() override
+   {
+      TTreeCache::SetTrainingFile("", "");
+      gSystem->Unlink(fFileName);
+      gSystem->Unlink(fTrainingFileName);
+      gSystem->Unlink(TString::Format("%s.lock", fTrainingFileName));
+   }
+
+   // Read branches x and y of all the entries, checking whether the cache had to learn them.
+   void Run(bool expectLearning)
+   {
+      std::unique_ptr<TFile> f(TFile::Open(fFileName));
+      auto t = f->Get<TTree>("t");
+      ASSERT_NE(t, nullptr);
+      t->SetCacheSize(10000000);
+      t->SetBranchStatus("*", false);
+      t->SetBranchStatus("x", true);
+      t->SetBranchStatus("y", true);
+      auto cache = dynamic_cast<TTreeCache *>(f->GetCacheRead(t));
+      ASSERT_NE(cache, nullptr);
+      t->GetEntry(0);
+      EXPECT_EQ(cache->IsLearning(), expectLearning);
+      for (Long64_t i = 1; i < t->GetEntries(); ++i)
+         t->GetEntry(i);
+      EXPECT_FALSE(cache->IsLearning());
+      EXPECT_EQ(cache->GetCachedBranches()->GetEntries(), 2);
+   }
+};
+
+TEST_F(TTreeCacheTraining, SaveAndLoad)
+{
+   TTreeCache::SetTrainingFile(fTrainingFileName, "analysis-v1");
+   EXPECT_STREQ(TTreeCache::GetTrainingFile(), fTrainingFileName);
+
+   // the first job learns the branches and stores them
+   Run(/*expectLearning=*/true);
+   EXPECT_FALSE(gSystem->AccessPathName(fTrainingFileName));
+
+   // the following jobs start with a trained cache
+   Run(/*expectLearning=*/false);
+
+   // a different analysis learns again
+   TTreeCache::SetTrainingFile(fTrainingFileName, "analysis-v2");
+   Run(/*expectLearning=*/true);
+   TTreeCache::SetTrainingFile(fTrainingFileName, "analysis-v1");
+   Run(/*expectLearning=*/false);
+}
+
+TEST_F(TTreeCacheTraining, ExplicitLocation)
+{
+   std::unique_ptr<TFile> f(TFile::Open(fFileName));
+   auto t = f->Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   t->SetCacheSize(10000000);
+   t->AddBranchToCache("x");
+   t->AddBranchToCache("z");
+   auto cache = dynamic_cast<TTreeCache *>(f->GetCacheRead(t));
+   ASSERT_NE(cache, nullptr);
+   // no training file is configured
+   EXPECT_EQ(cache->SaveTraining(), 0);
+   EXPECT_EQ(cache->SaveTraining(fTrainingFileName), 2);
+
+   std::unique_ptr<TFile> f2(TFile::Open(fFileName));
+   auto t2 = f2->Get<TTree>("t");
+   ASSERT_NE(t2, nullptr);
+   t2->SetCacheSize(10000000);
+   auto cache2 = dynamic_cast<TTreeCache *>(f2->GetCacheRead(t2));
+   ASSERT_NE(cache2, nullptr);
+   EXPECT_EQ(cache2->LoadTraining("ttreecache_training_missing.txt"), 0);
+   EXPECT_TRUE(cache2->IsLearning());
+   EXPECT_EQ(cache2->LoadTraining(fTrainingFileName), 2);
+   EXPECT_FALSE(cache2->IsLearning());
+   EXPECT_EQ(cache2->GetCachedBranches()->GetEntries(), 2);
+}
+
+TEST_F(TTreeCacheTraining, UnchangedTrainingNotRewritten)
+{
+   std::unique_ptr<TFile> f(TFile::Open(fFileName));
+   auto t = f->Get<TTree>("t");
+   ASSERT_NE(t, nullptr);
+   t->SetCacheSize(10000000);
+   t->AddBranchToCache("x");
+   auto cache = dynamic_cast<TTreeCache *>(f->GetCacheRead(t));
+   ASSERT_NE(cache, nullptr);
+   EXPECT_EQ(cache->SaveTraining(fTrainingFileName), 1);
+
+   // a rewrite would drop this comment
+   {
+      std::ofstream out(fTrainingFileName, std::ios::app);
+      out << "# marker\n";
+   }
+   EXPECT_EQ(cache->SaveTraining(fTrainingFileName), 1);
+   auto hasMarker = [this] {
+      std::ifstream in(fTrainingFileName);
+      std::string line;
+      while (std::getline(in, line))
+         if (line == "# marker")
+            return true;
+      return false;
+   };
+   EXPECT_TRUE(hasMarker());
+
+   t->AddBranchToCache("y");
+   EXPECT_EQ(cache->SaveTraining(fTrainingFileName), 2);
+   EXPECT_FALSE(hasMarker());
+}
+
+TEST_F(TTreeCacheTraining, ConcurrentSaves)
+{
+   ROOT::EnableThreadSafety();
+   const unsigned int nThreads = 8;
+   auto fileName = [](unsigned int i) { return "ttreecache_training_" + std::to_string(i) + ".root"; };
+   auto treeName = [](unsigned int i) { return "t" + std::to_string(i); };
+   for (unsigned int i = 0; i < nThreads; ++i) {
+      TFile f(fileName(i).c_str(), "RECREATE");
+      TTree t(treeName(i).c_str(), "t");
+      int x = 0;
+      t.Branch("x", &x);
+      t.Fill();
+      t.Write();
+   }
+
+   // each thread stores the training of its own tree in the same file
+   std::vector<std::thread> threads;
+   for (unsigned int i = 0; i < nThreads; ++i) {
+      threads.emplace_back([&, i] {
+         std::unique_ptr<TFile> f(TFile::Open(fileName(i).c_str()));
+         auto t = f->Get<TTree>(treeName(i).c_str());
+         t->SetCacheSize(10000000);
+         t->AddBranchToCache("x");
+         auto cache = dynamic_cast<TTreeCache *>(f->GetCacheRead(t));
+         EXPECT_EQ(cache->SaveTraining(fTrainingFileName), 1);
+      });
+   }
+   for (auto &th : threads)
+      th.join();
+
+   // no record was lost
+   for (unsigned int i = 0; i < nThreads; ++i) {
+      std::unique_ptr<TFile> f(TFile::Open(fileName(i).c_str()));
+      auto t = f->Get<TTree>(treeName(i).c_str());
+      ASSERT_NE(t, nullptr);
+      t->SetCacheSize(10000000);
+      auto cache = dynamic_cast<TTreeCache *>(f->GetCacheRead(t));
+      ASSERT_NE(cache, nullptr);
+      EXPECT_EQ(cache->LoadTraining(fTrainingFileName), 1) << treeName(i);
+   }
+   for (unsigned int i = 0; i < nThreads; ++i)
+      gSystem->Unlink(fileName(i).c_str());
+}
@@ -0,0 +1,90 @@
+#include "TBranch.h"
+#include "TBufferFile.h"
+#include "TFile.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+
+// Reads the baskets of a tree from a file opened with option READ_MMAP, with and without compression.
+class TTreeReadMmap : public ::testing::TestWithParam<int> {
+protected:
+   static constexpr Long64_t fNEntries = 100000;
+   std::string fFileName;
+
+   void SetUp() override
+   {
+      fFileName = "TTreeReadMmap_" + std::to_string(GetParam()) + ".root";
+      TFile f(fFileName.c_str(), "RECREATE", "", GetParam());
+      TTree t("t", "t");
+      float x = 0;
+      t.Branch("x", &x, 32000);
+      for (Long64_t i = 0; i < fNEntries; ++i) {
+         x = i;
+         t.Fill();
+      }
+      t.Write();
+   }
+
+   void TearDown() override { gSystem->Unlink(fFileName.c_str()); }
+};
+
+TEST_P(TTreeReadMmap, GetEntry)
+{
+   std::unique_ptr<TFile> f(TFile::Open(fFileName.c_str(), "READ_MMAP"));
+   ASSERT_TRUE(f && !f->IsZombie());
+#ifndef _WIN32
+   EXPECT_TRUE(f->IsMapped());
+#endif
+   auto t = f->Get<TTree>("t");
+   ASSERT_NE(nullptr, t);
+   ASSERT_GT(t->GetBranch("x")->GetWriteBasket(), 1);
+   float x = -1;
+   t->SetBranchAddress("x", &x);
+   // Read the tree twice, so that the baskets reuse their buffers.
+   for (int pass = 0; pass < 2; ++pass) {
+      for (Long64_t i = 0; i < fNEntries; ++i) {
+         ASSERT_GT(t->GetEntry(i), 0);
+         ASSERT_EQ(float(i), x);
+      }
+   }
+   t->ResetBranchAddresses();
+}
+
+TEST_P(TTreeReadMmap, GetBulkEntries)
+{
+   std::unique_ptr<TFile> f(TFile::Open(fFileName.c_str(), "READ_MMAP"));
+   ASSERT_TRUE(f && !f->IsZombie());
+   auto t = f->Get<TTree>("t");
+   ASSERT_NE(nullptr, t);
+   TBranch *b = t->GetBranch("x");
+   ASSERT_NE(nullptr, b);
+
+   TBufferFile buf(TBuffer::kWrite, 32 * 1024);
+   for (int pass = 0; pass < 2; ++pass) {
+      Long64_t entry = 0;
+      while (entry < fNEntries) {
+         auto count = b->GetBulkRead().GetBulkEntries(entry, buf);
+         ASSERT_GT(count, 0);
+         auto values = reinterpret_cast<float *>(buf.GetCurrent());
+         for (Int_t i = 0; i < count; ++i)
+            ASSERT_EQ(float(entry + i), values[i]);
+         entry += count;
+      }
+      EXPECT_EQ(fNEntries, entry);
+   }
+
+   // The standard API still works on the same branch after the bulk reads.
+   float x = -1;
+   t->SetBranchAddress("x", &x);
+   for (Long64_t i = 0; i < fNEntries; i += 997) {
+      ASSERT_GT(t->GetEntry(i), 0);
+      ASSERT_EQ(float(i), x);
+   }
+   t->ResetBranchAddresses();
+}
+
+INSTANTIATE_TEST_SUITE_P(Compression, TTreeReadMmap, ::testing::Values(0, 101));
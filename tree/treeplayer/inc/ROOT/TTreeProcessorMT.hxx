@@ -26,6 +26,7 @@
 
 #include <functional>
 #include <memory>
+#include <utility> // std::pair
 #include <vector>
 
 /** \class TTreeView
@@ -78,6 +79,10 @@ private:
    /// User-defined selection of entry numbers to be processed, empty if none was provided
    TEntryList fEntryList;
    const Internal::TreeUtils::RFriendInfo fFriendInfo;
+   /// Range of entries [begin, end) to be processed, in global entry numbers. end == -1 means "until the end".
+   std::pair<Long64_t, Long64_t> fGlobalRange{0ll, -1ll};
+   /// Whether the TTreeReaders passed to the user function should use global entry numbers
+   bool fUseGlobalEntries = false;
    ROOT::TThreadExecutor fPool; ///<! Thread pool for processing.
 
    /// Thread-local TreeViews
@@ -96,6 +101,8 @@ public:
 
    void Process(std::function<void(TTreeReader &)> func);
 
+   void SetGlobalEntryRange(Long64_t begin, Long64_t end = -1);
+
    static void SetTasksPerWorkerHint(unsigned int m);
    static unsigned int GetTasksPerWorkerHint();
 };
@@ -27,6 +27,11 @@ objects.
 #include "TROOT.h"
 #include "ROOT/TTreeProcessorMT.hxx"
 
+#include <algorithm> // std::max, std::min
+#include <limits>
+#include <stdexcept>
+#include <string>
+
 using namespace ROOT;
 
 namespace {
@@ -123,6 +128,28 @@ ConvertToElistClusters(std::vector<std::vector<EntryCluster>> &&clusters, TEntry
    return elistClusters;
 }
 
+/// Restrict a vector of vectors of EntryClusters (a vector per file) with global entry numbers to the entries in
+/// [begin, end). end == -1 means "until the last entry". Clusters that do not overlap with the range are removed.
+static std::vector<std::vector<EntryCluster>>
+TrimClustersToRange(std::vector<std::vector<EntryCluster>> &&clusters, Long64_t begin, Long64_t end)
+{
+   if (end == -1ll)
+      end = std::numeric_limits<Long64_t>::max();
+
+   for (auto &fileClusters : clusters) {
+      std::vector<EntryCluster> trimmedClusters;
+      for (const auto &c : fileClusters) {
+         const auto start = std::max(c.start, begin);
+         const auto stop = std::min(c.end, end);
+         if (start < stop)
+            trimmedClusters.emplace_back(EntryCluster{start, stop});
+      }
+      fileClusters = std::move(trimmedClusters);
+   }
+
+   return std::move(clusters);
+}
+
 // EntryClusters and number of entries per file
 using ClustersAndEntries = std::pair<std::vector<std::vector<EntryCluster>>, std::vector<Long64_t>>;
 
@@ -496,20 +523,23 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    const unsigned int maxTasksPerFile =
       std::ceil(float(GetTasksPerWorkerHint() * fPool.GetPoolSize()) / float(fFileNames.size()));
 
-   // If an entry list or friend trees are present, we need to generate clusters with global entry numbers,
-   // so we do it here for all files.
+   // If an entry list or friend trees are present, or if a global entry range was requested, we need to generate
+   // clusters with global entry numbers, so we do it here for all files.
    // Otherwise we can do it later, concurrently for each file, and clusters will contain local entry numbers.
    // TODO: in practice we could also find clusters per-file in the case of no friends and a TEntryList with
    // sub-entrylists.
    const bool hasFriends = !fFriendInfo.fFriendNames.empty();
    const bool hasEntryList = fEntryList.GetN() > 0;
-   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList;
+   const bool shouldRetrieveAllClusters = hasFriends || hasEntryList || fUseGlobalEntries;
    ClustersAndEntries clusterAndEntries{};
    if (shouldRetrieveAllClusters) {
       clusterAndEntries = MakeClusters(fTreeNames, fFileNames, maxTasksPerFile);
       if (hasEntryList)
          clusterAndEntries.first = ConvertToElistClusters(std::move(clusterAndEntries.first), fEntryList, fTreeNames,
                                                           fFileNames, clusterAndEntries.second);
+      if (fUseGlobalEntries)
+         clusterAndEntries.first =
+            TrimClustersToRange(std::move(clusterAndEntries.first), fGlobalRange.first, fGlobalRange.second);
    }
 
    const auto &clusters = clusterAndEntries.first;
@@ -551,6 +581,23 @@ void TTreeProcessorMT::Process(std::function<void(TTreeReader &)> func)
    fPool.Foreach(processFile, fileIdxs);
 }
 
+////////////////////////////////////////////////////////////////////////
+/// \brief Restrict processing to a range of global entry numbers.
+/// \param[in] begin First entry to be processed.
+/// \param[in] end One past the last entry to be processed, -1 to process all entries starting from `begin`.
+///
+/// After a call to this method, TTreeReader::GetCurrentEntry returns global entry numbers (i.e. entry numbers that
+/// refer to the whole dataset rather than to a single file) in the TTreeReaders passed to the user function.
+/// If a TEntryList was provided, entry numbers refer to the entries of the TEntryList.
+void TTreeProcessorMT::SetGlobalEntryRange(Long64_t begin, Long64_t end)
+{
+   if (begin < 0 || (end != -1 && end < begin))
+      throw std::invalid_argument("TTreeProcessorMT::SetGlobalEntryRange: invalid entry range [" +
+                                  std::to_string(begin) + ", " + std::to_string(end) + ")");
+   fGlobalRange = {begin, end};
+   fUseGlobalEntries = true;
+}
+
 ////////////////////////////////////////////////////////////////////////
 /// \brief Retrieve the current value for the desired number of tasks per worker.
 /// \return The desired number of tasks to be created per worker. TTreeProcessorMT uses this value as an hint.
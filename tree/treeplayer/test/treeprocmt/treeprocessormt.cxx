@@ -518,3 +518,51 @@ TEST(TreeProcessorMT, TreesInSameFile)
    gSystem->Unlink(fname.c_str());
    ROOT::DisableImplicitMT();
 }
+
+TEST(TreeProcessorMT, GlobalEntryRange)
+{
+   const auto nFiles = 4u;
+   const std::string treename = "t";
+   std::vector<std::string> filenames;
+   for (auto i = 0u; i < nFiles; ++i)
+      filenames.emplace_back("treeprocmt_globalentryrange" + std::to_string(i) + ".root");
+   WriteFiles(std::vector<std::string>(nFiles, treename), filenames);
+
+   TChain c(treename.c_str());
+   for (const auto &f : filenames)
+      c.Add(f.c_str());
+
+   // values of `v` are entry numbers + 1, entry numbers seen by the readers must be global ones
+   std::atomic_int sum(0);
+   std::atomic_int count(0);
+   std::atomic_int nMismatches(0);
+   auto sumValues = [&](TTreeReader &r) {
+      TTreeReaderValue<int> v(r, "v");
+      while (r.Next()) {
+         if (*v != r.GetCurrentEntry() + 1)
+            ++nMismatches;
+         sum += *v;
+         ++count;
+      }
+   };
+
+   ROOT::TTreeProcessorMT proc(c);
+   proc.SetGlobalEntryRange(5, 33);
+   proc.Process(sumValues);
+   EXPECT_EQ(nMismatches.load(), 0);
+   EXPECT_EQ(count.load(), 28);
+   EXPECT_EQ(sum.load(), 546); // sum of [6..33] inclusive
+
+   sum = 0;
+   count = 0;
+   ROOT::TTreeProcessorMT proc2(c);
+   proc2.SetGlobalEntryRange(12);
+   proc2.Process(sumValues);
+   EXPECT_EQ(nMismatches.load(), 0);
+   EXPECT_EQ(count.load(), 28);
+   EXPECT_EQ(sum.load(), 742); // sum of [13..40] inclusive
+
+   EXPECT_THROW(proc2.SetGlobalEntryRange(10, 5), std::invalid_argument);
+
+   DeleteFiles(filenames);
+}